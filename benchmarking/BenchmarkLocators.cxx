@@ -11,7 +11,10 @@
 #include "Benchmarker.h"
 
 #include <vtkm/Particle.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleRandomUniformReal.h>
+#include <vtkm/cont/CellLocatorBoundingIntervalHierarchy.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
 #include <vtkm/cont/CellLocatorUniformBins.h>
 #include <vtkm/cont/DataSet.h>
@@ -19,12 +22,14 @@
 #include <vtkm/cont/Logging.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/Timer.h>
+#include <vtkm/cont/internal/MortonOrder.h>
 #include <vtkm/cont/internal/OptionParser.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/geometry_refinement/Triangulate.h>
 
+#include <cstdlib>
 #include <random>
 
 namespace
@@ -342,6 +347,121 @@ void Bench2DCellLocatorUniformBinsIterate(::benchmark::State& state)
   }
 }
 
+// Measures the batched FindCells with and without sorting the queries along a Morton curve.
+// Besides the time, reports how far apart (in cell ids) consecutive queries in processing order
+// land, which is a proxy for how well the lookups share cache lines.
+void Bench2DCellLocatorTwoLevelBatch(::benchmark::State& state)
+{
+  vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  vtkm::Id Nx = static_cast<vtkm::Id>(state.range(1));
+  vtkm::Id Ny = static_cast<vtkm::Id>(state.range(2));
+  bool sortPoints = static_cast<bool>(state.range(3));
+
+  auto triDS = CreateExplicitDataSet2D(Nx, Ny);
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  vtkm::cont::Timer timer{ device };
+
+  vtkm::cont::CellLocatorTwoLevel locator2L;
+  locator2L.SetCellSet(triDS.GetCellSet());
+  locator2L.SetCoordinates(triDS.GetCoordinateSystem());
+  locator2L.Update();
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> pcoords;
+
+  //Random number seed. Modify it during the loop to ensure different random numbers.
+  vtkm::Id seed = 0;
+  vtkm::Float64 totalJump = 0;
+  vtkm::Id numJumps = 0;
+  for (auto _ : state)
+  {
+    (void)_;
+
+    auto points = CreateRandomPoints(numPoints, triDS, seed++);
+
+    timer.Start();
+    locator2L.FindCells(points, cellIds, pcoords, sortPoints);
+    timer.Stop();
+    state.SetIterationTime(timer.GetElapsedTime());
+
+    vtkm::cont::ArrayHandle<vtkm::Id> order;
+    if (sortPoints)
+    {
+      order = vtkm::cont::internal::MortonOrder(points);
+    }
+    else
+    {
+      vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numPoints), order);
+    }
+    auto orderPortal = order.ReadPortal();
+    auto cellIdsPortal = cellIds.ReadPortal();
+    for (vtkm::Id i = 1; i < numPoints; ++i)
+    {
+      totalJump += static_cast<vtkm::Float64>(std::abs(cellIdsPortal.Get(orderPortal.Get(i)) -
+                                                       cellIdsPortal.Get(orderPortal.Get(i - 1))));
+      ++numJumps;
+    }
+  }
+
+  state.counters["MeanCellIdJump"] =
+    benchmark::Counter(totalJump / static_cast<vtkm::Float64>(vtkm::Max(numJumps, vtkm::Id(1))));
+}
+
+// Measures building a bounding interval hierarchy and then querying it, and reports the two
+// separately so that the build methods can be compared on both.
+void Bench2DCellLocatorBIH(::benchmark::State& state)
+{
+  vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  vtkm::Id Nx = static_cast<vtkm::Id>(state.range(1));
+  vtkm::Id Ny = static_cast<vtkm::Id>(state.range(2));
+  bool binnedSAH = static_cast<bool>(state.range(3));
+  vtkm::IdComponent leafSize = static_cast<vtkm::IdComponent>(state.range(4));
+  vtkm::IdComponent numBins = static_cast<vtkm::IdComponent>(state.range(5));
+
+  auto triDS = CreateExplicitDataSet2D(Nx, Ny);
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  vtkm::cont::Timer timer{ device };
+
+  //Random number seed. Modify it during the loop to ensure different random numbers.
+  vtkm::Id seed = 0;
+  vtkm::Float64 buildTime = 0;
+  vtkm::Float64 queryTime = 0;
+  for (auto _ : state)
+  {
+    (void)_;
+
+    auto points = CreateRandomPoints(numPoints, triDS, seed++);
+
+    vtkm::cont::CellLocatorBoundingIntervalHierarchy locatorBIH;
+    locatorBIH.SetBuildMethod(
+      binnedSAH ? vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::BinnedSAH
+                : vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::SplittingPlanes);
+    locatorBIH.SetMaxLeafSize(leafSize);
+    locatorBIH.SetNumberOfBins(numBins);
+    locatorBIH.SetCellSet(triDS.GetCellSet());
+    locatorBIH.SetCoordinates(triDS.GetCoordinateSystem());
+
+    timer.Start();
+    locatorBIH.Update();
+    timer.Stop();
+    vtkm::Float64 iterationBuildTime = timer.GetElapsedTime();
+
+    timer.Start();
+    RunLocatorBenchmark(points, locatorBIH);
+    timer.Stop();
+    vtkm::Float64 iterationQueryTime = timer.GetElapsedTime();
+
+    buildTime += iterationBuildTime;
+    queryTime += iterationQueryTime;
+    state.SetIterationTime(iterationBuildTime + iterationQueryTime);
+  }
+
+  state.counters["BuildTime"] = benchmark::Counter(buildTime, benchmark::Counter::kAvgIterations);
+  state.counters["QueryTime"] = benchmark::Counter(queryTime, benchmark::Counter::kAvgIterations);
+}
+
 void Bench2DCellLocatorTwoLevelGenerator(::benchmark::internal::Benchmark* bm)
 {
   bm->ArgNames({ "NumPoints", "DSNx", "DSNy", "LocL1Param", "LocL2Param" });
@@ -378,6 +498,42 @@ void Bench2DCellLocatorUniformBinsGenerator(::benchmark::internal::Benchmark* bm
         }
 }
 
+void Bench2DCellLocatorTwoLevelBatchGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "NumPoints", "DSNx", "DSNy", "Sorted" });
+
+  auto numPts = { 100000, 1000000 };
+  auto DSdims = { 1000 };
+  auto sorted = { 0, 1 };
+
+  for (auto& DSDimx : DSdims)
+    for (auto& DSDimy : DSdims)
+      for (auto& np : numPts)
+        for (auto& s : sorted)
+        {
+          bm->Args({ np, DSDimx, DSDimy, s });
+        }
+}
+
+void Bench2DCellLocatorBIHGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "NumPoints", "DSNx", "DSNy", "BinnedSAH", "LeafSize", "NumBins" });
+
+  auto numPts = { 100000 };
+  auto DSdims = { 300, 1000 };
+  auto leafSizes = { 4, 8 };
+
+  for (auto& DSDim : DSdims)
+    for (auto& np : numPts)
+      for (auto& ls : leafSizes)
+      {
+        bm->Args({ np, DSDim, DSDim, 0, ls, 16 });
+        bm->Args({ np, DSDim, DSDim, 1, ls, 8 });
+        bm->Args({ np, DSDim, DSDim, 1, ls, 16 });
+        bm->Args({ np, DSDim, DSDim, 1, ls, 32 });
+      }
+}
+
 void Bench2DCellLocatorTwoLevelIterateGenerator(::benchmark::internal::Benchmark* bm)
 {
   bm->ArgNames({ "NumPoints", "NumIters", "DSNx", "DSNy", "LocL1Param", "LocL2Param", "LastCell" });
@@ -425,6 +581,8 @@ void Bench2DCellLocatorUniformBinsIterateGenerator(::benchmark::internal::Benchm
 
 VTKM_BENCHMARK_APPLY(Bench2DCellLocatorTwoLevel, Bench2DCellLocatorTwoLevelGenerator);
 VTKM_BENCHMARK_APPLY(Bench2DCellLocatorUniformBins, Bench2DCellLocatorUniformBinsGenerator);
+VTKM_BENCHMARK_APPLY(Bench2DCellLocatorTwoLevelBatch, Bench2DCellLocatorTwoLevelBatchGenerator);
+VTKM_BENCHMARK_APPLY(Bench2DCellLocatorBIH, Bench2DCellLocatorBIHGenerator);
 
 VTKM_BENCHMARK_APPLY(Bench2DCellLocatorTwoLevelIterate, Bench2DCellLocatorTwoLevelIterateGenerator);
 VTKM_BENCHMARK_APPLY(Bench2DCellLocatorUniformBinsIterate,
@@ -13,6 +13,7 @@
 #include <vtkm/Math.h>
 #include <vtkm/VectorAnalysis.h>
 
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/Invoker.h>
@@ -22,6 +23,13 @@
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
+#include <vtkm/filter/clean_grid/worklet/PointMerge.h>
+#include <vtkm/filter/contour/Contour.h>
+#include <vtkm/filter/geometry_refinement/SplitSharpEdges.h>
+#include <vtkm/filter/vector_analysis/SurfaceNormals.h>
+
+#include <vtkm/source/Wavelet.h>
+
 #include <cctype>
 #include <random>
 #include <string>
@@ -375,6 +383,119 @@ void BenchClassificationDynamic(::benchmark::State& state)
 };
 VTKM_BENCHMARK_TEMPLATES(BenchClassificationDynamic, ValueTypes);
 
+// Merges the points of a lattice where each point is repeated a few times with a small
+// jitter, as the output of a contour without merged points would.
+void BenchPointMerge(::benchmark::State& state)
+{
+  const bool useSpatialHash = static_cast<bool>(state.range(0));
+  const bool fastMerge = static_cast<bool>(state.range(1));
+  const vtkm::Id latticeSize = CUBE_SIZE / 4;
+  const vtkm::Id numCopies = 4;
+  const vtkm::Float64 delta = 1e-3;
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> input;
+  input.Allocate(latticeSize * latticeSize * latticeSize * numCopies);
+  {
+    NumberGenerator<vtkm::Float64> jitter{ -0.25 * delta, 0.25 * delta };
+    auto portal = input.WritePortal();
+    vtkm::Id index = 0;
+    for (vtkm::Id copy = 0; copy < numCopies; ++copy)
+    {
+      for (vtkm::Id k = 0; k < latticeSize; ++k)
+      {
+        for (vtkm::Id j = 0; j < latticeSize; ++j)
+        {
+          for (vtkm::Id i = 0; i < latticeSize; ++i)
+          {
+            portal.Set(index++,
+                       vtkm::Vec3f_64(static_cast<vtkm::Float64>(i) + jitter.next(),
+                                      static_cast<vtkm::Float64>(j) + jitter.next(),
+                                      static_cast<vtkm::Float64>(k) + jitter.next()));
+          }
+        }
+      }
+    }
+  }
+  const vtkm::Bounds bounds(vtkm::Vec3f_64(-delta),
+                            vtkm::Vec3f_64(static_cast<vtkm::Float64>(latticeSize - 1) + delta));
+
+  {
+    std::ostringstream desc;
+    desc << "NumPoints:" << input.GetNumberOfValues();
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::cont::Timer timer{ Config.Device };
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> points;
+  for (auto _ : state)
+  {
+    (void)_;
+    vtkm::cont::ArrayCopy(input, points);
+    vtkm::worklet::PointMerge pointMerge;
+    pointMerge.SetUseSpatialHash(useSpatialHash);
+
+    timer.Start();
+    pointMerge.Run(delta, fastMerge, bounds, points);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetItemsProcessed(static_cast<int64_t>(input.GetNumberOfValues()) * iterations);
+}
+VTKM_BENCHMARK_OPTS(BenchPointMerge,
+                      ->Ranges({ { 0, 1 }, { 0, 1 } })
+                      ->ArgNames({ "UseSpatialHash", "FastMerge" }));
+
+// Splits the sharp edges of the triangles of a wavelet isosurface, with the feature angle
+// in degrees as the argument.
+void BenchSplitSharpEdges(::benchmark::State& state)
+{
+  const vtkm::FloatDefault featureAngle = static_cast<vtkm::FloatDefault>(state.range(0));
+
+  vtkm::source::Wavelet wavelet;
+  wavelet.SetExtent(vtkm::Id3(0), vtkm::Id3(CUBE_SIZE / 2 - 1));
+  vtkm::filter::contour::Contour contour;
+  contour.SetActiveField("RTData");
+  contour.SetIsoValues({ 100, 150, 200 });
+  contour.SetGenerateNormals(false);
+  vtkm::filter::vector_analysis::SurfaceNormals normals;
+  normals.SetGenerateCellNormals(true);
+  normals.SetGeneratePointNormals(false);
+  normals.SetCellNormalsName("normals");
+  const vtkm::cont::DataSet input = normals.Execute(contour.Execute(wavelet.Execute()));
+
+  {
+    std::ostringstream desc;
+    desc << "NumCells:" << input.GetNumberOfCells();
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::filter::geometry_refinement::SplitSharpEdges filter;
+  filter.SetFeatureAngle(featureAngle);
+  filter.SetActiveField("normals", vtkm::cont::Field::Association::Cells);
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::DataSet result = filter.Execute(input);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetItemsProcessed(static_cast<int64_t>(input.GetNumberOfCells()) * iterations);
+}
+VTKM_BENCHMARK_OPTS(BenchSplitSharpEdges,
+                      ->ArgName("FeatureAngle")
+                      ->Arg(15)
+                      ->Arg(30)
+                      ->Arg(60));
+
 } // end anon namespace
 
 int main(int argc, char* argv[])
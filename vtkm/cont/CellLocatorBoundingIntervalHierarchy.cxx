@@ -21,6 +21,7 @@
 #include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/DeviceAdapterAlgorithm.h>
 #include <vtkm/cont/ErrorBadDevice.h>
+#include <vtkm/cont/Logging.h>
 #include <vtkm/exec/CellLocatorBoundingIntervalHierarchy.h>
 
 #include <vtkm/cont/Invoker.h>
@@ -224,11 +225,362 @@ IdArrayHandle CalculateSplitScatterIndices(const IdArrayHandle& cellIds,
   return scatterIndices;
 }
 
+// Chooses the split of each segment among numPlanes evenly spaced planes in each dimension.
+void SelectPlaneSplits(vtkm::IdComponent numPlanes,
+                       vtkm::IdComponent maxLeafSize,
+                       vtkm::Id numSegments,
+                       IdArrayHandle& segmentIds,
+                       IdArrayHandle& segmentSizes,
+                       RangeArrayHandle& xRanges,
+                       RangeArrayHandle& yRanges,
+                       RangeArrayHandle& zRanges,
+                       CoordsArrayHandle& centerXs,
+                       CoordsArrayHandle& centerYs,
+                       CoordsArrayHandle& centerZs,
+                       SplitArrayHandle& segmentSplits,
+                       IdArrayHandle& splitChoices,
+                       IdArrayHandle& leqFlags)
+{
+  vtkm::cont::Invoker invoker;
+  IdArrayHandle discardKeys;
+
+  //START_TIMER(s21);
+  // Calculate the X, Y, Z bounding ranges for each segment
+  RangeArrayHandle perSegmentXRanges, perSegmentYRanges, perSegmentZRanges;
+  vtkm::cont::Algorithm::ReduceByKey(
+    segmentIds, xRanges, discardKeys, perSegmentXRanges, vtkm::Add());
+  vtkm::cont::Algorithm::ReduceByKey(
+    segmentIds, yRanges, discardKeys, perSegmentYRanges, vtkm::Add());
+  vtkm::cont::Algorithm::ReduceByKey(
+    segmentIds, zRanges, discardKeys, perSegmentZRanges, vtkm::Add());
+  //PRINT_TIMER("2.1", s21);
+
+  // Expand the per segment bounding ranges, to per cell;
+  RangePermutationArrayHandle segmentXRanges(segmentIds, perSegmentXRanges);
+  RangePermutationArrayHandle segmentYRanges(segmentIds, perSegmentYRanges);
+  RangePermutationArrayHandle segmentZRanges(segmentIds, perSegmentZRanges);
+
+  //START_TIMER(s22);
+  // Calculate split costs for NumPlanes split planes, across X, Y and Z dimensions
+  vtkm::Id numSplitPlanes = numSegments * (numPlanes + 1);
+  vtkm::cont::ArrayHandle<vtkm::worklet::spatialstructure::SplitProperties> xSplits, ySplits,
+    zSplits;
+  xSplits.Allocate(numSplitPlanes);
+  ySplits.Allocate(numSplitPlanes);
+  zSplits.Allocate(numSplitPlanes);
+  CalculateSplitCosts(numPlanes, segmentXRanges, xRanges, centerXs, segmentIds, xSplits);
+  CalculateSplitCosts(numPlanes, segmentYRanges, yRanges, centerYs, segmentIds, ySplits);
+  CalculateSplitCosts(numPlanes, segmentZRanges, zRanges, centerZs, segmentIds, zSplits);
+  //PRINT_TIMER("2.2", s22);
+
+  segmentXRanges.ReleaseResourcesExecution();
+  segmentYRanges.ReleaseResourcesExecution();
+  segmentZRanges.ReleaseResourcesExecution();
+
+  //START_TIMER(s23);
+  // Select best split plane and dimension across X, Y, Z dimension, per segment
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> segmentPlanes;
+  CountingIdArrayHandle indices(0, 1, numSegments);
+
+  vtkm::worklet::spatialstructure::SplitSelector worklet(
+    numPlanes, maxLeafSize, numPlanes + 1);
+  invoker(worklet,
+          indices,
+          xSplits,
+          ySplits,
+          zSplits,
+          segmentSizes,
+          segmentSplits,
+          segmentPlanes,
+          splitChoices);
+  //PRINT_TIMER("2.3", s23);
+
+  // Expand the per segment split plane to per cell
+  SplitPermutationArrayHandle splits(segmentIds, segmentSplits);
+  CoordsPermutationArrayHandle planes(segmentIds, segmentPlanes);
+
+  //START_TIMER(s31);
+  invoker(vtkm::worklet::spatialstructure::CalculateSplitDirectionFlag{},
+          centerXs,
+          centerYs,
+          centerZs,
+          splits,
+          planes,
+          leqFlags);
+  //PRINT_TIMER("3.1", s31);
+}
+
+// Chooses the split of each segment with the lowest surface area heuristic cost. The candidate
+// splits lie between numBins equal bins spanning the cell centers of the segment along each
+// dimension. A histogram counts the cells of every bin and a reduction gathers their bounds,
+// after which a sweep over the bins of each segment evaluates all the candidates.
+void SelectBinnedSplits(vtkm::IdComponent numBins,
+                        vtkm::IdComponent maxLeafSize,
+                        vtkm::Id numSegments,
+                        IdArrayHandle& segmentIds,
+                        IdArrayHandle& segmentSizes,
+                        RangeArrayHandle& xRanges,
+                        RangeArrayHandle& yRanges,
+                        RangeArrayHandle& zRanges,
+                        CoordsArrayHandle& centerXs,
+                        CoordsArrayHandle& centerYs,
+                        CoordsArrayHandle& centerZs,
+                        SplitArrayHandle& segmentSplits,
+                        IdArrayHandle& splitChoices,
+                        IdArrayHandle& leqFlags)
+{
+  vtkm::cont::Invoker invoker;
+  IdArrayHandle discardKeys;
+  vtkm::Id numCells = segmentIds.GetNumberOfValues();
+
+  vtkm::cont::ArrayHandle<vtkm::Bounds> cellBounds;
+  invoker(vtkm::worklet::spatialstructure::CellBoundsCombiner{},
+          xRanges,
+          yRanges,
+          zRanges,
+          cellBounds);
+
+  // The first possible bin key of each segment, and one past the last segment.
+  CountingIdArrayHandle segmentFirstKeys(0, numBins, numSegments + 1);
+
+  const CoordsArrayHandle* centers[3] = { &centerXs, &centerYs, &centerZs };
+  RangeArrayHandle centerRanges[3];
+  vtkm::cont::ArrayHandle<vtkm::worklet::spatialstructure::BinnedSplit> splits[3];
+  for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+  {
+    RangeArrayHandle cellCenterRanges;
+    invoker(vtkm::worklet::spatialstructure::CenterRangeCalculator{},
+            *centers[dim],
+            cellCenterRanges);
+    vtkm::cont::Algorithm::ReduceByKey(
+      segmentIds, cellCenterRanges, discardKeys, centerRanges[dim], vtkm::Add());
+
+    // The keys are dense, so a histogram counts the cells of every bin and a counting sort
+    // groups the cells by key for the reduction of the bin bounds.
+    IdArrayHandle keys;
+    IdArrayHandle keyCounts;
+    keyCounts.AllocateAndFill(numSegments * numBins, 0);
+    invoker(vtkm::worklet::spatialstructure::BinKeyCalculator{ numBins },
+            *centers[dim],
+            segmentIds,
+            RangePermutationArrayHandle(segmentIds, centerRanges[dim]),
+            keys,
+            keyCounts);
+    IdArrayHandle cursors;
+    vtkm::cont::Algorithm::ScanExclusive(keyCounts, cursors);
+    IdArrayHandle cellOrder;
+    IdArrayHandle groupedKeys;
+    cellOrder.Allocate(numCells);
+    groupedKeys.Allocate(numCells);
+    invoker(vtkm::worklet::spatialstructure::BinScatter{}, keys, cursors, cellOrder, groupedKeys);
+
+    IdArrayHandle binKeys;
+    vtkm::cont::ArrayHandle<vtkm::Bounds> binBounds;
+    auto groupedCellBounds = vtkm::cont::make_ArrayHandlePermutation(cellOrder, cellBounds);
+    vtkm::cont::Algorithm::ReduceByKey(
+      groupedKeys, groupedCellBounds, binKeys, binBounds, vtkm::Add());
+    auto binCounts = vtkm::cont::make_ArrayHandlePermutation(binKeys, keyCounts);
+
+    IdArrayHandle binOffsets;
+    vtkm::cont::Algorithm::LowerBounds(binKeys, segmentFirstKeys, binOffsets);
+    invoker(vtkm::worklet::spatialstructure::BinnedSplitSweep{ numBins, dim },
+            CountingIdArrayHandle(0, 1, numSegments),
+            binOffsets,
+            binKeys,
+            binBounds,
+            binCounts,
+            splits[dim]);
+  }
+
+  IdArrayHandle splitBins;
+  RangeArrayHandle splitCenterRanges;
+  invoker(vtkm::worklet::spatialstructure::BinnedSplitSelector{ maxLeafSize },
+          segmentSizes,
+          splits[0],
+          splits[1],
+          splits[2],
+          centerRanges[0],
+          centerRanges[1],
+          centerRanges[2],
+          segmentSplits,
+          splitBins,
+          splitCenterRanges,
+          splitChoices);
+
+  IdArrayHandle segmentStarts;
+  vtkm::cont::Algorithm::ScanExclusive(segmentSizes, segmentStarts);
+  invoker(vtkm::worklet::spatialstructure::BinnedSplitDirectionFlag{ numBins },
+          centerXs,
+          centerYs,
+          centerZs,
+          SplitPermutationArrayHandle(segmentIds, segmentSplits),
+          IdPermutationArrayHandle(segmentIds, splitBins),
+          RangePermutationArrayHandle(segmentIds, splitCenterRanges),
+          IdPermutationArrayHandle(segmentIds, segmentStarts),
+          IdPermutationArrayHandle(segmentIds, segmentSizes),
+          leqFlags);
+}
+
+struct CellBoundsCalculator : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn, FieldInPoint coords, FieldOutCell bounds);
+  using ExecutionSignature = void(_2, _3);
+
+  template <typename PointsVecType>
+  VTKM_EXEC void operator()(const PointsVecType& points, vtkm::Bounds& bounds) const
+  {
+    bounds = vtkm::Bounds();
+    for (vtkm::IdComponent i = 0; i < points.GetNumberOfComponents(); ++i)
+    {
+      bounds.Include(points[i]);
+    }
+  }
+};
+
+// Recomputes the bounds of one level of the tree from the bounds of its cells (for leaves)
+// or from the bounds of the level below (for inner nodes), and updates the split intervals
+// of the inner nodes to match.
+struct RefitTreeLevel : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn nodeIndices,
+                                WholeArrayIn cellIds,
+                                WholeArrayIn cellBounds,
+                                WholeArrayInOut nodes,
+                                WholeArrayInOut nodeBounds);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  template <typename CellIdsPortal,
+            typename CellBoundsPortal,
+            typename NodesPortal,
+            typename NodeBoundsPortal>
+  VTKM_EXEC void operator()(vtkm::Id nodeIndex,
+                            const CellIdsPortal& cellIds,
+                            const CellBoundsPortal& cellBounds,
+                            NodesPortal& nodes,
+                            NodeBoundsPortal& nodeBounds) const
+  {
+    vtkm::exec::CellLocatorBoundingIntervalHierarchyNode node = nodes.Get(nodeIndex);
+    vtkm::Bounds bounds;
+    if (node.ChildIndex < 0)
+    {
+      for (vtkm::Id i = node.Leaf.Start; i < node.Leaf.Start + node.Leaf.Size; ++i)
+      {
+        bounds.Include(cellBounds.Get(cellIds.Get(i)));
+      }
+    }
+    else
+    {
+      vtkm::Bounds left = nodeBounds.Get(node.ChildIndex);
+      vtkm::Bounds right = nodeBounds.Get(node.ChildIndex + 1);
+      const vtkm::Range* leftRanges = &left.X;
+      const vtkm::Range* rightRanges = &right.X;
+      node.Node.LMax = static_cast<vtkm::FloatDefault>(leftRanges[node.Dimension].Max);
+      node.Node.RMin = static_cast<vtkm::FloatDefault>(rightRanges[node.Dimension].Min);
+      nodes.Set(nodeIndex, node);
+      bounds = left + right;
+    }
+    nodeBounds.Set(nodeIndex, bounds);
+  }
+};
+
+// Surface area heuristic cost of a node: the area of its bounds, weighted by the number of
+// cells to test for leaves.
+struct NodeCostCalculator : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn nodes, FieldIn nodeBounds, FieldOut cost);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_EXEC void operator()(const vtkm::exec::CellLocatorBoundingIntervalHierarchyNode& node,
+                            const vtkm::Bounds& bounds,
+                            vtkm::FloatDefault& cost) const
+  {
+    cost = vtkm::worklet::spatialstructure::HalfSurfaceArea(bounds);
+    if (node.ChildIndex < 0)
+    {
+      cost *= static_cast<vtkm::FloatDefault>(node.Leaf.Size);
+    }
+  }
+};
+
 } // anonymous namespace
 
+bool CellLocatorBoundingIntervalHierarchy::Refit(const vtkm::cont::CoordinateSystem& coords)
+{
+  this->RefitRequested = !this->GetModified() && (this->Nodes.GetNumberOfValues() > 0) &&
+    (coords.GetNumberOfPoints() == this->GetCoordinates().GetNumberOfPoints());
+  if (this->RefitRequested && (this->BuildCost < 0))
+  {
+    // The cost of the fresh tree is only needed to judge refits, so it is measured against
+    // the coordinates it was built with just before the first refit replaces them.
+    this->BuildCost = this->RefitNodes();
+  }
+  this->SetCoordinates(coords);
+  this->Update();
+  return this->LastUpdateWasRefit;
+}
+
+vtkm::FloatDefault CellLocatorBoundingIntervalHierarchy::RefitNodes()
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "CellLocatorBoundingIntervalHierarchy::RefitNodes");
+
+  vtkm::Id numNodes = this->Nodes.GetNumberOfValues();
+  if ((numNodes == 0) || (this->LevelOffsets.size() < 2))
+  {
+    return 0;
+  }
+
+  vtkm::cont::Invoker invoker;
+
+  vtkm::cont::ArrayHandle<vtkm::Bounds> cellBounds;
+  invoker(CellBoundsCalculator{},
+          this->GetCellSet(),
+          this->GetCoordinates().GetDataAsMultiplexer(),
+          cellBounds);
+
+  // The nodes of each level only depend on the level below, so work up from the leaves.
+  vtkm::cont::ArrayHandle<vtkm::Bounds> nodeBounds;
+  nodeBounds.Allocate(numNodes);
+  for (std::size_t level = this->LevelOffsets.size() - 1; level > 0; --level)
+  {
+    vtkm::Id levelStart = this->LevelOffsets[level - 1];
+    vtkm::Id levelSize = this->LevelOffsets[level] - levelStart;
+    invoker(RefitTreeLevel{},
+            CountingIdArrayHandle(levelStart, 1, levelSize),
+            this->ProcessedCellIds,
+            cellBounds,
+            this->Nodes,
+            nodeBounds);
+  }
+
+  vtkm::FloatDefault rootArea =
+    vtkm::worklet::spatialstructure::HalfSurfaceArea(nodeBounds.ReadPortal().Get(0));
+  if (rootArea <= 0)
+  {
+    return 0;
+  }
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> nodeCosts;
+  invoker(NodeCostCalculator{}, this->Nodes, nodeBounds, nodeCosts);
+  return vtkm::cont::Algorithm::Reduce(nodeCosts, vtkm::FloatDefault(0)) / rootArea;
+}
 
 void CellLocatorBoundingIntervalHierarchy::Build()
 {
+  if (this->RefitRequested)
+  {
+    this->RefitRequested = false;
+    vtkm::FloatDefault cost = this->RefitNodes();
+    if (cost <= this->RefitQualityThreshold * this->BuildCost)
+    {
+      this->LastUpdateWasRefit = true;
+      return;
+    }
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+               "Rebuilding bounding interval hierarchy: refit cost "
+                 << cost << " exceeds " << this->RefitQualityThreshold << " times build cost "
+                 << this->BuildCost);
+  }
+  this->LastUpdateWasRefit = false;
+
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "CellLocatorBoundingIntervalHierarchy::Build");
 
   vtkm::cont::Invoker invoker;
@@ -276,77 +628,50 @@ void CellLocatorBoundingIntervalHierarchy::Build()
   parentIndices.Allocate(1);
   parentIndices.WritePortal().Set(0, -1);
 
+  this->Nodes = vtkm::cont::ArrayHandle<vtkm::exec::CellLocatorBoundingIntervalHierarchyNode>{};
+  this->LevelOffsets.clear();
+
   while (!done)
   {
     //std::cout << "**** Iteration " << (++iteration) << " ****\n";
     //Output(segmentSizes);
-    //START_TIMER(s21);
-    // Calculate the X, Y, Z bounding ranges for each segment
-    RangeArrayHandle perSegmentXRanges, perSegmentYRanges, perSegmentZRanges;
-    vtkm::cont::Algorithm::ReduceByKey(
-      segmentIds, xRanges, discardKeys, perSegmentXRanges, vtkm::Add());
-    vtkm::cont::Algorithm::ReduceByKey(
-      segmentIds, yRanges, discardKeys, perSegmentYRanges, vtkm::Add());
-    vtkm::cont::Algorithm::ReduceByKey(
-      segmentIds, zRanges, discardKeys, perSegmentZRanges, vtkm::Add());
-    //PRINT_TIMER("2.1", s21);
-
-    // Expand the per segment bounding ranges, to per cell;
-    RangePermutationArrayHandle segmentXRanges(segmentIds, perSegmentXRanges);
-    RangePermutationArrayHandle segmentYRanges(segmentIds, perSegmentYRanges);
-    RangePermutationArrayHandle segmentZRanges(segmentIds, perSegmentZRanges);
-
-    //START_TIMER(s22);
-    // Calculate split costs for NumPlanes split planes, across X, Y and Z dimensions
-    vtkm::Id numSplitPlanes = numSegments * (this->NumPlanes + 1);
-    vtkm::cont::ArrayHandle<vtkm::worklet::spatialstructure::SplitProperties> xSplits, ySplits,
-      zSplits;
-    xSplits.Allocate(numSplitPlanes);
-    ySplits.Allocate(numSplitPlanes);
-    zSplits.Allocate(numSplitPlanes);
-    CalculateSplitCosts(this->NumPlanes, segmentXRanges, xRanges, centerXs, segmentIds, xSplits);
-    CalculateSplitCosts(this->NumPlanes, segmentYRanges, yRanges, centerYs, segmentIds, ySplits);
-    CalculateSplitCosts(this->NumPlanes, segmentZRanges, zRanges, centerZs, segmentIds, zSplits);
-    //PRINT_TIMER("2.2", s22);
-
-    segmentXRanges.ReleaseResourcesExecution();
-    segmentYRanges.ReleaseResourcesExecution();
-    segmentZRanges.ReleaseResourcesExecution();
-
-    //START_TIMER(s23);
-    // Select best split plane and dimension across X, Y, Z dimension, per segment
     SplitArrayHandle segmentSplits;
-    vtkm::cont::ArrayHandle<vtkm::FloatDefault> segmentPlanes;
-    vtkm::cont::ArrayHandle<vtkm::Id> splitChoices;
-    CountingIdArrayHandle indices(0, 1, numSegments);
-
-    vtkm::worklet::spatialstructure::SplitSelector worklet(
-      this->NumPlanes, this->MaxLeafSize, this->NumPlanes + 1);
-    invoker(worklet,
-            indices,
-            xSplits,
-            ySplits,
-            zSplits,
-            segmentSizes,
-            segmentSplits,
-            segmentPlanes,
-            splitChoices);
-    //PRINT_TIMER("2.3", s23);
-
-    // Expand the per segment split plane to per cell
-    SplitPermutationArrayHandle splits(segmentIds, segmentSplits);
-    CoordsPermutationArrayHandle planes(segmentIds, segmentPlanes);
-
-    //START_TIMER(s31);
+    IdArrayHandle splitChoices;
     IdArrayHandle leqFlags;
-    invoker(vtkm::worklet::spatialstructure::CalculateSplitDirectionFlag{},
-            centerXs,
-            centerYs,
-            centerZs,
-            splits,
-            planes,
-            leqFlags);
-    //PRINT_TIMER("3.1", s31);
+    if (this->Method == BuildMethod::BinnedSAH)
+    {
+      SelectBinnedSplits(this->NumBins,
+                         this->MaxLeafSize,
+                         numSegments,
+                         segmentIds,
+                         segmentSizes,
+                         xRanges,
+                         yRanges,
+                         zRanges,
+                         centerXs,
+                         centerYs,
+                         centerZs,
+                         segmentSplits,
+                         splitChoices,
+                         leqFlags);
+    }
+    else
+    {
+      SelectPlaneSplits(this->NumPlanes,
+                        this->MaxLeafSize,
+                        numSegments,
+                        segmentIds,
+                        segmentSizes,
+                        xRanges,
+                        yRanges,
+                        zRanges,
+                        centerXs,
+                        centerYs,
+                        centerZs,
+                        segmentSplits,
+                        splitChoices,
+                        leqFlags);
+    }
 
     //START_TIMER(s32);
     IdArrayHandle scatterIndices = CalculateSplitScatterIndices(cellIds, leqFlags, segmentIds);
@@ -405,6 +730,7 @@ void CellLocatorBoundingIntervalHierarchy::Build()
     //PRINT_TIMER("4.2", s42);
 
     //START_TIMER(s43);
+    this->LevelOffsets.push_back(nodesIndexOffset);
     // Make a new nodes with enough nodes for the current level, copying over the old one
     vtkm::Id nodesSize = this->Nodes.GetNumberOfValues() + numSegments;
     vtkm::cont::ArrayHandle<vtkm::exec::CellLocatorBoundingIntervalHierarchyNode> newTree;
@@ -443,6 +769,10 @@ void CellLocatorBoundingIntervalHierarchy::Build()
     //PRINT_TIMER("5.1", s51);
     //std::cout << "Iteration time: " << iterationTimer.GetElapsedTime() << "\n";
   }
+  this->LevelOffsets.push_back(nodesIndexOffset);
+
+  // The cost of the fresh tree is computed by the first call to Refit.
+  this->BuildCost = -1;
   //std::cout << "Total time: " << totalTimer.GetElapsedTime() << "\n";
 }
 
@@ -13,6 +13,7 @@
 
 #include <vtkm/cont/vtkm_cont_export.h>
 
+#include <vtkm/Math.h>
 #include <vtkm/Types.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
@@ -22,6 +23,8 @@
 #include <vtkm/exec/CellLocatorBoundingIntervalHierarchy.h>
 #include <vtkm/exec/CellLocatorMultiplexer.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace cont
@@ -41,6 +44,20 @@ public:
   using ExecObjType = vtkm::ListApply<CellLocatorExecList, vtkm::exec::CellLocatorMultiplexer>;
   using LastCell = typename ExecObjType::LastCell;
 
+  /// \brief How the cells of a node are divided between its children during `Build`.
+  ///
+  enum struct BuildMethod
+  {
+    /// Try `GetNumberOfSplittingPlanes` evenly spaced planes along each axis and pick the one
+    /// that best balances the number of cells against the extent of the children.
+    SplittingPlanes,
+    /// Sort the cell centers of each node into `GetNumberOfBins` bins along each axis and
+    /// pick the bin boundary with the lowest surface area heuristic cost. This evaluates more
+    /// candidate splits in fewer passes over the cells, which speeds up both building and
+    /// querying large meshes.
+    BinnedSAH
+  };
+
   VTKM_CONT
   CellLocatorBoundingIntervalHierarchy(vtkm::IdComponent numPlanes = 4,
                                        vtkm::IdComponent maxLeafSize = 5)
@@ -71,17 +88,85 @@ public:
   VTKM_CONT
   vtkm::Id GetMaxLeafSize() { return this->MaxLeafSize; }
 
+  /// \brief Specifies how cells are divided when building the hierarchy.
+  ///
+  /// The default is `BuildMethod::SplittingPlanes`.
+  ///
+  VTKM_CONT void SetBuildMethod(BuildMethod method)
+  {
+    this->Method = method;
+    this->SetModified();
+  }
+
+  VTKM_CONT BuildMethod GetBuildMethod() const { return this->Method; }
+
+  /// \brief Specifies the number of bins per axis used by `BuildMethod::BinnedSAH`.
+  ///
+  /// More bins find better splits at a higher build cost. The value is clamped to [2, 64].
+  /// The default is 16.
+  ///
+  VTKM_CONT void SetNumberOfBins(vtkm::IdComponent numBins)
+  {
+    this->NumBins = vtkm::Max(vtkm::IdComponent(2), vtkm::Min(numBins, vtkm::IdComponent(64)));
+    this->SetModified();
+  }
+
+  VTKM_CONT vtkm::IdComponent GetNumberOfBins() const { return this->NumBins; }
+
+  /// \brief Moves the points of the mesh without changing its cells.
+  ///
+  /// Replaces the coordinates of the locator with \p coords, which must have the same number
+  /// of points as the current coordinates. Rather than rebuilding the hierarchy from scratch,
+  /// the bounds stored in its nodes are recomputed bottom-up, one tree level at a time. This
+  /// is much faster than `Update` for meshes that deform while keeping their connectivity.
+  ///
+  /// Refitting keeps the original partitioning of the cells, which gets worse as the points
+  /// move further from where they were when the hierarchy was built. The quality of the tree
+  /// is estimated with the surface area heuristic. If the estimated cost grows beyond
+  /// `GetRefitQualityThreshold` times the cost of the last build, the hierarchy is rebuilt.
+  /// A full build is also done if the locator has not been built yet or if its cell set
+  /// changed since the last build.
+  ///
+  /// Returns true if the hierarchy was refit and false if it was rebuilt.
+  ///
+  VTKM_CONT bool Refit(const vtkm::cont::CoordinateSystem& coords);
+
+  /// \brief Specifies how much a refit may degrade the hierarchy before it is rebuilt.
+  ///
+  /// The value is the largest allowed ratio between the estimated cost of a refit hierarchy
+  /// and that of the freshly built one. The default is 2.
+  ///
+  VTKM_CONT void SetRefitQualityThreshold(vtkm::FloatDefault threshold)
+  {
+    this->RefitQualityThreshold = threshold;
+  }
+
+  VTKM_CONT vtkm::FloatDefault GetRefitQualityThreshold() const
+  {
+    return this->RefitQualityThreshold;
+  }
+
   VTKM_CONT ExecObjType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
                                             vtkm::cont::Token& token) const;
 
 private:
   vtkm::IdComponent NumPlanes;
   vtkm::IdComponent MaxLeafSize;
+  BuildMethod Method = BuildMethod::SplittingPlanes;
+  vtkm::IdComponent NumBins = 16;
   vtkm::cont::ArrayHandle<vtkm::exec::CellLocatorBoundingIntervalHierarchyNode> Nodes;
   vtkm::cont::ArrayHandle<vtkm::Id> ProcessedCellIds;
+  // Index of the first node in each level of the tree, followed by the number of nodes.
+  std::vector<vtkm::Id> LevelOffsets;
+  vtkm::FloatDefault RefitQualityThreshold = 2;
+  // Negative until the first refit after a build computes it.
+  vtkm::FloatDefault BuildCost = -1;
+  bool RefitRequested = false;
+  bool LastUpdateWasRefit = false;
 
   friend Superclass;
   VTKM_CONT void Build();
+  VTKM_CONT vtkm::FloatDefault RefitNodes();
 
   struct MakeExecObject;
 };
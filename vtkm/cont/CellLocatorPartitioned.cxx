@@ -9,10 +9,45 @@
 //============================================================================
 
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/CellLocatorPartitioned.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/PartitionedDataSet.h>
+#include <vtkm/cont/internal/MortonOrder.h>
 #include <vtkm/exec/CellLocatorPartitioned.h>
 
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace
+{
+
+class FindCellsPartitionedWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn points,
+                                ExecObject locator,
+                                FieldOut partitionIds,
+                                FieldOut cellIds,
+                                FieldOut parametricCoords);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  template <typename LocatorType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& point,
+                            const LocatorType& locator,
+                            vtkm::Id& partitionId,
+                            vtkm::Id& cellId,
+                            vtkm::Vec3f& parametric) const
+  {
+    if (locator.FindCell(point, partitionId, cellId, parametric) != vtkm::ErrorCode::Success)
+    {
+      partitionId = -1;
+      cellId = -1;
+    }
+  }
+};
+
+} // anonymous namespace
+
 namespace vtkm
 {
 namespace cont
@@ -50,6 +85,36 @@ void CellLocatorPartitioned::Build()
   }
 }
 
+void CellLocatorPartitioned::FindCells(const vtkm::cont::UnknownArrayHandle& points,
+                                       vtkm::cont::ArrayHandle<vtkm::Id>& partitionIds,
+                                       vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,
+                                       vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords,
+                                       bool sortPoints)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> pointsArray;
+  vtkm::cont::ArrayCopyShallowIfPossible(points, pointsArray);
+  vtkm::cont::Invoker invoke;
+
+  if (!sortPoints)
+  {
+    invoke(
+      FindCellsPartitionedWorklet{}, pointsArray, this, partitionIds, cellIds, parametricCoords);
+    return;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> order = vtkm::cont::internal::MortonOrder(pointsArray);
+  vtkm::Id numPoints = pointsArray.GetNumberOfValues();
+  partitionIds.Allocate(numPoints);
+  cellIds.Allocate(numPoints);
+  parametricCoords.Allocate(numPoints);
+  invoke(FindCellsPartitionedWorklet{},
+         vtkm::cont::make_ArrayHandlePermutation(order, pointsArray),
+         this,
+         vtkm::cont::make_ArrayHandlePermutation(order, partitionIds),
+         vtkm::cont::make_ArrayHandlePermutation(order, cellIds),
+         vtkm::cont::make_ArrayHandlePermutation(order, parametricCoords));
+}
+
 const vtkm::exec::CellLocatorPartitioned CellLocatorPartitioned::PrepareForExecution(
   vtkm::cont::DeviceAdapterId device,
   vtkm::cont::Token& token)
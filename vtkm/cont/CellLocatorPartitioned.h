@@ -40,6 +40,19 @@ public:
 
   void Build();
 
+  /// \brief Finds the partitions and cells containing a batch of points.
+  ///
+  /// For each point, \p partitionIds and \p cellIds receive the partition and cell containing
+  /// it (or -1 if it is not found) and \p parametricCoords the parametric coordinates in that
+  /// cell. As with `CellLocatorGeneral::FindCells`, the points are located in Morton order
+  /// when \p sortPoints is true and the results are returned in the input order.
+  ///
+  VTKM_CONT void FindCells(const vtkm::cont::UnknownArrayHandle& points,
+                           vtkm::cont::ArrayHandle<vtkm::Id>& partitionIds,
+                           vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,
+                           vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords,
+                           bool sortPoints = true);
+
   VTKM_CONT const vtkm::exec::CellLocatorPartitioned PrepareForExecution(
     vtkm::cont::DeviceAdapterId device,
     vtkm::cont::Token& token);
@@ -12,9 +12,12 @@
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
 
 #include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/Timer.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -335,6 +338,85 @@ struct DimensionsToCount
   VTKM_EXEC vtkm::Id operator()(const DimVec3& dim) const { return dim[0] * dim[1] * dim[2]; }
 };
 
+// Computes the log of the size of each cell's bounding box (and its square to get the variance).
+class CellLogSize : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+public:
+  using ControlSignature = void(CellSetIn cellset, FieldInPoint coords, FieldOutCell logSize);
+  using ExecutionSignature = void(_2, _3);
+
+  CellLogSize(const vtkm::Vec<bool, 3>& activeDims, vtkm::FloatDefault minSize)
+    : ActiveDims(activeDims)
+    , MinSize(minSize)
+  {
+  }
+
+  template <typename PointsVecType>
+  VTKM_EXEC void operator()(const PointsVecType& points, vtkm::Vec2f_64& logSize) const
+  {
+    auto cellBounds = ComputeCellBounds(points);
+    vtkm::Float64 sum = 0.0;
+    vtkm::Float64 count = 0.0;
+    for (vtkm::IdComponent i = 0; i < 3; ++i)
+    {
+      if (this->ActiveDims[i])
+      {
+        sum += static_cast<vtkm::Float64>(cellBounds.Max[i] - cellBounds.Min[i]);
+        count += 1.0;
+      }
+    }
+    vtkm::Float64 size = vtkm::Max(sum / count, static_cast<vtkm::Float64>(this->MinSize));
+    logSize[0] = vtkm::Log(size);
+    logSize[1] = logSize[0] * logSize[0];
+  }
+
+private:
+  vtkm::Vec<bool, 3> ActiveDims;
+  vtkm::FloatDefault MinSize;
+};
+
+class CellCenters : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn cellIds,
+                                WholeCellSetIn<Cell, Point> cellset,
+                                WholeArrayIn coords,
+                                FieldOut centers);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename CellSetType, typename CoordsPortalType>
+  VTKM_EXEC void operator()(vtkm::Id cellId,
+                            const CellSetType& cellset,
+                            const CoordsPortalType& coords,
+                            FloatVec3& center) const
+  {
+    auto indices = cellset.GetIndices(cellId);
+    vtkm::IdComponent numPoints = indices.GetNumberOfComponents();
+    center = FloatVec3(0);
+    for (vtkm::IdComponent i = 0; i < numPoints; ++i)
+    {
+      center = center + static_cast<FloatVec3>(coords.Get(indices[i]));
+    }
+    center = center / static_cast<vtkm::FloatDefault>(vtkm::Max(numPoints, 1));
+  }
+};
+
+class LocatePoints : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn points, ExecObject locator, FieldOut cellIds);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename LocatorType>
+  VTKM_EXEC void operator()(const FloatVec3& point,
+                            const LocatorType& locator,
+                            vtkm::Id& cellId) const
+  {
+    FloatVec3 parametric;
+    locator.FindCell(point, cellId, parametric);
+  }
+};
+
 } // anonymous namespace
 
 namespace vtkm
@@ -349,6 +431,21 @@ VTKM_CONT void CellLocatorTwoLevel::Build()
 {
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "CellLocatorTwoLevel::Build");
 
+  // Tuning always starts from the densities set by the user, so rebuilding does not drift.
+  this->ActiveDensityL1 = this->DensityL1;
+  this->ActiveDensityL2 = this->DensityL2;
+  switch (this->AutoTune)
+  {
+    case AutoTuneMode::CellStatistics:
+      this->TuneDensitiesFromCellStatistics();
+      break;
+    case AutoTuneMode::SampledQueries:
+      this->TuneDensitiesFromSampledQueries();
+      break;
+    case AutoTuneMode::Off:
+      break;
+  }
+
   vtkm::cont::Invoker invoke;
 
   auto cellset = this->GetCellSet();
@@ -367,7 +464,7 @@ VTKM_CONT void CellLocatorTwoLevel::Build()
   size += 2.0f * fudge;
 
   this->TopLevel.Dimensions =
-    ComputeGridDimension(cellset.GetNumberOfCells(), size, this->DensityL1);
+    ComputeGridDimension(cellset.GetNumberOfCells(), size, this->ActiveDensityL1);
   this->TopLevel.Origin = bmin - fudge;
   this->TopLevel.BinSize = size / static_cast<FloatVec3>(this->TopLevel.Dimensions);
 
@@ -402,7 +499,7 @@ VTKM_CONT void CellLocatorTwoLevel::Build()
     this->TopLevel.Dimensions[0] * this->TopLevel.Dimensions[1] * this->TopLevel.Dimensions[2];
   vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(DimVec3(0), numberOfBins),
                         this->LeafDimensions);
-  GenerateBinsL1 generateL1(this->TopLevel.BinSize, this->DensityL2);
+  GenerateBinsL1 generateL1(this->TopLevel.BinSize, this->ActiveDensityL2);
   invoke(generateL1, bins, cellsPerBin, this->LeafDimensions);
   bins.ReleaseResources();
   cellsPerBin.ReleaseResources();
@@ -452,6 +549,176 @@ VTKM_CONT void CellLocatorTwoLevel::Build()
   vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(0, numberOfLeaves),
                         this->CellCount);
   invoke(GenerateBinsL2{}, bins, cellsStart, cellsPerBin, this->CellStartIndex, this->CellCount);
+
+  if (this->AutoTune != AutoTuneMode::Off)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+               "CellLocatorTwoLevel auto tuned DensityL1 = "
+                 << this->ActiveDensityL1 << ", DensityL2 = " << this->ActiveDensityL2
+                 << ", memory footprint = " << this->GetMemoryFootprint() << " bytes");
+  }
+}
+
+//----------------------------------------------------------------------------
+VTKM_CONT void CellLocatorTwoLevel::TuneDensitiesFromCellStatistics()
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf,
+                 "CellLocatorTwoLevel::TuneDensitiesFromCellStatistics");
+
+  auto cellset = this->GetCellSet();
+  const auto& coords = this->GetCoordinates();
+
+  vtkm::Id numberOfCells = cellset.GetNumberOfCells();
+  if (numberOfCells < 1)
+  {
+    return;
+  }
+
+  // Use the same notion of the dimensionality of the domain as ComputeGridDimension.
+  auto bounds = coords.GetBounds();
+  vtkm::Vec3f_64 size(bounds.X.Length(), bounds.Y.Length(), bounds.Z.Length());
+  vtkm::Float64 maxside = vtkm::Max(size[0], vtkm::Max(size[1], size[2]));
+  if (!(maxside > 0.0))
+  {
+    return;
+  }
+  vtkm::Vec<bool, 3> activeDims;
+  vtkm::Float64 nsides = 0.0;
+  vtkm::Float64 domainVolume = 1.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    activeDims[i] = (size[i] / maxside >= 1e-4);
+    if (activeDims[i])
+    {
+      nsides += 1.0;
+      domainVolume *= size[i];
+    }
+  }
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Vec2f_64> logSizes;
+  invoke(CellLogSize{ activeDims, static_cast<vtkm::FloatDefault>(1e-6 * maxside) },
+         cellset,
+         coords,
+         logSizes);
+  vtkm::Vec2f_64 sums =
+    vtkm::cont::Algorithm::Reduce(logSizes, vtkm::Vec2f_64(0.0, 0.0), vtkm::Sum());
+  logSizes.ReleaseResources();
+
+  vtkm::Float64 n = static_cast<vtkm::Float64>(numberOfCells);
+  vtkm::Float64 meanLogSize = sums[0] / n;
+  vtkm::Float64 stdDevLogSize = vtkm::Sqrt(vtkm::Max(sums[1] / n - meanLogSize * meanLogSize, 0.0));
+
+  // Fraction of the domain covered by the cell bounding boxes. This is 1 for a mesh of
+  // axis-aligned cells that fill the domain, which is what the user densities are taken for.
+  vtkm::Float64 fill = n * vtkm::Exp(nsides * meanLogSize) / domainVolume;
+  // How much bigger the larger cells are than the typical one.
+  vtkm::Float64 spread = vtkm::Exp(nsides * stdDevLogSize);
+
+  vtkm::Float64 densityL1 = vtkm::Min(vtkm::Max(this->DensityL1 * fill * spread, 1.0), n);
+  vtkm::Float64 densityL2 =
+    vtkm::Min(vtkm::Max(this->DensityL2 * fill, 0.125 * this->DensityL2), 128.0 * this->DensityL2);
+  this->ActiveDensityL1 = static_cast<vtkm::FloatDefault>(densityL1);
+  this->ActiveDensityL2 = static_cast<vtkm::FloatDefault>(densityL2);
+}
+
+//----------------------------------------------------------------------------
+VTKM_CONT void CellLocatorTwoLevel::TuneDensitiesFromSampledQueries()
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf,
+                 "CellLocatorTwoLevel::TuneDensitiesFromSampledQueries");
+
+  this->TuneDensitiesFromCellStatistics();
+
+  vtkm::Id numberOfCells = this->GetCellSet().GetNumberOfCells();
+  vtkm::Id numberOfSamples = vtkm::Min(this->AutoTuneSampleSize, numberOfCells);
+  if (numberOfSamples < 1)
+  {
+    return;
+  }
+
+  // Use the centers of evenly strided cells as the sample queries.
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<FloatVec3> samples;
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> sampleCellIds(
+    0, numberOfCells / numberOfSamples, numberOfSamples);
+  invoke(CellCenters{},
+         sampleCellIds,
+         this->GetCellSet(),
+         this->GetCoordinates(),
+         samples);
+
+  struct Candidate
+  {
+    vtkm::FloatDefault DensityL1;
+    vtkm::FloatDefault DensityL2;
+    vtkm::Float64 Time;
+    vtkm::Id Memory;
+  };
+  std::vector<Candidate> candidates;
+  const vtkm::FloatDefault scalesL1[] = { 0.25f, 1.0f, 4.0f };
+  const vtkm::FloatDefault scalesL2[] = { 0.5f, 1.0f, 2.0f };
+  for (vtkm::FloatDefault scaleL1 : scalesL1)
+  {
+    for (vtkm::FloatDefault scaleL2 : scalesL2)
+    {
+      candidates.push_back({ vtkm::Max(this->ActiveDensityL1 * scaleL1, vtkm::FloatDefault(1)),
+                             this->ActiveDensityL2 * scaleL2,
+                             0.0,
+                             0 });
+    }
+  }
+  candidates.push_back({ this->DensityL1, this->DensityL2, 0.0, 0 });
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  for (auto& candidate : candidates)
+  {
+    CellLocatorTwoLevel locator;
+    locator.SetCellSet(this->GetCellSet());
+    locator.SetCoordinates(this->GetCoordinates());
+    locator.SetDensityL1(candidate.DensityL1);
+    locator.SetDensityL2(candidate.DensityL2);
+    locator.Update();
+    candidate.Memory = locator.GetMemoryFootprint();
+
+    // Take the best of two runs to reduce the noise from the first touch of the arrays.
+    candidate.Time = vtkm::Infinity64();
+    for (int run = 0; run < 2; ++run)
+    {
+      vtkm::cont::Timer timer;
+      timer.Start();
+      invoke(LocatePoints{}, samples, locator, cellIds);
+      timer.Stop();
+      candidate.Time = vtkm::Min(candidate.Time, timer.GetElapsedTime());
+    }
+  }
+
+  vtkm::Id minMemory = candidates.front().Memory;
+  for (const auto& candidate : candidates)
+  {
+    minMemory = vtkm::Min(minMemory, candidate.Memory);
+  }
+
+  const Candidate* best = nullptr;
+  for (const auto& candidate : candidates)
+  {
+    if ((candidate.Memory <= 2 * minMemory) && ((best == nullptr) || (candidate.Time < best->Time)))
+    {
+      best = &candidate;
+    }
+  }
+
+  this->ActiveDensityL1 = best->DensityL1;
+  this->ActiveDensityL2 = best->DensityL2;
+}
+
+//----------------------------------------------------------------------------
+vtkm::Id CellLocatorTwoLevel::GetMemoryFootprint() const
+{
+  return this->LeafDimensions.GetNumberOfValues() * static_cast<vtkm::Id>(sizeof(DimVec3)) +
+    (this->LeafStartIndex.GetNumberOfValues() + this->CellStartIndex.GetNumberOfValues() +
+     this->CellCount.GetNumberOfValues() + this->CellIds.GetNumberOfValues()) *
+    static_cast<vtkm::Id>(sizeof(vtkm::Id));
 }
 
 //----------------------------------------------------------------------------
@@ -493,6 +760,22 @@ void CellLocatorTwoLevel::PrintSummary(std::ostream& out) const
 {
   out << "DensityL1: " << this->DensityL1 << "\n";
   out << "DensityL2: " << this->DensityL2 << "\n";
+  out << "ActiveDensityL1: " << this->ActiveDensityL1 << "\n";
+  out << "ActiveDensityL2: " << this->ActiveDensityL2 << "\n";
+  out << "AutoTune: ";
+  switch (this->AutoTune)
+  {
+    case AutoTuneMode::Off:
+      out << "Off\n";
+      break;
+    case AutoTuneMode::CellStatistics:
+      out << "CellStatistics\n";
+      break;
+    case AutoTuneMode::SampledQueries:
+      out << "SampledQueries\n";
+      break;
+  }
+  out << "MemoryFootprint: " << this->GetMemoryFootprint() << " bytes\n";
   out << "Input CellSet: \n";
   this->GetCellSet().PrintSummary(out);
   out << "Input Coordinates: \n";
@@ -60,6 +60,34 @@ public:
   using ExecObjType = vtkm::ListApply<CellLocatorExecList, vtkm::exec::CellLocatorMultiplexer>;
   using LastCell = typename ExecObjType::LastCell;
 
+  /// \brief Methods for choosing the densities of the two grid levels.
+  ///
+  /// `Off` uses the values given to `SetDensityL1` and `SetDensityL2`.
+  ///
+  /// `CellStatistics` derives the densities from the distribution of cell bounding box sizes.
+  /// The level 2 density is scaled by how much the cell bounding boxes fill the domain so
+  /// that the expected number of leaf bins overlapped by each cell stays the same as with
+  /// the default density on a space-filling mesh. The level 1 density is scaled the same
+  /// way, but using the size of the larger cells (one standard deviation above the mean
+  /// log size) so that the coarse grid gets coarser when the cell sizes vary a lot.
+  ///
+  /// `SampledQueries` starts from the `CellStatistics` estimate, builds the locator for
+  /// several densities around it, and times the location of a sample of cell centers.
+  /// The fastest candidate whose memory footprint is within twice that of the smallest
+  /// candidate is selected. This is much more expensive than `CellStatistics` and is only
+  /// worthwhile if the locator is going to be used heavily.
+  ///
+  /// Auto tuning starts from the values given to `SetDensityL1` and `SetDensityL2`, which
+  /// are not changed. The densities used by the last update are returned by
+  /// `GetActiveDensityL1` and `GetActiveDensityL2`.
+  ///
+  enum struct AutoTuneMode
+  {
+    Off,
+    CellStatistics,
+    SampledQueries
+  };
+
   CellLocatorTwoLevel()
     : DensityL1(32.0f)
     , DensityL2(2.0f)
@@ -84,6 +112,37 @@ public:
   }
   vtkm::FloatDefault GetDensityL2() const { return this->DensityL2; }
 
+  /// Get the densities used to build the search structure. These are the values given to
+  /// `SetDensityL1` and `SetDensityL2` unless auto tuning is on. The locator must be
+  /// updated first.
+  ///
+  vtkm::FloatDefault GetActiveDensityL1() const { return this->ActiveDensityL1; }
+  vtkm::FloatDefault GetActiveDensityL2() const { return this->ActiveDensityL2; }
+
+  /// Get/Set how the level 1 and level 2 densities are chosen.
+  ///
+  void SetAutoTune(AutoTuneMode mode)
+  {
+    this->AutoTune = mode;
+    this->SetModified();
+  }
+  AutoTuneMode GetAutoTune() const { return this->AutoTune; }
+
+  /// Get/Set the maximum number of cell centers located for each candidate when
+  /// auto tuning with `AutoTuneMode::SampledQueries`.
+  ///
+  void SetAutoTuneSampleSize(vtkm::Id size)
+  {
+    this->AutoTuneSampleSize = size;
+    this->SetModified();
+  }
+  vtkm::Id GetAutoTuneSampleSize() const { return this->AutoTuneSampleSize; }
+
+  /// Returns the number of bytes used by the search structure (not counting the cell set
+  /// and coordinates). The locator must be updated first.
+  ///
+  vtkm::Id GetMemoryFootprint() const;
+
   void PrintSummary(std::ostream& out) const;
 
   ExecObjType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
@@ -92,8 +151,14 @@ public:
 private:
   friend Superclass;
   VTKM_CONT void Build();
+  VTKM_CONT void TuneDensitiesFromCellStatistics();
+  VTKM_CONT void TuneDensitiesFromSampledQueries();
 
   vtkm::FloatDefault DensityL1, DensityL2;
+  vtkm::FloatDefault ActiveDensityL1 = 32.0f;
+  vtkm::FloatDefault ActiveDensityL2 = 2.0f;
+  AutoTuneMode AutoTune = AutoTuneMode::Off;
+  vtkm::Id AutoTuneSampleSize = 4096;
 
   vtkm::internal::cl_uniform_bins::Grid TopLevel;
   vtkm::cont::ArrayHandle<vtkm::internal::cl_uniform_bins::DimVec3> LeafDimensions;
@@ -0,0 +1,156 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/CellSetStructuredTetrahedralized.h>
+
+#include <vtkm/cont/ErrorBadType.h>
+
+namespace vtkm
+{
+namespace cont
+{
+
+CellSetStructuredTetrahedralized::CellSetStructuredTetrahedralized(
+  const vtkm::cont::CellSetStructured<3>& structured)
+{
+  this->Structure.SetPointDimensions(structured.GetPointDimensions());
+}
+
+CellSetStructuredTetrahedralized::CellSetStructuredTetrahedralized(
+  const CellSetStructuredTetrahedralized& src)
+  : CellSet(src)
+  , Structure(src.Structure)
+{
+}
+
+CellSetStructuredTetrahedralized& CellSetStructuredTetrahedralized::operator=(
+  const CellSetStructuredTetrahedralized& src)
+{
+  this->CellSet::operator=(src);
+  this->Structure = src.Structure;
+  return *this;
+}
+
+CellSetStructuredTetrahedralized::~CellSetStructuredTetrahedralized() {}
+
+void CellSetStructuredTetrahedralized::SetPointDimensions(const vtkm::Id3& dimensions)
+{
+  this->Structure.SetPointDimensions(dimensions);
+}
+
+vtkm::Id3 CellSetStructuredTetrahedralized::GetPointDimensions() const
+{
+  return this->Structure.GetPointDimensions();
+}
+
+vtkm::cont::CellSetStructured<3> CellSetStructuredTetrahedralized::GetStructuredCellSet() const
+{
+  vtkm::cont::CellSetStructured<3> structured;
+  structured.SetPointDimensions(this->Structure.GetPointDimensions());
+  return structured;
+}
+
+vtkm::Id CellSetStructuredTetrahedralized::GetNumberOfCells() const
+{
+  return vtkm::exec::internal::StructuredTetrahedralizedTable::NUM_TETS_IN_HEXAHEDRON *
+    this->Structure.GetNumberOfCells();
+}
+
+vtkm::Id CellSetStructuredTetrahedralized::GetNumberOfPoints() const
+{
+  return this->Structure.GetNumberOfPoints();
+}
+
+vtkm::Id CellSetStructuredTetrahedralized::GetNumberOfFaces() const
+{
+  return -1;
+}
+
+vtkm::Id CellSetStructuredTetrahedralized::GetNumberOfEdges() const
+{
+  return -1;
+}
+
+vtkm::Id CellSetStructuredTetrahedralized::GetSchedulingRange(vtkm::TopologyElementTagCell) const
+{
+  return this->GetNumberOfCells();
+}
+
+vtkm::Id CellSetStructuredTetrahedralized::GetSchedulingRange(vtkm::TopologyElementTagPoint) const
+{
+  return this->GetNumberOfPoints();
+}
+
+vtkm::UInt8 CellSetStructuredTetrahedralized::GetCellShape(vtkm::Id) const
+{
+  return vtkm::CellShapeTagTetra::Id;
+}
+
+vtkm::IdComponent CellSetStructuredTetrahedralized::GetNumberOfPointsInCell(vtkm::Id) const
+{
+  return 4;
+}
+
+void CellSetStructuredTetrahedralized::GetCellPointIds(vtkm::Id id, vtkm::Id* ptids) const
+{
+  const vtkm::Id4 indices =
+    vtkm::exec::ConnectivityStructuredTetrahedralized(this->Structure).GetIndices(id);
+  for (vtkm::IdComponent i = 0; i < 4; ++i)
+  {
+    ptids[i] = indices[i];
+  }
+}
+
+std::shared_ptr<CellSet> CellSetStructuredTetrahedralized::NewInstance() const
+{
+  return std::make_shared<CellSetStructuredTetrahedralized>();
+}
+
+void CellSetStructuredTetrahedralized::DeepCopy(const CellSet* src)
+{
+  const auto* other = dynamic_cast<const CellSetStructuredTetrahedralized*>(src);
+  if (!other)
+  {
+    throw vtkm::cont::ErrorBadType("CellSetStructuredTetrahedralized::DeepCopy types don't match");
+  }
+
+  this->Structure = other->Structure;
+}
+
+void CellSetStructuredTetrahedralized::PrintSummary(std::ostream& out) const
+{
+  out << "  CellSetStructuredTetrahedralized:\n";
+  this->Structure.PrintSummary(out);
+}
+
+void CellSetStructuredTetrahedralized::ReleaseResourcesExecution()
+{
+  // Nothing is stored in the execution environment.
+}
+
+vtkm::exec::ConnectivityStructuredTetrahedralized CellSetStructuredTetrahedralized::PrepareForInput(
+  vtkm::cont::DeviceAdapterId,
+  vtkm::TopologyElementTagCell,
+  vtkm::TopologyElementTagPoint,
+  vtkm::cont::Token&) const
+{
+  return vtkm::exec::ConnectivityStructuredTetrahedralized(this->Structure);
+}
+
+vtkm::exec::ReverseConnectivityStructuredTetrahedralized
+CellSetStructuredTetrahedralized::PrepareForInput(vtkm::cont::DeviceAdapterId,
+                                                  vtkm::TopologyElementTagPoint,
+                                                  vtkm::TopologyElementTagCell,
+                                                  vtkm::cont::Token&) const
+{
+  return vtkm::exec::ReverseConnectivityStructuredTetrahedralized(this->Structure);
+}
+
+}
+} // namespace vtkm::cont
@@ -0,0 +1,168 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_CellSetStructuredTetrahedralized_h
+#define vtk_m_cont_CellSetStructuredTetrahedralized_h
+
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/cont/CellSet.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/exec/ConnectivityStructuredTetrahedralized.h>
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+template <typename VisitTopology, typename IncidentTopology>
+struct CellSetStructuredTetrahedralizedConnectivityChooser;
+
+template <>
+struct CellSetStructuredTetrahedralizedConnectivityChooser<vtkm::TopologyElementTagCell,
+                                                           vtkm::TopologyElementTagPoint>
+{
+  using ExecConnectivityType = vtkm::exec::ConnectivityStructuredTetrahedralized;
+};
+
+template <>
+struct CellSetStructuredTetrahedralizedConnectivityChooser<vtkm::TopologyElementTagPoint,
+                                                           vtkm::TopologyElementTagCell>
+{
+  using ExecConnectivityType = vtkm::exec::ReverseConnectivityStructuredTetrahedralized;
+};
+
+} // namespace detail
+
+/// @brief Defines a 3-dimensional structured grid split into tetrahedra.
+///
+/// `CellSetStructuredTetrahedralized` presents each hexahedron of a `CellSetStructured<3>`
+/// as 5 tetrahedra. The tetrahedra of hexahedron `i` are cells `5 * i` to `5 * i + 4`, and
+/// their points are computed from the structured index when they are visited, so the cell
+/// set stores no connectivity in either direction. The tetrahedra are the same as the ones
+/// the `Tetrahedralize` filter creates for structured grids.
+///
+/// Worklets can use this cell set like any other cell set of tetrahedra. Note that it is not
+/// in the default list of cell sets, so filters that resolve the cell set type with the
+/// default list do not support it.
+class VTKM_CONT_EXPORT CellSetStructuredTetrahedralized : public CellSet
+{
+  using InternalsType = vtkm::internal::ConnectivityStructuredInternals<3>;
+
+public:
+  VTKM_CONT CellSetStructuredTetrahedralized() = default;
+
+  VTKM_CONT CellSetStructuredTetrahedralized(const vtkm::cont::CellSetStructured<3>& structured);
+
+  VTKM_CONT CellSetStructuredTetrahedralized(const CellSetStructuredTetrahedralized& src);
+  VTKM_CONT CellSetStructuredTetrahedralized& operator=(
+    const CellSetStructuredTetrahedralized& src);
+
+  ~CellSetStructuredTetrahedralized() override;
+
+  /// Sets the dimensions of the points of the structured grid.
+  VTKM_CONT void SetPointDimensions(const vtkm::Id3& dimensions);
+  /// Returns the dimensions of the points of the structured grid.
+  VTKM_CONT vtkm::Id3 GetPointDimensions() const;
+
+  /// Returns the structured cell set of hexahedra that is split into tetrahedra.
+  VTKM_CONT vtkm::cont::CellSetStructured<3> GetStructuredCellSet() const;
+
+  vtkm::Id GetNumberOfCells() const override;
+  vtkm::Id GetNumberOfPoints() const override;
+  vtkm::Id GetNumberOfFaces() const override;
+  vtkm::Id GetNumberOfEdges() const override;
+
+  VTKM_CONT vtkm::Id GetSchedulingRange(vtkm::TopologyElementTagCell) const;
+  VTKM_CONT vtkm::Id GetSchedulingRange(vtkm::TopologyElementTagPoint) const;
+
+  vtkm::UInt8 GetCellShape(vtkm::Id id) const override;
+  vtkm::IdComponent GetNumberOfPointsInCell(vtkm::Id id) const override;
+  void GetCellPointIds(vtkm::Id id, vtkm::Id* ptids) const override;
+
+  std::shared_ptr<CellSet> NewInstance() const override;
+  void DeepCopy(const CellSet* src) override;
+
+  void PrintSummary(std::ostream& out) const override;
+  void ReleaseResourcesExecution() override;
+
+  template <typename VisitTopology, typename IncidentTopology>
+  using ExecConnectivityType = typename detail::
+    CellSetStructuredTetrahedralizedConnectivityChooser<VisitTopology,
+                                                        IncidentTopology>::ExecConnectivityType;
+
+  VTKM_CONT vtkm::exec::ConnectivityStructuredTetrahedralized PrepareForInput(
+    vtkm::cont::DeviceAdapterId,
+    vtkm::TopologyElementTagCell,
+    vtkm::TopologyElementTagPoint,
+    vtkm::cont::Token&) const;
+
+  VTKM_CONT vtkm::exec::ReverseConnectivityStructuredTetrahedralized PrepareForInput(
+    vtkm::cont::DeviceAdapterId,
+    vtkm::TopologyElementTagPoint,
+    vtkm::TopologyElementTagCell,
+    vtkm::cont::Token&) const;
+
+private:
+  InternalsType Structure;
+};
+
+}
+} // namespace vtkm::cont
+
+//=============================================================================
+// Specializations of serialization related classes
+/// @cond SERIALIZATION
+namespace vtkm
+{
+namespace cont
+{
+
+template <>
+struct SerializableTypeString<vtkm::cont::CellSetStructuredTetrahedralized>
+{
+  static VTKM_CONT const std::string& Get()
+  {
+    static std::string name = "CS_StructuredTetrahedralized";
+    return name;
+  }
+};
+}
+} // vtkm::cont
+
+namespace mangled_diy_namespace
+{
+
+template <>
+struct Serialization<vtkm::cont::CellSetStructuredTetrahedralized>
+{
+private:
+  using Type = vtkm::cont::CellSetStructuredTetrahedralized;
+
+public:
+  static VTKM_CONT void save(BinaryBuffer& bb, const Type& cs)
+  {
+    vtkmdiy::save(bb, cs.GetPointDimensions());
+  }
+
+  static VTKM_CONT void load(BinaryBuffer& bb, Type& cs)
+  {
+    vtkm::Id3 dimensions;
+    vtkmdiy::load(bb, dimensions);
+    cs = Type{};
+    cs.SetPointDimensions(dimensions);
+  }
+};
+
+} // diy
+/// @endcond SERIALIZATION
+
+#endif // vtk_m_cont_CellSetStructuredTetrahedralized_h
@@ -22,6 +22,9 @@
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ConvertNumComponentsToOffsets.h>
+#include <vtkm/cont/DefaultTypes.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
@@ -63,6 +66,76 @@ private:
   vtkm::Vec3f Dxdydz;
 };
 
+class CountNeighborsInRadiusWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn queryPoint, ExecObject locator, FieldOut count);
+  using ExecutionSignature = _3(_1, _2);
+
+  VTKM_CONT
+  explicit CountNeighborsInRadiusWorklet(vtkm::FloatDefault radius)
+    : Radius(radius)
+  {
+  }
+
+  template <typename CoordVecType, typename Locator>
+  VTKM_EXEC vtkm::IdComponent operator()(const CoordVecType& queryPoint,
+                                         const Locator& locator) const
+  {
+    return locator.CountNeighborsInRadius(queryPoint, this->Radius);
+  }
+
+private:
+  vtkm::FloatDefault Radius;
+};
+
+class FindNeighborsInRadiusWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn queryPoint,
+                                ExecObject locator,
+                                FieldOut neighborIds,
+                                FieldOut distances2);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  VTKM_CONT
+  explicit FindNeighborsInRadiusWorklet(vtkm::FloatDefault radius)
+    : Radius(radius)
+  {
+  }
+
+  template <typename CoordVecType, typename Locator, typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC void operator()(const CoordVecType& queryPoint,
+                            const Locator& locator,
+                            IdVecType& neighborIds,
+                            DistanceVecType& distances2) const
+  {
+    locator.FindNeighborsInRadius(queryPoint, this->Radius, neighborIds, distances2);
+  }
+
+private:
+  vtkm::FloatDefault Radius;
+};
+
+class FindKNearestNeighborsWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn queryPoint,
+                                ExecObject locator,
+                                FieldOut neighborIds,
+                                FieldOut distances2);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename CoordVecType, typename Locator, typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC void operator()(const CoordVecType& queryPoint,
+                            const Locator& locator,
+                            IdVecType& neighborIds,
+                            DistanceVecType& distances2) const
+  {
+    locator.FindKNearestNeighbors(queryPoint, neighborIds, distances2);
+  }
+};
+
 } // vtkm::cont::internal
 
 void PointLocatorSparseGrid::Build()
@@ -103,6 +176,85 @@ void PointLocatorSparseGrid::Build()
   vtkm::cont::Algorithm::LowerBounds(cellIds, cell_ids_counting, this->CellLower);
 }
 
+void PointLocatorSparseGrid::FindKNearestNeighbors(
+  const vtkm::cont::UnknownArrayHandle& queryPoints,
+  vtkm::IdComponent k,
+  NeighborIdsType& neighborIds,
+  NeighborDistancesType& distances2)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "PointLocatorSparseGrid::FindKNearestNeighbors");
+
+  if (k < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Number of nearest neighbors must not be negative.");
+  }
+
+  this->Update();
+
+  const vtkm::Id numQueries = queryPoints.GetNumberOfValues();
+  const vtkm::Id numNeighbors =
+    vtkm::Min(static_cast<vtkm::Id>(k), this->GetCoordinates().GetNumberOfValues());
+
+  // Every query finds the same number of neighbors, so the offsets can be computed directly.
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, numNeighbors, numQueries + 1),
+                        offsets);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> ids;
+  ids.Allocate(numQueries * numNeighbors);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> dists;
+  dists.Allocate(numQueries * numNeighbors);
+  neighborIds = NeighborIdsType(ids, offsets);
+  distances2 = NeighborDistancesType(dists, offsets);
+
+  vtkm::cont::Invoker invoke;
+  queryPoints.CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldVec3,
+                                                   VTKM_DEFAULT_STORAGE_LIST>(
+    [&](const auto& points) {
+      invoke(internal::FindKNearestNeighborsWorklet{}, points, *this, neighborIds, distances2);
+    });
+}
+
+void PointLocatorSparseGrid::FindNeighborsInRadius(
+  const vtkm::cont::UnknownArrayHandle& queryPoints,
+  vtkm::FloatDefault radius,
+  NeighborIdsType& neighborIds,
+  NeighborDistancesType& distances2)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "PointLocatorSparseGrid::FindNeighborsInRadius");
+
+  if (radius < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Search radius must not be negative.");
+  }
+
+  this->Update();
+
+  vtkm::cont::Invoker invoke;
+  queryPoints.CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldVec3,
+                                                   VTKM_DEFAULT_STORAGE_LIST>(
+    [&](const auto& points) {
+      // First pass: count the neighbors of each query to get the offsets.
+      vtkm::cont::ArrayHandle<vtkm::IdComponent> counts;
+      invoke(internal::CountNeighborsInRadiusWorklet{ radius }, points, *this, counts);
+
+      vtkm::Id totalNeighbors;
+      vtkm::cont::ArrayHandle<vtkm::Id> offsets =
+        vtkm::cont::ConvertNumComponentsToOffsets(counts, totalNeighbors);
+
+      // Second pass: each query writes into its own section of the packed arrays.
+      vtkm::cont::ArrayHandle<vtkm::Id> ids;
+      ids.Allocate(totalNeighbors);
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> dists;
+      dists.Allocate(totalNeighbors);
+      neighborIds = NeighborIdsType(ids, offsets);
+      distances2 = NeighborDistancesType(dists, offsets);
+
+      invoke(
+        internal::FindNeighborsInRadiusWorklet{ radius }, points, *this, neighborIds, distances2);
+    });
+}
+
 vtkm::exec::PointLocatorSparseGrid PointLocatorSparseGrid::PrepareForExecution(
   vtkm::cont::DeviceAdapterId device,
   vtkm::cont::Token& token) const
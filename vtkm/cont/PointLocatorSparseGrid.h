@@ -10,6 +10,8 @@
 #ifndef vtk_m_cont_PointLocatorSparseGrid_h
 #define vtk_m_cont_PointLocatorSparseGrid_h
 
+#include <vtkm/cont/ArrayHandleGroupVecVariable.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
 #include <vtkm/cont/internal/PointLocatorBase.h>
 #include <vtkm/exec/PointLocatorSparseGrid.h>
 
@@ -40,6 +42,15 @@ class VTKM_CONT_EXPORT PointLocatorSparseGrid
 public:
   using RangeType = vtkm::Vec<vtkm::Range, 3>;
 
+  /// Neighbor indices for each query point of a batched search.
+  using NeighborIdsType =
+    vtkm::cont::ArrayHandleGroupVecVariable<vtkm::cont::ArrayHandle<vtkm::Id>,
+                                            vtkm::cont::ArrayHandle<vtkm::Id>>;
+  /// Squared neighbor distances for each query point of a batched search.
+  using NeighborDistancesType =
+    vtkm::cont::ArrayHandleGroupVecVariable<vtkm::cont::ArrayHandle<vtkm::FloatDefault>,
+                                            vtkm::cont::ArrayHandle<vtkm::Id>>;
+
   void SetRange(const RangeType& range)
   {
     if (this->Range != range)
@@ -71,6 +82,32 @@ public:
 
   const vtkm::Id3& GetNumberOfBins() const { return this->Dims; }
 
+  /// \brief Find the k nearest neighbors for each point in a batch of queries.
+  ///
+  /// \c queryPoints must be an array of 3D vectors. For each query point, \c neighborIds
+  /// receives the indices of the (up to) \c k nearest points sorted by distance, and
+  /// \c distances2 receives the matching squared distances. Both outputs share the same
+  /// offsets array. Because every query gets min(k, number of points) neighbors, the offsets
+  /// are known before the search, which is done in a single pass.
+  ///
+  VTKM_CONT void FindKNearestNeighbors(const vtkm::cont::UnknownArrayHandle& queryPoints,
+                                       vtkm::IdComponent k,
+                                       NeighborIdsType& neighborIds,
+                                       NeighborDistancesType& distances2);
+
+  /// \brief Find all points within a radius for each point in a batch of queries.
+  ///
+  /// \c queryPoints must be an array of 3D vectors. For each query point, \c neighborIds
+  /// receives the indices of all points whose distance is at most \c radius, and
+  /// \c distances2 receives the matching squared distances. The search is done in two
+  /// passes: the first counts the neighbors of each query to build the offsets, and the
+  /// second fills the packed output. No atomics or per-query allocations are required.
+  ///
+  VTKM_CONT void FindNeighborsInRadius(const vtkm::cont::UnknownArrayHandle& queryPoints,
+                                       vtkm::FloatDefault radius,
+                                       NeighborIdsType& neighborIds,
+                                       NeighborDistancesType& distances2);
+
   VTKM_CONT
   vtkm::exec::PointLocatorSparseGrid PrepareForExecution(vtkm::cont::DeviceAdapterId device,
                                                          vtkm::cont::Token& token) const;
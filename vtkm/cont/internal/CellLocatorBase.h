@@ -13,17 +13,58 @@
 #include <vtkm/cont/vtkm_cont_export.h>
 
 #include <vtkm/Types.h>
+#include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/CoordinateSystem.h>
 #include <vtkm/cont/ExecutionObjectBase.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
 #include <vtkm/cont/UnknownCellSet.h>
 
 namespace vtkm
 {
 namespace cont
 {
+
+class CellLocatorBoundingIntervalHierarchy;
+class CellLocatorGeneral;
+class CellLocatorRectilinearGrid;
+class CellLocatorTwoLevel;
+class CellLocatorUniformBins;
+class CellLocatorUniformGrid;
+
 namespace internal
 {
 
+namespace detail
+{
+
+// Locates a batch of points. The overloads for the locators of VTK-m are compiled in the
+// vtkm_cont library. The template, for any other locator, is defined in
+// vtkm/cont/internal/CellLocatorFindCells.h, which must be included to use it.
+template <typename LocatorType>
+VTKM_CONT void FindCells(const LocatorType& locator,
+                         const vtkm::cont::UnknownArrayHandle& points,
+                         vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,
+                         vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords,
+                         bool sortPoints);
+
+#define VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(LocatorType)                                \
+  VTKM_CONT_EXPORT void FindCells(const LocatorType& locator,                             \
+                                  const vtkm::cont::UnknownArrayHandle& points,           \
+                                  vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,             \
+                                  vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords, \
+                                  bool sortPoints)
+
+VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(vtkm::cont::CellLocatorBoundingIntervalHierarchy);
+VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(vtkm::cont::CellLocatorGeneral);
+VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(vtkm::cont::CellLocatorRectilinearGrid);
+VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(vtkm::cont::CellLocatorTwoLevel);
+VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(vtkm::cont::CellLocatorUniformBins);
+VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE(vtkm::cont::CellLocatorUniformGrid);
+
+#undef VTK_M_CELL_LOCATOR_FIND_CELLS_DECLARE
+
+} // namespace detail
+
 /// \brief Base class for all `CellLocator` classes.
 ///
 /// `CellLocatorBase` uses the curiously recurring template pattern (CRTP). Subclasses
@@ -63,6 +104,28 @@ public:
     }
   }
 
+  /// \brief Finds the cells containing a batch of points.
+  ///
+  /// For each point in \p points (an array of 3D vectors), \p cellIds receives the id of the
+  /// containing cell (or -1 if the point is not in any cell) and \p parametricCoords receives
+  /// the parametric coordinates of the point in that cell. The outputs are in the same order
+  /// as the input points.
+  ///
+  /// When \p sortPoints is true (the default), the points are located in the order of a
+  /// Morton (Z-order) curve. Neighboring threads then search for nearby points and walk the
+  /// same parts of the search structure, which makes much better use of the caches when the
+  /// points arrive in random order. Sorting costs more than it saves for locators that do no
+  /// search (such as `CellLocatorUniformGrid`) or for points that are already coherent.
+  ///
+  VTKM_CONT void FindCells(const vtkm::cont::UnknownArrayHandle& points,
+                           vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,
+                           vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords,
+                           bool sortPoints = true) const
+  {
+    detail::FindCells(
+      *static_cast<const Derived*>(this), points, cellIds, parametricCoords, sortPoints);
+  }
+
 protected:
   void SetModified() { this->Modified = true; }
   bool GetModified() const { return this->Modified; }
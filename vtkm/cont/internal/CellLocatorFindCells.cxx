@@ -0,0 +1,51 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/CellLocatorFindCells.h>
+
+#include <vtkm/cont/CellLocatorBoundingIntervalHierarchy.h>
+#include <vtkm/cont/CellLocatorGeneral.h>
+#include <vtkm/cont/CellLocatorRectilinearGrid.h>
+#include <vtkm/cont/CellLocatorTwoLevel.h>
+#include <vtkm/cont/CellLocatorUniformBins.h>
+#include <vtkm/cont/CellLocatorUniformGrid.h>
+
+#define VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(LocatorType)                           \
+  void FindCells(const LocatorType& locator,                                        \
+                 const vtkm::cont::UnknownArrayHandle& points,                      \
+                 vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,                        \
+                 vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords,            \
+                 bool sortPoints)                                                   \
+  {                                                                                 \
+    FindCells<LocatorType>(locator, points, cellIds, parametricCoords, sortPoints); \
+  }
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+namespace detail
+{
+
+VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(vtkm::cont::CellLocatorBoundingIntervalHierarchy)
+VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(vtkm::cont::CellLocatorGeneral)
+VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(vtkm::cont::CellLocatorRectilinearGrid)
+VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(vtkm::cont::CellLocatorTwoLevel)
+VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(vtkm::cont::CellLocatorUniformBins)
+VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE(vtkm::cont::CellLocatorUniformGrid)
+
+} // namespace detail
+}
+}
+} // vtkm::cont::internal
+
+#undef VTK_M_CELL_LOCATOR_FIND_CELLS_DEFINE
@@ -0,0 +1,84 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_CellLocatorFindCells_h
+#define vtk_m_cont_internal_CellLocatorFindCells_h
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/internal/CellLocatorBase.h>
+#include <vtkm/cont/internal/MortonOrder.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+namespace detail
+{
+
+class FindCellsWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn points,
+                                ExecObject locator,
+                                FieldOut cellIds,
+                                FieldOut parametricCoords);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename LocatorType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& point,
+                            const LocatorType& locator,
+                            vtkm::Id& cellId,
+                            vtkm::Vec3f& parametric) const
+  {
+    locator.FindCell(point, cellId, parametric);
+  }
+};
+
+template <typename LocatorType>
+VTKM_CONT void FindCells(const LocatorType& locator,
+                         const vtkm::cont::UnknownArrayHandle& points,
+                         vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,
+                         vtkm::cont::ArrayHandle<vtkm::Vec3f>& parametricCoords,
+                         bool sortPoints)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> pointsArray;
+  vtkm::cont::ArrayCopyShallowIfPossible(points, pointsArray);
+  vtkm::cont::Invoker invoke;
+
+  if (!sortPoints)
+  {
+    invoke(FindCellsWorklet{}, pointsArray, locator, cellIds, parametricCoords);
+    return;
+  }
+
+  // Locate the points in Morton order, writing the results directly back to their
+  // original positions.
+  vtkm::cont::ArrayHandle<vtkm::Id> order = vtkm::cont::internal::MortonOrder(pointsArray);
+  vtkm::Id numPoints = pointsArray.GetNumberOfValues();
+  cellIds.Allocate(numPoints);
+  parametricCoords.Allocate(numPoints);
+  invoke(FindCellsWorklet{},
+         vtkm::cont::make_ArrayHandlePermutation(order, pointsArray),
+         locator,
+         vtkm::cont::make_ArrayHandlePermutation(order, cellIds),
+         vtkm::cont::make_ArrayHandlePermutation(order, parametricCoords));
+}
+
+} // namespace detail
+}
+}
+} // vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_CellLocatorFindCells_h
@@ -0,0 +1,102 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/MortonOrder.h>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace
+{
+
+// Spreads the lower 21 bits of x so that there are 2 zero bits between each.
+VTKM_EXEC inline vtkm::UInt64 ExpandBits(vtkm::UInt64 x)
+{
+  x &= 0x1FFFFF;
+  x = (x | x << 32) & 0x1F00000000FFFF;
+  x = (x | x << 16) & 0x1F0000FF0000FF;
+  x = (x | x << 8) & 0x100F00F00F00F00F;
+  x = (x | x << 4) & 0x10C30C30C30C30C3;
+  x = (x | x << 2) & 0x1249249249249249;
+  return x;
+}
+
+class ComputeMortonCode : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn point, FieldOut code);
+  using ExecutionSignature = _2(_1);
+
+  VTKM_CONT ComputeMortonCode(const vtkm::Vec3f_64& origin, const vtkm::Vec3f_64& scale)
+    : Origin(origin)
+    , Scale(scale)
+  {
+  }
+
+  VTKM_EXEC vtkm::UInt64 operator()(const vtkm::Vec3f& point) const
+  {
+    vtkm::UInt64 code = 0;
+    for (vtkm::IdComponent i = 0; i < 3; ++i)
+    {
+      vtkm::Float64 normalized = (static_cast<vtkm::Float64>(point[i]) - this->Origin[i]) *
+        this->Scale[i];
+      normalized = vtkm::Min(vtkm::Max(normalized, 0.0), 2097151.0);
+      code |= ExpandBits(static_cast<vtkm::UInt64>(normalized)) << i;
+    }
+    return code;
+  }
+
+private:
+  vtkm::Vec3f_64 Origin;
+  vtkm::Vec3f_64 Scale;
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+vtkm::cont::ArrayHandle<vtkm::Id> MortonOrder(const vtkm::cont::ArrayHandle<vtkm::Vec3f>& points)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "MortonOrder");
+
+  vtkm::cont::ArrayHandle<vtkm::Range> ranges = vtkm::cont::ArrayRangeCompute(points);
+  auto rangesPortal = ranges.ReadPortal();
+  vtkm::Vec3f_64 origin;
+  vtkm::Vec3f_64 scale;
+  for (vtkm::IdComponent i = 0; i < 3; ++i)
+  {
+    vtkm::Range range = rangesPortal.Get(i);
+    origin[i] = range.Min;
+    scale[i] = (range.Length() > 0.0) ? (2097152.0 / range.Length()) : 0.0;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::UInt64> codes;
+  vtkm::cont::Invoker invoke;
+  invoke(ComputeMortonCode{ origin, scale }, points, codes);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> order;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(points.GetNumberOfValues()), order);
+  vtkm::cont::Algorithm::SortByKey(codes, order);
+  return order;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
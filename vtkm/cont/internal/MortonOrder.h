@@ -0,0 +1,38 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_MortonOrder_h
+#define vtk_m_cont_internal_MortonOrder_h
+
+#include <vtkm/cont/ArrayHandle.h>
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+/// \brief Computes an order that sorts points along a Morton (Z-order) curve.
+///
+/// The returned array holds the indices of `points` such that visiting the points in that
+/// order follows a Morton curve spanning the bounds of the points (using 21 bits per
+/// dimension). Processing queries in this order makes consecutive queries spatially
+/// coherent, which improves the cache behavior of any search structure they traverse.
+///
+VTKM_CONT_EXPORT vtkm::cont::ArrayHandle<vtkm::Id> MortonOrder(
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f>& points);
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_MortonOrder_h
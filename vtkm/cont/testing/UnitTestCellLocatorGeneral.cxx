@@ -268,6 +268,23 @@ void TestWithDataSet(vtkm::cont::CellLocatorGeneral& locator, const vtkm::cont::
 
   //Call it again using the lastCell just computed to validate.
   TestLastCell(locator, 64, lastCell2, points, expCellIds, pcoords);
+
+  //Test the batched query, both in Morton order and in input order.
+  for (bool sortPoints : { true, false })
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> batchCellIds;
+    vtkm::cont::ArrayHandle<PointType> batchPCoords;
+    locator.FindCells(points, batchCellIds, batchPCoords, sortPoints);
+
+    auto batchCellIdPortal = batchCellIds.ReadPortal();
+    auto batchPCoordsPortal = batchPCoords.ReadPortal();
+    for (vtkm::Id i = 0; i < 64; ++i)
+    {
+      VTKM_TEST_ASSERT(batchCellIdPortal.Get(i) == expCellIdsPortal.Get(i), "Incorrect cell ids");
+      VTKM_TEST_ASSERT(test_equal(batchPCoordsPortal.Get(i), expPCoordsPortal.Get(i), 1e-3),
+                       "Incorrect parameteric coordinates");
+    }
+  }
 }
 
 void TestCellLocatorGeneral()
@@ -84,6 +84,14 @@ void Test()
   {
     VTKM_TEST_ASSERT(partitionIds.ReadPortal().Get(index) == index, "Incorrect partitionId");
   }
+
+  // check the batched query returns the same results
+  vtkm::cont::ArrayHandle<vtkm::Id> batchPartitionIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> batchCellIds;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> batchPCoords;
+  cellLocator.FindCells(queryPoints, batchPartitionIds, batchCellIds, batchPCoords);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(batchPartitionIds, partitionIds));
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(batchCellIds, cellIds));
 }
 
 } // anonymous namespace
@@ -302,6 +302,33 @@ void TestingCellLocatorUnstructured()
   TestCellLocator(locator2L, vtkm::Id3(8), 512);  // 3D dataset
   TestCellLocator(locator2L, vtkm::Id2(18), 512); // 2D dataset
 
+  //Test vtkm::cont::CellLocatorTwoLevel with auto tuned densities
+  vtkm::cont::CellLocatorTwoLevel locator2LStats;
+  locator2LStats.SetAutoTune(vtkm::cont::CellLocatorTwoLevel::AutoTuneMode::CellStatistics);
+  TestCellLocator(locator2LStats, vtkm::Id3(8), 512);  // 3D dataset
+  TestCellLocator(locator2LStats, vtkm::Id2(18), 512); // 2D dataset
+  VTKM_TEST_ASSERT(locator2LStats.GetActiveDensityL1() >= 1.0f);
+  VTKM_TEST_ASSERT(locator2LStats.GetActiveDensityL2() > 0.0f);
+  VTKM_TEST_ASSERT(locator2LStats.GetMemoryFootprint() > 0);
+
+  // Tuning starts from the user densities, which are kept, so rebuilding gives the same result.
+  locator2LStats.SetDensityL1(16.0f);
+  locator2LStats.Update();
+  const vtkm::FloatDefault tunedDensityL1 = locator2LStats.GetActiveDensityL1();
+  const vtkm::FloatDefault tunedDensityL2 = locator2LStats.GetActiveDensityL2();
+  locator2LStats.SetDensityL1(16.0f);
+  locator2LStats.Update();
+  VTKM_TEST_ASSERT(locator2LStats.GetDensityL1() == 16.0f, "User density was overwritten");
+  VTKM_TEST_ASSERT(locator2LStats.GetDensityL2() == 2.0f, "User density was overwritten");
+  VTKM_TEST_ASSERT(locator2LStats.GetActiveDensityL1() == tunedDensityL1, "Tuning drifted");
+  VTKM_TEST_ASSERT(locator2LStats.GetActiveDensityL2() == tunedDensityL2, "Tuning drifted");
+
+  vtkm::cont::CellLocatorTwoLevel locator2LSampled;
+  locator2LSampled.SetAutoTune(vtkm::cont::CellLocatorTwoLevel::AutoTuneMode::SampledQueries);
+  locator2LSampled.SetAutoTuneSampleSize(256);
+  TestCellLocator(locator2LSampled, vtkm::Id3(8), 512);  // 3D dataset
+  TestCellLocator(locator2LSampled, vtkm::Id2(18), 512); // 2D dataset
+
   //Test vtkm::cont::CellLocatorUniformBins
   vtkm::cont::CellLocatorUniformBins locatorUB;
   locatorUB.SetDims({ 32, 32, 32 });
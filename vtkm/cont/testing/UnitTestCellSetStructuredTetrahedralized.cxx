@@ -0,0 +1,202 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetStructuredTetrahedralized.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::IdComponent MaxCellsOnPoint = 32;
+
+struct CopyTopo : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn, FieldInPoint coords, FieldOutCell, FieldOutCell);
+  using ExecutionSignature = void(CellShape, PointIndices, _2, _3, _4);
+
+  template <typename IndicesType, typename CoordsType>
+  VTKM_EXEC void operator()(vtkm::CellShapeTagTetra,
+                            const IndicesType& indices,
+                            const CoordsType& coords,
+                            vtkm::Id4& pointIds,
+                            vtkm::FloatDefault& volume) const
+  {
+    for (vtkm::IdComponent i = 0; i < 4; ++i)
+    {
+      pointIds[i] = indices[i];
+    }
+    volume =
+      vtkm::Dot(coords[1] - coords[0], vtkm::Cross(coords[2] - coords[0], coords[3] - coords[0])) /
+      6;
+  }
+};
+
+struct CopyReverseTopo : public vtkm::worklet::WorkletVisitPointsWithCells
+{
+  using ControlSignature = void(CellSetIn, FieldInCell cellIds, FieldOutPoint, FieldOutPoint);
+  using ExecutionSignature = void(CellShape, CellCount, CellIndices, _2, _3, _4);
+
+  template <typename CellIndicesType, typename CellIdsType>
+  VTKM_EXEC void operator()(vtkm::CellShapeTagVertex,
+                            vtkm::IdComponent count,
+                            const CellIndicesType& cellIndices,
+                            const CellIdsType& cellIds,
+                            vtkm::IdComponent& outCount,
+                            vtkm::Vec<vtkm::Id, MaxCellsOnPoint>& outIndices) const
+  {
+    outCount = count;
+    for (vtkm::IdComponent i = 0; i < MaxCellsOnPoint; ++i)
+    {
+      outIndices[i] = -1;
+    }
+    for (vtkm::IdComponent i = 0; i < count; ++i)
+    {
+      // The incident cell field must be fetched from the same cells as the indices.
+      outIndices[i] = (cellIds[i] == cellIndices[i]) ? cellIndices[i] : -2;
+    }
+  }
+};
+
+void TestCellSetStructuredTetrahedralized()
+{
+  const vtkm::Id3 dimensions(4, 3, 5);
+  vtkm::cont::CellSetStructured<3> structured;
+  structured.SetPointDimensions(dimensions);
+  vtkm::cont::CellSetStructuredTetrahedralized cellSet(structured);
+
+  const vtkm::Id numHexahedra = structured.GetNumberOfCells();
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == 5 * numHexahedra);
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfPoints() == structured.GetNumberOfPoints());
+  VTKM_TEST_ASSERT(cellSet.GetCellShape(7) == vtkm::CELL_SHAPE_TETRA);
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfPointsInCell(7) == 4);
+
+  // The cell set can be held as an unknown cell set.
+  vtkm::cont::UnknownCellSet unknown(cellSet);
+  VTKM_TEST_ASSERT(unknown.IsType<vtkm::cont::CellSetStructuredTetrahedralized>());
+  VTKM_TEST_ASSERT(unknown.GetNumberOfCells() == cellSet.GetNumberOfCells());
+
+  std::cout << "Verify the tetrahedra of each hexahedron" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Id4> pointIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> volumes;
+  invoke(CopyTopo{},
+         cellSet,
+         vtkm::cont::ArrayHandleUniformPointCoordinates(dimensions),
+         pointIds,
+         volumes);
+  VTKM_TEST_ASSERT(pointIds.GetNumberOfValues() == cellSet.GetNumberOfCells());
+
+  auto pointIdsPortal = pointIds.ReadPortal();
+  auto volumesPortal = volumes.ReadPortal();
+  std::map<std::vector<vtkm::Id>, vtkm::IdComponent> faceCounts;
+  for (vtkm::Id hexahedron = 0; hexahedron < numHexahedra; ++hexahedron)
+  {
+    vtkm::Id hexahedronPoints[8];
+    structured.GetCellPointIds(hexahedron, hexahedronPoints);
+    vtkm::FloatDefault hexahedronVolume = 0;
+    for (vtkm::Id cell = 5 * hexahedron; cell < 5 * (hexahedron + 1); ++cell)
+    {
+      const vtkm::Id4 tet = pointIdsPortal.Get(cell);
+      vtkm::Id cellPoints[4];
+      cellSet.GetCellPointIds(cell, cellPoints);
+      for (vtkm::IdComponent i = 0; i < 4; ++i)
+      {
+        VTKM_TEST_ASSERT(cellPoints[i] == tet[i], "Cell point ids differ from the worklet");
+        VTKM_TEST_ASSERT(std::find(hexahedronPoints, hexahedronPoints + 8, tet[i]) !=
+                           hexahedronPoints + 8,
+                         "Tetrahedron point is not in its hexahedron");
+      }
+      VTKM_TEST_ASSERT(volumesPortal.Get(cell) > 0, "Inverted or degenerate tetrahedron");
+      hexahedronVolume += volumesPortal.Get(cell);
+
+      for (vtkm::IdComponent skip = 0; skip < 4; ++skip)
+      {
+        std::vector<vtkm::Id> face;
+        for (vtkm::IdComponent i = 0; i < 4; ++i)
+        {
+          if (i != skip)
+          {
+            face.push_back(tet[i]);
+          }
+        }
+        std::sort(face.begin(), face.end());
+        ++faceCounts[face];
+      }
+    }
+    VTKM_TEST_ASSERT(test_equal(hexahedronVolume, 1), "Tetrahedra do not fill the hexahedron");
+  }
+
+  // Neighboring hexahedra must be split along the same diagonals, so every face is shared by
+  // two tetrahedra except for the faces on the boundary. There are 2 triangles for each quad on
+  // the boundary.
+  const vtkm::Id3 cellDims = dimensions - vtkm::Id3(1);
+  const vtkm::Id numBoundaryFaces = 4 *
+    (cellDims[0] * cellDims[1] + cellDims[1] * cellDims[2] + cellDims[0] * cellDims[2]);
+  vtkm::Id numSingleFaces = 0;
+  for (const auto& face : faceCounts)
+  {
+    VTKM_TEST_ASSERT(face.second <= 2, "Face used by more than 2 tetrahedra");
+    numSingleFaces += (face.second == 1) ? 1 : 0;
+  }
+  VTKM_TEST_ASSERT(numSingleFaces == numBoundaryFaces, "Tetrahedra are not conforming");
+
+  std::cout << "Verify the reverse topology" << std::endl;
+  std::vector<std::vector<vtkm::Id>> expectedCells(
+    static_cast<std::size_t>(cellSet.GetNumberOfPoints()));
+  for (vtkm::Id cell = 0; cell < cellSet.GetNumberOfCells(); ++cell)
+  {
+    const vtkm::Id4 tet = pointIdsPortal.Get(cell);
+    for (vtkm::IdComponent i = 0; i < 4; ++i)
+    {
+      expectedCells[static_cast<std::size_t>(tet[i])].push_back(cell);
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> counts;
+  vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Id, MaxCellsOnPoint>> cellIds;
+  invoke(CopyReverseTopo{},
+         cellSet,
+         vtkm::cont::ArrayHandleIndex(cellSet.GetNumberOfCells()),
+         counts,
+         cellIds);
+  auto countsPortal = counts.ReadPortal();
+  auto cellIdsPortal = cellIds.ReadPortal();
+  for (vtkm::Id point = 0; point < cellSet.GetNumberOfPoints(); ++point)
+  {
+    const std::vector<vtkm::Id>& expected = expectedCells[static_cast<std::size_t>(point)];
+    VTKM_TEST_ASSERT(countsPortal.Get(point) == static_cast<vtkm::IdComponent>(expected.size()),
+                     "Wrong number of cells on point ",
+                     point);
+    const auto cells = cellIdsPortal.Get(point);
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      VTKM_TEST_ASSERT(cells[static_cast<vtkm::IdComponent>(i)] == expected[i],
+                       "Wrong cell on point ",
+                       point);
+    }
+  }
+}
+
+} // anonymous namespace
+
+int UnitTestCellSetStructuredTetrahedralized(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestCellSetStructuredTetrahedralized, argc, argv);
+}
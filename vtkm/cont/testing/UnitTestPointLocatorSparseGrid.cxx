@@ -16,6 +16,7 @@
 
 #include <vtkm/worklet/WorkletMapField.h>
 
+#include <algorithm>
 #include <random>
 
 namespace
@@ -181,9 +182,117 @@ void TestTest()
   VTKM_TEST_ASSERT(passTest, "Uniform Grid NN search result incorrect.");
 }
 
+void TestBatchedQueries()
+{
+  std::cout << "Testing batched kNN and radius queries." << std::endl;
+
+  std::default_random_engine dre;
+  std::uniform_real_distribution<vtkm::Float32> dr(0.0f, 10.0f);
+
+  std::vector<vtkm::Vec3f_32> coordi;
+  for (vtkm::Int32 i = 0; i < 500; i++)
+  {
+    coordi.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  auto coordi_Handle = vtkm::cont::make_ArrayHandle(coordi, vtkm::CopyFlag::Off);
+
+  std::vector<vtkm::Vec3f_32> qcVec;
+  for (vtkm::Int32 i = 0; i < 50; i++)
+  {
+    qcVec.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  // Queries outside of the locator range.
+  qcVec.push_back(vtkm::make_Vec(-2.0f, 5.0f, 5.0f));
+  qcVec.push_back(vtkm::make_Vec(12.0f, 12.0f, -1.0f));
+  auto qc_Handle = vtkm::cont::make_ArrayHandle(qcVec, vtkm::CopyFlag::Off);
+
+  vtkm::cont::PointLocatorSparseGrid locator;
+  locator.SetCoordinates(vtkm::cont::CoordinateSystem("points", coordi_Handle));
+  locator.SetNumberOfBins({ 8, 8, 8 });
+
+  auto bruteForce = [&](const vtkm::Vec3f_32& qc) {
+    std::vector<std::pair<vtkm::FloatDefault, vtkm::Id>> sorted;
+    for (std::size_t i = 0; i < coordi.size(); ++i)
+    {
+      sorted.emplace_back(vtkm::MagnitudeSquared(vtkm::Vec3f(coordi[i]) - vtkm::Vec3f(qc)),
+                          static_cast<vtkm::Id>(i));
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  };
+
+  constexpr vtkm::IdComponent k = 7;
+  vtkm::cont::PointLocatorSparseGrid::NeighborIdsType knnIds;
+  vtkm::cont::PointLocatorSparseGrid::NeighborDistancesType knnDists;
+  locator.FindKNearestNeighbors(qc_Handle, k, knnIds, knnDists);
+  VTKM_TEST_ASSERT(knnIds.GetNumberOfValues() == static_cast<vtkm::Id>(qcVec.size()));
+
+  auto knnIdsPortal = knnIds.ReadPortal();
+  auto knnDistsPortal = knnDists.ReadPortal();
+  for (std::size_t q = 0; q < qcVec.size(); ++q)
+  {
+    auto expected = bruteForce(qcVec[q]);
+    auto ids = knnIdsPortal.Get(static_cast<vtkm::Id>(q));
+    auto dists = knnDistsPortal.Get(static_cast<vtkm::Id>(q));
+    VTKM_TEST_ASSERT(ids.GetNumberOfComponents() == k, "Wrong number of neighbors");
+    for (vtkm::IdComponent n = 0; n < k; ++n)
+    {
+      VTKM_TEST_ASSERT(test_equal(dists[n], expected[static_cast<std::size_t>(n)].first),
+                       "Wrong distance for neighbor ",
+                       n,
+                       " of query ",
+                       q);
+      VTKM_TEST_ASSERT(ids[n] == expected[static_cast<std::size_t>(n)].second,
+                       "Wrong id for neighbor ",
+                       n,
+                       " of query ",
+                       q);
+    }
+  }
+
+  constexpr vtkm::FloatDefault radius = 1.5f;
+  vtkm::cont::PointLocatorSparseGrid::NeighborIdsType radiusIds;
+  vtkm::cont::PointLocatorSparseGrid::NeighborDistancesType radiusDists;
+  locator.FindNeighborsInRadius(qc_Handle, radius, radiusIds, radiusDists);
+  VTKM_TEST_ASSERT(radiusIds.GetNumberOfValues() == static_cast<vtkm::Id>(qcVec.size()));
+
+  auto radiusIdsPortal = radiusIds.ReadPortal();
+  auto radiusDistsPortal = radiusDists.ReadPortal();
+  for (std::size_t q = 0; q < qcVec.size(); ++q)
+  {
+    auto expected = bruteForce(qcVec[q]);
+    std::vector<vtkm::Id> expectedIds;
+    for (auto&& entry : expected)
+    {
+      if (entry.first <= radius * radius)
+      {
+        expectedIds.push_back(entry.second);
+      }
+    }
+
+    auto ids = radiusIdsPortal.Get(static_cast<vtkm::Id>(q));
+    auto dists = radiusDistsPortal.Get(static_cast<vtkm::Id>(q));
+    std::vector<vtkm::Id> foundIds;
+    for (vtkm::IdComponent n = 0; n < ids.GetNumberOfComponents(); ++n)
+    {
+      VTKM_TEST_ASSERT(dists[n] <= radius * radius, "Neighbor outside of radius");
+      foundIds.push_back(ids[n]);
+    }
+    std::sort(expectedIds.begin(), expectedIds.end());
+    std::sort(foundIds.begin(), foundIds.end());
+    VTKM_TEST_ASSERT(foundIds == expectedIds, "Wrong neighbors in radius for query ", q);
+  }
+}
+
+void TestPointLocatorSparseGrid()
+{
+  TestTest();
+  TestBatchedQueries();
+}
+
 } // anonymous namespace
 
 int UnitTestPointLocatorSparseGrid(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestTest, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestPointLocatorSparseGrid, argc, argv);
 }
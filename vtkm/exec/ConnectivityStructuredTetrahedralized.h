@@ -0,0 +1,205 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_exec_ConnectivityStructuredTetrahedralized_h
+#define vtk_m_exec_ConnectivityStructuredTetrahedralized_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/Types.h>
+#include <vtkm/VecVariable.h>
+#include <vtkm/internal/ConnectivityStructuredInternals.h>
+
+namespace vtkm
+{
+namespace exec
+{
+
+namespace internal
+{
+
+/// Each hexahedron of a structured grid is split into 5 tetrahedra. The split alternates with
+/// the parity of the logical index of the hexahedron so that the faces of neighboring
+/// hexahedra are split along the same diagonal. This is the same split as the
+/// `Tetrahedralize` filter uses for structured grids.
+struct StructuredTetrahedralizedTable
+{
+  static constexpr vtkm::IdComponent NUM_TETS_IN_HEXAHEDRON = 5;
+
+  // A point is shared by at most 4 tetrahedra of each of its 8 hexahedra.
+  static constexpr vtkm::IdComponent MAX_CELLS_ON_POINT = 32;
+
+  VTKM_EXEC_CONT static vtkm::IdComponent GetHexahedronPoint(vtkm::IdComponent parity,
+                                                             vtkm::IdComponent tetIndex,
+                                                             vtkm::IdComponent pointIndex)
+  {
+    VTKM_STATIC_CONSTEXPR_ARRAY vtkm::IdComponent StructuredTetrahedronIndices[2][5][4] = {
+      { { 0, 1, 3, 4 }, { 1, 4, 5, 6 }, { 1, 4, 6, 3 }, { 1, 3, 6, 2 }, { 3, 6, 7, 4 } },
+      { { 2, 1, 5, 0 }, { 0, 2, 3, 7 }, { 2, 5, 6, 7 }, { 0, 7, 4, 5 }, { 0, 2, 7, 5 } }
+    };
+    return StructuredTetrahedronIndices[parity][tetIndex][pointIndex];
+  }
+
+  VTKM_EXEC_CONT static vtkm::IdComponent GetParity(const vtkm::Id3& hexahedronIndex)
+  {
+    return static_cast<vtkm::IdComponent>(
+      (hexahedronIndex[0] + hexahedronIndex[1] + hexahedronIndex[2]) % 2);
+  }
+};
+
+} // namespace internal
+
+/// @brief Cell to point connectivity of a 3D structured grid split into tetrahedra.
+///
+/// The point indices of each tetrahedron are computed from the index of its hexahedron, so
+/// no connectivity is stored.
+class ConnectivityStructuredTetrahedralized
+{
+  using InternalsType = vtkm::internal::ConnectivityStructuredInternals<3>;
+  using Table = vtkm::exec::internal::StructuredTetrahedralizedTable;
+
+public:
+  using SchedulingRangeType = vtkm::Id;
+  using CellShapeTag = vtkm::CellShapeTagTetra;
+  using IndicesType = vtkm::Id4;
+
+  ConnectivityStructuredTetrahedralized() = default;
+
+  VTKM_EXEC_CONT
+  ConnectivityStructuredTetrahedralized(const InternalsType& structure)
+    : Structure(structure)
+  {
+  }
+
+  VTKM_EXEC_CONT
+  vtkm::Id GetNumberOfElements() const
+  {
+    return Table::NUM_TETS_IN_HEXAHEDRON * this->Structure.GetNumberOfCells();
+  }
+
+  VTKM_EXEC_CONT
+  CellShapeTag GetCellShape(vtkm::Id) const { return CellShapeTag(); }
+
+  VTKM_EXEC_CONT
+  vtkm::IdComponent GetNumberOfIndices(vtkm::Id) const { return 4; }
+
+  VTKM_EXEC_CONT
+  IndicesType GetIndices(vtkm::Id index) const
+  {
+    const vtkm::Id3 hexahedronIndex =
+      this->Structure.FlatToLogicalCellIndex(index / Table::NUM_TETS_IN_HEXAHEDRON);
+    const vtkm::IdComponent tetIndex =
+      static_cast<vtkm::IdComponent>(index % Table::NUM_TETS_IN_HEXAHEDRON);
+    const vtkm::IdComponent parity = Table::GetParity(hexahedronIndex);
+    const vtkm::Vec<vtkm::Id, 8> hexahedronPoints =
+      this->Structure.GetPointsOfCell(hexahedronIndex);
+
+    IndicesType indices;
+    for (vtkm::IdComponent pointIndex = 0; pointIndex < 4; ++pointIndex)
+    {
+      indices[pointIndex] =
+        hexahedronPoints[Table::GetHexahedronPoint(parity, tetIndex, pointIndex)];
+    }
+    return indices;
+  }
+
+private:
+  InternalsType Structure;
+};
+
+/// @brief Point to cell connectivity of a 3D structured grid split into tetrahedra.
+///
+/// The tetrahedra incident to a point are found by checking the tetrahedra of the (up to 8)
+/// hexahedra around the point. The cells are listed in increasing order.
+class ReverseConnectivityStructuredTetrahedralized
+{
+  using InternalsType = vtkm::internal::ConnectivityStructuredInternals<3>;
+  using Table = vtkm::exec::internal::StructuredTetrahedralizedTable;
+
+public:
+  using SchedulingRangeType = vtkm::Id;
+  using CellShapeTag = vtkm::CellShapeTagVertex;
+  using IndicesType = vtkm::VecVariable<vtkm::Id, Table::MAX_CELLS_ON_POINT>;
+
+  ReverseConnectivityStructuredTetrahedralized() = default;
+
+  VTKM_EXEC_CONT
+  ReverseConnectivityStructuredTetrahedralized(const InternalsType& structure)
+    : Structure(structure)
+  {
+  }
+
+  VTKM_EXEC_CONT
+  vtkm::Id GetNumberOfElements() const { return this->Structure.GetNumberOfPoints(); }
+
+  VTKM_EXEC_CONT
+  CellShapeTag GetCellShape(vtkm::Id) const { return CellShapeTag(); }
+
+  VTKM_EXEC_CONT
+  vtkm::IdComponent GetNumberOfIndices(vtkm::Id index) const
+  {
+    return this->GetIndices(index).GetNumberOfComponents();
+  }
+
+  VTKM_EXEC_CONT
+  IndicesType GetIndices(vtkm::Id index) const
+  {
+    // Local index of a point in a hexahedron from its offsets in the hexahedron.
+    VTKM_STATIC_CONSTEXPR_ARRAY vtkm::IdComponent HexahedronPointFromOffsets[2][2][2] = {
+      { { 0, 1 }, { 3, 2 } }, { { 4, 5 }, { 7, 6 } }
+    };
+
+    const vtkm::Id3 pointIndex = this->Structure.FlatToLogicalPointIndex(index);
+    const vtkm::Id3& cellDimensions = this->Structure.GetCellDimensions();
+
+    IndicesType cellIds;
+    for (vtkm::IdComponent k = 1; k >= 0; --k)
+    {
+      for (vtkm::IdComponent j = 1; j >= 0; --j)
+      {
+        for (vtkm::IdComponent i = 1; i >= 0; --i)
+        {
+          const vtkm::Id3 hexahedronIndex = pointIndex - vtkm::Id3(i, j, k);
+          if ((hexahedronIndex[0] < 0) || (hexahedronIndex[1] < 0) || (hexahedronIndex[2] < 0) ||
+              (hexahedronIndex[0] >= cellDimensions[0]) ||
+              (hexahedronIndex[1] >= cellDimensions[1]) ||
+              (hexahedronIndex[2] >= cellDimensions[2]))
+          {
+            continue;
+          }
+
+          const vtkm::IdComponent localPoint = HexahedronPointFromOffsets[k][j][i];
+          const vtkm::IdComponent parity = Table::GetParity(hexahedronIndex);
+          const vtkm::Id firstTet = Table::NUM_TETS_IN_HEXAHEDRON *
+            this->Structure.LogicalToFlatCellIndex(hexahedronIndex);
+          for (vtkm::IdComponent tetIndex = 0; tetIndex < Table::NUM_TETS_IN_HEXAHEDRON;
+               ++tetIndex)
+          {
+            for (vtkm::IdComponent tetPoint = 0; tetPoint < 4; ++tetPoint)
+            {
+              if (Table::GetHexahedronPoint(parity, tetIndex, tetPoint) == localPoint)
+              {
+                cellIds.Append(firstTet + tetIndex);
+                break;
+              }
+            }
+          }
+        }
+      }
+    }
+    return cellIds;
+  }
+
+private:
+  InternalsType Structure;
+};
+
+}
+} // namespace vtkm::exec
+
+#endif // vtk_m_exec_ConnectivityStructuredTetrahedralized_h
@@ -19,6 +19,100 @@ namespace vtkm
 namespace exec
 {
 
+namespace detail
+{
+
+struct CountInRadius
+{
+  vtkm::FloatDefault Radius2;
+  vtkm::IdComponent Count;
+
+  VTKM_EXEC void operator()(vtkm::Id, vtkm::FloatDefault distance2)
+  {
+    if (distance2 <= this->Radius2)
+    {
+      ++this->Count;
+    }
+  }
+};
+
+template <typename IdVecType, typename DistanceVecType>
+struct CollectInRadius
+{
+  vtkm::FloatDefault Radius2;
+  IdVecType& NeighborIds;
+  DistanceVecType& Distances2;
+  vtkm::IdComponent Capacity;
+  vtkm::IdComponent Count = 0;
+
+  VTKM_EXEC CollectInRadius(vtkm::FloatDefault radius2,
+                            IdVecType& neighborIds,
+                            DistanceVecType& distances2)
+    : Radius2(radius2)
+    , NeighborIds(neighborIds)
+    , Distances2(distances2)
+    , Capacity(neighborIds.GetNumberOfComponents())
+  {
+  }
+
+  VTKM_EXEC void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+  {
+    if ((distance2 <= this->Radius2) && (this->Count < this->Capacity))
+    {
+      this->NeighborIds[this->Count] = pointId;
+      this->Distances2[this->Count] = distance2;
+      ++this->Count;
+    }
+  }
+};
+
+// Keeps the closest points visited so far sorted by distance.
+template <typename IdVecType, typename DistanceVecType>
+struct CollectNearest
+{
+  IdVecType& NeighborIds;
+  DistanceVecType& Distances2;
+  vtkm::IdComponent K;
+  vtkm::IdComponent Count = 0;
+
+  VTKM_EXEC CollectNearest(IdVecType& neighborIds, DistanceVecType& distances2)
+    : NeighborIds(neighborIds)
+    , Distances2(distances2)
+    , K(neighborIds.GetNumberOfComponents())
+  {
+  }
+
+  VTKM_EXEC bool IsFull() const { return this->Count == this->K; }
+
+  VTKM_EXEC vtkm::FloatDefault WorstDistance2() const
+  {
+    return static_cast<vtkm::FloatDefault>(this->Distances2[this->K - 1]);
+  }
+
+  VTKM_EXEC void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+  {
+    if (this->IsFull() && !(distance2 < this->WorstDistance2()))
+    {
+      return;
+    }
+    // Insertion sort. k is expected to be small.
+    vtkm::IdComponent index = this->IsFull() ? this->K - 1 : this->Count++;
+    while ((index > 0) &&
+           (distance2 < static_cast<vtkm::FloatDefault>(this->Distances2[index - 1])))
+    {
+      const vtkm::Id prevId = this->NeighborIds[index - 1];
+      const vtkm::FloatDefault prevDistance2 = this->Distances2[index - 1];
+      this->NeighborIds[index] = prevId;
+      this->Distances2[index] = prevDistance2;
+      --index;
+    }
+    this->NeighborIds[index] = pointId;
+    this->Distances2[index] = distance2;
+  }
+};
+
+} // namespace detail
+
 class VTKM_ALWAYS_EXPORT PointLocatorSparseGrid
 {
 public:
@@ -82,6 +176,103 @@ public:
     this->FindInBox(queryPoint, ijk, level, nearestNeighborId, distance2);
   }
 
+  /// \brief Count the points within a given distance of a query point.
+  ///
+  /// Returns the number of points whose distance to \c queryPoint is less than or equal to
+  /// \c radius. This is the first (counting) phase of a batched radius search. The result
+  /// can be used to allocate the storage filled by `FindNeighborsInRadius`.
+  ///
+  VTKM_EXEC vtkm::IdComponent CountNeighborsInRadius(const vtkm::Vec3f& queryPoint,
+                                                     vtkm::FloatDefault radius) const
+  {
+    detail::CountInRadius counter{ radius * radius, 0 };
+    this->VisitCellsInRadius(queryPoint, radius, counter);
+    return counter.Count;
+  }
+
+  /// \brief Find the points within a given distance of a query point.
+  ///
+  /// Fills \c neighborIds and \c distances2 with the indices of, and squared distances to, the
+  /// points whose distance to \c queryPoint is less than or equal to \c radius. The points are
+  /// not returned in any particular order. The provided Vec-like objects must have space for
+  /// at least as many points as reported by `CountNeighborsInRadius`. Points that do not fit
+  /// are dropped. Returns the number of points written.
+  ///
+  template <typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC vtkm::IdComponent FindNeighborsInRadius(const vtkm::Vec3f& queryPoint,
+                                                    vtkm::FloatDefault radius,
+                                                    IdVecType& neighborIds,
+                                                    DistanceVecType& distances2) const
+  {
+    detail::CollectInRadius<IdVecType, DistanceVecType> collector(
+      radius * radius, neighborIds, distances2);
+    this->VisitCellsInRadius(queryPoint, radius, collector);
+    return collector.Count;
+  }
+
+  /// \brief Find the k nearest points to a query point.
+  ///
+  /// The number of neighbors searched for, k, is the number of components in \c neighborIds.
+  /// On return, \c neighborIds and \c distances2 hold the indices of, and squared distances to,
+  /// the nearest points sorted from nearest to farthest. If there are fewer than k points in the
+  /// locator, only the first entries are filled. Returns the number of neighbors found.
+  ///
+  /// The search expands shells of bins around the bin containing \c queryPoint until the k
+  /// closest points found so far are all closer than any point in an unvisited bin could be.
+  ///
+  template <typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC vtkm::IdComponent FindKNearestNeighbors(const vtkm::Vec3f& queryPoint,
+                                                    IdVecType& neighborIds,
+                                                    DistanceVecType& distances2) const
+  {
+    detail::CollectNearest<IdVecType, DistanceVecType> nearest(neighborIds, distances2);
+    if (nearest.K < 1)
+    {
+      return 0;
+    }
+
+    vtkm::Id3 ijk = (queryPoint - this->Min) / this->Dxdydz;
+    ijk = vtkm::Max(ijk, vtkm::Id3(0));
+    ijk = vtkm::Min(ijk, this->Dims - vtkm::Id3(1));
+
+    for (vtkm::Id level = 0;; ++level)
+    {
+      this->VisitShell(queryPoint, ijk, level, nearest);
+
+      // Distance from the query to the nearest face of the visited box. Faces on the
+      // boundary of the grid do not count because points outside of the range are
+      // binned into the boundary bins.
+      vtkm::FloatDefault searched = vtkm::Infinity<vtkm::FloatDefault>();
+      for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+      {
+        if ((ijk[dim] - level) > 0)
+        {
+          vtkm::FloatDefault face =
+            this->Min[dim] + static_cast<vtkm::FloatDefault>(ijk[dim] - level) * this->Dxdydz[dim];
+          searched = vtkm::Min(searched, vtkm::Max(queryPoint[dim] - face, vtkm::FloatDefault(0)));
+        }
+        if ((ijk[dim] + level) < (this->Dims[dim] - 1))
+        {
+          vtkm::FloatDefault face = this->Min[dim] +
+            static_cast<vtkm::FloatDefault>(ijk[dim] + level + 1) * this->Dxdydz[dim];
+          searched = vtkm::Min(searched, vtkm::Max(face - queryPoint[dim], vtkm::FloatDefault(0)));
+        }
+      }
+
+      if (searched == vtkm::Infinity<vtkm::FloatDefault>())
+      {
+        // Every bin has been visited.
+        break;
+      }
+      if (nearest.IsFull() && (nearest.WorstDistance2() <= (searched * searched)))
+      {
+        break;
+      }
+    }
+
+    return nearest.Count;
+  }
+
 private:
   vtkm::Vec3f Min;
   vtkm::Id3 Dims;
@@ -93,6 +284,89 @@ private:
   IdPortalType CellLower;
   IdPortalType CellUpper;
 
+  template <typename Visitor>
+  VTKM_EXEC void VisitCell(const vtkm::Vec3f& queryPoint,
+                           const vtkm::Id3& ijk,
+                           Visitor& visitor) const
+  {
+    vtkm::Id cellId = ijk[0] + (ijk[1] * this->Dims[0]) + (ijk[2] * this->Dims[0] * this->Dims[1]);
+    vtkm::Id lower = this->CellLower.Get(cellId);
+    vtkm::Id upper = this->CellUpper.Get(cellId);
+    for (vtkm::Id index = lower; index < upper; index++)
+    {
+      vtkm::Id pointid = this->PointIds.Get(index);
+      vtkm::Vec3f point = this->Coords.Get(pointid);
+      visitor(pointid, vtkm::MagnitudeSquared(point - queryPoint));
+    }
+  }
+
+  // Visits all the bins that overlap the axis-aligned box around the sphere of the given
+  // radius. Since points outside of the range are clamped to the boundary bins, clamping
+  // the box to the grid still visits every point that could be in range.
+  template <typename Visitor>
+  VTKM_EXEC void VisitCellsInRadius(const vtkm::Vec3f& queryPoint,
+                                    vtkm::FloatDefault radius,
+                                    Visitor& visitor) const
+  {
+    vtkm::Id3 lower = (queryPoint - vtkm::Vec3f(radius) - this->Min) / this->Dxdydz;
+    lower = vtkm::Min(vtkm::Max(lower, vtkm::Id3(0)), this->Dims - vtkm::Id3(1));
+    vtkm::Id3 upper = (queryPoint + vtkm::Vec3f(radius) - this->Min) / this->Dxdydz;
+    upper = vtkm::Min(vtkm::Max(upper, vtkm::Id3(0)), this->Dims - vtkm::Id3(1));
+
+    vtkm::Id3 ijk;
+    for (ijk[2] = lower[2]; ijk[2] <= upper[2]; ++ijk[2])
+    {
+      for (ijk[1] = lower[1]; ijk[1] <= upper[1]; ++ijk[1])
+      {
+        for (ijk[0] = lower[0]; ijk[0] <= upper[0]; ++ijk[0])
+        {
+          this->VisitCell(queryPoint, ijk, visitor);
+        }
+      }
+    }
+  }
+
+  // Visits the bins that are exactly `level` bins away (in the infinity norm) from `center`.
+  template <typename Visitor>
+  VTKM_EXEC void VisitShell(const vtkm::Vec3f& queryPoint,
+                            const vtkm::Id3& center,
+                            vtkm::Id level,
+                            Visitor& visitor) const
+  {
+    const vtkm::Id3 lower = vtkm::Max(center - vtkm::Id3(level), vtkm::Id3(0));
+    const vtkm::Id3 upper = vtkm::Min(center + vtkm::Id3(level), this->Dims - vtkm::Id3(1));
+
+    vtkm::Id3 ijk;
+    for (ijk[2] = lower[2]; ijk[2] <= upper[2]; ++ijk[2])
+    {
+      const bool interiorK = vtkm::Abs(ijk[2] - center[2]) < level;
+      for (ijk[1] = lower[1]; ijk[1] <= upper[1]; ++ijk[1])
+      {
+        if (interiorK && (vtkm::Abs(ijk[1] - center[1]) < level))
+        {
+          // Only the two ends of this row are on the shell.
+          ijk[0] = center[0] - level;
+          if (ijk[0] >= 0)
+          {
+            this->VisitCell(queryPoint, ijk, visitor);
+          }
+          ijk[0] = center[0] + level;
+          if (ijk[0] < this->Dims[0])
+          {
+            this->VisitCell(queryPoint, ijk, visitor);
+          }
+        }
+        else
+        {
+          for (ijk[0] = lower[0]; ijk[0] <= upper[0]; ++ijk[0])
+          {
+            this->VisitCell(queryPoint, ijk, visitor);
+          }
+        }
+      }
+    }
+  }
+
   VTKM_EXEC void FindInCell(const vtkm::Vec3f& queryPoint,
                             const vtkm::Id3& ijk,
                             vtkm::Id& nearestNeighborId,
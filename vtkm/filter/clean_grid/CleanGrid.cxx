@@ -128,6 +128,7 @@ vtkm::cont::DataSet CleanGrid::GenerateOutput(const vtkm::cont::DataSet& inData,
     }
 
     auto coordArray = activeCoordSystem.GetData();
+    worklets.PointMerger.SetUseSpatialHash(this->GetUseSpatialHash());
     worklets.PointMerger.Run(delta, this->GetFastMerge(), bounds, coordArray);
     activeCoordSystem = vtkm::cont::CoordinateSystem(activeCoordSystem.GetName(), coordArray);
 
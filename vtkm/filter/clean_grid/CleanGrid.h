@@ -93,6 +93,16 @@ public:
   /// @copydoc GetFastMerge
   VTKM_CONT void SetFastMerge(bool flag) { this->FastMerge = flag; }
 
+  /// When UseSpatialHash is true, coincident points are found by inserting the points
+  /// in a concurrent hash table of spatial bins instead of sorting the bins. This avoids
+  /// a sort of all the points and is usually faster on large inputs. When FastMerge is
+  /// false, each point is merged into the point of smallest index within the tolerance
+  /// that was not itself merged into another point. The default is false.
+  ///
+  VTKM_CONT bool GetUseSpatialHash() const { return this->UseSpatialHash; }
+  /// @copydoc GetUseSpatialHash
+  VTKM_CONT void SetUseSpatialHash(bool flag) { this->UseSpatialHash = flag; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& inData) override;
@@ -107,6 +117,7 @@ private:
   bool ToleranceIsAbsolute = false;
   bool RemoveDegenerateCells = true;
   bool FastMerge = true;
+  bool UseSpatialHash = false;
 };
 } // namespace clean_grid
 
@@ -11,6 +11,8 @@
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/contour/ContourMarchingCells.h>
@@ -67,7 +69,7 @@ void TestUniformGrid(vtkm::filter::clean_grid::CleanGrid clean)
                    outCellField.ReadPortal().Get(0));
 }
 
-void TestPointMerging()
+vtkm::cont::DataSet MakeUnmergedContour()
 {
   vtkm::cont::testing::MakeTestDataSet makeDataSet;
   vtkm::cont::DataSet baseData = makeDataSet.Make3DUniformDataSet3(vtkm::Id3(4, 4, 4));
@@ -76,7 +78,12 @@ void TestPointMerging()
   marchingCubes.SetIsoValue(0.05);
   marchingCubes.SetMergeDuplicatePoints(false);
   marchingCubes.SetActiveField("pointvar");
-  vtkm::cont::DataSet inData = marchingCubes.Execute(baseData);
+  return marchingCubes.Execute(baseData);
+}
+
+void TestPointMerging()
+{
+  vtkm::cont::DataSet inData = MakeUnmergedContour();
   constexpr vtkm::Id originalNumPoints = 228;
   constexpr vtkm::Id originalNumCells = 76;
   VTKM_TEST_ASSERT(inData.GetCellSet().GetNumberOfPoints() == originalNumPoints);
@@ -150,6 +157,122 @@ void TestPointMerging()
                    numNonDegenerateCells);
 }
 
+void TestPointMergingSpatialHash()
+{
+  constexpr vtkm::Id originalNumCells = 76;
+
+  auto checkMerge = [&](vtkm::Float64 tolerance,
+                        bool fastMerge,
+                        vtkm::Id expectedNumPoints,
+                        vtkm::Id expectedSortNumPoints) {
+    std::cout << "Spatial hash merge with tolerance " << tolerance << " and fast merge "
+              << fastMerge << std::endl;
+    vtkm::filter::clean_grid::CleanGrid cleanGrid;
+    cleanGrid.SetCompactPointFields(false);
+    cleanGrid.SetRemoveDegenerateCells(false);
+    cleanGrid.SetTolerance(tolerance);
+    cleanGrid.SetFastMerge(fastMerge);
+
+    // The inputs are rebuilt because merging by sorting modifies the input coordinates.
+    vtkm::cont::DataSet sortMerge = cleanGrid.Execute(MakeUnmergedContour());
+    cleanGrid.SetUseSpatialHash(true);
+    vtkm::cont::DataSet hashMerge = cleanGrid.Execute(MakeUnmergedContour());
+
+    VTKM_TEST_ASSERT(hashMerge.GetNumberOfCells() == originalNumCells);
+    VTKM_TEST_ASSERT(hashMerge.GetNumberOfPoints() == expectedNumPoints);
+    VTKM_TEST_ASSERT(sortMerge.GetNumberOfPoints() == expectedSortNumPoints);
+    VTKM_TEST_ASSERT(hashMerge.GetCellSet().GetNumberOfPoints() == expectedNumPoints);
+    VTKM_TEST_ASSERT(hashMerge.GetField("pointvar").GetNumberOfValues() == expectedNumPoints);
+    VTKM_TEST_ASSERT(hashMerge.GetField("cellvar").GetNumberOfValues() == originalNumCells);
+
+    if (!fastMerge)
+    {
+      return;
+    }
+
+    // With fast merge, points are only merged with the points in the same bin. Bins are
+    // 2*delta wide, so a merged point is at most a bin diagonal away from the original.
+    vtkm::cont::DataSet inData = MakeUnmergedContour();
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> inPoints;
+    inData.GetCoordinateSystem().GetData().AsArrayHandle(inPoints);
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> outPoints;
+    hashMerge.GetCoordinateSystem().GetData().AsArrayHandle(outPoints);
+    vtkm::cont::CellSetSingleType<> inCells;
+    inData.GetCellSet().AsCellSet(inCells);
+    vtkm::cont::CellSetExplicit<> outCells;
+    hashMerge.GetCellSet().AsCellSet(outCells);
+
+    const vtkm::Bounds bounds = inData.GetCoordinateSystem().GetBounds();
+    const vtkm::Float64 delta = tolerance *
+      vtkm::Magnitude(vtkm::make_Vec(bounds.X.Length(), bounds.Y.Length(), bounds.Z.Length()));
+    const vtkm::Float64 binDiagonal = 2.0 * delta * vtkm::Sqrt(3.0);
+
+    auto inConnectivity = inCells
+                            .GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                  vtkm::TopologyElementTagPoint{})
+                            .ReadPortal();
+    auto outConnectivity = outCells
+                             .GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                   vtkm::TopologyElementTagPoint{})
+                             .ReadPortal();
+    auto inPointsPortal = inPoints.ReadPortal();
+    auto outPointsPortal = outPoints.ReadPortal();
+    VTKM_TEST_ASSERT(inConnectivity.GetNumberOfValues() == outConnectivity.GetNumberOfValues());
+    for (vtkm::Id index = 0; index < inConnectivity.GetNumberOfValues(); ++index)
+    {
+      const vtkm::Vec3f inPoint = inPointsPortal.Get(inConnectivity.Get(index));
+      const vtkm::Vec3f outPoint = outPointsPortal.Get(outConnectivity.Get(index));
+      VTKM_TEST_ASSERT(vtkm::Magnitude(inPoint - outPoint) <= binDiagonal,
+                       "Point merged too far away");
+    }
+  };
+
+  checkMerge(1.0e-6, false, 62, 62);
+  checkMerge(1.0e-6, true, 62, 62);
+  // Merging by sorting also merges chains of close points in a bin, which the spatial hash
+  // only merges into representatives within the tolerance.
+  checkMerge(0.1, false, 39, 36);
+  checkMerge(0.1, true, 23, 23);
+}
+
+void TestPointMergingSpatialHashChain()
+{
+  // Each point is within the tolerance of the next one, but not of the one after that. A
+  // point only merges into a representative within the tolerance, so the chain does not
+  // collapse into a single point.
+  std::vector<vtkm::Vec3f> coordinates;
+  std::vector<vtkm::UInt8> shapes;
+  std::vector<vtkm::IdComponent> numIndices;
+  std::vector<vtkm::Id> connectivity;
+  for (vtkm::Id index = 0; index < 5; ++index)
+  {
+    coordinates.push_back(vtkm::Vec3f(0.6f * static_cast<vtkm::FloatDefault>(index), 0, 0));
+    shapes.push_back(vtkm::CELL_SHAPE_VERTEX);
+    numIndices.push_back(1);
+    connectivity.push_back(index);
+  }
+  vtkm::cont::DataSet inData =
+    vtkm::cont::DataSetBuilderExplicit::Create(coordinates, shapes, numIndices, connectivity);
+
+  vtkm::filter::clean_grid::CleanGrid cleanGrid;
+  cleanGrid.SetUseSpatialHash(true);
+  cleanGrid.SetFastMerge(false);
+  cleanGrid.SetTolerance(1.0);
+  cleanGrid.SetToleranceIsAbsolute(true);
+  cleanGrid.SetRemoveDegenerateCells(false);
+  vtkm::cont::DataSet outData = cleanGrid.Execute(inData);
+
+  VTKM_TEST_ASSERT(outData.GetNumberOfCells() == 5);
+  VTKM_TEST_ASSERT(outData.GetNumberOfPoints() == 3, "Chain of points merged transitively");
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> outPoints;
+  outData.GetCoordinateSystem().GetData().AsArrayHandle(outPoints);
+  VTKM_TEST_ASSERT(
+    test_equal_ArrayHandles(outPoints,
+                            vtkm::cont::make_ArrayHandle<vtkm::Vec3f>(
+                              { { 0.0f, 0, 0 }, { 1.2f, 0, 0 }, { 2.4f, 0, 0 } })),
+    "Points should merge into the representatives at 0, 1.2 and 2.4");
+}
+
 void RunTest()
 {
   vtkm::filter::clean_grid::CleanGrid clean;
@@ -176,6 +299,10 @@ void RunTest()
 
   std::cout << "*** Test point merging" << std::endl;
   TestPointMerging();
+
+  std::cout << "*** Test point merging with a spatial hash" << std::endl;
+  TestPointMergingSpatialHash();
+  TestPointMergingSpatialHashChain();
 }
 
 } // anonymous namespace
@@ -18,9 +18,11 @@
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletReduceByKey.h>
 
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/ExecutionAndControlObjectBase.h>
 #include <vtkm/cont/Invoker.h>
@@ -325,7 +327,289 @@ public:
     }
   };
 
+  // Inserts the bin of each point in a hash table with open addressing. Each used slot ends
+  // up holding the smallest index of the points in its bin, so the result does not depend on
+  // the order in which the points are inserted.
+  struct InsertInBinTable : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn pointCoordinates,
+                                  WholeArrayIn allCoordinates,
+                                  ExecObject binLocator,
+                                  AtomicArrayInOut binTable,
+                                  FieldOut binSlot);
+    using ExecutionSignature = void(InputIndex, _1, _2, _3, _4, _5);
+
+    template <typename T, typename CoordinatesPortal, typename BinTable>
+    VTKM_EXEC void operator()(vtkm::Id pointIndex,
+                              const vtkm::Vec<T, 3>& coordinates,
+                              const CoordinatesPortal& allCoordinates,
+                              const BinLocator& binLocator,
+                              const BinTable& binTable,
+                              vtkm::Id& binSlot) const
+    {
+      const vtkm::Id3 bin = binLocator.FindBin(coordinates);
+      const vtkm::Id mask = binTable.GetNumberOfValues() - 1;
+      binSlot = static_cast<vtkm::Id>(vtkm::Hash(bin)) & mask;
+      while (true)
+      {
+        vtkm::Id current = binTable.Get(binSlot);
+        if (current < 0)
+        {
+          if (binTable.CompareExchange(binSlot, &current, pointIndex))
+          {
+            return;
+          }
+          // Another point took the slot first. current now holds that point.
+        }
+        if (binLocator.FindBin(allCoordinates.Get(current)) == bin)
+        {
+          // Only points of this bin write to this slot from now on. Keep the smallest index.
+          while ((pointIndex < current) &&
+                 !binTable.CompareExchange(binSlot, &current, pointIndex))
+          {
+          }
+          return;
+        }
+        binSlot = (binSlot + 1) & mask;
+      }
+    }
+  };
+
+  // Finds the slot of a bin in the table built by InsertInBinTable, or -1 if no point is in it.
+  template <typename CoordinatesPortal, typename BinTablePortal>
+  VTKM_EXEC static vtkm::Id FindBinSlot(const vtkm::Id3& bin,
+                                        const CoordinatesPortal& allCoordinates,
+                                        const BinLocator& binLocator,
+                                        const BinTablePortal& binTable)
+  {
+    const vtkm::Id mask = binTable.GetNumberOfValues() - 1;
+    vtkm::Id binSlot = static_cast<vtkm::Id>(vtkm::Hash(bin)) & mask;
+    vtkm::Id current = binTable.Get(binSlot);
+    while (current >= 0)
+    {
+      if (binLocator.FindBin(allCoordinates.Get(current)) == bin)
+      {
+        return binSlot;
+      }
+      binSlot = (binSlot + 1) & mask;
+      current = binTable.Get(binSlot);
+    }
+    return -1;
+  }
+
+  struct CountBinPoints : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn binSlot, AtomicArrayInOut binCounts);
+    using ExecutionSignature = void(_1, _2);
+
+    template <typename BinCounts>
+    VTKM_EXEC void operator()(vtkm::Id binSlot, const BinCounts& binCounts) const
+    {
+      binCounts.Add(binSlot, 1);
+    }
+  };
+
+  struct FillBinPoints : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn binSlot,
+                                  AtomicArrayInOut binCursors,
+                                  WholeArrayOut binPoints);
+    using ExecutionSignature = void(InputIndex, _1, _2, _3);
+
+    template <typename BinCursors, typename BinPointsPortal>
+    VTKM_EXEC void operator()(vtkm::Id pointIndex,
+                              vtkm::Id binSlot,
+                              const BinCursors& binCursors,
+                              const BinPointsPortal& binPoints) const
+    {
+      binPoints.Set(binCursors.Add(binSlot, 1), pointIndex);
+    }
+  };
+
+  // Merges each point into the representative of smallest index within delta in the bins
+  // around it, or makes it a representative when there is none. Bins are at least 2*delta
+  // wide, so these points are in the neighboring bins. A point only decides once all the
+  // points of smaller index within delta have decided, so the result is the same as merging
+  // the points one after the other in index order, whatever the scheduling of the threads.
+  // Points are never merged through a chain of neighbors that are not representatives.
+  class ChooseRepresentatives : public vtkm::worklet::WorkletMapField
+  {
+    vtkm::Float64 DeltaSquared;
+
+  public:
+    VTKM_CONT ChooseRepresentatives(vtkm::Float64 delta)
+      : DeltaSquared(delta * delta)
+    {
+    }
+
+    using ControlSignature = void(FieldIn pointCoordinates,
+                                  WholeArrayIn allCoordinates,
+                                  ExecObject binLocator,
+                                  WholeArrayIn binTable,
+                                  WholeArrayIn binOffsets,
+                                  WholeArrayIn binPoints,
+                                  AtomicArrayInOut representatives);
+    using ExecutionSignature = void(InputIndex, _1, _2, _3, _4, _5, _6, _7);
+
+    template <typename T,
+              typename CoordinatesPortal,
+              typename BinTablePortal,
+              typename BinOffsetsPortal,
+              typename BinPointsPortal,
+              typename Representatives>
+    VTKM_EXEC void operator()(vtkm::Id pointIndex,
+                              const vtkm::Vec<T, 3>& coordinates,
+                              const CoordinatesPortal& allCoordinates,
+                              const BinLocator& binLocator,
+                              const BinTablePortal& binTable,
+                              const BinOffsetsPortal& binOffsets,
+                              const BinPointsPortal& binPoints,
+                              const Representatives& representatives) const
+    {
+      if (representatives.Get(pointIndex) >= 0)
+      {
+        // Decided in an earlier pass.
+        return;
+      }
+
+      vtkm::Id representative = pointIndex;
+      const vtkm::Id3 bin = binLocator.FindBin(coordinates);
+      for (vtkm::Id k = bin[2] - 1; k <= bin[2] + 1; ++k)
+      {
+        for (vtkm::Id j = bin[1] - 1; j <= bin[1] + 1; ++j)
+        {
+          for (vtkm::Id i = bin[0] - 1; i <= bin[0] + 1; ++i)
+          {
+            const vtkm::Id binSlot =
+              FindBinSlot(vtkm::Id3(i, j, k), allCoordinates, binLocator, binTable);
+            if (binSlot < 0)
+            {
+              continue;
+            }
+            for (vtkm::Id index = binOffsets.Get(binSlot); index < binOffsets.Get(binSlot + 1);
+                 ++index)
+            {
+              const vtkm::Id neighbor = binPoints.Get(index);
+              if ((neighbor < pointIndex) &&
+                  (vtkm::MagnitudeSquared(allCoordinates.Get(neighbor) - coordinates) <=
+                   this->DeltaSquared))
+              {
+                const vtkm::Id neighborRepresentative = representatives.Get(neighbor);
+                if (neighborRepresentative < 0)
+                {
+                  // Wait for the neighbor to decide in a later pass.
+                  return;
+                }
+                if ((neighborRepresentative == neighbor) && (neighbor < representative))
+                {
+                  representative = neighbor;
+                }
+              }
+            }
+          }
+        }
+      }
+      representatives.Set(pointIndex, representative);
+    }
+  };
+
+  struct IsUndecided
+  {
+    VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id representative) const
+    {
+      return (representative < 0) ? 1 : 0;
+    }
+  };
+
+  // Looks up the representative of each point, which is the smallest point index of its group.
+  struct FindRepresentatives : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn binSlot, WholeArrayIn binTable, FieldOut representative);
+    using ExecutionSignature = void(_1, _2, _3);
+
+    template <typename BinTablePortal>
+    VTKM_EXEC void operator()(vtkm::Id binSlot,
+                              const BinTablePortal& binTable,
+                              vtkm::Id& representative) const
+    {
+      representative = binTable.Get(binSlot);
+    }
+  };
+
 private:
+  template <typename T>
+  VTKM_CONT void RunSpatialHash(
+    vtkm::Float64 delta,                              // Distance to consider two points coincident
+    bool fastCheck,                                   // If true, approximate distances are used
+    const BinLocator& binLocator,                     // Used to find nearby points
+    vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>>& points) // coordinates, modified to merge close
+  {
+    vtkm::cont::Invoker invoker;
+    const vtkm::Id numPoints = points.GetNumberOfValues();
+
+    // A power of two at least twice the number of points keeps the probe sequences short.
+    vtkm::Id tableSize = 1;
+    while (tableSize < 2 * numPoints)
+    {
+      tableSize *= 2;
+    }
+    vtkm::cont::ArrayHandle<vtkm::Id> binTable;
+    binTable.AllocateAndFill(tableSize, -1);
+    vtkm::cont::ArrayHandle<vtkm::Id> binSlots;
+    invoker(InsertInBinTable{}, points, points, binLocator, binTable, binSlots);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> representatives;
+    if (fastCheck)
+    {
+      // All the points in a bin are merged.
+      invoker(FindRepresentatives{}, binSlots, binTable, representatives);
+    }
+    else
+    {
+      // Lay out the points of each bin contiguously, ordered like the table slots.
+      vtkm::cont::ArrayHandle<vtkm::Id> binOffsets;
+      binOffsets.AllocateAndFill(tableSize + 1, 0);
+      invoker(CountBinPoints{}, binSlots, binOffsets);
+      vtkm::cont::Algorithm::ScanExclusive(binOffsets, binOffsets);
+      vtkm::cont::ArrayHandle<vtkm::Id> binCursors;
+      vtkm::cont::ArrayCopy(binOffsets, binCursors);
+      vtkm::cont::ArrayHandle<vtkm::Id> binPoints;
+      binPoints.Allocate(numPoints);
+      invoker(FillBinPoints{}, binSlots, binCursors, binPoints);
+
+      // Each pass decides at least the undecided point of smallest index. On a serial device,
+      // the points are visited in index order and all decide in the first pass.
+      representatives.AllocateAndFill(numPoints, -1);
+      vtkm::Id numUndecided = numPoints;
+      while (numUndecided > 0)
+      {
+        invoker(ChooseRepresentatives{ delta },
+                points,
+                points,
+                binLocator,
+                binTable,
+                binOffsets,
+                binPoints,
+                representatives);
+        numUndecided = vtkm::cont::Algorithm::Reduce(
+          vtkm::cont::make_ArrayHandleTransform(representatives, IsUndecided{}), vtkm::Id(0));
+      }
+    }
+
+    // The point fields are averaged with AverageByKey, which needs the points sorted by
+    // representative.
+    this->MergeKeys = vtkm::worklet::Keys<vtkm::Id>(representatives);
+
+    invoker(BuildPointInputToOutputMap(), this->MergeKeys, this->PointInputToOutputMap);
+
+    // Each group keeps the coordinates of its representative point.
+    vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> uniquePointCoordinates;
+    vtkm::cont::ArrayCopy(
+      vtkm::cont::make_ArrayHandlePermutation(this->MergeKeys.GetUniqueKeys(), points),
+      uniquePointCoordinates);
+    points = uniquePointCoordinates;
+  }
+
   template <typename T>
   VTKM_CONT static void RunOneIteration(
     vtkm::Float64 delta,                              // Distance to consider two points coincident
@@ -361,6 +645,12 @@ public:
 
     BinLocator binLocator(bounds, delta);
 
+    if (this->UseSpatialHash)
+    {
+      this->RunSpatialHash(delta, fastCheck, binLocator, points);
+      return;
+    }
+
     vtkm::cont::ArrayHandle<vtkm::Id> indexNeighborMap;
     vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(points.GetNumberOfValues()),
                           indexNeighborMap);
@@ -464,7 +754,14 @@ public:
 
   vtkm::worklet::Keys<vtkm::Id> GetMergeKeys() const { return this->MergeKeys; }
 
+  // When on, points are grouped with a concurrent spatial hash of the bins instead of sorting
+  // the bins. Without the fast check, each point is merged into the point of smallest index
+  // within delta that is not itself merged into another point, so merges do not chain.
+  VTKM_CONT void SetUseSpatialHash(bool flag) { this->UseSpatialHash = flag; }
+  VTKM_CONT bool GetUseSpatialHash() const { return this->UseSpatialHash; }
+
 private:
+  bool UseSpatialHash = false;
   vtkm::worklet::Keys<vtkm::Id> MergeKeys;
   vtkm::cont::ArrayHandle<vtkm::Id> PointInputToOutputMap;
 };
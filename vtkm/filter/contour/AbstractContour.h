@@ -11,6 +11,8 @@
 #ifndef vtk_m_filter_contour_AbstractContour_h
 #define vtk_m_filter_contour_AbstractContour_h
 
+#include <vtkm/Math.h>
+#include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/filter/Filter.h>
 #include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/contour/vtkm_filter_contour_export.h>
@@ -147,6 +149,89 @@ public:
   bool GetMergeDuplicatePoints() { return this->MergeDuplicatedPoints; }
 
 protected:
+  /// \brief Return whether no iso value lies within the range of the given field.
+  ///
+  /// In that case no cell of the input can be crossed by a contour. The range of a field
+  /// is cached, so this check is cheap when the same data, such as the partitions of a
+  /// `vtkm::cont::PartitionedDataSet`, is contoured repeatedly.
+  ///
+  /// Marching cells counts a value equal to the iso value as below it, so a cell is crossed
+  /// when its minimum is at most the iso value and its maximum is above it. Flying edges
+  /// counts such a value as above the iso value, which is selected with
+  /// `equalValuesAreAbove`; a cell is then crossed when its minimum is below the iso value
+  /// and its maximum is at least the iso value. A NaN iso value crosses nothing.
+  VTKM_CONT bool IsoValuesOutsideFieldRange(const vtkm::cont::Field& field,
+                                            bool equalValuesAreAbove = false) const
+  {
+    const vtkm::cont::ArrayHandle<vtkm::Range>& ranges = field.GetRange();
+    if (ranges.GetNumberOfValues() != 1)
+    {
+      return false;
+    }
+    const vtkm::Range range = ranges.ReadPortal().Get(0);
+
+    // The contour worklets may compare in single precision, so the test is also done with
+    // the values rounded to Float32.
+    auto crosses = [equalValuesAreAbove](
+                     vtkm::Float64 low, vtkm::Float64 high, vtkm::Float64 isoValue) {
+      return equalValuesAreAbove ? ((low < isoValue) && (isoValue <= high))
+                                 : ((low <= isoValue) && (isoValue < high));
+    };
+    auto round = [](vtkm::Float64 value) {
+      return static_cast<vtkm::Float64>(static_cast<vtkm::Float32>(value));
+    };
+    for (vtkm::Float64 isoValue : this->IsoValues)
+    {
+      // NaN is neither above nor below any value. Skipping it also avoids comparing with it.
+      if (vtkm::IsNan(isoValue))
+      {
+        continue;
+      }
+      if (crosses(range.Min, range.Max, isoValue) ||
+          crosses(round(range.Min), round(range.Max), round(isoValue)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Create the output of a contour that does not cross the input.
+  ///
+  /// The output has no points or cells, but has the same fields as a regular output.
+  VTKM_CONT vtkm::cont::DataSet CreateEmptyResult(const vtkm::cont::DataSet& input)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> noIds;
+    vtkm::cont::CellSetSingleType<> outputCells;
+    outputCells.Fill(0, vtkm::CELL_SHAPE_TRIANGLE, 3, noIds);
+
+    auto mapper = [&](auto& result, const auto& f) {
+      if (f.IsWholeDataSetField())
+      {
+        result.AddField(f);
+      }
+      else
+      {
+        vtkm::filter::MapFieldPermutation(f, noIds, result);
+      }
+    };
+    const vtkm::cont::CoordinateSystem& inputCoords =
+      input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+    vtkm::cont::DataSet output = this->CreateResultCoordinateSystem(
+      input, outputCells, inputCoords.GetName(), vtkm::cont::ArrayHandle<vtkm::Vec3f>{}, mapper);
+
+    if (this->GenerateNormals)
+    {
+      output.AddPointField(this->NormalArrayName, vtkm::cont::ArrayHandle<vtkm::Vec3f>{});
+    }
+    if (this->AddInterpolationEdgeIds)
+    {
+      output.AddPointField(this->InterpolationEdgeIdsArrayName,
+                           vtkm::cont::ArrayHandle<vtkm::Id2>{});
+    }
+    return output;
+  }
+
   /// \brief Map a given field to the output \c DataSet , depending on its type.
   ///
   /// The worklet needs to implement \c ProcessPointField to process point fields as arrays
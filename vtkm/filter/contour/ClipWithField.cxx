@@ -60,6 +60,34 @@ bool DoMapField(vtkm::cont::DataSet& result,
     return false;
   }
 }
+
+// Return whether every point of the input is clipped away. The clip worklet may compare
+// the values after rounding them to Float32, so both precisions must agree.
+bool IsFieldRangeClipped(const vtkm::cont::Field& field, vtkm::Float64 clipValue, bool invert)
+{
+  const vtkm::cont::ArrayHandle<vtkm::Range>& ranges = field.GetRange();
+  if (ranges.GetNumberOfValues() != 1)
+  {
+    return false;
+  }
+  const vtkm::Range range = ranges.ReadPortal().Get(0);
+  auto round = [](vtkm::Float64 value) {
+    return static_cast<vtkm::Float64>(static_cast<vtkm::Float32>(value));
+  };
+
+  if (!range.IsNonEmpty())
+  {
+    return false;
+  }
+  else if (invert)
+  {
+    return (range.Min >= clipValue) && (round(range.Min) >= clipValue);
+  }
+  else
+  {
+    return (range.Max <= clipValue) && (round(range.Max) <= clipValue);
+  }
+}
 } // anonymous
 
 //-----------------------------------------------------------------------------
@@ -71,6 +99,28 @@ vtkm::cont::DataSet ClipWithField::DoExecute(const vtkm::cont::DataSet& input)
     throw vtkm::cont::ErrorFilterExecution("Point field expected.");
   }
 
+  if (IsFieldRangeClipped(field, this->ClipValue, this->Invert))
+  {
+    // Nothing is left of the input, so skip classifying its cells.
+    vtkm::cont::ArrayHandle<vtkm::Id> noIds;
+    vtkm::cont::CellSetExplicit<> emptyCellSet;
+    emptyCellSet.Fill(0,
+                      vtkm::cont::ArrayHandle<vtkm::UInt8>{},
+                      noIds,
+                      vtkm::cont::make_ArrayHandle<vtkm::Id>({ 0 }));
+    auto mapper = [&](auto& result, const auto& f) {
+      if (f.IsWholeDataSetField())
+      {
+        result.AddField(f);
+      }
+      else
+      {
+        vtkm::filter::MapFieldPermutation(f, noIds, result);
+      }
+    };
+    return this->CreateResult(input, emptyCellSet, mapper);
+  }
+
   vtkm::worklet::Clip worklet;
 
   const vtkm::cont::UnknownCellSet& inputCellSet = input.GetCellSet();
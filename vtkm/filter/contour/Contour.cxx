@@ -34,8 +34,9 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
   auto inCoords = inDataSet.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex()).GetData();
   std::unique_ptr<vtkm::filter::contour::AbstractContour> implementation;
 
-  // Flying Edges is only used for 3D Structured CellSets
-  if (inCellSet.template IsType<vtkm::cont::CellSetStructured<3>>())
+  // Flying Edges is only used for 2D and 3D Structured CellSets
+  if (inCellSet.template IsType<vtkm::cont::CellSetStructured<3>>() ||
+      inCellSet.template IsType<vtkm::cont::CellSetStructured<2>>())
   {
     VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Using flying edges");
     implementation.reset(new vtkm::filter::contour::ContourFlyingEdges);
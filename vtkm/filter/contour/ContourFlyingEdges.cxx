@@ -7,11 +7,17 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/UnknownCellSet.h>
 
+#include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/contour/ContourFlyingEdges.h>
 #include <vtkm/filter/contour/worklet/ContourFlyingEdges.h>
 
@@ -29,6 +35,7 @@ vtkm::cont::DataSet ContourFlyingEdges::DoExecute(const vtkm::cont::DataSet& inD
 {
   vtkm::worklet::ContourFlyingEdges worklet;
   worklet.SetMergeDuplicatePoints(this->GetMergeDuplicatePoints());
+  worklet.SetSlabSize(this->SlabSize);
 
   if (!this->GetFieldFromDataSet(inDataSet).IsPointField())
   {
@@ -44,15 +51,19 @@ vtkm::cont::DataSet ContourFlyingEdges::DoExecute(const vtkm::cont::DataSet& inD
   const vtkm::cont::CoordinateSystem& inCoords =
     inDataSet.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
 
-  if (!inCellSet.template IsType<vtkm::cont::CellSetStructured<3>>())
+  if (!inCellSet.template IsType<vtkm::cont::CellSetStructured<3>>() &&
+      !inCellSet.template IsType<vtkm::cont::CellSetStructured<2>>())
   {
-    throw vtkm::cont::ErrorFilterExecution("This filter is only available for 3-Dimensional "
-                                           "Structured Cell Sets");
+    throw vtkm::cont::ErrorFilterExecution("This filter is only available for 2-Dimensional "
+                                           "and 3-Dimensional Structured Cell Sets");
   }
 
-  // Get the CellSet's known dynamic type
-  const vtkm::cont::CellSetStructured<3>& inputCells =
-    inDataSet.GetCellSet().AsCellSet<vtkm::cont::CellSetStructured<3>>();
+  if (this->IsoValuesOutsideFieldRange(this->GetFieldFromDataSet(inDataSet), true))
+  {
+    this->IsoValuePointOffsets.assign(this->IsoValues.size() + 1, 0);
+    this->IsoValueCellOffsets.assign(this->IsoValues.size() + 1, 0);
+    return this->CreateEmptyResult(inDataSet);
+  }
 
   using Vec3HandleType = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
   Vec3HandleType vertices;
@@ -70,13 +81,25 @@ vtkm::cont::DataSet ContourFlyingEdges::DoExecute(const vtkm::cont::DataSet& inD
       ivalues[i] = static_cast<IVType>(this->IsoValues[i]);
     }
 
-    if (this->GenerateNormals && !this->GetComputeFastNormals())
+    auto runWithCells = [&](const auto& inputCells) {
+      if (this->GenerateNormals && !this->GetComputeFastNormals())
+      {
+        outputCells = worklet.Run(ivalues, inputCells, inCoords, concrete, vertices, normals);
+      }
+      else
+      {
+        outputCells = worklet.Run(ivalues, inputCells, inCoords, concrete, vertices);
+      }
+    };
+
+    // 2D structured cell sets produce isolines.
+    if (inCellSet.template IsType<vtkm::cont::CellSetStructured<2>>())
     {
-      outputCells = worklet.Run(ivalues, inputCells, inCoords, concrete, vertices, normals);
+      runWithCells(inCellSet.AsCellSet<vtkm::cont::CellSetStructured<2>>());
     }
     else
     {
-      outputCells = worklet.Run(ivalues, inputCells, inCoords, concrete, vertices);
+      runWithCells(inCellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>());
     }
   };
 
@@ -84,6 +107,8 @@ vtkm::cont::DataSet ContourFlyingEdges::DoExecute(const vtkm::cont::DataSet& inD
     .GetData()
     .CastAndCallForTypesWithFloatFallback<SupportedTypes, VTKM_DEFAULT_STORAGE_LIST>(
       resolveFieldType);
+  this->IsoValuePointOffsets = worklet.GetIsoValuePointOffsets();
+  this->IsoValueCellOffsets = worklet.GetIsoValueCellOffsets();
 
   auto mapper = [&](auto& result, const auto& f) { this->DoMapField(result, f, worklet); };
   vtkm::cont::DataSet output = this->CreateResultCoordinateSystem(
@@ -94,6 +119,74 @@ vtkm::cont::DataSet ContourFlyingEdges::DoExecute(const vtkm::cont::DataSet& inD
 
   return output;
 }
+
+//-----------------------------------------------------------------------------
+vtkm::cont::PartitionedDataSet ContourFlyingEdges::ExecuteByIsoValue(
+  const vtkm::cont::DataSet& input)
+{
+  const vtkm::cont::DataSet contours = this->Execute(input);
+  const bool isolines = input.GetCellSet().IsType<vtkm::cont::CellSetStructured<2>>();
+  const vtkm::UInt8 shape = isolines ? vtkm::CELL_SHAPE_LINE : vtkm::CELL_SHAPE_TRIANGLE;
+  const vtkm::IdComponent pointsPerCell = isolines ? 2 : 3;
+
+  vtkm::cont::CellSetSingleType<> contourCells;
+  contours.GetCellSet().AsCellSet(contourCells);
+  const auto connectivity = contourCells.GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                              vtkm::TopologyElementTagPoint{});
+
+  vtkm::cont::PartitionedDataSet output;
+  for (std::size_t i = 0; i + 1 < this->IsoValuePointOffsets.size(); ++i)
+  {
+    const vtkm::Id pointOffset = this->IsoValuePointOffsets[i];
+    const vtkm::Id numPoints = this->IsoValuePointOffsets[i + 1] - pointOffset;
+    const vtkm::Id cellOffset = this->IsoValueCellOffsets[i];
+    const vtkm::Id numCells = this->IsoValueCellOffsets[i + 1] - cellOffset;
+
+    // The connectivity of each iso value refers to the points of that iso value only.
+    vtkm::cont::ArrayHandle<vtkm::Id> partitionConnectivity;
+    vtkm::cont::Algorithm::Transform(
+      vtkm::cont::make_ArrayHandleView(
+        connectivity, cellOffset * pointsPerCell, numCells * pointsPerCell),
+      vtkm::cont::make_ArrayHandleConstant(pointOffset, numCells * pointsPerCell),
+      partitionConnectivity,
+      vtkm::Subtract{});
+    vtkm::cont::CellSetSingleType<> partitionCells;
+    partitionCells.Fill(numPoints, shape, pointsPerCell, partitionConnectivity);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> pointIds;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleCounting(pointOffset, vtkm::Id(1), numPoints),
+                          pointIds);
+    vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleCounting(cellOffset, vtkm::Id(1), numCells),
+                          cellIds);
+
+    vtkm::cont::DataSet partition;
+    partition.SetCellSet(partitionCells);
+    for (vtkm::IdComponent fieldIndex = 0; fieldIndex < contours.GetNumberOfFields(); ++fieldIndex)
+    {
+      const vtkm::cont::Field& field = contours.GetField(fieldIndex);
+      if (field.IsPointField())
+      {
+        vtkm::filter::MapFieldPermutation(field, pointIds, partition);
+      }
+      else if (field.IsCellField())
+      {
+        vtkm::filter::MapFieldPermutation(field, cellIds, partition);
+      }
+      else
+      {
+        partition.AddField(field);
+      }
+    }
+    for (vtkm::IdComponent csIndex = 0; csIndex < contours.GetNumberOfCoordinateSystems();
+         ++csIndex)
+    {
+      partition.AddCoordinateSystem(contours.GetCoordinateSystemName(csIndex));
+    }
+    output.AppendPartition(partition);
+  }
+  return output;
+}
 } // namespace contour
 } // namespace filter
 } // namespace vtkm
@@ -11,9 +11,12 @@
 #ifndef vtk_m_filter_contour_ContourFlyingEdges_h
 #define vtk_m_filter_contour_ContourFlyingEdges_h
 
+#include <vtkm/cont/PartitionedDataSet.h>
 #include <vtkm/filter/contour/AbstractContour.h>
 #include <vtkm/filter/contour/vtkm_filter_contour_export.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace filter
@@ -28,11 +31,42 @@ namespace contour
 ///
 /// This implementation only accepts \c CellSetStructured<3> inputs using
 /// \c ArrayHandleUniformPointCoordinates for point coordinates,
-/// and is only used as part of the more general \c Contour filter
+/// and is only used as part of the more general \c Contour filter.
+/// \c CellSetStructured<2> inputs are also accepted and generate isolines
+/// made of line cells.
 class VTKM_FILTER_CONTOUR_EXPORT ContourFlyingEdges : public vtkm::filter::contour::AbstractContour
 {
+public:
+  /// @brief Set the maximum number of planes of points processed at once.
+  ///
+  /// Flying edges keeps metadata for every point and row of points of the volume
+  /// it processes. When this is set to a value smaller than the number of planes of
+  /// points along the Z axis, the volume is processed in slabs of at most this many
+  /// planes, and the contours of the slabs are stitched together. Consecutive slabs
+  /// share a plane of points, so the output is the same as for the whole volume up
+  /// to the ordering of points and cells. The memory used by the algorithm is then
+  /// bounded by the size of a slab. A value of 0, the default, processes the whole
+  /// volume at once. Slabs are only used for uniform point coordinates; other inputs
+  /// are always processed at once.
+  VTKM_CONT void SetSlabSize(vtkm::Id numPlanes) { this->SlabSize = numPlanes; }
+  /// @copydoc SetSlabSize
+  VTKM_CONT vtkm::Id GetSlabSize() const { return this->SlabSize; }
+
+  /// @brief Extract the contours and return the contour of each iso value as its own partition.
+  ///
+  /// All the iso values are extracted in a single execution, which classifies the edges
+  /// of the input against several iso values per traversal. Partition `i` of the result
+  /// holds the contour of the `i`-th iso value with the fields that `Execute` would map.
+  /// A partition is empty when its iso value does not cross the input.
+  VTKM_CONT vtkm::cont::PartitionedDataSet ExecuteByIsoValue(const vtkm::cont::DataSet& input);
+
 protected:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& result) override;
+
+private:
+  vtkm::Id SlabSize = 0;
+  std::vector<vtkm::Id> IsoValuePointOffsets;
+  std::vector<vtkm::Id> IsoValueCellOffsets;
 };
 } // namespace contour
 } // namespace filter
@@ -37,8 +37,22 @@ vtkm::cont::DataSet ContourMarchingCells::DoExecute(const vtkm::cont::DataSet& i
     throw vtkm::cont::ErrorFilterExecution("No iso-values provided.");
   }
 
+  if (this->IsoValuesOutsideFieldRange(this->GetFieldFromDataSet(inDataSet)))
+  {
+    return this->CreateEmptyResult(inDataSet);
+  }
+
   //get the inputCells and coordinates of the dataset
   const vtkm::cont::UnknownCellSet& inputCells = inDataSet.GetCellSet();
+
+  const bool useIndex = this->Index.IsBuilt();
+  if (useIndex &&
+      (this->Index.GetFieldName() != this->GetActiveFieldName() ||
+       this->Index.GetNumberOfCells() != inputCells.GetNumberOfCells()))
+  {
+    throw vtkm::cont::ErrorFilterExecution(
+      "Span space index was not built for the active field of the input.");
+  }
   const vtkm::cont::CoordinateSystem& inputCoords =
     inDataSet.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
 
@@ -57,6 +71,13 @@ vtkm::cont::DataSet ContourMarchingCells::DoExecute(const vtkm::cont::DataSet& i
       ivalues[i] = static_cast<T>(this->IsoValues[i]);
     }
 
+    if (useIndex)
+    {
+      // Query with the iso values converted to the field type, as used for classification.
+      std::vector<vtkm::Float64> queryValues(ivalues.begin(), ivalues.end());
+      worklet.SetCandidateCells(this->Index.FindCandidateCells(queryValues));
+    }
+
     if (this->GenerateNormals && !this->GetComputeFastNormals())
     {
       outputCells = worklet.Run(ivalues, inputCells, inputCoords, concrete, vertices, normals);
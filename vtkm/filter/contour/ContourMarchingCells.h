@@ -12,6 +12,7 @@
 #define vtk_m_filter_contour_ContourMarchingCells_h
 
 #include <vtkm/filter/contour/AbstractContour.h>
+#include <vtkm/filter/contour/SpanSpaceIndex.h>
 #include <vtkm/filter/contour/vtkm_filter_contour_export.h>
 
 namespace vtkm
@@ -32,9 +33,29 @@ namespace contour
 class VTKM_FILTER_CONTOUR_EXPORT ContourMarchingCells
   : public vtkm::filter::contour::AbstractContour
 {
+public:
+  /// @brief Use a span space index to visit only the cells crossed by the contours.
+  ///
+  /// The index must have been built for the cell set and active field of the data
+  /// set given to `Execute`. Building the index once and reusing it makes repeated
+  /// executions with different iso values much cheaper on large meshes. Set a
+  /// default constructed index to classify all cells again.
+  VTKM_CONT void SetSpanSpaceIndex(const vtkm::filter::contour::SpanSpaceIndex& index)
+  {
+    this->Index = index;
+  }
+  /// @copydoc SetSpanSpaceIndex
+  VTKM_CONT const vtkm::filter::contour::SpanSpaceIndex& GetSpanSpaceIndex() const
+  {
+    return this->Index;
+  }
+
 protected:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& result) override;
+
+private:
+  vtkm::filter::contour::SpanSpaceIndex Index;
 };
 } // namespace contour
 } // namespace filter
@@ -9,8 +9,169 @@
 //============================================================================
 
 #include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/filter/contour/Slice.h>
+#include <vtkm/filter/contour/worklet/contour/FieldPropagation.h>
+
+namespace
+{
+
+// Converts the index of a point or cell of an axis-aligned slice to the index of the
+// point or cell at the given layer of the input structured mesh.
+struct SliceToInputIndex
+{
+  vtkm::Id3 Dimensions;
+  vtkm::IdComponent Axis;
+
+  VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id index, vtkm::Id layer) const
+  {
+    const vtkm::IdComponent u = (this->Axis == 0) ? 1 : 0;
+    const vtkm::IdComponent v = (this->Axis == 2) ? 1 : 2;
+    vtkm::Id3 ijk;
+    ijk[this->Axis] = layer;
+    ijk[u] = index % this->Dimensions[u];
+    ijk[v] = index / this->Dimensions[u];
+    return ijk[0] + this->Dimensions[0] * (ijk[1] + this->Dimensions[1] * ijk[2]);
+  }
+};
+
+struct SlicePointEdge
+{
+  SliceToInputIndex Points;
+  vtkm::Id Layer;
+
+  VTKM_EXEC_CONT vtkm::Id2 operator()(vtkm::Id index) const
+  {
+    return vtkm::Id2(this->Points(index, this->Layer), this->Points(index, this->Layer + 1));
+  }
+};
+
+struct SliceCellId
+{
+  SliceToInputIndex Cells;
+  vtkm::Id Layer;
+
+  VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id index) const
+  {
+    return this->Cells(index, this->Layer);
+  }
+};
+
+// Plays the role of the contour worklet when mapping fields onto an axis-aligned slice.
+// Every point of the slice interpolates the pair of input points on either side of it
+// with the same weight.
+class AxisAlignedSliceMapper
+{
+public:
+  AxisAlignedSliceMapper(vtkm::Id numPoints,
+                         vtkm::Id numCells,
+                         const SlicePointEdge& pointEdge,
+                         const SliceCellId& cellId,
+                         vtkm::FloatDefault weight)
+    : Edges(vtkm::cont::ArrayHandleIndex(numPoints), pointEdge)
+    , Weights(weight, numPoints)
+  {
+    vtkm::cont::ArrayCopyDevice(
+      vtkm::cont::make_ArrayHandleTransform(vtkm::cont::ArrayHandleIndex(numCells), cellId),
+      this->CellIdMap);
+  }
+
+  template <typename InArrayType, typename OutArrayType>
+  void ProcessPointField(const InArrayType& input, const OutArrayType& output) const
+  {
+    vtkm::cont::Invoker invoke;
+    invoke(vtkm::worklet::contour::MapPointField{}, this->Edges, this->Weights, input, output);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->CellIdMap; }
+
+  vtkm::cont::ArrayHandle<vtkm::Id2> GetInterpolationEdgeIds() const
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id2> edgeIds;
+    vtkm::cont::ArrayCopyDevice(this->Edges, edgeIds);
+    return edgeIds;
+  }
+
+private:
+  vtkm::cont::ArrayHandleTransform<vtkm::cont::ArrayHandleIndex, SlicePointEdge> Edges;
+  vtkm::cont::ArrayHandleConstant<vtkm::FloatDefault> Weights;
+  vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
+};
+
+// Finds the layer of points below `position` along an axis and the weight of the layer
+// above it. Returns false if the position is outside of the axis.
+template <typename PortalType>
+bool FindSliceLayer(const PortalType& axis,
+                    vtkm::FloatDefault position,
+                    vtkm::Id& layer,
+                    vtkm::FloatDefault& weight)
+{
+  const vtkm::Id numValues = axis.GetNumberOfValues();
+  if (numValues < 2 || !(axis.Get(0) < axis.Get(numValues - 1)) ||
+      position < static_cast<vtkm::FloatDefault>(axis.Get(0)) ||
+      position > static_cast<vtkm::FloatDefault>(axis.Get(numValues - 1)))
+  {
+    return false;
+  }
+
+  // Binary search for the last value that is not past the position.
+  vtkm::Id low = 0;
+  vtkm::Id high = numValues - 1;
+  while (high - low > 1)
+  {
+    const vtkm::Id mid = low + (high - low) / 2;
+    if (static_cast<vtkm::FloatDefault>(axis.Get(mid)) <= position)
+    {
+      low = mid;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  layer = low;
+  const vtkm::FloatDefault lowValue = static_cast<vtkm::FloatDefault>(axis.Get(layer));
+  const vtkm::FloatDefault highValue = static_cast<vtkm::FloatDefault>(axis.Get(layer + 1));
+  weight = (position - lowValue) / (highValue - lowValue);
+  return true;
+}
+
+template <typename T>
+bool MakeRectilinearSliceCoordinates(const vtkm::cont::UnknownArrayHandle& coords,
+                                     vtkm::IdComponent axis,
+                                     vtkm::FloatDefault position,
+                                     vtkm::Id& layer,
+                                     vtkm::FloatDefault& weight,
+                                     vtkm::cont::UnknownArrayHandle& sliceCoords)
+{
+  using AxisType = vtkm::cont::ArrayHandle<T>;
+  using CoordsType = vtkm::cont::ArrayHandleCartesianProduct<AxisType, AxisType, AxisType>;
+  if (!coords.CanConvert<CoordsType>())
+  {
+    return false;
+  }
+
+  CoordsType inCoords = coords.AsArrayHandle<CoordsType>();
+  AxisType axes[3] = { inCoords.GetFirstArray(),
+                       inCoords.GetSecondArray(),
+                       inCoords.GetThirdArray() };
+  if (!FindSliceLayer(axes[axis].ReadPortal(), position, layer, weight))
+  {
+    return false;
+  }
+
+  axes[axis] = vtkm::cont::make_ArrayHandle<T>({ static_cast<T>(position) });
+  sliceCoords = vtkm::cont::make_ArrayHandleCartesianProduct(axes[0], axes[1], axes[2]);
+  return true;
+}
+
+} // anonymous namespace
 
 namespace vtkm
 {
@@ -20,9 +181,19 @@ namespace contour
 {
 vtkm::cont::DataSet Slice::DoExecute(const vtkm::cont::DataSet& input)
 {
-  const auto& coords = input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+  if (this->GetNumberOfIsoValues() < 1)
+  {
+    this->SetIsoValue(0.0);
+  }
 
   vtkm::cont::DataSet result;
+  if (this->DoExecuteAxisAligned(input, result))
+  {
+    return result;
+  }
+
+  const auto& coords = input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+
   auto impFuncEval =
     vtkm::ImplicitFunctionValueFunctor<vtkm::ImplicitFunctionGeneral>(this->Function);
   auto coordTransform =
@@ -33,15 +204,109 @@ vtkm::cont::DataSet Slice::DoExecute(const vtkm::cont::DataSet& input)
   vtkm::cont::DataSet clone = input;
   clone.AddField(vtkm::cont::make_FieldPoint("sliceScalars", sliceScalars));
 
-  if (this->GetNumberOfIsoValues() < 1)
-  {
-    this->SetIsoValue(0.0);
-  }
   this->Contour::SetActiveField("sliceScalars");
   result = this->Contour::DoExecute(clone);
 
   return result;
 }
+
+bool Slice::DoExecuteAxisAligned(const vtkm::cont::DataSet& input, vtkm::cont::DataSet& output)
+{
+  // The slice of an axis-aligned plane through a uniform or rectilinear grid is a plane
+  // of points interpolated from the two neighboring planes of input points.
+  if (!this->Function.IsType<vtkm::Plane>() || this->GetNumberOfIsoValues() != 1 ||
+      !input.GetCellSet().IsType<vtkm::cont::CellSetStructured<3>>())
+  {
+    return false;
+  }
+
+  const vtkm::Plane& plane = this->Function.Get<vtkm::Plane>();
+  const vtkm::Vec3f normal = plane.GetNormal();
+  vtkm::IdComponent axis = -1;
+  for (vtkm::IdComponent i = 0; i < 3; ++i)
+  {
+    if (normal[i] != 0)
+    {
+      if (axis >= 0)
+      {
+        return false;
+      }
+      axis = i;
+    }
+  }
+  if (axis < 0)
+  {
+    return false;
+  }
+  const vtkm::FloatDefault position = plane.GetOrigin()[axis] +
+    static_cast<vtkm::FloatDefault>(this->GetIsoValue(0)) / normal[axis];
+
+  const vtkm::Id3 pointDims = input.GetCellSet()
+                                .AsCellSet<vtkm::cont::CellSetStructured<3>>()
+                                .GetSchedulingRange(vtkm::TopologyElementTagPoint{});
+  const vtkm::IdComponent u = (axis == 0) ? 1 : 0;
+  const vtkm::IdComponent v = (axis == 2) ? 1 : 2;
+  if (pointDims[u] < 2 || pointDims[v] < 2)
+  {
+    return false;
+  }
+
+  const vtkm::cont::CoordinateSystem& coords =
+    input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+  vtkm::Id layer = 0;
+  vtkm::FloatDefault weight = 0;
+  vtkm::cont::UnknownArrayHandle sliceCoords;
+  if (coords.GetData().IsType<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+  {
+    auto inCoords =
+      coords.GetData().AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>();
+    vtkm::Vec3f origin = inCoords.GetOrigin();
+    const vtkm::Vec3f spacing = inCoords.GetSpacing();
+    vtkm::Id3 sliceDims = inCoords.GetDimensions();
+    const vtkm::FloatDefault location = (position - origin[axis]) / spacing[axis];
+    if (sliceDims[axis] < 2 || !(location >= 0) ||
+        location > static_cast<vtkm::FloatDefault>(sliceDims[axis] - 1))
+    {
+      return false;
+    }
+    layer = vtkm::Min(static_cast<vtkm::Id>(location), sliceDims[axis] - 2);
+    weight = location - static_cast<vtkm::FloatDefault>(layer);
+
+    origin[axis] = position;
+    sliceDims[axis] = 1;
+    sliceCoords = vtkm::cont::ArrayHandleUniformPointCoordinates(sliceDims, origin, spacing);
+  }
+  else if (!MakeRectilinearSliceCoordinates<vtkm::Float32>(
+             coords.GetData(), axis, position, layer, weight, sliceCoords) &&
+           !MakeRectilinearSliceCoordinates<vtkm::Float64>(
+             coords.GetData(), axis, position, layer, weight, sliceCoords))
+  {
+    return false;
+  }
+
+  vtkm::cont::CellSetStructured<2> sliceCells;
+  sliceCells.SetPointDimensions(vtkm::Id2(pointDims[u], pointDims[v]));
+  const vtkm::Id numPoints = sliceCells.GetNumberOfPoints();
+
+  const SliceToInputIndex toInputPoint{ pointDims, axis };
+  const SliceToInputIndex toInputCell{ pointDims - vtkm::Id3(1), axis };
+  AxisAlignedSliceMapper mapper(numPoints,
+                                sliceCells.GetNumberOfCells(),
+                                SlicePointEdge{ toInputPoint, layer },
+                                SliceCellId{ toInputCell, layer },
+                                weight);
+  auto fieldMapper = [&](auto& result, const auto& f) { this->DoMapField(result, f, mapper); };
+  output = this->CreateResultCoordinateSystem(
+    input, sliceCells, coords.GetName(), sliceCoords, fieldMapper);
+
+  // The gradient of the plane function is its normal everywhere.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+  normals.AllocateAndFill(numPoints, vtkm::Normal(normal));
+  this->ExecuteGenerateNormals(output, normals);
+  this->ExecuteAddInterpolationEdgeIds(output, mapper);
+  return true;
+}
+
 } // namespace contour
 } // namespace filter
 } // namespace vtkm
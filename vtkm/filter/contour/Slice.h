@@ -28,6 +28,13 @@ namespace contour
 /// slice on. A `vtkm::Plane` is a common function to use that cuts the mesh
 /// along a plane.
 ///
+/// When the function is a `vtkm::Plane` perpendicular to a coordinate axis and the
+/// input is a 3D structured mesh with uniform or rectilinear coordinates, the slice
+/// lies between two planes of points. In this case the filter does not evaluate the
+/// function over the mesh. It interpolates between the two planes of points and
+/// outputs a 2D structured data set with `CellSetStructured<2>` cells, so the work
+/// and memory are proportional to the size of the slice.
+///
 class VTKM_FILTER_CONTOUR_EXPORT Slice : public vtkm::filter::contour::Contour
 {
 public:
@@ -45,6 +52,9 @@ public:
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
+  VTKM_CONT bool DoExecuteAxisAligned(const vtkm::cont::DataSet& input,
+                                      vtkm::cont::DataSet& output);
+
   vtkm::ImplicitFunctionGeneral Function;
 };
 } // namespace contour
@@ -39,7 +39,9 @@ public:
 vtkm::cont::DataSet SliceMultiple::DoExecute(const vtkm::cont::DataSet& input)
 {
   vtkm::cont::PartitionedDataSet slices;
-  //Executing Slice filter several times and merge results together
+  //Executing Slice filter several times and merge results together.
+  //Axis-aligned planes on uniform and rectilinear grids take the structured
+  //fast path of the Slice filter, and their quads are merged with the rest.
   for (vtkm::IdComponent i = 0; i < static_cast<vtkm::IdComponent>(this->FunctionList.size()); i++)
   {
     vtkm::filter::contour::Slice slice;
@@ -0,0 +1,338 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/contour/SpanSpaceIndex.h>
+
+#include <vtkm/Math.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/ArrayHandleZip.h>
+#include <vtkm/cont/DefaultTypes.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/ScatterCounting.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+namespace
+{
+
+class CellFieldRange : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+public:
+  using ControlSignature = void(CellSetIn cellSet,
+                                FieldInPoint field,
+                                FieldOutCell cellMin,
+                                FieldOutCell cellMax);
+  using ExecutionSignature = void(PointCount, _2, _3, _4);
+
+  template <typename FieldVecType>
+  VTKM_EXEC void operator()(vtkm::IdComponent numPoints,
+                            const FieldVecType& field,
+                            vtkm::Float64& cellMin,
+                            vtkm::Float64& cellMax) const
+  {
+    cellMin = vtkm::Infinity64();
+    cellMax = vtkm::NegativeInfinity64();
+    for (vtkm::IdComponent i = 0; i < numPoints; ++i)
+    {
+      // Marching cells never counts a NaN as above the iso value, which is the same
+      // as treating it as negative infinity.
+      vtkm::Float64 value = field[i];
+      value = vtkm::IsNan(value) ? vtkm::NegativeInfinity64() : value;
+      cellMin = vtkm::Min(cellMin, value);
+      cellMax = vtkm::Max(cellMax, value);
+    }
+  }
+};
+
+class BinOfRank : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn rank, FieldOut bin);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_CONT BinOfRank(vtkm::Id numCells, vtkm::Id numBins)
+    : NumCells(numCells)
+    , NumBins(numBins)
+  {
+  }
+
+  VTKM_EXEC void operator()(vtkm::Id rank, vtkm::Id& bin) const
+  {
+    bin = (rank * this->NumBins) / this->NumCells;
+  }
+
+private:
+  vtkm::Id NumCells;
+  vtkm::Id NumBins;
+};
+
+class BinOffset : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn bin, FieldOut offset);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_CONT BinOffset(vtkm::Id numCells, vtkm::Id numBins)
+    : NumCells(numCells)
+    , NumBins(numBins)
+  {
+  }
+
+  // The first rank that BinOfRank maps to the bin.
+  VTKM_EXEC void operator()(vtkm::Id bin, vtkm::Id& offset) const
+  {
+    offset = (bin * this->NumCells + this->NumBins - 1) / this->NumBins;
+  }
+
+private:
+  vtkm::Id NumCells;
+  vtkm::Id NumBins;
+};
+
+struct BinThenDecreasingMax
+{
+  VTKM_EXEC_CONT bool operator()(const vtkm::Pair<vtkm::Id, vtkm::Float64>& a,
+                                 const vtkm::Pair<vtkm::Id, vtkm::Float64>& b) const
+  {
+    return (a.first < b.first) || ((a.first == b.first) && (a.second > b.second));
+  }
+};
+
+class CountBinCandidates : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn binBegin,
+                                FieldIn binEnd,
+                                FieldIn binMin,
+                                WholeArrayIn cellMaxs,
+                                FieldOut count);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  VTKM_CONT explicit CountBinCandidates(vtkm::Float64 isoValue)
+    : IsoValue(isoValue)
+  {
+  }
+
+  template <typename MaxPortalType>
+  VTKM_EXEC void operator()(vtkm::Id binBegin,
+                            vtkm::Id binEnd,
+                            vtkm::Float64 binMin,
+                            const MaxPortalType& cellMaxs,
+                            vtkm::IdComponent& count) const
+  {
+    if (binMin > this->IsoValue)
+    {
+      count = 0;
+      return;
+    }
+
+    // The maximums decrease within the bin, so the cells above the iso value form a
+    // prefix of the bin.
+    vtkm::Id low = binBegin;
+    vtkm::Id high = binEnd;
+    while (low < high)
+    {
+      vtkm::Id mid = low + (high - low) / 2;
+      if (cellMaxs.Get(mid) > this->IsoValue)
+      {
+        low = mid + 1;
+      }
+      else
+      {
+        high = mid;
+      }
+    }
+    count = static_cast<vtkm::IdComponent>(low - binBegin);
+  }
+
+private:
+  vtkm::Float64 IsoValue;
+};
+
+class ExpandBinCandidates : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn binBegin,
+                                WholeArrayIn cellIds,
+                                WholeArrayIn cellMins,
+                                FieldOut candidateId,
+                                FieldOut keep);
+  using ExecutionSignature = void(_1, _2, _3, VisitIndex, _4, _5);
+  using ScatterType = vtkm::worklet::ScatterCounting;
+
+  VTKM_CONT explicit ExpandBinCandidates(vtkm::Float64 isoValue)
+    : IsoValue(isoValue)
+  {
+  }
+
+  template <typename IdPortalType, typename MinPortalType>
+  VTKM_EXEC void operator()(vtkm::Id binBegin,
+                            const IdPortalType& cellIds,
+                            const MinPortalType& cellMins,
+                            vtkm::IdComponent visitIndex,
+                            vtkm::Id& candidateId,
+                            vtkm::UInt8& keep) const
+  {
+    // Only the bin containing the iso value has cells with a minimum above it.
+    const vtkm::Id index = binBegin + visitIndex;
+    candidateId = cellIds.Get(index);
+    keep = (cellMins.Get(index) <= this->IsoValue) ? 1 : 0;
+  }
+
+private:
+  vtkm::Float64 IsoValue;
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+namespace contour
+{
+
+void SpanSpaceIndex::Build(const vtkm::cont::DataSet& input, const std::string& fieldName)
+{
+  this->Build(input.GetCellSet(), input.GetField(fieldName));
+}
+
+void SpanSpaceIndex::Build(const vtkm::cont::UnknownCellSet& cells,
+                           const vtkm::cont::Field& field)
+{
+  if (!field.IsPointField())
+  {
+    throw vtkm::cont::ErrorBadValue("SpanSpaceIndex requires a point field.");
+  }
+  if (field.GetNumberOfValues() != cells.GetNumberOfPoints())
+  {
+    throw vtkm::cont::ErrorBadValue("Field size does not match the number of points.");
+  }
+
+  vtkm::cont::Invoker invoke;
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> pointValues;
+  vtkm::cont::ArrayCopyShallowIfPossible(field.GetData(), pointValues);
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> cellMins;
+  vtkm::cont::ArrayHandle<vtkm::Float64> cellMaxs;
+  cells.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>([&](const auto& concrete) {
+    invoke(CellFieldRange{}, concrete, pointValues, cellMins, cellMaxs);
+  });
+
+  const vtkm::Id numCells = cellMins.GetNumberOfValues();
+  vtkm::Id numBins = this->NumberOfBins;
+  if (numBins <= 0)
+  {
+    numBins = static_cast<vtkm::Id>(vtkm::Sqrt(static_cast<vtkm::Float64>(numCells)));
+  }
+  numBins = vtkm::Max(vtkm::Id(1), vtkm::Min(numBins, numCells));
+
+  // Split the cells into bins of equal size along the minimum axis of span space.
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numCells), this->CellIds);
+  auto idsAndMaxs = vtkm::cont::make_ArrayHandleZip(this->CellIds, cellMaxs);
+  vtkm::cont::Algorithm::SortByKey(cellMins, idsAndMaxs);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> binIds;
+  invoke(BinOfRank{ numCells, numBins }, vtkm::cont::ArrayHandleIndex(numCells), binIds);
+  invoke(BinOffset{ numCells, numBins },
+         vtkm::cont::ArrayHandleIndex(numBins + 1),
+         this->BinOffsets);
+  vtkm::cont::ArrayCopy(
+    vtkm::cont::make_ArrayHandlePermutation(
+      vtkm::cont::make_ArrayHandleView(this->BinOffsets, 0, numBins), cellMins),
+    this->BinMins);
+
+  // Sort each bin along the maximum axis so that the cells above an iso value are a prefix.
+  auto binsAndMaxs = vtkm::cont::make_ArrayHandleZip(binIds, cellMaxs);
+  auto idsAndMins = vtkm::cont::make_ArrayHandleZip(this->CellIds, cellMins);
+  vtkm::cont::Algorithm::SortByKey(binsAndMaxs, idsAndMins, BinThenDecreasingMax{});
+
+  this->CellMins = cellMins;
+  this->CellMaxs = cellMaxs;
+  this->FieldName = field.GetName();
+  this->Built = true;
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> SpanSpaceIndex::FindCandidateCells(
+  vtkm::Float64 isoValue) const
+{
+  if (!this->Built)
+  {
+    throw vtkm::cont::ErrorBadValue("SpanSpaceIndex has not been built.");
+  }
+
+  vtkm::cont::Invoker invoke;
+  const vtkm::Id numBins = this->BinMins.GetNumberOfValues();
+  auto binBegins = vtkm::cont::make_ArrayHandleView(this->BinOffsets, 0, numBins);
+  auto binEnds = vtkm::cont::make_ArrayHandleView(this->BinOffsets, 1, numBins);
+
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> binCounts;
+  invoke(CountBinCandidates{ isoValue },
+         binBegins,
+         binEnds,
+         this->BinMins,
+         this->CellMaxs,
+         binCounts);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::ArrayHandle<vtkm::UInt8> keep;
+  invoke(ExpandBinCandidates{ isoValue },
+         vtkm::worklet::ScatterCounting(binCounts),
+         binBegins,
+         this->CellIds,
+         this->CellMins,
+         cellIds,
+         keep);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> candidates;
+  vtkm::cont::Algorithm::CopyIf(cellIds, keep, candidates);
+  return candidates;
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> SpanSpaceIndex::FindCandidateCells(
+  const std::vector<vtkm::Float64>& isoValues) const
+{
+  if (isoValues.size() == 1)
+  {
+    return this->FindCandidateCells(isoValues[0]);
+  }
+
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Id>> perIsoValue;
+  vtkm::Id numCandidates = 0;
+  for (vtkm::Float64 isoValue : isoValues)
+  {
+    perIsoValue.push_back(this->FindCandidateCells(isoValue));
+    numCandidates += perIsoValue.back().GetNumberOfValues();
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> candidates;
+  candidates.Allocate(numCandidates);
+  vtkm::Id offset = 0;
+  for (const auto& part : perIsoValue)
+  {
+    vtkm::cont::Algorithm::CopySubRange(part, 0, part.GetNumberOfValues(), candidates, offset);
+    offset += part.GetNumberOfValues();
+  }
+
+  // A cell can be crossed by several contours but must be visited once.
+  vtkm::cont::Algorithm::Sort(candidates);
+  vtkm::cont::Algorithm::Unique(candidates);
+  return candidates;
+}
+
+} // namespace contour
+} // namespace filter
+} // namespace vtkm
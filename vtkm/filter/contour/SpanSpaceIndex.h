@@ -0,0 +1,105 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_contour_SpanSpaceIndex_h
+#define vtk_m_filter_contour_SpanSpaceIndex_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/Field.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/filter/contour/vtkm_filter_contour_export.h>
+
+#include <string>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace contour
+{
+
+/// \brief Index of the cells of a mesh that can be crossed by a contour.
+///
+/// `SpanSpaceIndex` records the range (minimum and maximum) of a point field over
+/// each cell. A cell can only contribute to a contour at an iso value when the iso
+/// value lies within this range, so the index can quickly return the cells worth
+/// classifying for a given set of iso values.
+///
+/// The cells are placed in span space, where each cell is a point with its minimum
+/// as the x coordinate and its maximum as the y coordinate. Span space is split into
+/// bins holding equal numbers of cells sorted by minimum, and the cells in each bin
+/// are sorted by maximum. A query performs a binary search in each bin, so its cost
+/// grows with the number of candidate cells rather than the size of the mesh.
+///
+/// Building the index costs about as much as a few contour executions, so it pays off
+/// when many iso values are extracted from the same mesh and field. Give the index to
+/// `ContourMarchingCells::SetSpanSpaceIndex` to use it. The index does not track
+/// changes to the mesh or field; build it again when either changes.
+class VTKM_FILTER_CONTOUR_EXPORT SpanSpaceIndex
+{
+public:
+  /// @brief Build the index for the named point field of a data set.
+  VTKM_CONT void Build(const vtkm::cont::DataSet& input, const std::string& fieldName);
+
+  /// @brief Build the index for a point field over the given cells.
+  VTKM_CONT void Build(const vtkm::cont::UnknownCellSet& cells, const vtkm::cont::Field& field);
+
+  /// @brief Return whether `Build` has been called.
+  VTKM_CONT bool IsBuilt() const { return this->Built; }
+
+  /// @brief Specify the number of bins used to partition span space.
+  ///
+  /// A value of 0, the default, uses the square root of the number of cells, which
+  /// balances the binary searches over the bins against the scan of the bin that
+  /// straddles the iso value. Takes effect on the next call to `Build`.
+  VTKM_CONT void SetNumberOfBins(vtkm::Id numBins) { this->NumberOfBins = numBins; }
+  /// @copydoc SetNumberOfBins
+  VTKM_CONT vtkm::Id GetNumberOfBins() const { return this->NumberOfBins; }
+
+  /// @brief The number of cells of the mesh the index was built for.
+  VTKM_CONT vtkm::Id GetNumberOfCells() const { return this->CellIds.GetNumberOfValues(); }
+
+  /// @brief The name of the field the index was built for.
+  VTKM_CONT const std::string& GetFieldName() const { return this->FieldName; }
+
+  /// @brief Return the ids of the cells that may be crossed by the contour at `isoValue`.
+  ///
+  /// A cell is a candidate when its minimum is at most `isoValue` and its maximum is
+  /// greater than `isoValue`, which matches the classification used by the marching
+  /// cells algorithm. The ids are not sorted.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> FindCandidateCells(vtkm::Float64 isoValue) const;
+
+  /// @brief Return the ids of the cells that may be crossed by any of the contours.
+  ///
+  /// The ids are sorted and each cell is listed once.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> FindCandidateCells(
+    const std::vector<vtkm::Float64>& isoValues) const;
+
+private:
+  bool Built = false;
+  vtkm::Id NumberOfBins = 0;
+  std::string FieldName;
+
+  // Cells sorted by bin and, within each bin, by decreasing maximum.
+  vtkm::cont::ArrayHandle<vtkm::Id> CellIds;
+  vtkm::cont::ArrayHandle<vtkm::Float64> CellMins;
+  vtkm::cont::ArrayHandle<vtkm::Float64> CellMaxs;
+  // Offsets of the bins into the sorted cells and the smallest minimum in each bin.
+  vtkm::cont::ArrayHandle<vtkm::Id> BinOffsets;
+  vtkm::cont::ArrayHandle<vtkm::Float64> BinMins;
+};
+
+} // namespace contour
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_contour_SpanSpaceIndex_h
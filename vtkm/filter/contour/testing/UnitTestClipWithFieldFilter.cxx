@@ -98,11 +98,36 @@ void TestClipVolume()
   const vtkm::cont::DataSet outputData = clip.Execute(ds);
 }
 
+void TestClipEverything()
+{
+  std::cout << "Testing Clip Filter removing all the data" << std::endl;
+
+  vtkm::cont::DataSet ds = MakeTestDatasetExplicit();
+  ds.AddCellField("cellvar", std::vector<vtkm::Float32>{ 10.0f, 20.0f });
+
+  vtkm::filter::contour::ClipWithField clip;
+  clip.SetActiveField("scalars");
+  for (bool invert : { false, true })
+  {
+    clip.SetClipValue(invert ? 0.0 : 2.0);
+    clip.SetInvertClip(invert);
+    const vtkm::cont::DataSet outputData = clip.Execute(ds);
+
+    VTKM_TEST_ASSERT(outputData.GetNumberOfCells() == 0, "Clip should remove all cells");
+    VTKM_TEST_ASSERT(outputData.GetNumberOfPoints() == 0, "Clip should remove all points");
+    VTKM_TEST_ASSERT(outputData.GetNumberOfCoordinateSystems() == 1,
+                     "Wrong number of coordinate systems in the output dataset");
+    VTKM_TEST_ASSERT(outputData.GetField("scalars").GetNumberOfValues() == 0);
+    VTKM_TEST_ASSERT(outputData.GetField("cellvar").GetNumberOfValues() == 0);
+  }
+}
+
 void TestClip()
 {
   //todo: add more clip tests
   TestClipExplicit();
   TestClipVolume();
+  TestClipEverything();
 }
 }
 
@@ -10,19 +10,29 @@
 
 #include <vtkm/Math.h>
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/PartitionedDataSet.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
 #include <vtkm/filter/contour/Contour.h>
 #include <vtkm/filter/contour/ContourFlyingEdges.h>
 #include <vtkm/filter/contour/ContourMarchingCells.h>
+#include <vtkm/filter/contour/SpanSpaceIndex.h>
 #include <vtkm/filter/field_transform/GenerateIds.h>
+#include <vtkm/filter/geometry_refinement/Tetrahedralize.h>
 
 #include <vtkm/io/VTKDataSetReader.h>
 #include <vtkm/source/Tangle.h>
 
+#include <algorithm>
+#include <array>
+#include <map>
+
 namespace
 {
 
@@ -173,6 +183,307 @@ public:
     VTKM_TEST_ASSERT(result.GetNumberOfCells() == 52);
   }
 
+  template <typename ContourFilterType>
+  void TestIsolines2D() const
+  {
+    std::cout << "Testing Contour filter isolines on a 2D uniform grid" << std::endl;
+
+    const vtkm::Id2 dims(9, 7);
+    std::vector<vtkm::Float32> values(static_cast<std::size_t>(dims[0] * dims[1]));
+    std::vector<vtkm::FloatDefault> cellIds(
+      static_cast<std::size_t>((dims[0] - 1) * (dims[1] - 1)));
+    for (vtkm::Id j = 0; j < dims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < dims[0]; ++i)
+      {
+        // Two bumps that produce separate loops and saddle cells between them.
+        const vtkm::Float32 x = static_cast<vtkm::Float32>(i);
+        const vtkm::Float32 y = static_cast<vtkm::Float32>(j);
+        const vtkm::Float32 d0 = (x - 2.4f) * (x - 2.4f) + (y - 3.2f) * (y - 3.2f);
+        const vtkm::Float32 d1 = (x - 5.7f) * (x - 5.7f) + (y - 2.9f) * (y - 2.9f);
+        values[static_cast<std::size_t>(j * dims[0] + i)] = vtkm::Min(d0, d1);
+      }
+    }
+    for (std::size_t c = 0; c < cellIds.size(); ++c)
+    {
+      cellIds[c] = static_cast<vtkm::FloatDefault>(c);
+    }
+    vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims);
+    dataSet.AddPointField("pointvar", values);
+    dataSet.AddCellField("cellvar", cellIds);
+
+    const std::vector<vtkm::Float64> isoValues = { 1.7, 2.3, 5.2 };
+
+    // Every intersected edge generates one point.
+    vtkm::Id expectedPoints = 0;
+    for (vtkm::Float64 iso : isoValues)
+    {
+      auto above = [&](vtkm::Id i, vtkm::Id j) {
+        return values[static_cast<std::size_t>(j * dims[0] + i)] >= iso;
+      };
+      for (vtkm::Id j = 0; j < dims[1]; ++j)
+      {
+        for (vtkm::Id i = 0; i < dims[0]; ++i)
+        {
+          expectedPoints += (i + 1 < dims[0] && above(i, j) != above(i + 1, j)) ? 1 : 0;
+          expectedPoints += (j + 1 < dims[1] && above(i, j) != above(i, j + 1)) ? 1 : 0;
+        }
+      }
+    }
+
+    ContourFilterType filter;
+    filter.SetIsoValues(isoValues);
+    filter.SetActiveField("pointvar");
+    filter.SetGenerateNormals(true);
+    filter.SetFieldsToPass({ "pointvar", "cellvar" });
+    vtkm::cont::DataSet result = filter.Execute(dataSet);
+
+    VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expectedPoints, "Wrong number of points");
+    vtkm::cont::CellSetSingleType<> cells;
+    result.GetCellSet().AsCellSet(cells);
+    VTKM_TEST_ASSERT(cells.GetCellShape(0) == vtkm::CELL_SHAPE_LINE, "Expected line cells");
+
+    // The isolines are closed, so every point is shared by exactly two lines.
+    VTKM_TEST_ASSERT(cells.GetNumberOfCells() == expectedPoints, "Wrong number of lines");
+    std::vector<vtkm::IdComponent> uses(static_cast<std::size_t>(expectedPoints), 0);
+    auto connPortal =
+      cells.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{})
+        .ReadPortal();
+    for (vtkm::Id c = 0; c < connPortal.GetNumberOfValues(); ++c)
+    {
+      ++uses[static_cast<std::size_t>(connPortal.Get(c))];
+    }
+    for (vtkm::IdComponent count : uses)
+    {
+      VTKM_TEST_ASSERT(count == 2, "Isoline points must be shared by two lines");
+    }
+
+    // The mapped field is the iso value of the line and the lines lie in the cells they map to.
+    vtkm::cont::ArrayHandle<vtkm::Float32> mapped;
+    result.GetPointField("pointvar").GetData().AsArrayHandle(mapped);
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> mappedCellIds;
+    result.GetCellField("cellvar").GetData().AsArrayHandle(mappedCellIds);
+    auto mappedPortal = mapped.ReadPortal();
+    auto cellIdPortal = mappedCellIds.ReadPortal();
+    auto coordsPortal = result.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+    for (vtkm::Id c = 0; c < cells.GetNumberOfCells(); ++c)
+    {
+      const vtkm::Id cellId = static_cast<vtkm::Id>(cellIdPortal.Get(c));
+      const vtkm::FloatDefault ci = static_cast<vtkm::FloatDefault>(cellId % (dims[0] - 1));
+      const vtkm::FloatDefault cj = static_cast<vtkm::FloatDefault>(cellId / (dims[0] - 1));
+      const vtkm::Float32 v0 = mappedPortal.Get(connPortal.Get(2 * c));
+      VTKM_TEST_ASSERT(test_equal(v0, mappedPortal.Get(connPortal.Get(2 * c + 1))),
+                       "Line connects points of different isolines");
+      auto onIsoValue = [&](vtkm::Float64 iso) {
+        return test_equal(v0, static_cast<vtkm::Float32>(iso));
+      };
+      VTKM_TEST_ASSERT(std::any_of(isoValues.begin(), isoValues.end(), onIsoValue),
+                       "Isoline point does not lie on an iso value");
+      for (vtkm::IdComponent v = 0; v < 2; ++v)
+      {
+        const auto point = coordsPortal.Get(connPortal.Get(2 * c + v));
+        VTKM_TEST_ASSERT(point[0] >= ci && point[0] <= ci + 1 && point[1] >= cj &&
+                           point[1] <= cj + 1,
+                         "Line is not inside its cell");
+      }
+    }
+
+    // Normals follow the gradient of the field, which lies in the plane of the grid.
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+    result.GetPointField(filter.GetNormalArrayName()).GetData().AsArrayHandle(normals);
+    auto normalsPortal = normals.ReadPortal();
+    for (vtkm::Id p = 0; p < normals.GetNumberOfValues(); ++p)
+    {
+      const vtkm::Vec3f normal = normalsPortal.Get(p);
+      VTKM_TEST_ASSERT(test_equal(vtkm::Magnitude(normal), 1) && test_equal(normal[2], 0),
+                       "Wrong isoline normal");
+    }
+  }
+
+  // Describe each triangle by its input cell and the interpolation state of its
+  // points, which does not depend on the order of the output.
+  static std::vector<std::vector<vtkm::Float64>> TriangleRecords(
+    const vtkm::cont::DataSet& result)
+  {
+    vtkm::cont::CellSetSingleType<> cells;
+    result.GetCellSet().AsCellSet(cells);
+    vtkm::cont::ArrayHandle<vtkm::Id2> edgeIds;
+    result.GetPointField("edgeIds").GetData().AsArrayHandle(edgeIds);
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> cellvar;
+    result.GetCellField("cellvar").GetData().AsArrayHandle(cellvar);
+    vtkm::cont::ArrayHandle<vtkm::Float32> tangle;
+    result.GetPointField("tangle").GetData().AsArrayHandle(tangle);
+
+    auto conn =
+      cells.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{})
+        .ReadPortal();
+    auto edgePortal = edgeIds.ReadPortal();
+    auto cellPortal = cellvar.ReadPortal();
+    auto tanglePortal = tangle.ReadPortal();
+    std::vector<std::vector<vtkm::Float64>> records;
+    for (vtkm::Id c = 0; c < cells.GetNumberOfCells(); ++c)
+    {
+      std::vector<std::array<vtkm::Float64, 3>> points;
+      for (vtkm::IdComponent v = 0; v < 3; ++v)
+      {
+        const vtkm::Id p = conn.Get(3 * c + v);
+        const vtkm::Id2 edge = edgePortal.Get(p);
+        points.push_back({ static_cast<vtkm::Float64>(edge[0]),
+                           static_cast<vtkm::Float64>(edge[1]),
+                           static_cast<vtkm::Float64>(tanglePortal.Get(p)) });
+      }
+      std::sort(points.begin(), points.end());
+      std::vector<vtkm::Float64> record = { static_cast<vtkm::Float64>(cellPortal.Get(c)) };
+      for (const auto& point : points)
+      {
+        record.insert(record.end(), point.begin(), point.end());
+      }
+      records.push_back(record);
+    }
+    std::sort(records.begin(), records.end());
+    return records;
+  }
+
+  // Map the interpolation state of each point, which does not depend on the order of the
+  // output, to its normal.
+  static std::map<std::array<vtkm::Float64, 3>, vtkm::Vec3f> PointNormals(
+    const vtkm::cont::DataSet& result,
+    const std::string& normalsName)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id2> edgeIds;
+    result.GetPointField("edgeIds").GetData().AsArrayHandle(edgeIds);
+    vtkm::cont::ArrayHandle<vtkm::Float32> tangle;
+    result.GetPointField("tangle").GetData().AsArrayHandle(tangle);
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+    result.GetPointField(normalsName).GetData().AsArrayHandle(normals);
+
+    auto edgePortal = edgeIds.ReadPortal();
+    auto tanglePortal = tangle.ReadPortal();
+    auto normalsPortal = normals.ReadPortal();
+    std::map<std::array<vtkm::Float64, 3>, vtkm::Vec3f> pointNormals;
+    for (vtkm::Id p = 0; p < normals.GetNumberOfValues(); ++p)
+    {
+      const vtkm::Id2 edge = edgePortal.Get(p);
+      pointNormals[{ static_cast<vtkm::Float64>(edge[0]),
+                     static_cast<vtkm::Float64>(edge[1]),
+                     static_cast<vtkm::Float64>(tanglePortal.Get(p)) }] = normalsPortal.Get(p);
+    }
+    return pointNormals;
+  }
+
+  void TestFlyingEdgesSlabs() const
+  {
+    std::cout << "Testing Contour flying edges in slabs" << std::endl;
+
+    vtkm::source::Tangle tangle;
+    tangle.SetCellDimensions({ 12, 10, 15 });
+    vtkm::filter::field_transform::GenerateIds genIds;
+    genIds.SetUseFloat(true);
+    genIds.SetGeneratePointIds(false);
+    genIds.SetCellFieldName("cellvar");
+    vtkm::cont::DataSet dataSet = genIds.Execute(tangle.Execute());
+
+    vtkm::filter::contour::ContourFlyingEdges filter;
+    filter.SetIsoValues({ 0.2, 0.5 });
+    filter.SetActiveField("tangle");
+    filter.SetAddInterpolationEdgeIds(true);
+    filter.SetFieldsToPass({ "tangle", "cellvar" });
+    vtkm::cont::DataSet reference = filter.Execute(dataSet);
+    const auto referenceRecords = TriangleRecords(reference);
+    VTKM_TEST_ASSERT(!referenceRecords.empty(), "Expected a non-empty contour");
+    const auto referenceNormals = PointNormals(reference, filter.GetNormalArrayName());
+
+    for (vtkm::Id slabSize : { 2, 3, 5, 15 })
+    {
+      filter.SetSlabSize(slabSize);
+      vtkm::cont::DataSet result = filter.Execute(dataSet);
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() == reference.GetNumberOfPoints(),
+                       "Slabs should not duplicate points");
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == reference.GetNumberOfCells(),
+                       "Wrong number of triangles from slabs");
+      VTKM_TEST_ASSERT(TriangleRecords(result) == referenceRecords,
+                       "Slabs generate different triangles");
+
+      const auto normals = PointNormals(result, filter.GetNormalArrayName());
+      VTKM_TEST_ASSERT(normals.size() == referenceNormals.size(), "Wrong number of normals");
+      for (const auto& normal : normals)
+      {
+        auto match = referenceNormals.find(normal.first);
+        VTKM_TEST_ASSERT(match != referenceNormals.end(), "Slab point missing from reference");
+        VTKM_TEST_ASSERT(test_equal(normal.second, match->second),
+                         "Slab normal differs from the normal of the whole volume");
+      }
+    }
+  }
+
+  void TestFlyingEdgesByIsoValue() const
+  {
+    std::cout << "Testing Contour flying edges with one partition per iso value" << std::endl;
+
+    vtkm::source::Tangle tangle;
+    tangle.SetCellDimensions({ 12, 10, 15 });
+    vtkm::filter::field_transform::GenerateIds genIds;
+    genIds.SetUseFloat(true);
+    genIds.SetGeneratePointIds(false);
+    genIds.SetCellFieldName("cellvar");
+    vtkm::cont::DataSet dataSet = genIds.Execute(tangle.Execute());
+
+    // More iso values than are classified in one pass, and one that crosses nothing.
+    const std::vector<vtkm::Float64> isoValues = { 0.1, 0.2, 0.3, 0.4, 0.5,  0.6,
+                                                   0.7, 0.8, 0.9, 1.0, 100.0 };
+    vtkm::filter::contour::ContourFlyingEdges filter;
+    filter.SetIsoValues(isoValues);
+    filter.SetActiveField("tangle");
+    filter.SetFieldsToPass({ "tangle", "cellvar" });
+    vtkm::cont::PartitionedDataSet partitions = filter.ExecuteByIsoValue(dataSet);
+    VTKM_TEST_ASSERT(partitions.GetNumberOfPartitions() ==
+                       static_cast<vtkm::Id>(isoValues.size()),
+                     "Expected one partition per iso value");
+
+    vtkm::Id numPoints = 0;
+    for (std::size_t i = 0; i < isoValues.size(); ++i)
+    {
+      filter.SetIsoValues({ isoValues[i] });
+      vtkm::cont::DataSet expected = filter.Execute(dataSet);
+      const vtkm::cont::DataSet& partition = partitions.GetPartition(static_cast<vtkm::Id>(i));
+      VTKM_TEST_ASSERT(partition.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                       "Wrong number of points for iso value ",
+                       isoValues[i]);
+      VTKM_TEST_ASSERT(partition.GetNumberOfCells() == expected.GetNumberOfCells(),
+                       "Wrong number of cells for iso value ",
+                       isoValues[i]);
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(partition.GetCoordinateSystem().GetData(),
+                                               expected.GetCoordinateSystem().GetData()),
+                       "Wrong points for iso value ",
+                       isoValues[i]);
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+                         partition.GetCellSet()
+                           .AsCellSet<vtkm::cont::CellSetSingleType<>>()
+                           .GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                 vtkm::TopologyElementTagPoint{}),
+                         expected.GetCellSet()
+                           .AsCellSet<vtkm::cont::CellSetSingleType<>>()
+                           .GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                 vtkm::TopologyElementTagPoint{})),
+                       "Wrong connectivity for iso value ",
+                       isoValues[i]);
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(partition.GetCellField("cellvar").GetData(),
+                                               expected.GetCellField("cellvar").GetData()),
+                       "Wrong cell field for iso value ",
+                       isoValues[i]);
+      numPoints += expected.GetNumberOfPoints();
+    }
+    VTKM_TEST_ASSERT(partitions.GetPartition(0).GetNumberOfPoints() > 0,
+                     "Expected a non-empty contour");
+    VTKM_TEST_ASSERT(partitions.GetPartition(static_cast<vtkm::Id>(isoValues.size() - 1))
+                         .GetNumberOfPoints() == 0,
+                     "Expected an empty contour");
+
+    filter.SetIsoValues(isoValues);
+    VTKM_TEST_ASSERT(filter.Execute(dataSet).GetNumberOfPoints() == numPoints,
+                     "Merged contours should hold the points of all iso values");
+  }
+
   void TestUnsupportedFlyingEdges() const
   {
     vtkm::cont::testing::MakeTestDataSet maker;
@@ -245,6 +556,188 @@ public:
                      "Wrong number of cells in rectilinear contour");
   }
 
+  void TestSpanSpaceIndex() const
+  {
+    std::cout << "Testing Contour filter with a span space index" << std::endl;
+
+    vtkm::source::Tangle tangle;
+    tangle.SetCellDimensions({ 8, 8, 8 });
+    vtkm::filter::field_transform::GenerateIds genIds;
+    genIds.SetGeneratePointIds(false);
+    genIds.SetCellFieldName("cellvar");
+    vtkm::filter::geometry_refinement::Tetrahedralize tetrahedralize;
+    vtkm::cont::DataSet dataSet = tetrahedralize.Execute(genIds.Execute(tangle.Execute()));
+
+    vtkm::filter::contour::SpanSpaceIndex index;
+    index.Build(dataSet, "tangle");
+    VTKM_TEST_ASSERT(index.IsBuilt());
+    VTKM_TEST_ASSERT(index.GetNumberOfCells() == dataSet.GetNumberOfCells());
+
+    // The candidates must be exactly the cells whose range contains the iso value.
+    vtkm::cont::ArrayHandle<vtkm::Float64> field;
+    vtkm::cont::ArrayCopyShallowIfPossible(dataSet.GetPointField("tangle").GetData(), field);
+    auto fieldPortal = field.ReadPortal();
+    vtkm::cont::CellSetSingleType<> cells;
+    dataSet.GetCellSet().AsCellSet(cells);
+    const vtkm::Float64 isoValue = 0.5;
+    std::vector<vtkm::Id> expected;
+    for (vtkm::Id cellId = 0; cellId < cells.GetNumberOfCells(); ++cellId)
+    {
+      vtkm::Id pointIds[4];
+      cells.GetCellPointIds(cellId, pointIds);
+      vtkm::Float64 low = vtkm::Infinity64();
+      vtkm::Float64 high = vtkm::NegativeInfinity64();
+      for (vtkm::Id pointId : pointIds)
+      {
+        low = vtkm::Min(low, fieldPortal.Get(pointId));
+        high = vtkm::Max(high, fieldPortal.Get(pointId));
+      }
+      if (low <= isoValue && high > isoValue)
+      {
+        expected.push_back(cellId);
+      }
+    }
+    auto candidates = index.FindCandidateCells(isoValue);
+    vtkm::cont::Algorithm::Sort(candidates);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+                       candidates, vtkm::cont::make_ArrayHandle(expected, vtkm::CopyFlag::On)),
+                     "Wrong candidate cells");
+    VTKM_TEST_ASSERT(candidates.GetNumberOfValues() < dataSet.GetNumberOfCells());
+
+    // Contours computed with the index must match contours computed without it.
+    std::vector<std::vector<vtkm::Float64>> isoValueSets = {
+      { 0.5 }, { -100.0 }, { 100.0 }, { 0.1, 0.5, 1.2 }, { 0.5, 0.5 }
+    };
+    for (const auto& isoValues : isoValueSets)
+    {
+      vtkm::filter::contour::ContourMarchingCells filter;
+      filter.SetActiveField("tangle");
+      filter.SetIsoValues(isoValues);
+      filter.SetGenerateNormals(true);
+      filter.SetFieldsToPass("cellvar");
+      vtkm::cont::DataSet reference = filter.Execute(dataSet);
+
+      filter.SetSpanSpaceIndex(index);
+      vtkm::cont::DataSet indexed = filter.Execute(dataSet);
+
+      VTKM_TEST_ASSERT(indexed.GetNumberOfCells() == reference.GetNumberOfCells());
+      VTKM_TEST_ASSERT(indexed.GetNumberOfPoints() == reference.GetNumberOfPoints());
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(indexed.GetCoordinateSystem().GetData(),
+                                               reference.GetCoordinateSystem().GetData()));
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(indexed.GetField("cellvar").GetData(),
+                                               reference.GetField("cellvar").GetData()));
+    }
+
+    // An index built for another field must be rejected.
+    vtkm::filter::contour::ContourMarchingCells filter;
+    filter.SetActiveField("tangle");
+    filter.SetIsoValue(0.5);
+    vtkm::filter::contour::SpanSpaceIndex otherIndex;
+    otherIndex.Build(tangle.Execute(), "tangle");
+    filter.SetSpanSpaceIndex(otherIndex);
+    try
+    {
+      filter.Execute(dataSet);
+      VTKM_TEST_FAIL("Contour should not use an index built for another mesh");
+    }
+    catch (vtkm::cont::ErrorFilterExecution&)
+    {
+      std::cout << "Execution successfully aborted" << std::endl;
+    }
+  }
+
+  template <typename ContourFilterType>
+  void TestPartitionCulling() const
+  {
+    std::cout << "Testing Contour filter on partitions outside the iso value" << std::endl;
+
+    vtkm::source::Tangle tangle;
+    tangle.SetCellDimensions({ 8, 8, 8 });
+    vtkm::filter::field_transform::GenerateIds genIds;
+    genIds.SetGeneratePointIds(false);
+    genIds.SetCellFieldName("cellvar");
+    vtkm::cont::DataSet inside = genIds.Execute(tangle.Execute());
+
+    // Copy of the data with the field shifted so that it does not contain the iso value.
+    vtkm::cont::DataSet outside = inside;
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> shifted;
+    vtkm::cont::ArrayCopy(inside.GetPointField("tangle").GetData(), shifted);
+    vtkm::cont::Algorithm::Transform(shifted,
+                                     vtkm::cont::make_ArrayHandleConstant<vtkm::FloatDefault>(
+                                       100, shifted.GetNumberOfValues()),
+                                     shifted,
+                                     vtkm::Sum{});
+    outside.AddPointField("tangle", shifted);
+
+    vtkm::cont::PartitionedDataSet input({ inside, outside });
+
+    ContourFilterType filter;
+    filter.SetActiveField("tangle");
+    filter.SetIsoValue(0.5);
+    filter.SetGenerateNormals(true);
+    filter.SetAddInterpolationEdgeIds(true);
+    filter.SetFieldsToPass({ "tangle", "cellvar" });
+    vtkm::cont::PartitionedDataSet output = filter.Execute(input);
+
+    VTKM_TEST_ASSERT(output.GetNumberOfPartitions() == 2);
+    const vtkm::cont::DataSet& crossed = output.GetPartition(0);
+    const vtkm::cont::DataSet& culled = output.GetPartition(1);
+    VTKM_TEST_ASSERT(crossed.GetNumberOfCells() > 0);
+    VTKM_TEST_ASSERT(culled.GetNumberOfCells() == 0);
+    VTKM_TEST_ASSERT(culled.GetNumberOfPoints() == 0);
+    VTKM_TEST_ASSERT(culled.GetNumberOfFields() == crossed.GetNumberOfFields());
+    for (vtkm::IdComponent i = 0; i < crossed.GetNumberOfFields(); ++i)
+    {
+      const vtkm::cont::Field& field = crossed.GetField(i);
+      VTKM_TEST_ASSERT(culled.HasField(field.GetName(), field.GetAssociation()));
+      VTKM_TEST_ASSERT(culled.GetField(field.GetName()).GetNumberOfValues() == 0);
+    }
+  }
+
+  // Checks the range culling against the way each algorithm classifies a point whose value
+  // equals the iso value: marching cells counts it as below, flying edges as above.
+  template <typename ContourFilterType>
+  void TestIsoValueAtRangeEnds(vtkm::IdComponent dimension, bool equalValuesAreAbove) const
+  {
+    std::cout << "Testing Contour filter with iso values at the ends of the field range ("
+              << dimension << "D)" << std::endl;
+
+    // A single point with value 1 in the middle of a block of zeros.
+    const vtkm::Id3 pointDims = (dimension == 2) ? vtkm::Id3(3, 3, 1) : vtkm::Id3(3, 3, 3);
+    vtkm::cont::DataSet dataSet = (dimension == 2)
+      ? vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id2(3, 3))
+      : vtkm::cont::DataSetBuilderUniform::Create(pointDims);
+    std::vector<vtkm::FloatDefault> values(
+      static_cast<std::size_t>(pointDims[0] * pointDims[1] * pointDims[2]), 0);
+    values[values.size() / 2] = 1;
+    dataSet.AddPointField("pointvar", values);
+
+    // The gradient vanishes at the peak, which has no normal.
+    ContourFilterType filter;
+    filter.SetActiveField("pointvar");
+    filter.SetGenerateNormals(false);
+
+    filter.SetIsoValue(1);
+    vtkm::Id atMax = filter.Execute(dataSet).GetNumberOfCells();
+    filter.SetIsoValue(0);
+    vtkm::Id atMin = filter.Execute(dataSet).GetNumberOfCells();
+    if (equalValuesAreAbove)
+    {
+      VTKM_TEST_ASSERT(atMax > 0, "Iso value at the range maximum should produce a contour");
+      VTKM_TEST_ASSERT(atMin == 0, "Iso value at the range minimum should be culled");
+    }
+    else
+    {
+      VTKM_TEST_ASSERT(atMax == 0, "Iso value at the range maximum should be culled");
+      VTKM_TEST_ASSERT(atMin > 0, "Iso value at the range minimum should produce a contour");
+    }
+
+    filter.SetIsoValue(vtkm::Nan64());
+    vtkm::cont::DataSet nanResult = filter.Execute(dataSet);
+    VTKM_TEST_ASSERT(nanResult.GetNumberOfCells() == 0, "NaN iso value should be culled");
+    VTKM_TEST_ASSERT(nanResult.GetNumberOfPoints() == 0, "NaN iso value should be culled");
+  }
+
   void operator()() const
   {
     this->TestContourUniformGrid<vtkm::filter::contour::Contour>(72);
@@ -264,7 +757,23 @@ public:
     this->TestNonUniformStructured<vtkm::filter::contour::ContourFlyingEdges>();
     this->TestNonUniformStructured<vtkm::filter::contour::ContourMarchingCells>();
 
+    this->TestIsolines2D<vtkm::filter::contour::Contour>();
+    this->TestIsolines2D<vtkm::filter::contour::ContourFlyingEdges>();
+
+    this->TestFlyingEdgesSlabs();
+    this->TestFlyingEdgesByIsoValue();
+
     this->TestUnsupportedFlyingEdges();
+
+    this->TestSpanSpaceIndex();
+
+    this->TestPartitionCulling<vtkm::filter::contour::Contour>();
+    this->TestPartitionCulling<vtkm::filter::contour::ContourMarchingCells>();
+
+    this->TestIsoValueAtRangeEnds<vtkm::filter::contour::ContourMarchingCells>(3, false);
+    this->TestIsoValueAtRangeEnds<vtkm::filter::contour::ContourFlyingEdges>(3, true);
+    this->TestIsoValueAtRangeEnds<vtkm::filter::contour::ContourFlyingEdges>(2, true);
+    this->TestIsoValueAtRangeEnds<vtkm::filter::contour::Contour>(2, true);
   }
 
 }; // class TestContourFilter
@@ -0,0 +1,188 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/filter/contour/Slice.h>
+
+#include <vector>
+
+namespace
+{
+
+using AxisValues = std::vector<vtkm::FloatDefault>;
+
+vtkm::Float64 LinearField(const vtkm::Vec3f& point)
+{
+  return point[0] + 2 * point[1] + 3 * point[2];
+}
+
+void AddFields(vtkm::cont::DataSet& dataSet, const AxisValues axes[3])
+{
+  std::vector<vtkm::Float64> pointValues;
+  for (vtkm::FloatDefault z : axes[2])
+  {
+    for (vtkm::FloatDefault y : axes[1])
+    {
+      for (vtkm::FloatDefault x : axes[0])
+      {
+        pointValues.push_back(LinearField({ x, y, z }));
+      }
+    }
+  }
+  dataSet.AddPointField("linear", pointValues);
+
+  std::vector<vtkm::FloatDefault> cellValues(static_cast<std::size_t>(dataSet.GetNumberOfCells()));
+  for (std::size_t i = 0; i < cellValues.size(); ++i)
+  {
+    cellValues[i] = static_cast<vtkm::FloatDefault>(i);
+  }
+  dataSet.AddCellField("cellvar", cellValues);
+}
+
+void CheckAxisAlignedSlice(const vtkm::cont::DataSet& dataSet,
+                           const AxisValues axes[3],
+                           const vtkm::Plane& plane,
+                           vtkm::Float64 isoValue,
+                           vtkm::IdComponent axis)
+{
+  vtkm::filter::contour::Slice slice;
+  slice.SetImplicitFunction(plane);
+  slice.SetIsoValue(isoValue);
+  slice.SetFieldsToPass({ "linear", "cellvar" });
+  vtkm::cont::DataSet result = slice.Execute(dataSet);
+
+  const vtkm::FloatDefault position = plane.GetOrigin()[axis] +
+    static_cast<vtkm::FloatDefault>(isoValue) / plane.GetNormal()[axis];
+  const vtkm::IdComponent u = (axis == 0) ? 1 : 0;
+  const vtkm::IdComponent v = (axis == 2) ? 1 : 2;
+  const vtkm::Id du = static_cast<vtkm::Id>(axes[u].size());
+  const vtkm::Id dv = static_cast<vtkm::Id>(axes[v].size());
+
+  VTKM_TEST_ASSERT(result.GetCellSet().IsType<vtkm::cont::CellSetStructured<2>>(),
+                   "Axis-aligned slice should be structured");
+  auto cells = result.GetCellSet().AsCellSet<vtkm::cont::CellSetStructured<2>>();
+  VTKM_TEST_ASSERT(cells.GetPointDimensions() == vtkm::Id2(du, dv), "Wrong slice dimensions");
+  VTKM_TEST_ASSERT(result.GetNumberOfPoints() == du * dv, "Wrong number of points");
+
+  auto coords = result.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  vtkm::cont::ArrayHandle<vtkm::Float64> linear;
+  result.GetPointField("linear").GetData().AsArrayHandle(linear);
+  auto linearPortal = linear.ReadPortal();
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+  result.GetPointField(slice.GetNormalArrayName()).GetData().AsArrayHandle(normals);
+  auto normalsPortal = normals.ReadPortal();
+  for (vtkm::Id p = 0; p < result.GetNumberOfPoints(); ++p)
+  {
+    const vtkm::Vec3f point = coords.Get(p);
+    VTKM_TEST_ASSERT(test_equal(point[axis], position), "Point is not on the slice");
+    VTKM_TEST_ASSERT(test_equal(point[u], axes[u][static_cast<std::size_t>(p % du)]) &&
+                       test_equal(point[v], axes[v][static_cast<std::size_t>(p / du)]),
+                     "Wrong slice point");
+    VTKM_TEST_ASSERT(test_equal(linearPortal.Get(p), LinearField(point)),
+                     "Wrong interpolated point field");
+    VTKM_TEST_ASSERT(test_equal(normalsPortal.Get(p), vtkm::Normal(plane.GetNormal())),
+                     "Wrong slice normal");
+  }
+
+  // Each slice cell must come from an input cell that contains it.
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> cellvar;
+  result.GetCellField("cellvar").GetData().AsArrayHandle(cellvar);
+  auto cellvarPortal = cellvar.ReadPortal();
+  const vtkm::Id3 cellDims(static_cast<vtkm::Id>(axes[0].size()) - 1,
+                           static_cast<vtkm::Id>(axes[1].size()) - 1,
+                           static_cast<vtkm::Id>(axes[2].size()) - 1);
+  for (vtkm::Id c = 0; c < result.GetNumberOfCells(); ++c)
+  {
+    const vtkm::Id p0 = (c % (du - 1)) + du * (c / (du - 1));
+    const vtkm::Vec3f center = (coords.Get(p0) + coords.Get(p0 + du + 1)) * 0.5f;
+    const vtkm::Id inputCell = static_cast<vtkm::Id>(cellvarPortal.Get(c));
+    const vtkm::Id3 ijk(inputCell % cellDims[0],
+                        (inputCell / cellDims[0]) % cellDims[1],
+                        inputCell / (cellDims[0] * cellDims[1]));
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      const std::size_t index = static_cast<std::size_t>(ijk[d]);
+      VTKM_TEST_ASSERT(center[d] >= axes[d][index] - 1e-5f &&
+                         center[d] <= axes[d][index + 1] + 1e-5f,
+                       "Slice cell is not inside its input cell");
+    }
+  }
+}
+
+void TestAxisAlignedSlices(const vtkm::cont::DataSet& dataSet, const AxisValues axes[3])
+{
+  CheckAxisAlignedSlice(dataSet, axes, vtkm::Plane({ 0.8f, 0, 0 }, { 1, 0, 0 }), 0.0, 0);
+  CheckAxisAlignedSlice(dataSet, axes, vtkm::Plane({ 0, 1.5f, 0 }, { 0, -2, 0 }), 0.0, 1);
+  CheckAxisAlignedSlice(dataSet, axes, vtkm::Plane({ 0, 0, 0 }, { 0, 0, 1 }), 3.0, 2);
+  // Slices through the first and last plane of points.
+  CheckAxisAlignedSlice(dataSet, axes, vtkm::Plane({ axes[0].front(), 0, 0 }, { 1, 0, 0 }), 0.0, 0);
+  CheckAxisAlignedSlice(dataSet, axes, vtkm::Plane({ 0, 0, axes[2].back() }, { 0, 0, 1 }), 0.0, 2);
+
+  // Other planes go through the general contour path.
+  vtkm::filter::contour::Slice slice;
+  slice.SetImplicitFunction(vtkm::Plane({ 1, 1, 1 }, { 1, 1, 0 }));
+  vtkm::cont::DataSet result = slice.Execute(dataSet);
+  VTKM_TEST_ASSERT(result.GetCellSet().IsType<vtkm::cont::CellSetSingleType<>>(),
+                   "Oblique slice should be triangles");
+  VTKM_TEST_ASSERT(result.GetNumberOfCells() > 0, "Oblique slice should not be empty");
+
+  // An axis-aligned plane that misses the mesh produces no cells.
+  slice.SetImplicitFunction(vtkm::Plane({ 0, 0, 100 }, { 0, 0, 1 }));
+  result = slice.Execute(dataSet);
+  VTKM_TEST_ASSERT(result.GetNumberOfCells() == 0, "Slice outside the mesh should be empty");
+}
+
+void TestSliceUniform()
+{
+  std::cout << "Testing axis-aligned slices of a uniform grid" << std::endl;
+  const vtkm::Id3 dims(5, 4, 6);
+  const vtkm::Vec3f origin(-0.5f, 0.0f, 1.0f);
+  const vtkm::Vec3f spacing(0.5f, 1.0f, 2.0f);
+  AxisValues axes[3];
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    for (vtkm::Id i = 0; i < dims[d]; ++i)
+    {
+      axes[d].push_back(origin[d] + static_cast<vtkm::FloatDefault>(i) * spacing[d]);
+    }
+  }
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims, origin, spacing);
+  AddFields(dataSet, axes);
+  TestAxisAlignedSlices(dataSet, axes);
+}
+
+void TestSliceRectilinear()
+{
+  std::cout << "Testing axis-aligned slices of a rectilinear grid" << std::endl;
+  AxisValues axes[3] = { { -0.5f, 0.1f, 0.7f, 2.0f },
+                         { 0.0f, 0.25f, 1.0f, 1.75f, 3.0f },
+                         { 1.0f, 1.5f, 3.5f, 4.0f, 9.0f, 11.0f } };
+  vtkm::cont::DataSet dataSet =
+    vtkm::cont::DataSetBuilderRectilinear::Create(axes[0], axes[1], axes[2]);
+  AddFields(dataSet, axes);
+  TestAxisAlignedSlices(dataSet, axes);
+}
+
+void TestSliceFilter()
+{
+  TestSliceUniform();
+  TestSliceRectilinear();
+}
+
+} // anonymous namespace
+
+int UnitTestSliceFilter(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestSliceFilter, argc, argv);
+}
@@ -125,7 +125,8 @@ void TestSliceMultipleFilter()
                    "wrong pointV3 values");
   VTKM_TEST_ASSERT(test_equal_ArrayHandles(CheckingV4, result.GetField("pointV4").GetData()),
                    "wrong pointV4 values");
-  VTKM_TEST_ASSERT(result.GetNumberOfCells() == 24, "wrong number of cells in merged data set");
+  // The planes are axis-aligned, so each slice is a structured grid of 4 quads.
+  VTKM_TEST_ASSERT(result.GetNumberOfCells() == 12, "wrong number of cells in merged data set");
 }
 } // anonymous namespace
 int UnitTestSliceMultipleFilter(int argc, char* argv[])
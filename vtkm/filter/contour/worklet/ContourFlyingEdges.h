@@ -16,6 +16,8 @@
 #include <vtkm/filter/contour/worklet/contour/CommonState.h>
 #include <vtkm/filter/contour/worklet/contour/FieldPropagation.h>
 #include <vtkm/filter/contour/worklet/contour/FlyingEdges.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdges2D.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdgesSlabs.h>
 
 namespace vtkm
 {
@@ -24,6 +26,8 @@ namespace worklet
 
 /// \brief Compute the isosurface of a given \c CellSetStructured<3> input with
 /// \c ArrayHandleUniformPointCoordinates for point coordinates using the Flying Edges algorithm.
+///
+/// \c CellSetStructured<2> inputs produce isolines made of line cells.
 class ContourFlyingEdges
 {
 public:
@@ -48,6 +52,28 @@ public:
   //----------------------------------------------------------------------------
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->SharedState.CellIdMap; }
 
+  //----------------------------------------------------------------------------
+  /// Offsets of the first output point of each iso value, followed by the number of points.
+  const std::vector<vtkm::Id>& GetIsoValuePointOffsets() const
+  {
+    return this->SharedState.IsoValuePointOffsets;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Offsets of the first output cell of each iso value, followed by the number of cells.
+  const std::vector<vtkm::Id>& GetIsoValueCellOffsets() const
+  {
+    return this->SharedState.IsoValueCellOffsets;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Process 3D volumes with uniform coordinates in slabs of at most this many planes of
+  /// points along Z. A value of 0 processes the whole volume at once.
+  void SetSlabSize(vtkm::Id numPlanes) { this->SlabSize = numPlanes; }
+
+  //----------------------------------------------------------------------------
+  vtkm::Id GetSlabSize() const { return this->SlabSize; }
+
   //----------------------------------------------------------------------------
   template <typename InArrayType, typename OutArrayType>
   void ProcessPointField(const InArrayType& input, const OutArrayType& output) const
@@ -66,7 +92,8 @@ public:
   void ReleaseCellMapArrays() { this->SharedState.CellIdMap.ReleaseResources(); }
 
   // Filter called without normals generation
-  template <typename IVType,
+  template <vtkm::IdComponent Dimension,
+            typename IVType,
             typename ValueType,
             typename CoordsType,
             typename StorageTagField,
@@ -74,7 +101,7 @@ public:
             typename StorageTagVertices>
   vtkm::cont::CellSetSingleType<> Run(
     const std::vector<IVType>& isovalues,
-    const vtkm::cont::CellSetStructured<3>& cells,
+    const vtkm::cont::CellSetStructured<Dimension>& cells,
     const CoordsType& coordinateSystem,
     const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& input,
     vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& vertices)
@@ -82,13 +109,12 @@ public:
     this->SharedState.GenerateNormals = false;
     vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>> normals;
 
-    vtkm::cont::CellSetSingleType<> outputCells;
-    return flying_edges::execute(
-      cells, coordinateSystem, isovalues, input, vertices, normals, this->SharedState);
+    return this->Execute(cells, coordinateSystem, isovalues, input, vertices, normals);
   }
 
   // Filter called with normals generation
-  template <typename IVType,
+  template <vtkm::IdComponent Dimension,
+            typename IVType,
             typename ValueType,
             typename CoordsType,
             typename StorageTagField,
@@ -97,20 +123,69 @@ public:
             typename StorageTagNormals>
   vtkm::cont::CellSetSingleType<> Run(
     const std::vector<IVType>& isovalues,
-    const vtkm::cont::CellSetStructured<3>& cells,
+    const vtkm::cont::CellSetStructured<Dimension>& cells,
     const CoordsType& coordinateSystem,
     const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& input,
     vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& vertices,
     vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagNormals>& normals)
   {
     this->SharedState.GenerateNormals = true;
-    vtkm::cont::CellSetSingleType<> outputCells;
+    return this->Execute(cells, coordinateSystem, isovalues, input, vertices, normals);
+  }
+
+private:
+  template <typename IVType,
+            typename ValueType,
+            typename CoordsType,
+            typename StorageTagField,
+            typename VerticesType,
+            typename NormalsType>
+  vtkm::cont::CellSetSingleType<> Execute(
+    const vtkm::cont::CellSetStructured<2>& cells,
+    const CoordsType& coordinateSystem,
+    const std::vector<IVType>& isovalues,
+    const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& input,
+    VerticesType& vertices,
+    NormalsType& normals)
+  {
+    return flying_edges::execute(
+      cells, coordinateSystem, isovalues, input, vertices, normals, this->SharedState);
+  }
+
+  template <typename IVType,
+            typename ValueType,
+            typename CoordsType,
+            typename StorageTagField,
+            typename VerticesType,
+            typename NormalsType>
+  vtkm::cont::CellSetSingleType<> Execute(
+    const vtkm::cont::CellSetStructured<3>& cells,
+    const CoordsType& coordinateSystem,
+    const std::vector<IVType>& isovalues,
+    const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& input,
+    VerticesType& vertices,
+    NormalsType& normals)
+  {
+    // Slabs need uniform coordinates, which can be split without copying any points.
+    if (this->SlabSize > 0 && this->SlabSize < cells.GetPointDimensions()[2] &&
+        coordinateSystem.GetData()
+          .template IsType<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+    {
+      return flying_edges::execute_slabs(cells,
+                                         coordinateSystem,
+                                         isovalues,
+                                         input,
+                                         this->SlabSize,
+                                         vertices,
+                                         normals,
+                                         this->SharedState);
+    }
     return flying_edges::execute(
       cells, coordinateSystem, isovalues, input, vertices, normals, this->SharedState);
   }
 
-private:
   vtkm::worklet::contour::CommonState SharedState;
+  vtkm::Id SlabSize = 0;
 };
 }
 } // namespace vtkm::worklet
@@ -103,6 +103,22 @@ public:
   //----------------------------------------------------------------------------
   bool GetMergeDuplicatePoints() const { return this->SharedState.MergeDuplicatePoints; }
 
+  //----------------------------------------------------------------------------
+  /// Restrict the classification to the given cells. The other cells must not be
+  /// crossed by any of the contours; use `ClearCandidateCells` to visit all cells.
+  void SetCandidateCells(const vtkm::cont::ArrayHandle<vtkm::Id>& cellIds)
+  {
+    this->SharedState.UseCandidateCells = true;
+    this->SharedState.CandidateCellIds = cellIds;
+  }
+
+  //----------------------------------------------------------------------------
+  void ClearCandidateCells()
+  {
+    this->SharedState.UseCandidateCells = false;
+    this->SharedState.CandidateCellIds = vtkm::cont::ArrayHandle<vtkm::Id>{};
+  }
+
   //----------------------------------------------------------------------------
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->SharedState.CellIdMap; }
 
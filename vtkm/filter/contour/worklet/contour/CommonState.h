@@ -14,6 +14,8 @@
 
 #include <vtkm/cont/ArrayHandle.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace worklet
@@ -33,6 +35,13 @@ struct CommonState
   vtkm::cont::ArrayHandle<vtkm::FloatDefault> InterpolationWeights;
   vtkm::cont::ArrayHandle<vtkm::Id2> InterpolationEdgeIds;
   vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
+  // When set, only these cells are classified; all others are assumed to produce nothing.
+  bool UseCandidateCells = false;
+  vtkm::cont::ArrayHandle<vtkm::Id> CandidateCellIds;
+  // Offsets of the first output point and cell of each iso value, followed by the
+  // total numbers of points and cells. Only filled by the flying edges algorithm.
+  std::vector<vtkm::Id> IsoValuePointOffsets;
+  std::vector<vtkm::Id> IsoValueCellOffsets;
 };
 }
 }
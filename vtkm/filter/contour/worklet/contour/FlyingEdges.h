@@ -19,6 +19,7 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandleGroupVec.h>
+#include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/Invoker.h>
 
 namespace vtkm
@@ -59,16 +60,25 @@ vtkm::cont::CellSetSingleType<> execute(
 {
   vtkm::cont::Invoker invoke;
   auto pdims = cells.GetPointDimensions();
+  const vtkm::Id numPoints = coordinateSystem.GetData().GetNumberOfValues();
 
+  // Pass 1 classifies the edges against a group of iso values at once, keeping one
+  // byte per point for each iso value of the group.
+  const std::size_t groupSize =
+    vtkm::Min(isovalues.size(), static_cast<std::size_t>(MaxFusedIsoValues));
   vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases;
-  edgeCases.Allocate(coordinateSystem.GetData().GetNumberOfValues());
+  edgeCases.Allocate(static_cast<vtkm::Id>(groupSize) * numPoints);
 
   vtkm::cont::CellSetStructured<2> metaDataMesh2D;
+  vtkm::cont::ArrayHandle<vtkm::Id> groupLinearSums; //per point of metaDataMesh and iso value
+  vtkm::cont::ArrayHandle<vtkm::Id> groupMin;        //per point of metaDataMesh and iso value
+  vtkm::cont::ArrayHandle<vtkm::Id> groupMax;        //per point of metaDataMesh and iso value
   vtkm::cont::ArrayHandle<vtkm::Id> metaDataLinearSums; //per point of metaDataMesh
   vtkm::cont::ArrayHandle<vtkm::Id> metaDataMin;        //per point of metaDataMesh
   vtkm::cont::ArrayHandle<vtkm::Id> metaDataMax;        //per point of metaDataMesh
   vtkm::cont::ArrayHandle<vtkm::Int32> metaDataNumTris; //per cell of metaDataMesh
 
+  auto groupSums = vtkm::cont::make_ArrayHandleGroupVec<3>(groupLinearSums);
   auto metaDataSums = vtkm::cont::make_ArrayHandleGroupVec<3>(metaDataLinearSums);
 
   // Since sharedState can be re-used between invocations of contour,
@@ -77,13 +87,15 @@ vtkm::cont::CellSetSingleType<> execute(
   sharedState.InterpolationEdgeIds.ReleaseResources();
   sharedState.InterpolationWeights.ReleaseResources();
   sharedState.CellIdMap.ReleaseResources();
+  sharedState.IsoValuePointOffsets.clear();
+  sharedState.IsoValueCellOffsets.clear();
 
   vtkm::cont::ArrayHandle<vtkm::Id> triangle_topology;
-  for (std::size_t i = 0; i < isovalues.size(); ++i)
+  for (std::size_t groupStart = 0; groupStart < isovalues.size(); groupStart += groupSize)
   {
-    auto multiContourCellOffset = sharedState.CellIdMap.GetNumberOfValues();
-    auto multiContourPointOffset = sharedState.InterpolationWeights.GetNumberOfValues();
-    IVType isoval = isovalues[i];
+    const std::size_t groupEnd = vtkm::Min(groupStart + groupSize, isovalues.size());
+    auto groupIsoValues = vtkm::cont::make_ArrayHandleMove(
+      std::vector<IVType>(isovalues.begin() + groupStart, isovalues.begin() + groupEnd));
 
     //----------------------------------------------------------------------------
     // PASS 1: Process all of the voxel edges that compose each row. Determine the
@@ -101,84 +113,105 @@ vtkm::cont::CellSetSingleType<> execute(
       // Additionally GPU's does significantly better when you do an initial fill
       // and write only non-below values
       //
-      ComputePass1<IVType> worklet1(isoval, pdims);
+      ComputePass1MultiIso<IVType> worklet1(pdims);
       vtkm::cont::TryExecuteOnDevice(invoke.GetDevice(),
                                      launchComputePass1{},
                                      worklet1,
                                      inputField,
                                      edgeCases,
                                      metaDataMesh2D,
-                                     metaDataSums,
-                                     metaDataMin,
-                                     metaDataMax);
+                                     groupIsoValues,
+                                     groupSums,
+                                     groupMin,
+                                     groupMax);
     }
 
-    //----------------------------------------------------------------------------
-    // PASS 2: Process a single row of voxels/cells. Count the number of other
-    // axis intersections by topological reasoning from previous edge cases.
-    // Determine the number of primitives (i.e., triangles) generated from this
-    // row. Use computational trimming to reduce work.
-    {
-      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass2");
-      ComputePass2 worklet2(pdims);
-      invoke(worklet2,
-             metaDataMesh2D,
-             metaDataSums,
-             metaDataMin,
-             metaDataMax,
-             metaDataNumTris,
-             edgeCases);
-    }
-
-    //----------------------------------------------------------------------------
-    // PASS 3: Compute the number of points and triangles that each edge
-    // row needs to generate by using exclusive scans.
-    vtkm::cont::Algorithm::ScanExtended(metaDataNumTris, metaDataNumTris);
-    auto sumTris =
-      vtkm::cont::ArrayGetValue(metaDataNumTris.GetNumberOfValues() - 1, metaDataNumTris);
-    if (sumTris > 0)
+    const vtkm::Id numRows = metaDataMesh2D.GetNumberOfPoints();
+    for (std::size_t i = groupStart; i < groupEnd; ++i)
     {
-      detail::extend_by(triangle_topology, 3 * sumTris);
-      detail::extend_by(sharedState.CellIdMap, sumTris);
-
+      auto multiContourCellOffset = sharedState.CellIdMap.GetNumberOfValues();
+      auto multiContourPointOffset = sharedState.InterpolationWeights.GetNumberOfValues();
+      sharedState.IsoValuePointOffsets.push_back(multiContourPointOffset);
+      sharedState.IsoValueCellOffsets.push_back(multiContourCellOffset);
+      IVType isoval = isovalues[i];
+
+      const vtkm::Id n = static_cast<vtkm::Id>(i - groupStart);
+      vtkm::cont::Algorithm::CopySubRange(
+        groupLinearSums, 3 * n * numRows, 3 * numRows, metaDataLinearSums);
+      vtkm::cont::Algorithm::CopySubRange(groupMin, n * numRows, numRows, metaDataMin);
+      vtkm::cont::Algorithm::CopySubRange(groupMax, n * numRows, numRows, metaDataMax);
+      auto isoEdgeCases = vtkm::cont::make_ArrayHandleView(edgeCases, n * numPoints, numPoints);
 
-      vtkm::Id newPointSize =
-        vtkm::cont::Algorithm::ScanExclusive(metaDataLinearSums, metaDataLinearSums);
-      detail::extend_by(sharedState.InterpolationEdgeIds, newPointSize);
-      detail::extend_by(sharedState.InterpolationWeights, newPointSize);
+      //----------------------------------------------------------------------------
+      // PASS 2: Process a single row of voxels/cells. Count the number of other
+      // axis intersections by topological reasoning from previous edge cases.
+      // Determine the number of primitives (i.e., triangles) generated from this
+      // row. Use computational trimming to reduce work.
+      {
+        VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass2");
+        ComputePass2 worklet2(pdims);
+        invoke(worklet2,
+               metaDataMesh2D,
+               metaDataSums,
+               metaDataMin,
+               metaDataMax,
+               metaDataNumTris,
+               isoEdgeCases);
+      }
 
       //----------------------------------------------------------------------------
-      // PASS 4: Process voxel rows and generate topology, and interpolation state
+      // PASS 3: Compute the number of points and triangles that each edge
+      // row needs to generate by using exclusive scans.
+      vtkm::cont::Algorithm::ScanExtended(metaDataNumTris, metaDataNumTris);
+      auto sumTris =
+        vtkm::cont::ArrayGetValue(metaDataNumTris.GetNumberOfValues() - 1, metaDataNumTris);
+      if (sumTris > 0)
       {
-        VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass4");
+        detail::extend_by(triangle_topology, 3 * sumTris);
+        detail::extend_by(sharedState.CellIdMap, sumTris);
 
-        auto pass4 = launchComputePass4(pdims, multiContourCellOffset, multiContourPointOffset);
 
-        detail::extend_by(points, newPointSize);
-        if (sharedState.GenerateNormals)
+        vtkm::Id newPointSize =
+          vtkm::cont::Algorithm::ScanExclusive(metaDataLinearSums, metaDataLinearSums);
+        detail::extend_by(sharedState.InterpolationEdgeIds, newPointSize);
+        detail::extend_by(sharedState.InterpolationWeights, newPointSize);
+
+        //----------------------------------------------------------------------------
+        // PASS 4: Process voxel rows and generate topology, and interpolation state
         {
-          detail::extend_by(normals, newPointSize);
+          VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass4");
+
+          auto pass4 =
+            launchComputePass4(pdims, multiContourCellOffset, multiContourPointOffset);
+
+          detail::extend_by(points, newPointSize);
+          if (sharedState.GenerateNormals)
+          {
+            detail::extend_by(normals, newPointSize);
+          }
+
+          vtkm::cont::TryExecuteOnDevice(invoke.GetDevice(),
+                                         pass4,
+                                         newPointSize,
+                                         isoval,
+                                         coordinateSystem,
+                                         inputField,
+                                         isoEdgeCases,
+                                         metaDataMesh2D,
+                                         metaDataSums,
+                                         metaDataMin,
+                                         metaDataMax,
+                                         metaDataNumTris,
+                                         sharedState,
+                                         triangle_topology,
+                                         points,
+                                         normals);
         }
-
-        vtkm::cont::TryExecuteOnDevice(invoke.GetDevice(),
-                                       pass4,
-                                       newPointSize,
-                                       isoval,
-                                       coordinateSystem,
-                                       inputField,
-                                       edgeCases,
-                                       metaDataMesh2D,
-                                       metaDataSums,
-                                       metaDataMin,
-                                       metaDataMax,
-                                       metaDataNumTris,
-                                       sharedState,
-                                       triangle_topology,
-                                       points,
-                                       normals);
       }
     }
   }
+  sharedState.IsoValuePointOffsets.push_back(sharedState.InterpolationWeights.GetNumberOfValues());
+  sharedState.IsoValueCellOffsets.push_back(sharedState.CellIdMap.GetNumberOfValues());
 
   vtkm::cont::CellSetSingleType<> outputCells;
   outputCells.Fill(points.GetNumberOfValues(), vtkm::CELL_SHAPE_TRIANGLE, 3, triangle_topology);
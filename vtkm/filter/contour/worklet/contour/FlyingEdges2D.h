@@ -0,0 +1,493 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_contour_flyingedges2d_h
+#define vtk_m_worklet_contour_flyingedges2d_h
+
+#include <vtkm/filter/contour/worklet/contour/CommonState.h>
+#include <vtkm/filter/contour/worklet/contour/FieldPropagation.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdgesHelpers.h>
+#include <vtkm/filter/contour/worklet/contour/MarchingCells.h>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace flying_edges
+{
+
+/*
+* Flying edges for 2D structured cell sets.
+*
+* The 2D variant produces isolines. It works on rows of points along the X axis:
+*
+* PASS 1: Process the X edges of each row of points. Count the intersections
+* and find where the intersections along the row begin and end.
+*
+* PASS 2: Process each row of cells. Using the trim bounds of the two rows of
+* points, count the intersections along the Y edges and the number of line
+* segments generated by the row.
+*
+* PASS 3: Exclusive scans of the counts give the output point and line ids of
+* each row.
+*
+* PASS 4: Process each row of cells again and write the line segments along
+* with the interpolation state of the intersected edges.
+*
+* The output points are numbered by row and, within a row, in the order of
+* their edges. Each intersected edge therefore has a unique point, and no
+* merging of duplicate points is needed.
+*/
+struct FlyingEdges2D
+{
+  // Quad points: 0 = (i, j), 1 = (i+1, j), 2 = (i+1, j+1), 3 = (i, j+1).
+  // Quad edges: 0 = (0, 1), 1 = (1, 2), 2 = (3, 2), 3 = (0, 3).
+  VTKM_EXEC static vtkm::IdComponent GetNumberOfLines(vtkm::IdComponent caseNumber)
+  {
+    VTKM_STATIC_CONSTEXPR_ARRAY vtkm::IdComponent numLines[16] = { 0, 1, 1, 1, 1, 2, 1, 1,
+                                                                   1, 1, 2, 1, 1, 1, 1, 0 };
+    return numLines[caseNumber];
+  }
+
+  VTKM_EXEC static vtkm::IdComponent GetLineEdge(vtkm::IdComponent caseNumber,
+                                                 vtkm::IdComponent line,
+                                                 vtkm::IdComponent vertex)
+  {
+    // clang-format off
+    VTKM_STATIC_CONSTEXPR_ARRAY vtkm::IdComponent lineEdges[16][4] = {
+      { 0, 0, 0, 0 }, { 3, 0, 0, 0 }, { 0, 1, 0, 0 }, { 3, 1, 0, 0 },
+      { 1, 2, 0, 0 }, { 3, 0, 1, 2 }, { 0, 2, 0, 0 }, { 3, 2, 0, 0 },
+      { 2, 3, 0, 0 }, { 0, 2, 0, 0 }, { 0, 1, 2, 3 }, { 1, 2, 0, 0 },
+      { 3, 1, 0, 0 }, { 0, 1, 0, 0 }, { 3, 0, 0, 0 }, { 0, 0, 0, 0 }
+    };
+    // clang-format on
+    return lineEdges[caseNumber][2 * line + vertex];
+  }
+};
+
+template <typename T>
+struct ComputePass1Rows2D : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id2 PointDims;
+  T IsoValue;
+
+  ComputePass1Rows2D() {}
+  ComputePass1Rows2D(T value, const vtkm::Id2& pdims)
+    : PointDims(pdims)
+    , IsoValue(value)
+  {
+  }
+
+  using ControlSignature = void(FieldIn row,
+                                FieldOut numXPoints,
+                                FieldOut trimMin,
+                                FieldOut trimMax,
+                                WholeArrayIn data);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  template <typename WholeDataField>
+  VTKM_EXEC void operator()(vtkm::Id row,
+                            vtkm::Id& numXPoints,
+                            vtkm::Id& trimMin,
+                            vtkm::Id& trimMax,
+                            const WholeDataField& field) const
+  {
+    const vtkm::Id end = this->PointDims[0] - 1;
+    const vtkm::Id startPos = row * this->PointDims[0];
+
+    numXPoints = 0;
+    trimMin = end;
+    trimMax = 0;
+    bool above1 = static_cast<T>(field.Get(startPos)) >= this->IsoValue;
+    for (vtkm::Id i = 0; i < end; ++i)
+    {
+      const bool above0 = above1;
+      above1 = static_cast<T>(field.Get(startPos + i + 1)) >= this->IsoValue;
+      if (above0 != above1)
+      {
+        ++numXPoints;
+        trimMin = vtkm::Min(trimMin, i);
+        trimMax = i + 1;
+      }
+    }
+  }
+};
+
+template <typename T>
+struct ComputePass2Rows2D : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id2 PointDims;
+  T IsoValue;
+
+  ComputePass2Rows2D() {}
+  ComputePass2Rows2D(T value, const vtkm::Id2& pdims)
+    : PointDims(pdims)
+    , IsoValue(value)
+  {
+  }
+
+  using ControlSignature = void(FieldIn row,
+                                FieldOut numYPoints,
+                                FieldOut numLines,
+                                FieldOut cellTrimMin,
+                                FieldOut cellTrimMax,
+                                WholeArrayIn pointTrimMin,
+                                WholeArrayIn pointTrimMax,
+                                WholeArrayIn data);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8);
+
+  template <typename WholeTrimField, typename WholeDataField>
+  VTKM_EXEC void operator()(vtkm::Id row,
+                            vtkm::Id& numYPoints,
+                            vtkm::Id& numLines,
+                            vtkm::Id& cellTrimMin,
+                            vtkm::Id& cellTrimMax,
+                            const WholeTrimField& pointTrimMin,
+                            const WholeTrimField& pointTrimMax,
+                            const WholeDataField& field) const
+  {
+    const vtkm::Id nx = this->PointDims[0];
+    const vtkm::Id bottom = row * nx;
+    const vtkm::Id top = bottom + nx;
+    auto isAbove = [&](vtkm::Id index) {
+      return static_cast<T>(field.Get(index)) >= this->IsoValue;
+    };
+
+    // Outside of the trim bounds of both rows of points, the points of each row
+    // are all above or all below. The Y edges there are only intersected when
+    // the two rows differ, in which case the trimming extends to the boundary.
+    cellTrimMin = vtkm::Min(pointTrimMin.Get(row), pointTrimMin.Get(row + 1));
+    cellTrimMax = vtkm::Max(pointTrimMax.Get(row), pointTrimMax.Get(row + 1));
+    if (isAbove(bottom) != isAbove(top))
+    {
+      cellTrimMin = 0;
+    }
+    if (isAbove(top - 1) != isAbove(top + nx - 1))
+    {
+      cellTrimMax = nx - 1;
+    }
+
+    numYPoints = 0;
+    numLines = 0;
+    if (cellTrimMin >= cellTrimMax)
+    {
+      return;
+    }
+
+    bool bottomAbove = isAbove(bottom + cellTrimMin);
+    bool topAbove = isAbove(top + cellTrimMin);
+    for (vtkm::Id i = cellTrimMin; i < cellTrimMax; ++i)
+    {
+      const bool nextBottomAbove = isAbove(bottom + i + 1);
+      const bool nextTopAbove = isAbove(top + i + 1);
+      numYPoints += (bottomAbove != topAbove) ? 1 : 0;
+
+      const vtkm::IdComponent caseNumber = (bottomAbove ? 1 : 0) | (nextBottomAbove ? 2 : 0) |
+        (nextTopAbove ? 4 : 0) | (topAbove ? 8 : 0);
+      numLines += FlyingEdges2D::GetNumberOfLines(caseNumber);
+
+      bottomAbove = nextBottomAbove;
+      topAbove = nextTopAbove;
+    }
+    numYPoints += (bottomAbove != topAbove) ? 1 : 0;
+  }
+};
+
+struct InterleaveRowCounts2D : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn index,
+                                WholeArrayIn numXPoints,
+                                WholeArrayIn numYPoints,
+                                FieldOut count);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename WholeCountField>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            const WholeCountField& numXPoints,
+                            const WholeCountField& numYPoints,
+                            vtkm::Id& count) const
+  {
+    // Points are numbered by the X edges of point row j, then the Y edges of
+    // cell row j, then the X edges of point row j + 1, and so on.
+    count = (index % 2 == 0) ? numXPoints.Get(index / 2) : numYPoints.Get(index / 2);
+  }
+};
+
+template <typename T>
+struct ComputePass4Rows2D : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id2 PointDims;
+  T IsoValue;
+  vtkm::Id CellWriteOffset;
+  vtkm::Id PointWriteOffset;
+
+  ComputePass4Rows2D() {}
+  ComputePass4Rows2D(T value,
+                     const vtkm::Id2& pdims,
+                     vtkm::Id multiContourCellOffset,
+                     vtkm::Id multiContourPointOffset)
+    : PointDims(pdims)
+    , IsoValue(value)
+    , CellWriteOffset(multiContourCellOffset)
+    , PointWriteOffset(multiContourPointOffset)
+  {
+  }
+
+  using ControlSignature = void(FieldIn row,
+                                FieldIn cellTrimMin,
+                                FieldIn cellTrimMax,
+                                FieldIn lineOffset,
+                                WholeArrayIn pointOffsets,
+                                WholeArrayIn data,
+                                WholeArrayOut connectivity,
+                                WholeArrayOut edgeIds,
+                                WholeArrayOut weights,
+                                WholeArrayOut inputCellIds);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10);
+
+  template <typename WholeOffsetField,
+            typename WholeDataField,
+            typename WholeConnField,
+            typename WholeEdgeIdField,
+            typename WholeWeightField,
+            typename WholeCellIdField>
+  VTKM_EXEC void operator()(vtkm::Id row,
+                            vtkm::Id cellTrimMin,
+                            vtkm::Id cellTrimMax,
+                            vtkm::Id lineOffset,
+                            const WholeOffsetField& pointOffsets,
+                            const WholeDataField& field,
+                            const WholeConnField& connectivity,
+                            const WholeEdgeIdField& edgeIds,
+                            const WholeWeightField& weights,
+                            const WholeCellIdField& inputCellIds) const
+  {
+    const vtkm::Id nx = this->PointDims[0];
+    const vtkm::Id bottom = row * nx;
+    const vtkm::Id top = bottom + nx;
+    const bool writeTopRow = (row == this->PointDims[1] - 2);
+
+    // No intersected X edge lies before the trim bounds, so the point ids of the
+    // row start at the offsets of the row.
+    vtkm::Id bottomId = this->PointWriteOffset + pointOffsets.Get(2 * row);
+    vtkm::Id leftId = this->PointWriteOffset + pointOffsets.Get(2 * row + 1);
+    vtkm::Id topId = this->PointWriteOffset + pointOffsets.Get(2 * row + 2);
+    vtkm::Id lineId = this->CellWriteOffset + lineOffset;
+
+    auto writePoint = [&](vtkm::Id pointId, vtkm::Id p0, vtkm::Id p1, T s0, T s1) {
+      edgeIds.Set(pointId, vtkm::Id2{ p0, p1 });
+      weights.Set(pointId,
+                  static_cast<vtkm::FloatDefault>(this->IsoValue - s0) /
+                    static_cast<vtkm::FloatDefault>(s1 - s0));
+    };
+
+    T s0 = static_cast<T>(field.Get(bottom + cellTrimMin));
+    T s3 = static_cast<T>(field.Get(top + cellTrimMin));
+    for (vtkm::Id i = cellTrimMin; i < cellTrimMax; ++i)
+    {
+      const T s1 = static_cast<T>(field.Get(bottom + i + 1));
+      const T s2 = static_cast<T>(field.Get(top + i + 1));
+      const vtkm::IdComponent caseNumber = (s0 >= this->IsoValue ? 1 : 0) |
+        (s1 >= this->IsoValue ? 2 : 0) | (s2 >= this->IsoValue ? 4 : 0) |
+        (s3 >= this->IsoValue ? 8 : 0);
+
+      const bool cuts0 = ((caseNumber & 1) != 0) != ((caseNumber & 2) != 0);
+      const bool cuts1 = ((caseNumber & 2) != 0) != ((caseNumber & 4) != 0);
+      const bool cuts2 = ((caseNumber & 8) != 0) != ((caseNumber & 4) != 0);
+      const bool cuts3 = ((caseNumber & 1) != 0) != ((caseNumber & 8) != 0);
+      const vtkm::Id ids[4] = { bottomId, leftId + (cuts3 ? 1 : 0), topId, leftId };
+
+      // Each row of cells writes the points on the X edges of its bottom row and
+      // on its Y edges. The last row also writes the points of its top row.
+      if (cuts0)
+      {
+        writePoint(ids[0], bottom + i, bottom + i + 1, s0, s1);
+      }
+      if (cuts2 && writeTopRow)
+      {
+        writePoint(ids[2], top + i, top + i + 1, s3, s2);
+      }
+      if (cuts3)
+      {
+        writePoint(ids[3], bottom + i, top + i, s0, s3);
+      }
+      if (cuts1 && (i == cellTrimMax - 1))
+      {
+        writePoint(ids[1], bottom + i + 1, top + i + 1, s1, s2);
+      }
+
+      const vtkm::IdComponent numLines = FlyingEdges2D::GetNumberOfLines(caseNumber);
+      for (vtkm::IdComponent line = 0; line < numLines; ++line, ++lineId)
+      {
+        connectivity.Set(2 * lineId, ids[FlyingEdges2D::GetLineEdge(caseNumber, line, 0)]);
+        connectivity.Set(2 * lineId + 1, ids[FlyingEdges2D::GetLineEdge(caseNumber, line, 1)]);
+        inputCellIds.Set(lineId, row * (nx - 1) + i);
+      }
+
+      bottomId += cuts0 ? 1 : 0;
+      topId += cuts2 ? 1 : 0;
+      leftId += cuts3 ? 1 : 0;
+      s0 = s1;
+      s3 = s2;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <typename IVType,
+          typename ValueType,
+          typename CoordsType,
+          typename StorageTagField,
+          typename StorageTagVertices,
+          typename StorageTagNormals,
+          typename CoordinateType,
+          typename NormalType>
+vtkm::cont::CellSetSingleType<> execute(
+  const vtkm::cont::CellSetStructured<2>& cells,
+  const CoordsType coordinateSystem,
+  const std::vector<IVType>& isovalues,
+  const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& inputField,
+  vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& points,
+  vtkm::cont::ArrayHandle<vtkm::Vec<NormalType, 3>, StorageTagNormals>& normals,
+  vtkm::worklet::contour::CommonState& sharedState)
+{
+  vtkm::cont::Invoker invoke;
+  const vtkm::Id2 pdims = cells.GetPointDimensions();
+
+  // Since sharedState can be re-used between invocations of contour,
+  // we need to make sure we reset the size of the Interpolation arrays.
+  sharedState.InterpolationEdgeIds.ReleaseResources();
+  sharedState.InterpolationWeights.ReleaseResources();
+  sharedState.CellIdMap.ReleaseResources();
+  sharedState.IsoValuePointOffsets.assign(isovalues.size() + 1, 0);
+  sharedState.IsoValueCellOffsets.assign(isovalues.size() + 1, 0);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> line_topology;
+  if (pdims[0] < 2 || pdims[1] < 2)
+  {
+    points.Allocate(0);
+    normals.Allocate(0);
+    vtkm::cont::CellSetSingleType<> outputCells;
+    outputCells.Fill(0, vtkm::CELL_SHAPE_LINE, 2, line_topology);
+    return outputCells;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> numXPoints;   //per row of points
+  vtkm::cont::ArrayHandle<vtkm::Id> pointTrimMin; //per row of points
+  vtkm::cont::ArrayHandle<vtkm::Id> pointTrimMax; //per row of points
+  vtkm::cont::ArrayHandle<vtkm::Id> numYPoints;   //per row of cells
+  vtkm::cont::ArrayHandle<vtkm::Id> numLines;     //per row of cells
+  vtkm::cont::ArrayHandle<vtkm::Id> cellTrimMin;  //per row of cells
+  vtkm::cont::ArrayHandle<vtkm::Id> cellTrimMax;  //per row of cells
+  vtkm::cont::ArrayHandle<vtkm::Id> pointOffsets;
+
+  for (std::size_t i = 0; i < isovalues.size(); ++i)
+  {
+    const vtkm::Id multiContourCellOffset = sharedState.CellIdMap.GetNumberOfValues();
+    const vtkm::Id multiContourPointOffset = sharedState.InterpolationWeights.GetNumberOfValues();
+    const IVType isoval = isovalues[i];
+    sharedState.IsoValuePointOffsets[i] = multiContourPointOffset;
+    sharedState.IsoValueCellOffsets[i] = multiContourCellOffset;
+
+    {
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges2D Pass1");
+      invoke(ComputePass1Rows2D<IVType>{ isoval, pdims },
+             vtkm::cont::ArrayHandleIndex(pdims[1]),
+             numXPoints,
+             pointTrimMin,
+             pointTrimMax,
+             inputField);
+    }
+
+    {
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges2D Pass2");
+      invoke(ComputePass2Rows2D<IVType>{ isoval, pdims },
+             vtkm::cont::ArrayHandleIndex(pdims[1] - 1),
+             numYPoints,
+             numLines,
+             cellTrimMin,
+             cellTrimMax,
+             pointTrimMin,
+             pointTrimMax,
+             inputField);
+    }
+
+    // PASS 3: Compute where the points and lines of each row start.
+    invoke(InterleaveRowCounts2D{},
+           vtkm::cont::ArrayHandleIndex(2 * pdims[1] - 1),
+           numXPoints,
+           numYPoints,
+           pointOffsets);
+    const vtkm::Id newPointSize = vtkm::cont::Algorithm::ScanExclusive(pointOffsets, pointOffsets);
+    const vtkm::Id newLineSize = vtkm::cont::Algorithm::ScanExclusive(numLines, numLines);
+    if (newLineSize == 0)
+    {
+      continue;
+    }
+
+    detail::extend_by(line_topology, 2 * newLineSize);
+    detail::extend_by(sharedState.CellIdMap, newLineSize);
+    detail::extend_by(sharedState.InterpolationEdgeIds, newPointSize);
+    detail::extend_by(sharedState.InterpolationWeights, newPointSize);
+
+    {
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges2D Pass4");
+      invoke(ComputePass4Rows2D<IVType>{
+               isoval, pdims, multiContourCellOffset, multiContourPointOffset },
+             vtkm::cont::ArrayHandleIndex(pdims[1] - 1),
+             cellTrimMin,
+             cellTrimMax,
+             numLines,
+             pointOffsets,
+             inputField,
+             line_topology,
+             sharedState.InterpolationEdgeIds,
+             sharedState.InterpolationWeights,
+             sharedState.CellIdMap);
+    }
+  }
+  sharedState.IsoValuePointOffsets.back() = sharedState.InterpolationWeights.GetNumberOfValues();
+  sharedState.IsoValueCellOffsets.back() = sharedState.CellIdMap.GetNumberOfValues();
+
+  invoke(vtkm::worklet::contour::MapPointField{},
+         sharedState.InterpolationEdgeIds,
+         sharedState.InterpolationWeights,
+         coordinateSystem,
+         points);
+
+  if (sharedState.GenerateNormals)
+  {
+    vtkm::worklet::marching_cells::GenerateNormals genNorms;
+    genNorms(coordinateSystem,
+             invoke,
+             normals,
+             inputField,
+             cells,
+             sharedState.InterpolationEdgeIds,
+             sharedState.InterpolationWeights);
+  }
+
+  vtkm::cont::CellSetSingleType<> outputCells;
+  outputCells.Fill(points.GetNumberOfValues(), vtkm::CELL_SHAPE_LINE, 2, line_topology);
+  return outputCells;
+}
+
+} //namespace flying_edges
+}
+}
+
+#endif
@@ -66,36 +66,50 @@ inline VTKM_EXEC void write_edge(vtkm::cont::DeviceAdapterTagCuda,
   }
 }
 
+// The largest number of iso values whose edges are classified in a single pass.
+// Bounds the memory of the edge cases to this many bytes per point.
+constexpr vtkm::IdComponent MaxFusedIsoValues = 8;
+
+// Classify the edges of each row against several iso values at once.
+//
+// The edge cases and row metadata of iso value n are written after those of the
+// previous iso values, at offsets of n times the number of points and rows. Each
+// sample of a row is read once and classified against all the iso values.
 template <typename T>
-struct ComputePass1 : public vtkm::worklet::WorkletVisitPointsWithCells
+struct ComputePass1MultiIso : public vtkm::worklet::WorkletVisitPointsWithCells
 {
   vtkm::Id3 PointDims;
-  T IsoValue;
+  vtkm::Id NumberOfRows = 0;
 
-  ComputePass1() {}
-  ComputePass1(T value, const vtkm::Id3& pdims)
+  ComputePass1MultiIso() {}
+  explicit ComputePass1MultiIso(const vtkm::Id3& pdims)
     : PointDims(pdims)
-    , IsoValue(value)
   {
   }
 
   using ControlSignature = void(CellSetIn,
-                                FieldOut axis_sum,
-                                FieldOut axis_min,
-                                FieldOut axis_max,
+                                WholeArrayIn isoValues,
+                                WholeArrayOut axis_sums,
+                                WholeArrayOut axis_mins,
+                                WholeArrayOut axis_maxs,
                                 WholeArrayInOut edgeData,
                                 WholeArrayIn data);
-  using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, Device);
+  using ExecutionSignature = void(ThreadIndices, InputIndex, _2, _3, _4, _5, _6, _7, Device);
   using InputDomain = _1;
 
   template <typename ThreadIndices,
+            typename WholeIsoField,
+            typename WholeSumField,
+            typename WholeIdField,
             typename WholeEdgeField,
             typename WholeDataField,
             typename Device>
   VTKM_EXEC void operator()(const ThreadIndices& threadIndices,
-                            vtkm::Id3& axis_sum,
-                            vtkm::Id& axis_min,
-                            vtkm::Id& axis_max,
+                            vtkm::Id row,
+                            const WholeIsoField& isoValues,
+                            const WholeSumField& axis_sums,
+                            const WholeIdField& axis_mins,
+                            const WholeIdField& axis_maxs,
                             WholeEdgeField& edges,
                             const WholeDataField& field,
                             Device device) const
@@ -106,42 +120,66 @@ struct ComputePass1 : public vtkm::worklet::WorkletVisitPointsWithCells
     const vtkm::Id3 dims = this->PointDims;
     const vtkm::Id startPos = compute_start(AxisToSum{}, ijk, dims);
     const vtkm::Id offset = compute_inc(AxisToSum{}, dims);
+    const vtkm::Id numPoints = dims[0] * dims[1] * dims[2];
+    const vtkm::Id end = this->PointDims[AxisToSum::xindex] - 1;
+
+    const vtkm::IdComponent numIsoValues =
+      static_cast<vtkm::IdComponent>(isoValues.GetNumberOfValues());
+    vtkm::Vec<T, MaxFusedIsoValues> values;
+    vtkm::Vec<vtkm::Id, MaxFusedIsoValues> axis_sum;
+    vtkm::Vec<vtkm::Id, MaxFusedIsoValues> axis_min;
+    vtkm::Vec<vtkm::Id, MaxFusedIsoValues> axis_max;
+    for (vtkm::IdComponent n = 0; n < numIsoValues; ++n)
+    {
+      values[n] = isoValues.Get(n);
+      axis_sum[n] = 0;
+      axis_min[n] = this->PointDims[AxisToSum::xindex];
+      axis_max[n] = 0;
+    }
 
-    const T value = this->IsoValue;
-    axis_min = this->PointDims[AxisToSum::xindex];
-    axis_max = 0;
     T s1 = field.Get(startPos);
-    T s0 = s1;
-    axis_sum = { 0, 0, 0 };
-    const vtkm::Id end = this->PointDims[AxisToSum::xindex] - 1;
     for (vtkm::Id i = 0; i < end; ++i)
     {
-      s0 = s1;
+      const T s0 = s1;
       s1 = field.Get(startPos + (offset * (i + 1)));
 
-      vtkm::UInt8 edgeCase = FlyingEdges3D::Below;
-      if (s0 >= value)
-      {
-        edgeCase = FlyingEdges3D::LeftAbove;
-      }
-      if (s1 >= value)
+      for (vtkm::IdComponent n = 0; n < numIsoValues; ++n)
       {
-        edgeCase |= FlyingEdges3D::RightAbove;
-      }
+        vtkm::UInt8 edgeCase = FlyingEdges3D::Below;
+        if (s0 >= values[n])
+        {
+          edgeCase = FlyingEdges3D::LeftAbove;
+        }
+        if (s1 >= values[n])
+        {
+          edgeCase |= FlyingEdges3D::RightAbove;
+        }
 
-      write_edge(device, startPos + (offset * i), edges, edgeCase);
+        write_edge(device, n * numPoints + startPos + (offset * i), edges, edgeCase);
 
-      if (edgeCase == FlyingEdges3D::LeftAbove || edgeCase == FlyingEdges3D::RightAbove)
-      {
-        axis_sum[AxisToSum::xindex] += 1; // increment number of intersections along axis
-        axis_max = i + 1;
-        if (axis_min == (end + 1))
+        if (edgeCase == FlyingEdges3D::LeftAbove || edgeCase == FlyingEdges3D::RightAbove)
         {
-          axis_min = i;
+          axis_sum[n] += 1; // increment number of intersections along axis
+          axis_max[n] = i + 1;
+          if (axis_min[n] == (end + 1))
+          {
+            axis_min[n] = i;
+          }
         }
       }
     }
-    write_edge(device, startPos + (offset * end), edges, FlyingEdges3D::Below);
+
+    for (vtkm::IdComponent n = 0; n < numIsoValues; ++n)
+    {
+      write_edge(device, n * numPoints + startPos + (offset * end), edges, FlyingEdges3D::Below);
+
+      vtkm::Id3 sums = { 0, 0, 0 };
+      sums[AxisToSum::xindex] = axis_sum[n];
+      const vtkm::Id rowIndex = n * this->NumberOfRows + row;
+      axis_sums.Set(rowIndex, sums);
+      axis_mins.Set(rowIndex, axis_min[n]);
+      axis_maxs.Set(rowIndex, axis_max[n]);
+    }
   }
 };
 
@@ -151,38 +189,90 @@ struct launchComputePass1
             typename IVType,
             typename T,
             typename StorageTagField,
-            typename... Args>
+            typename IsoValuesType,
+            typename SumsType>
   VTKM_CONT bool LaunchXAxis(DeviceAdapterTag device,
-                             const ComputePass1<IVType>& worklet,
+                             ComputePass1MultiIso<IVType> worklet,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
                              vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
                              vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
-                             Args&&... args) const
+                             const IsoValuesType& isoValues,
+                             SumsType& metaDataSums,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax) const
   {
-    vtkm::cont::Invoker invoke(device);
     metaDataMesh2D = make_metaDataMesh2D(SumXAxis{}, worklet.PointDims);
-
-    invoke(worklet, metaDataMesh2D, std::forward<Args>(args)..., edgeCases, inputField);
-    return true;
+    return this->LaunchMultiIso(device,
+                                worklet,
+                                inputField,
+                                edgeCases,
+                                metaDataMesh2D,
+                                isoValues,
+                                metaDataSums,
+                                metaDataMin,
+                                metaDataMax);
   }
 
   template <typename DeviceAdapterTag,
             typename IVType,
             typename T,
             typename StorageTagField,
-            typename... Args>
+            typename IsoValuesType,
+            typename SumsType>
   VTKM_CONT bool LaunchYAxis(DeviceAdapterTag device,
-                             const ComputePass1<IVType>& worklet,
+                             ComputePass1MultiIso<IVType> worklet,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
                              vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
                              vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
-                             Args&&... args) const
+                             const IsoValuesType& isoValues,
+                             SumsType& metaDataSums,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax) const
   {
-    vtkm::cont::Invoker invoke(device);
     metaDataMesh2D = make_metaDataMesh2D(SumYAxis{}, worklet.PointDims);
-
     edgeCases.Fill(static_cast<vtkm::UInt8>(FlyingEdges3D::Below));
-    invoke(worklet, metaDataMesh2D, std::forward<Args>(args)..., edgeCases, inputField);
+    return this->LaunchMultiIso(device,
+                                worklet,
+                                inputField,
+                                edgeCases,
+                                metaDataMesh2D,
+                                isoValues,
+                                metaDataSums,
+                                metaDataMin,
+                                metaDataMax);
+  }
+
+  template <typename DeviceAdapterTag,
+            typename IVType,
+            typename T,
+            typename StorageTagField,
+            typename IsoValuesType,
+            typename SumsType>
+  VTKM_CONT bool LaunchMultiIso(DeviceAdapterTag device,
+                                ComputePass1MultiIso<IVType> worklet,
+                                const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
+                                vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
+                                const vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
+                                const IsoValuesType& isoValues,
+                                SumsType& metaDataSums,
+                                vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
+                                vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax) const
+  {
+    vtkm::cont::Invoker invoke(device);
+    worklet.NumberOfRows = metaDataMesh2D.GetNumberOfPoints();
+    const vtkm::Id numRows = isoValues.GetNumberOfValues() * worklet.NumberOfRows;
+    metaDataSums.Allocate(numRows);
+    metaDataMin.Allocate(numRows);
+    metaDataMax.Allocate(numRows);
+
+    invoke(worklet,
+           metaDataMesh2D,
+           isoValues,
+           metaDataSums,
+           metaDataMin,
+           metaDataMax,
+           edgeCases,
+           inputField);
     return true;
   }
 
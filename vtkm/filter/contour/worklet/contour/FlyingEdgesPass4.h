@@ -46,6 +46,7 @@ struct launchComputePass4
             typename T,
             typename CoordsType,
             typename StorageTagField,
+            typename EdgeCasesType,
             typename MeshSums,
             typename PointType,
             typename NormalType>
@@ -54,7 +55,7 @@ struct launchComputePass4
                              IVType isoval,
                              CoordsType coordinateSystem,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
-                             vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases,
+                             const EdgeCasesType& edgeCases,
                              vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
                              const MeshSums& metaDataSums,
                              const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
@@ -114,6 +115,7 @@ struct launchComputePass4
             typename T,
             typename CoordsType,
             typename StorageTagField,
+            typename EdgeCasesType,
             typename MeshSums,
             typename PointType,
             typename NormalType>
@@ -122,7 +124,7 @@ struct launchComputePass4
                              IVType isoval,
                              CoordsType coordinateSystem,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
-                             vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases,
+                             const EdgeCasesType& edgeCases,
                              vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
                              const MeshSums& metaDataSums,
                              const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
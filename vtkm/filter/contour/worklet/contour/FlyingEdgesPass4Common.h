@@ -28,6 +28,37 @@ VTKM_EXEC inline vtkm::Id3 compute_incs3d(const vtkm::Id3& dims)
   return vtkm::Id3{ 1, dims[0], (dims[0] * dims[1]) };
 }
 
+// Gradient of the field at a point of the volume, by central differences inside the volume
+// and by one-sided differences on its faces.
+template <typename WholeDataField>
+VTKM_EXEC inline vtkm::Vec3f compute_gradient(const vtkm::Id3& ijk,
+                                              const vtkm::Id3& pdims,
+                                              const vtkm::Id3& incs,
+                                              vtkm::Id pos,
+                                              const WholeDataField& field)
+{
+  auto s = field.Get(pos);
+  vtkm::Vec3f g;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (ijk[i] == 0)
+    {
+      g[i] = static_cast<vtkm::FloatDefault>(field.Get(pos + incs[i]) - s);
+    }
+    else if (ijk[i] >= (pdims[i] - 1))
+    {
+      g[i] = static_cast<vtkm::FloatDefault>(s - field.Get(pos - incs[i]));
+    }
+    else
+    {
+      g[i] =
+        static_cast<vtkm::FloatDefault>(field.Get(pos + incs[i]) - field.Get(pos - incs[i])) *
+        0.5f;
+    }
+  }
+  return g;
+}
+
 VTKM_EXEC inline constexpr vtkm::Id increment_cellId(SumXAxis,
                                                      vtkm::Id cellId,
                                                      vtkm::Id,
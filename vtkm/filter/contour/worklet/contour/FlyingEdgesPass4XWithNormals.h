@@ -407,27 +407,7 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
     }
 
     //We are on some boundary edge
-    auto s = field.Get(pos);
-    vtkm::Vec3f g;
-    for (int i = 0; i < 3; ++i)
-    {
-      if (ijk[i] == 0)
-      {
-        g[i] = static_cast<vtkm::FloatDefault>(field.Get(pos + incs[i]) - s);
-      }
-      else if (ijk[i] >= (this->PointDims[i] - 1))
-      {
-        g[i] = static_cast<vtkm::FloatDefault>(s - field.Get(pos - incs[i]));
-      }
-      else
-      {
-        g[i] =
-          static_cast<vtkm::FloatDefault>(field.Get(pos + incs[i]) - field.Get(pos - incs[i])) *
-          0.5f;
-      }
-    }
-
-    return g;
+    return compute_gradient(ijk, this->PointDims, incs, pos, field);
   }
 };
 }
@@ -0,0 +1,365 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_contour_flyingedges_slabs_h
+#define vtk_m_worklet_contour_flyingedges_slabs_h
+
+#include <vtkm/filter/contour/worklet/contour/CommonState.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdges.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdgesPass4Common.h>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace flying_edges
+{
+
+/*
+* Flying edges over slabs of a 3D structured cell set.
+*
+* The volume is processed in slabs of planes of points along the Z axis.
+* Consecutive slabs share one plane of points, so every cell belongs to exactly
+* one slab. Each slab is contoured on its own, which bounds the size of the
+* flying edges metadata by the size of a slab rather than the size of the grid.
+*
+* The points on the X and Y edges of a shared plane are generated by both slabs
+* that contain the plane. The ids of the points on the last plane of a slab are
+* recorded in a lookup indexed by edge, and the next slab reuses these ids for
+* the points on its first plane instead of adding them again.
+*
+* Within a slab, flying edges would compute the gradients on the shared planes with
+* one-sided differences. The normals of the new points of each slab are instead
+* computed from the whole field, with the same differences and interpolation as
+* flying edges uses for the whole volume, so that they do not depend on the slabs.
+*/
+namespace slabs
+{
+
+// Return the index of an X or Y edge lying in the given plane of points of a slab,
+// or -1 if the edge is not in the plane.
+VTKM_EXEC inline vtkm::Id PlaneEdgeIndex(const vtkm::Id2& edge,
+                                         vtkm::Id planeSize,
+                                         vtkm::Id rowSize,
+                                         vtkm::Id plane)
+{
+  const vtkm::Id planeStart = plane * planeSize;
+  if (edge[0] < planeStart || edge[1] >= planeStart + planeSize)
+  {
+    return -1;
+  }
+  return 2 * (edge[0] - planeStart) + ((edge[1] - edge[0] == rowSize) ? 1 : 0);
+}
+
+struct ClassifySlabPoint : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id PlaneSize;
+  vtkm::Id RowSize;
+  bool SharesFirstPlane;
+
+  ClassifySlabPoint(vtkm::Id planeSize, vtkm::Id rowSize, bool sharesFirstPlane)
+    : PlaneSize(planeSize)
+    , RowSize(rowSize)
+    , SharesFirstPlane(sharesFirstPlane)
+  {
+  }
+
+  using ControlSignature = void(FieldIn edge, FieldOut isNew);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_EXEC void operator()(const vtkm::Id2& edge, vtkm::Id& isNew) const
+  {
+    const bool shared =
+      this->SharesFirstPlane && PlaneEdgeIndex(edge, this->PlaneSize, this->RowSize, 0) >= 0;
+    isNew = shared ? 0 : 1;
+  }
+};
+
+struct MapSlabPoint : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id PlaneSize;
+  vtkm::Id RowSize;
+  vtkm::Id LastPlane;
+  vtkm::Id PointOffset;
+
+  MapSlabPoint(vtkm::Id planeSize, vtkm::Id rowSize, vtkm::Id lastPlane, vtkm::Id pointOffset)
+    : PlaneSize(planeSize)
+    , RowSize(rowSize)
+    , LastPlane(lastPlane)
+    , PointOffset(pointOffset)
+  {
+  }
+
+  using ControlSignature = void(FieldIn edge,
+                                FieldIn isNew,
+                                FieldIn newIndex,
+                                WholeArrayIn firstPlaneIds,
+                                WholeArrayOut lastPlaneIds,
+                                FieldOut pointId);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            vtkm::Id isNew,
+                            vtkm::Id newIndex,
+                            const InPortalType& firstPlaneIds,
+                            const OutPortalType& lastPlaneIds,
+                            vtkm::Id& pointId) const
+  {
+    pointId = isNew
+      ? this->PointOffset + newIndex
+      : firstPlaneIds.Get(PlaneEdgeIndex(edge, this->PlaneSize, this->RowSize, 0));
+
+    const vtkm::Id lastIndex =
+      PlaneEdgeIndex(edge, this->PlaneSize, this->RowSize, this->LastPlane);
+    if (lastIndex >= 0)
+    {
+      lastPlaneIds.Set(lastIndex, pointId);
+    }
+  }
+};
+
+struct OffsetSlabEdge : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id Offset;
+
+  explicit OffsetSlabEdge(vtkm::Id offset)
+    : Offset(offset)
+  {
+  }
+
+  using ControlSignature = void(FieldInOut edge);
+  using ExecutionSignature = void(_1);
+
+  VTKM_EXEC void operator()(vtkm::Id2& edge) const { edge += vtkm::Id2(this->Offset); }
+};
+
+struct OffsetSlabCell : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id Offset;
+
+  explicit OffsetSlabCell(vtkm::Id offset)
+    : Offset(offset)
+  {
+  }
+
+  using ControlSignature = void(FieldInOut cellId);
+  using ExecutionSignature = void(_1);
+
+  VTKM_EXEC void operator()(vtkm::Id& cellId) const { cellId += this->Offset; }
+};
+
+// Interpolate the normal of a point from the gradients at the ends of its edge, as flying
+// edges does, using the field of the whole volume.
+struct InterpolateSlabNormal : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id3 PointDims;
+
+  explicit InterpolateSlabNormal(const vtkm::Id3& pdims)
+    : PointDims(pdims)
+  {
+  }
+
+  using ControlSignature = void(FieldIn edge, FieldIn weight, WholeArrayIn field, FieldOut normal);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename FieldPortalType, typename NormalType>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            vtkm::FloatDefault weight,
+                            const FieldPortalType& field,
+                            NormalType& normal) const
+  {
+    const vtkm::Id3 incs = compute_incs3d(this->PointDims);
+    auto ijk = [&](vtkm::Id pos) {
+      return vtkm::Id3(pos % incs[1], (pos / incs[1]) % this->PointDims[1], pos / incs[2]);
+    };
+    vtkm::Vec3f g0 = compute_gradient(ijk(edge[0]), this->PointDims, incs, edge[0], field);
+    vtkm::Vec3f g1 = compute_gradient(ijk(edge[1]), this->PointDims, incs, edge[1], field);
+    normal = NormalType(vtkm::Normal(g0 + (weight * (g1 - g0))));
+  }
+};
+
+template <typename T, typename S>
+void append(const vtkm::cont::ArrayHandle<T, S>& input, vtkm::cont::ArrayHandle<T>& output)
+{
+  const vtkm::Id numValues = input.GetNumberOfValues();
+  if (numValues > 0)
+  {
+    const vtkm::Id start = detail::extend_by(output, numValues);
+    vtkm::cont::Algorithm::CopySubRange(input, 0, numValues, output, start);
+  }
+}
+
+template <typename T>
+void append_if(const vtkm::cont::ArrayHandle<T>& input,
+               const vtkm::cont::ArrayHandle<vtkm::Id>& stencil,
+               vtkm::cont::ArrayHandle<T>& output)
+{
+  vtkm::cont::ArrayHandle<T> selected;
+  vtkm::cont::Algorithm::CopyIf(input, stencil, selected);
+  append(selected, output);
+}
+
+// Make the uniform coordinates of a slab.
+inline vtkm::cont::CoordinateSystem MakeSlabCoordinates(
+  const vtkm::cont::CoordinateSystem& coordinateSystem,
+  const vtkm::Id3& pdims,
+  vtkm::Id firstPlane,
+  vtkm::Id numPlanes)
+{
+  using UniformType = vtkm::cont::ArrayHandleUniformPointCoordinates;
+  UniformType uniform = coordinateSystem.GetData().AsArrayHandle<UniformType>();
+  vtkm::Vec3f origin = uniform.GetOrigin();
+  const vtkm::Vec3f spacing = uniform.GetSpacing();
+  origin[2] += static_cast<vtkm::FloatDefault>(firstPlane) * spacing[2];
+  return vtkm::cont::CoordinateSystem(
+    coordinateSystem.GetName(),
+    UniformType(vtkm::Id3(pdims[0], pdims[1], numPlanes), origin, spacing));
+}
+
+} // namespace slabs
+
+//----------------------------------------------------------------------------
+template <typename IVType,
+          typename ValueType,
+          typename StorageTagField,
+          typename StorageTagVertices,
+          typename StorageTagNormals,
+          typename CoordinateType,
+          typename NormalType>
+vtkm::cont::CellSetSingleType<> execute_slabs(
+  const vtkm::cont::CellSetStructured<3>& cells,
+  const vtkm::cont::CoordinateSystem& coordinateSystem,
+  const std::vector<IVType>& isovalues,
+  const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& inputField,
+  vtkm::Id slabSize,
+  vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& points,
+  vtkm::cont::ArrayHandle<vtkm::Vec<NormalType, 3>, StorageTagNormals>& normals,
+  vtkm::worklet::contour::CommonState& sharedState)
+{
+  vtkm::cont::Invoker invoke;
+  const vtkm::Id3 pdims = cells.GetPointDimensions();
+  const vtkm::Id planeSize = pdims[0] * pdims[1];
+  const vtkm::Id cellPlaneSize = (pdims[0] - 1) * (pdims[1] - 1);
+  slabSize = vtkm::Max(slabSize, vtkm::Id(2));
+
+  sharedState.InterpolationEdgeIds.ReleaseResources();
+  sharedState.InterpolationWeights.ReleaseResources();
+  sharedState.CellIdMap.ReleaseResources();
+  points.ReleaseResources();
+  normals.ReleaseResources();
+  sharedState.IsoValuePointOffsets.clear();
+  sharedState.IsoValueCellOffsets.clear();
+
+  // Normals are computed from the whole field, so that the points on the shared planes
+  // see the field on both sides of the plane.
+  vtkm::worklet::contour::CommonState slabState(sharedState.MergeDuplicatePoints);
+  slabState.GenerateNormals = false;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> triangle_topology;
+  for (const IVType& isoval : isovalues)
+  {
+    sharedState.IsoValuePointOffsets.push_back(points.GetNumberOfValues());
+    sharedState.IsoValueCellOffsets.push_back(sharedState.CellIdMap.GetNumberOfValues());
+    vtkm::cont::ArrayHandle<vtkm::Id> firstPlaneIds;
+    vtkm::cont::ArrayHandle<vtkm::Id> lastPlaneIds;
+    for (vtkm::Id firstPlane = 0; firstPlane < pdims[2] - 1; firstPlane += slabSize - 1)
+    {
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Slab");
+      const vtkm::Id numPlanes = vtkm::Min(slabSize, pdims[2] - firstPlane);
+
+      vtkm::cont::CellSetStructured<3> slabCells;
+      slabCells.SetPointDimensions(vtkm::Id3(pdims[0], pdims[1], numPlanes));
+      vtkm::cont::CoordinateSystem slabCoords =
+        slabs::MakeSlabCoordinates(coordinateSystem, pdims, firstPlane, numPlanes);
+      vtkm::cont::ArrayHandle<ValueType> slabField;
+      vtkm::cont::ArrayCopyDevice(
+        vtkm::cont::make_ArrayHandleView(inputField, firstPlane * planeSize, numPlanes * planeSize),
+        slabField);
+
+      vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>> slabPoints;
+      vtkm::cont::ArrayHandle<vtkm::Vec<NormalType, 3>> slabNormals;
+      vtkm::cont::CellSetSingleType<> slabTriangles = execute(slabCells,
+                                                              slabCoords,
+                                                              std::vector<IVType>{ isoval },
+                                                              slabField,
+                                                              slabPoints,
+                                                              slabNormals,
+                                                              slabState);
+
+      // Give the new points of the slab the next ids and the points of its first
+      // plane the ids they got from the previous slab.
+      vtkm::cont::ArrayHandle<vtkm::Id> isNew;
+      invoke(slabs::ClassifySlabPoint{ planeSize, pdims[0], firstPlane > 0 },
+             slabState.InterpolationEdgeIds,
+             isNew);
+      vtkm::cont::ArrayHandle<vtkm::Id> newIndex;
+      vtkm::cont::Algorithm::ScanExclusive(isNew, newIndex);
+
+      vtkm::cont::ArrayHandle<vtkm::Id> pointIds;
+      lastPlaneIds.Allocate(2 * planeSize);
+      invoke(slabs::MapSlabPoint{ planeSize, pdims[0], numPlanes - 1, points.GetNumberOfValues() },
+             slabState.InterpolationEdgeIds,
+             isNew,
+             newIndex,
+             firstPlaneIds,
+             lastPlaneIds,
+             pointIds);
+      std::swap(firstPlaneIds, lastPlaneIds);
+
+      invoke(slabs::OffsetSlabEdge{ firstPlane * planeSize }, slabState.InterpolationEdgeIds);
+      invoke(slabs::OffsetSlabCell{ firstPlane * cellPlaneSize }, slabState.CellIdMap);
+      vtkm::cont::ArrayHandle<vtkm::Id2> newEdgeIds;
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> newWeights;
+      vtkm::cont::Algorithm::CopyIf(slabState.InterpolationEdgeIds, isNew, newEdgeIds);
+      vtkm::cont::Algorithm::CopyIf(slabState.InterpolationWeights, isNew, newWeights);
+      if (sharedState.GenerateNormals)
+      {
+        invoke(slabs::InterpolateSlabNormal{ pdims },
+               newEdgeIds,
+               newWeights,
+               inputField,
+               slabNormals);
+        slabs::append(slabNormals, normals);
+      }
+      slabs::append_if(slabPoints, isNew, points);
+      slabs::append(newEdgeIds, sharedState.InterpolationEdgeIds);
+      slabs::append(newWeights, sharedState.InterpolationWeights);
+      slabs::append(slabState.CellIdMap, sharedState.CellIdMap);
+      slabs::append(
+        vtkm::cont::make_ArrayHandlePermutation(
+          slabTriangles.GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                             vtkm::TopologyElementTagPoint{}),
+          pointIds),
+        triangle_topology);
+    }
+  }
+  sharedState.IsoValuePointOffsets.push_back(points.GetNumberOfValues());
+  sharedState.IsoValueCellOffsets.push_back(sharedState.CellIdMap.GetNumberOfValues());
+
+  vtkm::cont::CellSetSingleType<> outputCells;
+  outputCells.Fill(points.GetNumberOfValues(), vtkm::CELL_SHAPE_TRIANGLE, 3, triangle_topology);
+  return outputCells;
+}
+
+} //namespace flying_edges
+}
+}
+
+#endif
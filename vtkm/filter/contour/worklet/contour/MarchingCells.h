@@ -26,6 +26,7 @@
 #include <vtkm/cont/Invoker.h>
 
 #include <vtkm/worklet/Keys.h>
+#include <vtkm/worklet/MaskIndices.h>
 #include <vtkm/worklet/ScatterCounting.h>
 #include <vtkm/worklet/ScatterPermutation.h>
 
@@ -113,6 +114,37 @@ public:
   }
 };
 
+/// \brief Classify only the cells given by a mask, such as the candidates
+/// found with a span space index. The triangle counts of the other cells are
+/// left untouched, so the output array must be initialized beforehand.
+// ---------------------------------------------------------------------------
+template <typename T>
+class ClassifyCandidateCell : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+public:
+  using ControlSignature = void(WholeArrayIn isoValues,
+                                FieldInPoint fieldIn,
+                                CellSetIn cellSet,
+                                FieldInOutCell outNumTriangles,
+                                ExecObject classifyTable);
+  using ExecutionSignature = void(CellShape, _1, _2, _4, _5);
+  using InputDomain = _3;
+  using MaskType = vtkm::worklet::MaskIndices;
+
+  template <typename CellShapeType,
+            typename IsoValuesType,
+            typename FieldInType,
+            typename ClassifyTableType>
+  VTKM_EXEC void operator()(CellShapeType shape,
+                            const IsoValuesType& isovalues,
+                            const FieldInType& fieldIn,
+                            vtkm::IdComponent& numTriangles,
+                            const ClassifyTableType& classifyTable) const
+  {
+    ClassifyCell<T>{}(shape, isovalues, fieldIn, numTriangles, classifyTable);
+  }
+};
+
 /// \brief Used to store data need for the EdgeWeightGenerate worklet.
 /// This information is not passed as part of the arguments to the worklet as
 /// that dramatically increase compile time by 200%
@@ -622,6 +654,21 @@ vtkm::cont::CellSetSingleType<> execute(
   // Call the ClassifyCell functor to compute the Marching Cubes case numbers
   // for each cell, and the number of vertices to be generated
   vtkm::cont::ArrayHandle<vtkm::IdComponent> numOutputTrisPerCell;
+  if (sharedState.UseCandidateCells)
+  {
+    // Cells that are not candidates cannot be crossed by any contour, so only the
+    // candidates are classified and all other cells produce no triangles.
+    numOutputTrisPerCell.AllocateAndFill(cells.GetNumberOfCells(), 0);
+    vtkm::worklet::MaskIndices mask(sharedState.CandidateCellIds);
+    invoker(marching_cells::ClassifyCandidateCell<ValueType>{},
+            mask,
+            isoValuesHandle,
+            inputField,
+            cells,
+            numOutputTrisPerCell,
+            classTable);
+  }
+  else
   {
     marching_cells::ClassifyCell<ValueType> classifyCell;
     invoker(classifyCell, isoValuesHandle, inputField, cells, numOutputTrisPerCell, classTable);
@@ -36,6 +36,13 @@ void ExternalFaces::SetPassPolyData(bool value)
   this->Worklet->SetPassPolyData(value);
 }
 
+//-----------------------------------------------------------------------------
+void ExternalFaces::SetUseHashTable(bool value)
+{
+  this->UseHashTable = value;
+  this->Worklet->SetUseHashTable(value);
+}
+
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet ExternalFaces::GenerateOutput(const vtkm::cont::DataSet& input,
                                                   vtkm::cont::CellSetExplicit<>& outCellSet)
@@ -60,6 +60,19 @@ public:
   /// @copydoc GetPassPolyData
   VTKM_CONT void SetPassPolyData(bool value);
 
+  /// @brief Specify how the faces shared by two cells are found in unstructured grids.
+  ///
+  /// When off (the default), the faces are grouped by sorting their hashes. When on, the
+  /// faces are inserted in a hash table keyed on their point ids, and each face cancels
+  /// the matching face of the neighboring cell as it is inserted. This avoids sorting all
+  /// the faces, which is the most expensive step of this filter on large meshes, at the
+  /// cost of a table of about twice as many entries as faces. The same faces are
+  /// extracted either way, but in a different order. The external faces found with the
+  /// hash table are ordered by the cell they belong to.
+  VTKM_CONT bool GetUseHashTable() const { return this->UseHashTable; }
+  /// @copydoc GetUseHashTable
+  VTKM_CONT void SetUseHashTable(bool value);
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
@@ -70,6 +83,7 @@ private:
 
   bool CompactPoints = false;
   bool PassPolyData = true;
+  bool UseHashTable = false;
 
   // Note: This shared state as a data member requires us to explicitly implement the
   // constructor and destructor in the .cxx file, after the compiler actually have
@@ -13,6 +13,7 @@
 #include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/entity_extraction/ExtractGeometry.h>
 #include <vtkm/filter/entity_extraction/worklet/ExtractGeometry.h>
+#include <vtkm/worklet/ImplicitFunctionBricks.h>
 
 namespace
 {
@@ -59,14 +60,32 @@ vtkm::cont::DataSet ExtractGeometry::DoExecute(const vtkm::cont::DataSet& input)
   vtkm::worklet::ExtractGeometry worklet;
   vtkm::cont::UnknownCellSet outCells;
 
-  cells.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>([&](const auto& concrete) {
-    outCells = worklet.Run(concrete,
-                           coords,
-                           this->Function,
-                           this->ExtractInside,
-                           this->ExtractBoundaryCells,
-                           this->ExtractOnlyBoundaryCells);
-  });
+  // On uniform and rectilinear meshes, the function is only evaluated at the cells of the
+  // bricks that it crosses.
+  vtkm::worklet::ImplicitFunctionBricks bricks;
+  if (bricks.Run(cells, this->Function, 0.0, coords))
+  {
+    cells.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST_STRUCTURED>([&](const auto& concrete) {
+      outCells = worklet.Run(concrete,
+                             coords,
+                             this->Function,
+                             bricks,
+                             this->ExtractInside,
+                             this->ExtractBoundaryCells,
+                             this->ExtractOnlyBoundaryCells);
+    });
+  }
+  else
+  {
+    cells.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>([&](const auto& concrete) {
+      outCells = worklet.Run(concrete,
+                             coords,
+                             this->Function,
+                             this->ExtractInside,
+                             this->ExtractBoundaryCells,
+                             this->ExtractOnlyBoundaryCells);
+    });
+  }
 
   // create the output dataset
   auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
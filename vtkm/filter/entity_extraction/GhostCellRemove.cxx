@@ -9,12 +9,17 @@
 //============================================================================
 
 #include <vtkm/RangeId3.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandleImplicit.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/DefaultTypes.h>
 #include <vtkm/cont/UnknownCellSet.h>
 
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/entity_extraction/ExtractStructured.h>
 #include <vtkm/filter/entity_extraction/GhostCellRemove.h>
+#include <vtkm/filter/entity_extraction/worklet/ExtractStructured.h>
 #include <vtkm/filter/entity_extraction/worklet/Threshold.h>
 
 namespace
@@ -260,6 +265,76 @@ bool CanDoStructuredStrip(const vtkm::cont::UnknownCellSet& cells,
   return canDo;
 }
 
+// Maps the flat index of a point or cell in a block of a structured grid to its flat
+// index in the whole grid.
+struct BlockToGridIndex
+{
+  vtkm::Id3 BlockDims;
+  vtkm::Id3 GridDims;
+  vtkm::Id3 Start;
+
+  VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id index) const
+  {
+    const vtkm::Id i = index % this->BlockDims[0];
+    const vtkm::Id j = (index / this->BlockDims[0]) % this->BlockDims[1];
+    const vtkm::Id k = index / (this->BlockDims[0] * this->BlockDims[1]);
+    return (this->Start[0] + i) +
+      this->GridDims[0] * ((this->Start[1] + j) + this->GridDims[1] * (this->Start[2] + k));
+  }
+};
+
+using BlockIndexArray = vtkm::cont::ArrayHandleImplicit<BlockToGridIndex>;
+
+vtkm::Id3 StructuredPointDimensions(const vtkm::cont::UnknownCellSet& cells)
+{
+  vtkm::Id3 dims(1, 1, 1);
+  if (cells.CanConvert<vtkm::cont::CellSetStructured<1>>())
+  {
+    dims[0] = cells.AsCellSet<vtkm::cont::CellSetStructured<1>>().GetPointDimensions();
+  }
+  else if (cells.CanConvert<vtkm::cont::CellSetStructured<2>>())
+  {
+    vtkm::Id2 d = cells.AsCellSet<vtkm::cont::CellSetStructured<2>>().GetPointDimensions();
+    dims[0] = d[0];
+    dims[1] = d[1];
+  }
+  else
+  {
+    dims = cells.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+  }
+  return dims;
+}
+
+// Adds a view of the field that selects the values of the block. Basic arrays of the
+// common value types are viewed through an `ArrayHandlePermutation`. Anything else is
+// gathered into a new array.
+void MapFieldToBlockView(vtkm::cont::DataSet& result,
+                         const vtkm::cont::Field& field,
+                         const BlockIndexArray& blockIds)
+{
+  bool mapped = false;
+  vtkm::ListForEach(
+    [&](auto value) {
+      using T = decltype(value);
+      if (!mapped && field.GetData().IsType<vtkm::cont::ArrayHandle<T>>())
+      {
+        result.AddField(vtkm::cont::Field(
+          field.GetName(),
+          field.GetAssociation(),
+          vtkm::cont::make_ArrayHandlePermutation(
+            blockIds, field.GetData().AsArrayHandle<vtkm::cont::ArrayHandle<T>>())));
+        mapped = true;
+      }
+    },
+    VTKM_DEFAULT_TYPE_LIST{});
+  if (!mapped)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> permutation;
+    vtkm::cont::ArrayCopyDevice(blockIds, permutation);
+    vtkm::filter::MapFieldPermutation(field, permutation, result);
+  }
+}
+
 bool DoMapField(vtkm::cont::DataSet& result,
                 const vtkm::cont::Field& field,
                 const vtkm::worklet::Threshold& worklet)
@@ -319,6 +394,11 @@ VTKM_CONT vtkm::cont::DataSet GhostCellRemove::DoExecute(const vtkm::cont::DataS
     vtkm::RangeId3 range;
     if (CanDoStructuredStrip(cells, fieldArray, this->Invoke, this->GetTypesToRemove(), range))
     {
+      if (!this->GetCopyFields())
+      {
+        return this->StripToBlockView(input, field, range);
+      }
+
       vtkm::filter::entity_extraction::ExtractStructured extract;
       extract.SetInvoker(this->Invoke);
       vtkm::RangeId3 erange(
@@ -345,6 +425,88 @@ VTKM_CONT vtkm::cont::DataSet GhostCellRemove::DoExecute(const vtkm::cont::DataS
   return this->CreateResult(input, cellOut, mapper);
 }
 
+//-----------------------------------------------------------------------------
+VTKM_CONT vtkm::cont::DataSet GhostCellRemove::StripToBlockView(const vtkm::cont::DataSet& input,
+                                                                const vtkm::cont::Field& ghostField,
+                                                                const vtkm::RangeId3& range)
+{
+  const vtkm::cont::UnknownCellSet& cells = input.GetCellSet();
+
+  vtkm::RangeId3 voi(
+    range.X.Min, range.X.Max + 2, range.Y.Min, range.Y.Max + 2, range.Z.Min, range.Z.Max + 2);
+  vtkm::worklet::ExtractStructured worklet;
+  auto cellset = worklet.Run(cells.ResetCellSetList<VTKM_DEFAULT_CELL_SET_LIST_STRUCTURED>(),
+                             voi,
+                             vtkm::Id3(1, 1, 1),
+                             false,
+                             false);
+
+  // The kept cells form a block of the grid, so the indices of its points and cells
+  // are computed on the fly instead of being gathered into index arrays.
+  const vtkm::Id3 start(range.X.Min, range.Y.Min, range.Z.Min);
+  const vtkm::Id3 blockCellDims(
+    range.X.Max - range.X.Min + 1, range.Y.Max - range.Y.Min + 1, range.Z.Max - range.Z.Min + 1);
+  const vtkm::Id3 gridPointDims = StructuredPointDimensions(cells);
+  vtkm::Id3 gridCellDims;
+  vtkm::Id3 blockPointDims;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    // Unused dimensions have a single point and a single (degenerate) cell layer.
+    const bool used = gridPointDims[d] > 1;
+    gridCellDims[d] = used ? gridPointDims[d] - 1 : 1;
+    blockPointDims[d] = used ? blockCellDims[d] + 1 : 1;
+  }
+  BlockIndexArray pointIds(BlockToGridIndex{ blockPointDims, gridPointDims, start },
+                           blockPointDims[0] * blockPointDims[1] * blockPointDims[2]);
+  BlockIndexArray cellIds(BlockToGridIndex{ blockCellDims, gridCellDims, start },
+                          blockCellDims[0] * blockCellDims[1] * blockCellDims[2]);
+
+  auto mapField = [&](vtkm::cont::DataSet& result, const vtkm::cont::Field& f) {
+    using UniformCoordinatesArrayHandle =
+      vtkm::worklet::ExtractStructured::UniformCoordinatesArrayHandle;
+    using RectilinearCoordinatesArrayHandle =
+      vtkm::worklet::ExtractStructured::RectilinearCoordinatesArrayHandle;
+    if (f.IsPointField())
+    {
+      const vtkm::cont::UnknownArrayHandle& array = f.GetData();
+      if (array.CanConvert<UniformCoordinatesArrayHandle>())
+      {
+        result.AddField(vtkm::cont::Field(
+          f.GetName(),
+          f.GetAssociation(),
+          worklet.MapCoordinatesUniform(array.AsArrayHandle<UniformCoordinatesArrayHandle>())));
+      }
+      else if (array.CanConvert<RectilinearCoordinatesArrayHandle>())
+      {
+        auto coords = array.AsArrayHandle<RectilinearCoordinatesArrayHandle>();
+        result.AddField(vtkm::cont::Field(
+          f.GetName(), f.GetAssociation(), worklet.MapCoordinatesRectilinear(coords)));
+      }
+      else
+      {
+        MapFieldToBlockView(result, f, pointIds);
+      }
+    }
+    else if (f.IsCellField())
+    {
+      MapFieldToBlockView(result, f, cellIds);
+    }
+    else if (f.IsWholeDataSetField())
+    {
+      result.AddField(f);
+    }
+  };
+
+  vtkm::cont::DataSet output = this->CreateResult(input, cellset, mapField);
+  // Like the copying path, keep the ghost field unless asked to remove it.
+  if (!this->GetRemoveGhostField() &&
+      !output.HasField(ghostField.GetName(), ghostField.GetAssociation()))
+  {
+    mapField(output, ghostField);
+  }
+  return output;
+}
+
 }
 }
 }
@@ -13,6 +13,7 @@
 
 #include <vtkm/CellClassification.h>
 #include <vtkm/Deprecated.h>
+#include <vtkm/RangeId3.h>
 #include <vtkm/filter/Filter.h>
 #include <vtkm/filter/entity_extraction/vtkm_filter_entity_extraction_export.h>
 
@@ -85,6 +86,20 @@ public:
   /// @copydoc GetUseGhostCellsAsField
   VTKM_CONT void SetUseGhostCellsAsField(bool flag) { this->UseGhostCellsAsField = flag; }
 
+  /// @brief Specify whether the fields of a structured output are copied.
+  ///
+  /// When the ghost cells of a structured input form layers along its boundary, the
+  /// output is the block of the input between these layers. When this flag is true
+  /// (the default), the point and cell fields of the block are copied into new arrays.
+  /// When this flag is false, the fields of the output are views into the arrays of
+  /// the input that compute the indices of the block on the fly, which avoids the
+  /// copies but makes each later access a little more expensive. Uniform and
+  /// rectilinear coordinates are always rebuilt for the block. This flag has no
+  /// effect when the output is an explicit data set.
+  VTKM_CONT void SetCopyFields(bool flag) { this->CopyFields = flag; }
+  /// @copydoc SetCopyFields
+  VTKM_CONT bool GetCopyFields() const { return this->CopyFields; }
+
   VTKM_DEPRECATED(2.1, "Use !AreAllTypesRemoved().")
   VTKM_CONT bool GetRemoveByType() const { return !this->AreAllTypesRemoved(); }
   VTKM_DEPRECATED(2.1, "Use GetTypesToRemove().")
@@ -94,8 +109,13 @@ private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
+  VTKM_CONT vtkm::cont::DataSet StripToBlockView(const vtkm::cont::DataSet& input,
+                                                 const vtkm::cont::Field& ghostField,
+                                                 const vtkm::RangeId3& range);
+
   bool UseGhostCellsAsField = true;
   bool RemoveField = false;
+  bool CopyFields = true;
   vtkm::UInt8 TypesToRemove = 0xFF;
 };
 
@@ -11,6 +11,9 @@
 #include <vtkm/filter/entity_extraction/Threshold.h>
 #include <vtkm/filter/entity_extraction/worklet/Threshold.h>
 
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/DefaultTypes.h>
 #include <vtkm/cont/Invoker.h>
 
 #include <vtkm/BinaryPredicates.h>
@@ -44,7 +47,8 @@ private:
 
 bool DoMapField(vtkm::cont::DataSet& result,
                 const vtkm::cont::Field& field,
-                const vtkm::worklet::Threshold& worklet)
+                const vtkm::worklet::Threshold& worklet,
+                bool copyCells)
 {
   if (field.IsPointField() || field.IsWholeDataSetField())
   {
@@ -54,6 +58,31 @@ bool DoMapField(vtkm::cont::DataSet& result,
   }
   else if (field.IsCellField())
   {
+    if (!copyCells)
+    {
+      // Basic arrays of the common value types are permuted lazily. Anything else is
+      // gathered into a new array.
+      bool mapped = false;
+      vtkm::ListForEach(
+        [&](auto value) {
+          using T = decltype(value);
+          if (!mapped && field.GetData().IsType<vtkm::cont::ArrayHandle<T>>())
+          {
+            result.AddField(vtkm::cont::Field(
+              field.GetName(),
+              field.GetAssociation(),
+              vtkm::cont::make_ArrayHandlePermutation(
+                worklet.GetValidCellIds(),
+                field.GetData().AsArrayHandle<vtkm::cont::ArrayHandle<T>>())));
+            mapped = true;
+          }
+        },
+        VTKM_DEFAULT_TYPE_LIST{});
+      if (mapped)
+      {
+        return true;
+      }
+    }
     return vtkm::filter::MapFieldPermutation(field, worklet.GetValidCellIds(), result);
   }
   else
@@ -120,12 +149,73 @@ VTKM_CONT void Threshold::SetThresholdBetween(vtkm::Float64 value1, vtkm::Float6
 }
 
 //-----------------------------------------------------------------------------
+bool Threshold::IsFieldRangeOutsideThreshold(const vtkm::cont::Field& field) const
+{
+  // Inverted thresholds pass NaN values, which are not part of the range.
+  if (this->Invert)
+  {
+    return false;
+  }
+
+  const vtkm::cont::ArrayHandle<vtkm::Range>& ranges = field.GetRange();
+  auto rangePortal = ranges.ReadPortal();
+  auto isOutside = [&](vtkm::IdComponent component) {
+    const vtkm::Range range = rangePortal.Get(component);
+    return !range.IsNonEmpty() || (range.Max < this->GetLowerThreshold()) ||
+      (range.Min > this->GetUpperThreshold());
+  };
+
+  const vtkm::IdComponent numComponents =
+    static_cast<vtkm::IdComponent>(ranges.GetNumberOfValues());
+  if (this->ComponentMode == Component::Selected || numComponents == 1)
+  {
+    const vtkm::IdComponent component = (numComponents == 1) ? 0 : this->SelectedComponent;
+    return (component >= 0) && (component < numComponents) && isOutside(component);
+  }
+
+  // With Any, a cell needs one component in range; with All, it needs every component.
+  bool anyOutside = false;
+  bool allOutside = true;
+  for (vtkm::IdComponent component = 0; component < numComponents; ++component)
+  {
+    const bool outside = isOutside(component);
+    anyOutside = anyOutside || outside;
+    allOutside = allOutside && outside;
+  }
+  return (this->ComponentMode == Component::Any) ? allOutside : anyOutside;
+}
+
 vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
 {
   //get the cells and coordinates of the dataset
   const vtkm::cont::UnknownCellSet& cells = input.GetCellSet();
   const auto& field = this->GetFieldFromDataSet(input);
 
+  // A permuted output needs the concrete type of the input cell set, so it always
+  // visits the cells.
+  if (this->CopyCells && this->IsFieldRangeOutsideThreshold(field))
+  {
+    // No cell passes, so skip visiting the cells and return an empty cell set that keeps
+    // the points, as a regular threshold output would.
+    vtkm::cont::ArrayHandle<vtkm::Id> noIds;
+    vtkm::cont::CellSetExplicit<> emptyCellSet;
+    emptyCellSet.Fill(input.GetNumberOfPoints(),
+                      vtkm::cont::ArrayHandle<vtkm::UInt8>{},
+                      noIds,
+                      vtkm::cont::make_ArrayHandle<vtkm::Id>({ 0 }));
+    auto mapper = [&](auto& result, const auto& f) {
+      if (f.IsPointField() || f.IsWholeDataSetField())
+      {
+        result.AddField(f);
+      }
+      else if (f.IsCellField())
+      {
+        vtkm::filter::MapFieldPermutation(f, noIds, result);
+      }
+    };
+    return this->CreateResult(input, emptyCellSet, mapper);
+  }
+
   ThresholdRange predicate(this->GetLowerThreshold(), this->GetUpperThreshold());
   vtkm::worklet::Threshold worklet;
   vtkm::cont::UnknownCellSet cellOut;
@@ -141,8 +231,16 @@ vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
     {
       auto arrayComponent =
         field.GetData().ExtractComponent<ComponentType>(this->SelectedComponent);
-      cellOut = worklet.Run(
-        cells, arrayComponent, field.GetAssociation(), predicate, this->AllInRange, this->Invert);
+      if (this->CopyCells)
+      {
+        cellOut = worklet.Run(
+          cells, arrayComponent, field.GetAssociation(), predicate, this->AllInRange, this->Invert);
+      }
+      else
+      {
+        cellOut = worklet.RunPermutation(
+          cells, arrayComponent, field.GetAssociation(), predicate, this->AllInRange, this->Invert);
+      }
     }
     else
     {
@@ -170,18 +268,32 @@ vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
         }
       }
 
-      cellOut = worklet.Run(cells,
-                            passFlags,
-                            field.GetAssociation(),
-                            ThresholdPassFlag{},
-                            this->AllInRange,
-                            this->Invert);
+      if (this->CopyCells)
+      {
+        cellOut = worklet.Run(cells,
+                              passFlags,
+                              field.GetAssociation(),
+                              ThresholdPassFlag{},
+                              this->AllInRange,
+                              this->Invert);
+      }
+      else
+      {
+        cellOut = worklet.RunPermutation(cells,
+                                         passFlags,
+                                         field.GetAssociation(),
+                                         ThresholdPassFlag{},
+                                         this->AllInRange,
+                                         this->Invert);
+      }
     }
   };
 
   vtkm::ListForEach(callWithArrayBaseComponent, vtkm::TypeListScalarAll{});
 
-  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  auto mapper = [&](auto& result, const auto& f) {
+    DoMapField(result, f, worklet, this->CopyCells);
+  };
   return this->CreateResult(input, cellOut, mapper);
 }
 } // namespace entity_extraction
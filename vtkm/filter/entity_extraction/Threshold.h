@@ -25,7 +25,8 @@ namespace entity_extraction
 ///
 /// Extracts all cells from any dataset type that satisfy a threshold criterion.
 /// The output of this filter stores its connectivity in a `vtkm::cont::CellSetExplicit<>`
-/// regardless of the input dataset type or which cells are passed.
+/// regardless of the input dataset type or which cells are passed, unless
+/// `SetCopyCells()` is turned off.
 ///
 /// You can threshold either on point or cell fields. If thresholding on point fields,
 /// you must specify whether a cell should be kept if some but not all of its incident
@@ -106,10 +107,26 @@ public:
   /// @copydoc SetInvert
   VTKM_CONT bool GetInvert() const { return this->Invert; }
 
+  /// @brief Specify whether the passing cells are copied to the output.
+  ///
+  /// When true (the default), the connectivity of the passing cells is copied into a
+  /// `vtkm::cont::CellSetExplicit<>`. When false, the output cell set is a
+  /// `vtkm::cont::CellSetPermutation` that refers to the passing cells of the input
+  /// cell set, and the cell fields are `vtkm::cont::ArrayHandlePermutation` views of
+  /// the input arrays. This avoids copying connectivity and cell data when the output
+  /// is only rendered or reduced, but the permuted cell set is not part of the default
+  /// cell set list, so not every filter accepts it.
+  VTKM_CONT void SetCopyCells(bool value) { this->CopyCells = value; }
+  /// @copydoc SetCopyCells
+  VTKM_CONT bool GetCopyCells() const { return this->CopyCells; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
+  // Whether the cached range of the field shows that no cell can pass the threshold.
+  VTKM_CONT bool IsFieldRangeOutsideThreshold(const vtkm::cont::Field& field) const;
+
   double LowerValue = 0;
   double UpperValue = 0;
 
@@ -125,6 +142,7 @@ private:
 
   bool AllInRange = false;
   bool Invert = false;
+  bool CopyCells = true;
 };
 } // namespace entity_extraction
 } // namespace filter
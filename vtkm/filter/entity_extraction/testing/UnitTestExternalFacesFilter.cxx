@@ -14,11 +14,18 @@
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/entity_extraction/ExternalFaces.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 using vtkm::cont::testing::MakeTestDataSet;
 
 namespace
 {
 
+// Whether the external faces of unstructured grids are found with a hash table.
+bool UseHashTable = false;
+
 // convert a 5x5x5 uniform grid to unstructured grid
 vtkm::cont::DataSet MakeDataTestSet1()
 {
@@ -60,6 +67,7 @@ void TestExternalFacesExplicitGrid(const vtkm::cont::DataSet& ds,
   vtkm::filter::entity_extraction::ExternalFaces externalFaces;
   externalFaces.SetCompactPoints(compactPoints);
   externalFaces.SetPassPolyData(passPolyData);
+  externalFaces.SetUseHashTable(UseHashTable);
   vtkm::cont::DataSet resultds = externalFaces.Execute(ds);
 
   // verify cellset
@@ -135,13 +143,53 @@ void TestWithMixed2Dand3DMesh()
   TestExternalFacesExplicitGrid(ds, true, 6, 5, false);
 }
 
+// The hash table and sorted hashes extract the same faces, in a different order.
+void TestHashTableMatchesSortedHashes()
+{
+  std::cout << "Testing that the hash table finds the faces of the sorted hashes\n";
+  auto sortedFaces = [](const vtkm::cont::DataSet& ds) {
+    vtkm::cont::CellSetExplicit<> cellSet =
+      ds.GetCellSet().AsCellSet<vtkm::cont::CellSetExplicit<>>();
+    vtkm::cont::ArrayHandle<vtkm::Float32> cellvar;
+    ds.GetCellField("cellvar").GetData().AsArrayHandle(cellvar);
+    auto cellvarPortal = cellvar.ReadPortal();
+    std::vector<std::pair<std::vector<vtkm::Id>, vtkm::Float32>> faces;
+    for (vtkm::Id cell = 0; cell < cellSet.GetNumberOfCells(); ++cell)
+    {
+      std::vector<vtkm::Id> pointIds(
+        static_cast<std::size_t>(cellSet.GetNumberOfPointsInCell(cell)));
+      cellSet.GetCellPointIds(cell, pointIds.data());
+      std::sort(pointIds.begin(), pointIds.end());
+      faces.emplace_back(pointIds, cellvarPortal.Get(cell));
+    }
+    std::sort(faces.begin(), faces.end());
+    return faces;
+  };
+
+  for (const vtkm::cont::DataSet& ds :
+       { MakeDataTestSet1(), MakeDataTestSet2(), MakeDataTestSet5() })
+  {
+    vtkm::filter::entity_extraction::ExternalFaces externalFaces;
+    auto expected = sortedFaces(externalFaces.Execute(ds));
+    externalFaces.SetUseHashTable(true);
+    auto faces = sortedFaces(externalFaces.Execute(ds));
+    VTKM_TEST_ASSERT(faces == expected, "Hash table found different external faces");
+  }
+}
+
 void TestExternalFacesFilter()
 {
-  TestWithHeterogeneousMesh();
-  TestWithHexahedraMesh();
-  TestWithUniformMesh();
-  TestWithRectilinearMesh();
-  TestWithMixed2Dand3DMesh();
+  for (bool useHashTable : { false, true })
+  {
+    std::cout << "Use hash table: " << std::boolalpha << useHashTable << "\n";
+    UseHashTable = useHashTable;
+    TestWithHeterogeneousMesh();
+    TestWithHexahedraMesh();
+    TestWithUniformMesh();
+    TestWithRectilinearMesh();
+    TestWithMixed2Dand3DMesh();
+  }
+  TestHashTableMatchesSortedHashes();
 }
 
 } // anonymous namespace
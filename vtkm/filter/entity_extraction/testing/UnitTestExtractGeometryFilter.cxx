@@ -8,10 +8,15 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
 #include <vtkm/filter/entity_extraction/ExtractGeometry.h>
+#include <vtkm/worklet/ImplicitFunctionBricks.h>
 
 using vtkm::cont::testing::MakeTestDataSet;
 
@@ -128,12 +133,99 @@ public:
     VTKM_TEST_ASSERT(outCellData.ReadPortal().Get(55) == 63.f, "Wrong cell field data");
   }
 
+  static void TestBricks(vtkm::cont::DataSet& dataset)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(dataset.GetNumberOfCells()), cellIds);
+    dataset.AddCellField("cellid", cellIds);
+
+    // The same mesh with explicit coordinates is processed without bricks.
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+    vtkm::cont::ArrayCopy(dataset.GetCoordinateSystem().GetData(), points);
+    vtkm::cont::DataSet reference;
+    reference.SetCellSet(dataset.GetCellSet());
+    reference.AddField(dataset.GetField("cellid"));
+    reference.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coordinates", points));
+
+    std::vector<vtkm::ImplicitFunctionGeneral> functions = {
+      vtkm::Sphere(vtkm::Vec3f(2.0f, 2.5f, 0.5f), 1.3f),
+      vtkm::Box(vtkm::Vec3f(1.05f, 1.05f, -0.55f), vtkm::Vec3f(2.55f, 3.05f, 2.05f)),
+      vtkm::Plane(vtkm::Vec3f(3.0f, 3.0f, 3.0f), vtkm::Vec3f(1.0f, 0.5f, 0.0f))
+    };
+    for (const auto& function : functions)
+    {
+      using Bricks = vtkm::worklet::ImplicitFunctionBricks;
+      Bricks bricks;
+      VTKM_TEST_ASSERT(
+        bricks.Run(dataset.GetCellSet(), function, 0.0, dataset.GetCoordinateSystem()),
+        "Bricks should support this mesh");
+      VTKM_TEST_ASSERT(bricks.GetNumberOfBricks(Bricks::Crossing) < bricks.GetNumberOfBricks(),
+                       "Some bricks should have been pruned");
+      VTKM_TEST_ASSERT(bricks.GetNumberOfBricks(Bricks::Inside) +
+                           bricks.GetNumberOfBricks(Bricks::Outside) +
+                           bricks.GetNumberOfBricks(Bricks::Crossing) ==
+                         bricks.GetNumberOfBricks(),
+                       "Every brick should be classified");
+
+      for (int flags = 0; flags < 8; ++flags)
+      {
+        vtkm::filter::entity_extraction::ExtractGeometry extractGeometry;
+        extractGeometry.SetImplicitFunction(function);
+        extractGeometry.SetExtractInside((flags & 1) != 0);
+        extractGeometry.SetExtractBoundaryCells((flags & 2) != 0);
+        extractGeometry.SetExtractOnlyBoundaryCells((flags & 4) != 0);
+        extractGeometry.SetFieldsToPass("cellid");
+
+        vtkm::cont::DataSet output = extractGeometry.Execute(dataset);
+        vtkm::cont::DataSet expected = extractGeometry.Execute(reference);
+        VTKM_TEST_ASSERT(output.GetNumberOfCells() == expected.GetNumberOfCells(),
+                         "Wrong number of cells with bricks");
+        VTKM_TEST_ASSERT(test_equal_ArrayHandles(output.GetField("cellid").GetData(),
+                                                 expected.GetField("cellid").GetData()),
+                         "Wrong cells with bricks");
+      }
+    }
+  }
+
+  static void TestUniformBricks()
+  {
+    std::cout << "Testing extract geometry with bricks on uniform mesh" << std::endl;
+    vtkm::cont::DataSet dataset = vtkm::cont::DataSetBuilderUniform::Create(
+      vtkm::Id3(70, 60, 50), vtkm::Vec3f(0.0f, 0.0f, 0.0f), vtkm::Vec3f(0.1f, 0.1f, 0.1f));
+    TestBricks(dataset);
+  }
+
+  static void TestUniform2DBricks()
+  {
+    std::cout << "Testing extract geometry with bricks on 2D uniform mesh" << std::endl;
+    vtkm::cont::DataSet dataset = vtkm::cont::DataSetBuilderUniform::Create(
+      vtkm::Id2(70, 60), vtkm::Vec2f(0.0f, 0.0f), vtkm::Vec2f(0.1f, 0.1f));
+    TestBricks(dataset);
+  }
+
+  static void TestRectilinearBricks()
+  {
+    std::cout << "Testing extract geometry with bricks on rectilinear mesh" << std::endl;
+    std::vector<vtkm::FloatDefault> x(70), y(60), z(50);
+    for (std::size_t i = 0; i < x.size(); ++i)
+      x[i] = 0.002f * static_cast<vtkm::FloatDefault>(i * i);
+    for (std::size_t i = 0; i < y.size(); ++i)
+      y[i] = 0.1f * static_cast<vtkm::FloatDefault>(i);
+    for (std::size_t i = 0; i < z.size(); ++i)
+      z[i] = 0.15f * static_cast<vtkm::FloatDefault>(i);
+    vtkm::cont::DataSet dataset = vtkm::cont::DataSetBuilderRectilinear::Create(x, y, z);
+    TestBricks(dataset);
+  }
+
   void operator()() const
   {
     TestingExtractGeometry::TestUniformByBox0();
     TestingExtractGeometry::TestUniformByBox1();
     TestingExtractGeometry::TestUniformByBox2();
     TestingExtractGeometry::TestUniformByBox3();
+    TestingExtractGeometry::TestUniformBricks();
+    TestingExtractGeometry::TestUniform2DBricks();
+    TestingExtractGeometry::TestRectilinearBricks();
   }
 };
 }
@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/DataSetBuilderRectilinear.h>
@@ -333,9 +334,69 @@ void TestGhostCellRemove()
     }
   }
 }
+
+void TestGhostCellRemoveBlockViews()
+{
+  std::cout << "Testing GhostCellRemove without copying fields" << std::endl;
+  std::vector<std::vector<vtkm::Id>> tests = { { 10, 5, 0, 2 }, { 10, 5, 7, 2 }, { 6, 6, 6, 0 } };
+  for (auto& t : tests)
+  {
+    vtkm::Id nx = t[0], ny = t[1], nz = t[2];
+    int layer = static_cast<int>(t[3]);
+    for (const std::string dsType : { "uniform", "rectilinear" })
+    {
+      std::string nameType = "default";
+      vtkm::cont::DataSet ds = (dsType == "uniform") ? MakeUniform(nx, ny, nz, layer, nameType)
+                                                     : MakeRectilinear(nx, ny, nz, layer, nameType);
+      vtkm::cont::ArrayHandle<vtkm::Float32> pointField;
+      vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(ds.GetNumberOfPoints()), pointField);
+      ds.AddPointField("pointvar", pointField);
+      vtkm::cont::ArrayHandle<vtkm::Id> cellField;
+      vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(ds.GetNumberOfCells()), cellField);
+      ds.AddCellField("cellvar", cellField);
+
+      vtkm::filter::entity_extraction::GhostCellRemove ghostCellRemoval;
+      auto copied = ghostCellRemoval.Execute(ds);
+      ghostCellRemoval.SetCopyFields(false);
+      auto viewed = ghostCellRemoval.Execute(ds);
+
+      VTKM_TEST_ASSERT(viewed.GetNumberOfCells() == copied.GetNumberOfCells(),
+                       "Wrong number of cells in output");
+      VTKM_TEST_ASSERT(viewed.GetNumberOfPoints() == copied.GetNumberOfPoints(),
+                       "Wrong number of points in output");
+      VTKM_TEST_ASSERT(viewed.GetCellSet().GetCellSetBase()->GetCellShape(0) ==
+                         copied.GetCellSet().GetCellSetBase()->GetCellShape(0),
+                       "Wrong cell shape in output");
+      VTKM_TEST_ASSERT(
+        test_equal_ArrayHandles(viewed.GetCoordinateSystem().GetData(),
+                                copied.GetCoordinateSystem().GetData()),
+        "Wrong coordinates in output");
+      for (const std::string name : { "pointvar", "cellvar" })
+      {
+        VTKM_TEST_ASSERT(
+          test_equal_ArrayHandles(viewed.GetField(name).GetData(), copied.GetField(name).GetData()),
+          "Wrong field ",
+          name,
+          " in output");
+      }
+      VTKM_TEST_ASSERT(!viewed.GetField("cellvar").GetData().IsType<decltype(cellField)>(),
+                       "Cell field should be a view of the input");
+      VTKM_TEST_ASSERT(viewed.HasGhostCellField(), "Ghost field should be passed");
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(viewed.GetGhostCellField().GetData(),
+                                               copied.GetGhostCellField().GetData()),
+                       "Wrong ghost field in output");
+    }
+  }
+}
+
+void TestGhostCellRemoveFilter()
+{
+  TestGhostCellRemove();
+  TestGhostCellRemoveBlockViews();
+}
 }
 
 int UnitTestGhostCellRemove(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestGhostCellRemove, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestGhostCellRemoveFilter, argc, argv);
 }
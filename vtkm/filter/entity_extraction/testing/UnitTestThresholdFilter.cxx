@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/CellSetPermutation.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -311,6 +312,55 @@ public:
     VTKM_TEST_ASSERT(failures == 0, "Some combinations have failed");
   }
 
+  static void TestPermutationOutput()
+  {
+    std::cout << "Testing threshold with a permutation of the input cells" << std::endl;
+    vtkm::cont::DataSet dataset = MakeTestDataSet().Make3DUniformDataSet0();
+
+    vtkm::filter::entity_extraction::Threshold threshold;
+    threshold.SetLowerThreshold(20);
+    threshold.SetUpperThreshold(21);
+    threshold.SetActiveField("pointvar");
+    threshold.SetFieldsToPass("cellvar");
+    auto copied = threshold.Execute(dataset);
+
+    threshold.SetCopyCells(false);
+    auto permuted = threshold.Execute(dataset);
+
+    using PermutedCellSet = vtkm::cont::CellSetPermutation<vtkm::cont::CellSetStructured<3>>;
+    VTKM_TEST_ASSERT(permuted.GetCellSet().IsType<PermutedCellSet>(),
+                     "Expected a permutation of the input cells");
+    VTKM_TEST_ASSERT(permuted.GetNumberOfCells() == copied.GetNumberOfCells(),
+                     "Wrong number of cells in the permuted output");
+    VTKM_TEST_ASSERT(permuted.GetNumberOfPoints() == copied.GetNumberOfPoints(),
+                     "Wrong number of points in the permuted output");
+
+    auto permutedCells = permuted.GetCellSet().AsCellSet<PermutedCellSet>();
+    auto copiedCells = copied.GetCellSet().AsCellSet<vtkm::cont::CellSetExplicit<>>();
+    for (vtkm::Id cell = 0; cell < permuted.GetNumberOfCells(); ++cell)
+    {
+      vtkm::Id permutedIds[8];
+      vtkm::Id copiedIds[8];
+      permutedCells.GetCellPointIds(cell, permutedIds);
+      copiedCells.GetCellPointIds(cell, copiedIds);
+      for (vtkm::IdComponent i = 0; i < 8; ++i)
+      {
+        VTKM_TEST_ASSERT(permutedIds[i] == copiedIds[i], "Wrong permuted connectivity");
+      }
+    }
+
+    using FieldArray = vtkm::cont::ArrayHandle<vtkm::Float32>;
+    using PermutedField =
+      vtkm::cont::ArrayHandlePermutation<vtkm::cont::ArrayHandle<vtkm::Id>, FieldArray>;
+    VTKM_TEST_ASSERT(permuted.GetCellField("cellvar").GetData().IsType<PermutedField>(),
+                     "Expected a permutation of the input cell field");
+    VTKM_TEST_ASSERT(
+      test_equal_ArrayHandles(
+        permuted.GetCellField("cellvar").GetData().AsArrayHandle<PermutedField>(),
+        copied.GetCellField("cellvar").GetData().AsArrayHandle<FieldArray>()),
+      "Wrong permuted cell field");
+  }
+
   // Regression test for issue #804
   static void RegressionTest804()
   {
@@ -341,6 +391,7 @@ public:
     TestingThreshold::TestExplicit3D();
     TestingThreshold::TestExplicit3DZeroResults();
     TestingThreshold::TestAllOptions();
+    TestingThreshold::TestPermutationOutput();
     TestingThreshold::RegressionTest804();
   }
 };
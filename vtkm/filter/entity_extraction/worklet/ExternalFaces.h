@@ -35,10 +35,12 @@
 #include <vtkm/cont/Field.h>
 #include <vtkm/cont/Timer.h>
 
+#include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/DispatcherMapTopology.h>
 #include <vtkm/worklet/DispatcherReduceByKey.h>
 #include <vtkm/worklet/Keys.h>
 #include <vtkm/worklet/ScatterCounting.h>
+#include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 #include <vtkm/worklet/WorkletReduceByKey.h>
 
@@ -367,6 +369,159 @@ struct ExternalFaces
     }
   };
 
+  //Worklet that identifies each cell face by its canonical id.
+  class FaceCanonicalId : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  FieldOut faceIds,
+                                  FieldOut originCells,
+                                  FieldOut originFaces);
+    using ExecutionSignature = void(_2, _3, _4, CellShape, PointIndices, InputIndex, VisitIndex);
+    using InputDomain = _1;
+
+    using ScatterType = vtkm::worklet::ScatterCounting;
+
+    template <typename CellShapeTag, typename CellNodeVecType>
+    VTKM_EXEC void operator()(vtkm::Id3& faceId,
+                              vtkm::Id& cellIndex,
+                              vtkm::IdComponent& faceIndex,
+                              CellShapeTag shape,
+                              const CellNodeVecType& cellNodeIds,
+                              vtkm::Id inputIndex,
+                              vtkm::IdComponent visitIndex) const
+    {
+      vtkm::exec::CellFaceCanonicalId(visitIndex, shape, cellNodeIds, faceId);
+      cellIndex = inputIndex;
+      faceIndex = visitIndex;
+    }
+  };
+
+  // Worklet that inserts each face in an open addressing hash table keyed on the
+  // canonical face id. An empty slot holds -1 and a slot holding face i is
+  // replaced with -(i + 2) when the matching face of another cell is found, which
+  // cancels the internal face pair in place. A face that finds an already paired
+  // face keeps probing, so as with the sorted keys at most 2 faces cancel.
+  class InsertFace : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn faceIds, WholeArrayIn allFaceIds, AtomicArrayInOut table);
+    using ExecutionSignature = void(_1, InputIndex, _2, _3);
+    using InputDomain = _1;
+
+    template <typename FaceIdsPortal, typename TablePortal>
+    VTKM_EXEC void operator()(const vtkm::Id3& faceId,
+                              vtkm::Id faceIndex,
+                              const FaceIdsPortal& allFaceIds,
+                              const TablePortal& table) const
+    {
+      const vtkm::Id mask = table.GetNumberOfValues() - 1;
+      vtkm::Id slot = static_cast<vtkm::Id>(vtkm::Hash(faceId)) & mask;
+      vtkm::Id current = table.Get(slot);
+      while (true)
+      {
+        if (current == -1)
+        {
+          if (table.CompareExchange(slot, &current, faceIndex))
+          {
+            return;
+          }
+          // Another face took the slot. Look at it again.
+          continue;
+        }
+        if (current >= 0 && allFaceIds.Get(current) == faceId)
+        {
+          if (table.CompareExchange(slot, &current, -(current + 2)))
+          {
+            return;
+          }
+          continue;
+        }
+        slot = (slot + 1) & mask;
+        current = table.Get(slot);
+      }
+    }
+  };
+
+  // Worklet that flags the faces left unpaired in the hash table as external.
+  class MarkExternalFace : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn table, WholeArrayOut isExternal);
+    using ExecutionSignature = void(_1, _2);
+    using InputDomain = _1;
+
+    template <typename IsExternalPortal>
+    VTKM_EXEC void operator()(vtkm::Id faceIndex, const IsExternalPortal& isExternal) const
+    {
+      if (faceIndex >= 0)
+      {
+        isExternal.Set(faceIndex, 1);
+      }
+    }
+  };
+
+  // Worklet that returns the number of points of each external face found with the hash table.
+  class NumPointsPerExternalFace : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn originCells,
+                                  FieldIn originFaces,
+                                  WholeCellSetIn<> inputCells,
+                                  FieldOut numPointsInFace);
+    using ExecutionSignature = void(_1, _2, _3, _4);
+    using InputDomain = _1;
+
+    template <typename CellSetType>
+    VTKM_EXEC void operator()(vtkm::Id originCell,
+                              vtkm::IdComponent originFace,
+                              const CellSetType& cellSet,
+                              vtkm::IdComponent& numFacePoints) const
+    {
+      vtkm::exec::CellFaceNumberOfPoints(
+        originFace, cellSet.GetCellShape(originCell), numFacePoints);
+    }
+  };
+
+  // Worklet that returns the shape and connectivity of each external face found
+  // with the hash table.
+  class BuildExternalFaceConnectivity : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn originCells,
+                                  FieldIn originFaces,
+                                  WholeCellSetIn<> inputCells,
+                                  FieldOut shapesOut,
+                                  FieldOut connectivityOut);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5);
+    using InputDomain = _1;
+
+    template <typename CellSetType, typename ConnectivityType>
+    VTKM_EXEC void operator()(vtkm::Id originCell,
+                              vtkm::IdComponent originFace,
+                              const CellSetType& cellSet,
+                              vtkm::UInt8& shapeOut,
+                              ConnectivityType& connectivityOut) const
+    {
+      typename CellSetType::CellShapeTag shapeIn = cellSet.GetCellShape(originCell);
+      vtkm::exec::CellFaceShape(originFace, shapeIn, shapeOut);
+
+      vtkm::IdComponent numFacePoints;
+      vtkm::exec::CellFaceNumberOfPoints(originFace, shapeIn, numFacePoints);
+      VTKM_ASSERT(numFacePoints == connectivityOut.GetNumberOfComponents());
+
+      typename CellSetType::IndicesType inCellIndices = cellSet.GetIndices(originCell);
+      for (vtkm::IdComponent facePointIndex = 0; facePointIndex < numFacePoints; facePointIndex++)
+      {
+        vtkm::IdComponent localFaceIndex;
+        vtkm::ErrorCode status =
+          vtkm::exec::CellFaceLocalIndex(facePointIndex, originFace, shapeIn, localFaceIndex);
+        connectivityOut[facePointIndex] =
+          (status == vtkm::ErrorCode::Success) ? inCellIndices[localFaceIndex] : 0;
+      }
+    }
+  };
+
   // Worklet that identifies the number of cells written out per face.
   // Because there can be collisions in the face ids, this instance might
   // represent multiple faces, which have to be checked. The resulting
@@ -676,6 +831,12 @@ public:
   VTKM_CONT
   bool GetPassPolyData() const { return this->PassPolyData; }
 
+  VTKM_CONT
+  void SetUseHashTable(bool flag) { this->UseHashTable = flag; }
+
+  VTKM_CONT
+  bool GetUseHashTable() const { return this->UseHashTable; }
+
   void ReleaseCellMapArrays() { this->CellIdMap.ReleaseResources(); }
 
 
@@ -848,57 +1009,68 @@ public:
       }
     }
 
-    vtkm::cont::ArrayHandle<vtkm::HashType> faceHashes;
-    vtkm::cont::ArrayHandle<vtkm::Id> originCells;
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> originFaces;
-    vtkm::worklet::DispatcherMapTopology<FaceHash> faceHashDispatcher(scatterCellToFace);
+    PointCountArrayType facePointCount;
+    ShapeArrayType faceShapes;
+    OffsetsArrayType faceOffsets;
+    ConnectivityArrayType faceConnectivity;
+    vtkm::cont::ArrayHandle<vtkm::Id> faceToCellIdMap;
+    if (this->UseHashTable)
+    {
+      this->MatchFacesWithHashTable(inCellSet,
+                                    scatterCellToFace,
+                                    facePointCount,
+                                    faceShapes,
+                                    faceOffsets,
+                                    faceConnectivity,
+                                    faceToCellIdMap);
+    }
+    else
+    {
+      vtkm::cont::ArrayHandle<vtkm::HashType> faceHashes;
+      vtkm::cont::ArrayHandle<vtkm::Id> originCells;
+      vtkm::cont::ArrayHandle<vtkm::IdComponent> originFaces;
+      vtkm::worklet::DispatcherMapTopology<FaceHash> faceHashDispatcher(scatterCellToFace);
 
-    faceHashDispatcher.Invoke(inCellSet, faceHashes, originCells, originFaces);
+      faceHashDispatcher.Invoke(inCellSet, faceHashes, originCells, originFaces);
 
-    vtkm::worklet::Keys<vtkm::HashType> faceKeys(faceHashes);
+      vtkm::worklet::Keys<vtkm::HashType> faceKeys(faceHashes);
 
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> faceOutputCount;
-    vtkm::worklet::DispatcherReduceByKey<FaceCounts> faceCountDispatcher;
+      vtkm::cont::ArrayHandle<vtkm::IdComponent> faceOutputCount;
+      vtkm::worklet::DispatcherReduceByKey<FaceCounts> faceCountDispatcher;
 
-    faceCountDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, faceOutputCount);
+      faceCountDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, faceOutputCount);
 
-    auto scatterCullInternalFaces = NumPointsPerFace::MakeScatter(faceOutputCount);
+      auto scatterCullInternalFaces = NumPointsPerFace::MakeScatter(faceOutputCount);
 
-    PointCountArrayType facePointCount;
-    vtkm::worklet::DispatcherReduceByKey<NumPointsPerFace> pointsPerFaceDispatcher(
-      scatterCullInternalFaces);
+      vtkm::worklet::DispatcherReduceByKey<NumPointsPerFace> pointsPerFaceDispatcher(
+        scatterCullInternalFaces);
 
-    pointsPerFaceDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, facePointCount);
+      pointsPerFaceDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, facePointCount);
 
-    ShapeArrayType faceShapes;
+      vtkm::Id connectivitySize;
+      vtkm::cont::ConvertNumComponentsToOffsets(facePointCount, faceOffsets, connectivitySize);
 
-    OffsetsArrayType faceOffsets;
-    vtkm::Id connectivitySize;
-    vtkm::cont::ConvertNumComponentsToOffsets(facePointCount, faceOffsets, connectivitySize);
+      // Must pre allocate because worklet invocation will not have enough
+      // information to.
+      faceConnectivity.Allocate(connectivitySize);
 
-    ConnectivityArrayType faceConnectivity;
-    // Must pre allocate because worklet invocation will not have enough
-    // information to.
-    faceConnectivity.Allocate(connectivitySize);
+      vtkm::worklet::DispatcherReduceByKey<BuildConnectivity> buildConnectivityDispatcher(
+        scatterCullInternalFaces);
 
-    vtkm::worklet::DispatcherReduceByKey<BuildConnectivity> buildConnectivityDispatcher(
-      scatterCullInternalFaces);
-
-    vtkm::cont::ArrayHandle<vtkm::Id> faceToCellIdMap;
+      buildConnectivityDispatcher.Invoke(
+        faceKeys,
+        inCellSet,
+        originCells,
+        originFaces,
+        faceShapes,
+        vtkm::cont::make_ArrayHandleGroupVecVariable(faceConnectivity, faceOffsets),
+        faceToCellIdMap);
+    }
 
     // Create a view that doesn't have the last offset:
     auto faceOffsetsTrim =
       vtkm::cont::make_ArrayHandleView(faceOffsets, 0, faceOffsets.GetNumberOfValues() - 1);
 
-    buildConnectivityDispatcher.Invoke(
-      faceKeys,
-      inCellSet,
-      originCells,
-      originFaces,
-      faceShapes,
-      vtkm::cont::make_ArrayHandleGroupVecVariable(faceConnectivity, faceOffsets),
-      faceToCellIdMap);
-
     if (!polyDataConnectivitySize)
     {
       outCellSet.Fill(inCellSet.GetNumberOfPoints(), faceShapes, faceConnectivity, faceOffsets);
@@ -948,8 +1120,81 @@ public:
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->CellIdMap; }
 
 private:
+  // Finds the external faces by inserting every face in a hash table keyed on its
+  // canonical id, which cancels the internal face pairs without sorting the faces.
+  // The external faces are output in the order of the cells they belong to.
+  template <typename InCellSetType,
+            typename ShapeArrayType,
+            typename OffsetsArrayType,
+            typename ConnectivityArrayType>
+  VTKM_CONT static void MatchFacesWithHashTable(
+    const InCellSetType& inCellSet,
+    const vtkm::worklet::ScatterCounting& scatterCellToFace,
+    vtkm::cont::ArrayHandle<vtkm::IdComponent>& facePointCount,
+    ShapeArrayType& faceShapes,
+    OffsetsArrayType& faceOffsets,
+    ConnectivityArrayType& faceConnectivity,
+    vtkm::cont::ArrayHandle<vtkm::Id>& faceToCellIdMap)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id3> faceIds;
+    vtkm::cont::ArrayHandle<vtkm::Id> originCells;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> originFaces;
+    vtkm::worklet::DispatcherMapTopology<FaceCanonicalId> faceIdDispatcher(scatterCellToFace);
+
+    faceIdDispatcher.Invoke(inCellSet, faceIds, originCells, originFaces);
+
+    // Keep the table at most half full so that the probe sequences stay short.
+    const vtkm::Id numFaces = faceIds.GetNumberOfValues();
+    vtkm::Id tableSize = 1;
+    while (tableSize < 2 * numFaces)
+    {
+      tableSize *= 2;
+    }
+    vtkm::cont::ArrayHandle<vtkm::Id> table;
+    table.AllocateAndFill(tableSize, -1);
+    vtkm::worklet::DispatcherMapField<InsertFace> insertFaceDispatcher;
+
+    insertFaceDispatcher.Invoke(faceIds, faceIds, table);
+    faceIds.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::UInt8> isExternal;
+    isExternal.AllocateAndFill(numFaces, 0);
+    vtkm::worklet::DispatcherMapField<MarkExternalFace> markExternalDispatcher;
+
+    markExternalDispatcher.Invoke(table, isExternal);
+    table.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> externalOriginFaces;
+    vtkm::cont::Algorithm::CopyIf(originCells, isExternal, faceToCellIdMap);
+    vtkm::cont::Algorithm::CopyIf(originFaces, isExternal, externalOriginFaces);
+    originCells.ReleaseResources();
+    originFaces.ReleaseResources();
+
+    vtkm::worklet::DispatcherMapField<NumPointsPerExternalFace> pointsPerFaceDispatcher;
+
+    pointsPerFaceDispatcher.Invoke(
+      faceToCellIdMap, externalOriginFaces, inCellSet, facePointCount);
+
+    vtkm::Id connectivitySize;
+    vtkm::cont::ConvertNumComponentsToOffsets(facePointCount, faceOffsets, connectivitySize);
+
+    // Must pre allocate because worklet invocation will not have enough
+    // information to.
+    faceConnectivity.Allocate(connectivitySize);
+
+    vtkm::worklet::DispatcherMapField<BuildExternalFaceConnectivity> buildConnectivityDispatcher;
+
+    buildConnectivityDispatcher.Invoke(
+      faceToCellIdMap,
+      externalOriginFaces,
+      inCellSet,
+      faceShapes,
+      vtkm::cont::make_ArrayHandleGroupVecVariable(faceConnectivity, faceOffsets));
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
   bool PassPolyData;
+  bool UseHashTable = false;
 
 }; //struct ExternalFaces
 }
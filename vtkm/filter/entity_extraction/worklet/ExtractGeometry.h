@@ -10,11 +10,13 @@
 #ifndef vtkm_m_worklet_ExtractGeometry_h
 #define vtkm_m_worklet_ExtractGeometry_h
 
+#include <vtkm/worklet/ImplicitFunctionBricks.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/CellSetPermutation.h>
 #include <vtkm/cont/CoordinateSystem.h>
 #include <vtkm/cont/Invoker.h>
@@ -70,7 +72,14 @@ public:
           outCnt++;
       }
 
-      // Decide if cell is extracted
+      return this->PassCell(numIndices, inCnt, outCnt);
+    }
+
+    // Decide if cell is extracted
+    VTKM_EXEC_CONT bool PassCell(vtkm::Id numIndices,
+                                 vtkm::IdComponent inCnt,
+                                 vtkm::IdComponent outCnt) const
+    {
       bool passFlag = false;
       if (inCnt == numIndices && ExtractInside && !ExtractOnlyBoundaryCells)
       {
@@ -93,6 +102,50 @@ public:
     bool ExtractOnlyBoundaryCells;
   };
 
+  ////////////////////////////////////////////////////////////////////////////////////
+  // Worklet to identify cells within volume of interest from the state of their brick. The
+  // function is only evaluated at the cells of the bricks it crosses.
+  class ExtractCellsByVOIInBricks : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  FieldInCell brickStates,
+                                  WholeArrayIn coordinates,
+                                  ExecObject implicitFunction,
+                                  FieldOutCell passFlags);
+    using ExecutionSignature = _5(PointCount, PointIndices, _2, _3, _4);
+
+    VTKM_CONT
+    ExtractCellsByVOIInBricks(bool extractInside,
+                              bool extractBoundaryCells,
+                              bool extractOnlyBoundaryCells)
+      : CellsByVOI(extractInside, extractBoundaryCells, extractOnlyBoundaryCells)
+    {
+    }
+
+    template <typename ConnectivityInVec, typename InVecFieldPortalType, typename ImplicitFunction>
+    VTKM_EXEC bool operator()(vtkm::Id numIndices,
+                              const ConnectivityInVec& connectivityIn,
+                              vtkm::UInt8 brickState,
+                              const InVecFieldPortalType& coordinates,
+                              const ImplicitFunction& function) const
+    {
+      using Bricks = vtkm::worklet::ImplicitFunctionBricks;
+      if (brickState == Bricks::Inside)
+      {
+        return this->CellsByVOI.PassCell(numIndices, static_cast<vtkm::IdComponent>(numIndices), 0);
+      }
+      else if (brickState == Bricks::Outside)
+      {
+        return this->CellsByVOI.PassCell(numIndices, 0, static_cast<vtkm::IdComponent>(numIndices));
+      }
+      return this->CellsByVOI(numIndices, connectivityIn, coordinates, function);
+    }
+
+  private:
+    ExtractCellsByVOI CellsByVOI;
+  };
+
   class AddPermutationCellSet
   {
     vtkm::cont::UnknownCellSet* Output;
@@ -152,6 +205,33 @@ public:
     return vtkm::cont::CellSetPermutation<CellSetType>(this->ValidCellIds, cellSet);
   }
 
+  ////////////////////////////////////////////////////////////////////////////////////
+  // Extract cells by implicit function classified by bricks permutes input data. The cells
+  // of bricks entirely inside or outside are kept or dropped as a whole, and the function is
+  // only evaluated at the cells of the bricks it crosses.
+  template <typename CellSetType>
+  vtkm::cont::CellSetPermutation<CellSetType> Run(
+    const CellSetType& cellSet,
+    const vtkm::cont::CoordinateSystem& coordinates,
+    const vtkm::ImplicitFunctionGeneral& implicitFunction,
+    const vtkm::worklet::ImplicitFunctionBricks& bricks,
+    bool extractInside,
+    bool extractBoundaryCells,
+    bool extractOnlyBoundaryCells)
+  {
+    vtkm::cont::ArrayHandle<bool> passFlags;
+
+    ExtractCellsByVOIInBricks worklet(
+      extractInside, extractBoundaryCells, extractOnlyBoundaryCells);
+    vtkm::cont::Invoker invoke;
+    invoke(worklet, cellSet, bricks.GetCellStates(), coordinates, implicitFunction, passFlags);
+
+    vtkm::cont::Algorithm::CopyIf(
+      vtkm::cont::ArrayHandleIndex(passFlags.GetNumberOfValues()), passFlags, this->ValidCellIds);
+
+    return vtkm::cont::CellSetPermutation<CellSetType>(this->ValidCellIds, cellSet);
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> GetValidCellIds() const { return this->ValidCellIds; }
 
 private:
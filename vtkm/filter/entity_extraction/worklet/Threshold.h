@@ -141,6 +141,24 @@ public:
     return output;
   }
 
+  // Same as `Run`, but returns a `CellSetPermutation` of the input cells instead of
+  // copying the connectivity of the passing cells.
+  template <typename ValueType, typename StorageType, typename UnaryPredicate>
+  vtkm::cont::UnknownCellSet RunPermutation(
+    const vtkm::cont::UnknownCellSet& cellSet,
+    const vtkm::cont::ArrayHandle<ValueType, StorageType>& field,
+    vtkm::cont::Field::Association fieldType,
+    const UnaryPredicate& predicate,
+    bool allPointsMustPass = false, // only considered when field association is `Points`
+    bool invert = false)
+  {
+    vtkm::cont::UnknownCellSet output;
+    CastAndCall(cellSet, [&](auto concrete) {
+      output = this->RunImpl(concrete, field, fieldType, predicate, allPointsMustPass, invert);
+    });
+    return output;
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> GetValidCellIds() const { return this->ValidCellIds; }
 
 private:
@@ -10,8 +10,11 @@
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/filter/field_conversion/CellAverage.h>
+#include <vtkm/filter/field_conversion/internal/AverageFields.h>
 #include <vtkm/filter/field_conversion/worklet/CellAverage.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace filter
@@ -21,6 +24,11 @@ namespace field_conversion
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet CellAverage::DoExecute(const vtkm::cont::DataSet& input)
 {
+  if (this->ConvertAllFields || (this->GetNumberOfActiveFields() > 1))
+  {
+    return this->ExecuteMultipleFields(input);
+  }
+
   const auto& field = GetFieldFromDataSet(input);
   if (!field.IsPointField())
   {
@@ -46,6 +54,45 @@ vtkm::cont::DataSet CellAverage::DoExecute(const vtkm::cont::DataSet& input)
   }
   return this->CreateResultFieldCell(input, outputName, outArray);
 }
+
+vtkm::cont::DataSet CellAverage::ExecuteMultipleFields(const vtkm::cont::DataSet& input)
+{
+  std::vector<vtkm::cont::Field> fields;
+  if (this->ConvertAllFields)
+  {
+    for (vtkm::IdComponent index = 0; index < input.GetNumberOfFields(); ++index)
+    {
+      const vtkm::cont::Field& field = input.GetField(index);
+      if (field.IsPointField() && !input.HasCoordinateSystem(field.GetName()))
+      {
+        fields.push_back(field);
+      }
+    }
+  }
+  else
+  {
+    for (vtkm::IdComponent index = 0; index < this->GetNumberOfActiveFields(); ++index)
+    {
+      const vtkm::cont::Field& field = this->GetFieldFromDataSet(index, input);
+      if (!field.IsPointField())
+      {
+        throw vtkm::cont::ErrorFilterExecution("Point field expected.");
+      }
+      fields.push_back(field);
+    }
+  }
+
+  vtkm::cont::DataSet result = this->CreateResult(input);
+  internal::AverageFields(this->Invoke,
+                          vtkm::worklet::CellAverage{},
+                          input.GetCellSet(),
+                          fields,
+                          vtkm::cont::Field::Association::Cells,
+                          input.GetNumberOfCells(),
+                          this->ConvertAllFields,
+                          result);
+  return result;
+}
 } // namespace field_conversion
 } // namespace filter
 } // namespace vtkm
@@ -12,8 +12,11 @@
 #include <vtkm/cont/UncertainCellSet.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/filter/field_conversion/PointAverage.h>
+#include <vtkm/filter/field_conversion/internal/AverageFields.h>
 #include <vtkm/filter/field_conversion/worklet/PointAverage.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace filter
@@ -22,6 +25,11 @@ namespace field_conversion
 {
 vtkm::cont::DataSet PointAverage::DoExecute(const vtkm::cont::DataSet& input)
 {
+  if (this->ConvertAllFields || (this->GetNumberOfActiveFields() > 1))
+  {
+    return this->ExecuteMultipleFields(input);
+  }
+
   const auto& field = GetFieldFromDataSet(input);
   if (!field.IsCellField())
   {
@@ -55,6 +63,48 @@ vtkm::cont::DataSet PointAverage::DoExecute(const vtkm::cont::DataSet& input)
   }
   return this->CreateResultFieldPoint(input, outputName, outArray);
 }
+
+vtkm::cont::DataSet PointAverage::ExecuteMultipleFields(const vtkm::cont::DataSet& input)
+{
+  std::vector<vtkm::cont::Field> fields;
+  if (this->ConvertAllFields)
+  {
+    for (vtkm::IdComponent index = 0; index < input.GetNumberOfFields(); ++index)
+    {
+      const vtkm::cont::Field& field = input.GetField(index);
+      if (field.IsCellField() && (field.GetName() != input.GetGhostCellFieldName()))
+      {
+        fields.push_back(field);
+      }
+    }
+  }
+  else
+  {
+    for (vtkm::IdComponent index = 0; index < this->GetNumberOfActiveFields(); ++index)
+    {
+      const vtkm::cont::Field& field = this->GetFieldFromDataSet(index, input);
+      if (!field.IsCellField())
+      {
+        throw vtkm::cont::ErrorFilterExecution("Cell field expected.");
+      }
+      fields.push_back(field);
+    }
+  }
+
+  vtkm::cont::UnknownCellSet cellSet = input.GetCellSet();
+  using SupportedCellSets =
+    vtkm::ListAppend<vtkm::List<vtkm::cont::CellSetExtrude>, VTKM_DEFAULT_CELL_SET_LIST>;
+  vtkm::cont::DataSet result = this->CreateResult(input);
+  internal::AverageFields(this->Invoke,
+                          vtkm::worklet::PointAverage{},
+                          cellSet.ResetCellSetList<SupportedCellSets>(),
+                          fields,
+                          vtkm::cont::Field::Association::Points,
+                          input.GetNumberOfPoints(),
+                          this->ConvertAllFields,
+                          result);
+  return result;
+}
 }
 }
 }
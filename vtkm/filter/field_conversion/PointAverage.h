@@ -34,8 +34,24 @@ namespace field_conversion
 ///
 class VTKM_FILTER_FIELD_CONVERSION_EXPORT PointAverage : public vtkm::filter::Filter
 {
+public:
+  /// @brief Specify whether to convert all the cell fields of the input.
+  ///
+  /// When on, every cell field of the input (except ghost cells) is converted. Each
+  /// output point field has the same name as its input field. This flag is off by default.
+  ///
+  /// Several fields are also converted together when more than one active field is
+  /// set with `SetActiveField(index, name)`. In either case, fields with the same
+  /// base component type are averaged in a single traversal of the topology.
+  VTKM_CONT void SetConvertAllFields(bool flag) { this->ConvertAllFields = flag; }
+  /// @copydoc SetConvertAllFields
+  VTKM_CONT bool GetConvertAllFields() const { return this->ConvertAllFields; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+  VTKM_CONT vtkm::cont::DataSet ExecuteMultipleFields(const vtkm::cont::DataSet& input);
+
+  bool ConvertAllFields = false;
 };
 } // namespace field_conversion
 } // namespace filter
@@ -0,0 +1,99 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_field_conversion_internal_AverageFields_h
+#define vtk_m_filter_field_conversion_internal_AverageFields_h
+
+#include <vtkm/cont/ArrayHandleRecombineVec.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/Field.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace field_conversion
+{
+namespace internal
+{
+
+/// Averages several fields with one averaging worklet and adds them to `result` with
+/// `association`.
+///
+/// The components of all the fields with the same base component type are recombined into
+/// one array, so the topology is traversed once per component type instead of once per
+/// field. A field whose component type is not supported is skipped when `skipUnsupported`
+/// is set, and raises an error otherwise.
+template <typename WorkletType, typename CellSetType>
+VTKM_CONT void AverageFields(const vtkm::cont::Invoker& invoke,
+                             const WorkletType& worklet,
+                             const CellSetType& cellSet,
+                             const std::vector<vtkm::cont::Field>& fields,
+                             vtkm::cont::Field::Association association,
+                             vtkm::Id numberOfValues,
+                             bool skipUnsupported,
+                             vtkm::cont::DataSet& result)
+{
+  std::vector<vtkm::cont::UnknownArrayHandle> outArrays(fields.size());
+  std::vector<bool> converted(fields.size(), false);
+
+  auto resolveComponentType = [&](auto baseComponent) {
+    using T = decltype(baseComponent);
+    vtkm::cont::ArrayHandleRecombineVec<T> inGroup;
+    vtkm::cont::ArrayHandleRecombineVec<T> outGroup;
+    for (std::size_t index = 0; index < fields.size(); ++index)
+    {
+      const vtkm::cont::UnknownArrayHandle& inArray = fields[index].GetData();
+      if (converted[index] || !inArray.IsBaseComponentType<T>())
+      {
+        continue;
+      }
+      outArrays[index] = inArray.NewInstanceBasic();
+      outArrays[index].Allocate(numberOfValues);
+      auto inComponents = inArray.ExtractArrayFromComponents<T>();
+      auto outComponents = outArrays[index].ExtractArrayFromComponents<T>(vtkm::CopyFlag::Off);
+      for (vtkm::IdComponent c = 0; c < inComponents.GetNumberOfComponents(); ++c)
+      {
+        inGroup.AppendComponentArray(inComponents.GetComponentArray(c));
+        outGroup.AppendComponentArray(outComponents.GetComponentArray(c));
+      }
+      converted[index] = true;
+    }
+    if (inGroup.GetNumberOfComponents() > 0)
+    {
+      invoke(worklet, cellSet, inGroup, outGroup);
+    }
+  };
+  vtkm::ListForEach(resolveComponentType, vtkm::TypeListScalarAll{});
+
+  for (std::size_t index = 0; index < fields.size(); ++index)
+  {
+    if (converted[index])
+    {
+      result.AddField(vtkm::cont::Field(fields[index].GetName(), association, outArrays[index]));
+    }
+    else if (!skipUnsupported)
+    {
+      throw vtkm::cont::ErrorFilterExecution("Unsupported type for field " +
+                                             fields[index].GetName());
+    }
+  }
+}
+
+}
+}
+}
+} // namespace vtkm::filter::field_conversion::internal
+
+#endif // vtk_m_filter_field_conversion_internal_AverageFields_h
@@ -113,12 +113,68 @@ void TestPointAverageExplicit2()
   }
 }
 
+void TestPointAverageMultipleFields()
+{
+  std::cout << "Testing PointAverage Filter on several fields" << std::endl;
+
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataSet = testDataSet.Make3DUniformDataSet0();
+
+  // Add fields of different types and sizes, so some of them are grouped together.
+  vtkm::cont::ArrayHandle<vtkm::Float32> scalars;
+  dataSet.GetCellField("cellvar").GetData().AsArrayHandle(scalars);
+  const vtkm::Id numValues = scalars.GetNumberOfValues();
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> vectors;
+  vtkm::cont::ArrayHandle<vtkm::Float64> doubles;
+  vtkm::cont::ArrayHandle<vtkm::Id> ids;
+  vectors.Allocate(numValues);
+  doubles.Allocate(numValues);
+  ids.Allocate(numValues);
+  for (vtkm::Id index = 0; index < numValues; ++index)
+  {
+    vtkm::Float32 value = scalars.ReadPortal().Get(index);
+    vectors.WritePortal().Set(index, vtkm::Vec3f_32(value, 2 * value, -value));
+    doubles.WritePortal().Set(index, static_cast<vtkm::Float64>(index) / 3);
+    ids.WritePortal().Set(index, 4 * index);
+  }
+  dataSet.AddCellField("vectors", vectors);
+  dataSet.AddCellField("doubles", doubles);
+  dataSet.AddCellField("ids", ids);
+
+  const std::vector<std::string> names = { "cellvar", "vectors", "doubles", "ids" };
+  auto checkFields = [&](const vtkm::cont::DataSet& result) {
+    for (const std::string& name : names)
+    {
+      vtkm::filter::field_conversion::PointAverage single;
+      single.SetActiveField(name);
+      auto expected = single.Execute(dataSet);
+      VTKM_TEST_ASSERT(result.HasPointField(name), "Field missing.");
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetPointField(name).GetData(),
+                                               expected.GetPointField(name).GetData()),
+                       "Wrong result for field ",
+                       name);
+    }
+  };
+
+  vtkm::filter::field_conversion::PointAverage activeFields;
+  for (std::size_t index = 0; index < names.size(); ++index)
+  {
+    activeFields.SetActiveField(static_cast<vtkm::IdComponent>(index), names[index]);
+  }
+  checkFields(activeFields.Execute(dataSet));
+
+  vtkm::filter::field_conversion::PointAverage allFields;
+  allFields.SetConvertAllFields(true);
+  checkFields(allFields.Execute(dataSet));
+}
+
 void TestPointAverage()
 {
   TestPointAverageUniform3D();
   TestPointAverageRegular3D();
   TestPointAverageExplicit1();
   TestPointAverageExplicit2();
+  TestPointAverageMultipleFields();
 }
 }
 
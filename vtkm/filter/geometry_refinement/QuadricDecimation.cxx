@@ -0,0 +1,77 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/UncertainCellSet.h>
+#include <vtkm/filter/MapFieldMergeAverage.h>
+#include <vtkm/filter/MapFieldPermutation.h>
+#include <vtkm/filter/geometry_refinement/QuadricDecimation.h>
+#include <vtkm/filter/geometry_refinement/worklet/QuadricDecimation.h>
+
+namespace
+{
+VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
+                          const vtkm::cont::Field& field,
+                          const vtkm::worklet::QuadricDecimation& worklet)
+{
+  if (field.IsPointField())
+  {
+    return vtkm::filter::MapFieldMergeAverage(field, worklet.GetPointKeys(), result);
+  }
+  else if (field.IsCellField())
+  {
+    return vtkm::filter::MapFieldPermutation(field, worklet.GetCellIdMap(), result);
+  }
+  else if (field.IsWholeDataSetField())
+  {
+    result.AddField(field);
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+namespace geometry_refinement
+{
+VTKM_CONT vtkm::cont::DataSet QuadricDecimation::DoExecute(const vtkm::cont::DataSet& input)
+{
+  const vtkm::cont::CoordinateSystem& inCoords = input.GetCoordinateSystem();
+  auto inCellSet = input.GetCellSet().ResetCellSetList<VTKM_DEFAULT_CELL_SET_LIST_UNSTRUCTURED>();
+
+  vtkm::Id target = this->GetTargetNumberOfTriangles();
+  if (target <= 0)
+  {
+    target = static_cast<vtkm::Id>(static_cast<vtkm::Float64>(input.GetNumberOfCells()) *
+                                   (1.0 - this->GetTargetReduction()));
+  }
+
+  vtkm::worklet::QuadricDecimation worklet;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> points;
+  vtkm::cont::CellSetSingleType<> outCellSet =
+    worklet.Run(inCellSet, inCoords.GetData(), target, points);
+
+  // Keep the value type of the input coordinates.
+  vtkm::cont::UnknownArrayHandle outCoords = inCoords.GetData().NewInstanceBasic();
+  vtkm::cont::ArrayCopy(points, outCoords);
+
+  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  return this->CreateResultCoordinateSystem(
+    input, outCellSet, inCoords.GetName(), outCoords, mapper);
+}
+} // namespace geometry_refinement
+} // namespace filter
+} // namespace vtkm
@@ -0,0 +1,75 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_geometry_refinement_QuadricDecimation_h
+#define vtk_m_filter_geometry_refinement_QuadricDecimation_h
+
+#include <vtkm/filter/Filter.h>
+#include <vtkm/filter/geometry_refinement/vtkm_filter_geometry_refinement_export.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace geometry_refinement
+{
+/// \brief Reduce the number of triangles in a mesh with quadric error metric edge collapses.
+///
+/// `QuadricDecimation` simplifies a triangle mesh by collapsing edges into points placed
+/// where they minimize the quadric error metric of Garland and Heckbert, which measures the
+/// squared distance to the planes of the original triangles. The input must be a
+/// `vtkm::cont::DataSet` that contains only triangles.
+///
+/// The edges are collapsed in parallel rounds. In each round, an edge collapses when it is
+/// the cheapest of all the edges that touch the triangles around it, so the collapses of a
+/// round do not interfere with each other. Collapses that would flip a triangle or make the
+/// mesh non-manifold are rejected. The points of boundary and non-manifold edges are kept
+/// in place.
+///
+/// Compared to `VertexClustering`, this filter is slower but gives a much more accurate
+/// surface for the same number of triangles. Point fields are averaged over the points that
+/// collapse together and cell fields are taken from the remaining cells.
+class VTKM_FILTER_GEOMETRY_REFINEMENT_EXPORT QuadricDecimation : public vtkm::filter::Filter
+{
+public:
+  /// @brief Specifies the number of triangles to reach.
+  ///
+  /// The filter stops collapsing edges when the mesh has this many triangles or fewer, or
+  /// when no edge can collapse. When 0 (the default), the target is derived from the
+  /// target reduction.
+  VTKM_CONT void SetTargetNumberOfTriangles(vtkm::Id count)
+  {
+    this->TargetNumberOfTriangles = count;
+  }
+  /// @copydoc SetTargetNumberOfTriangles
+  VTKM_CONT vtkm::Id GetTargetNumberOfTriangles() const { return this->TargetNumberOfTriangles; }
+
+  /// @brief Specifies the fraction of the triangles to remove.
+  ///
+  /// This is only used when no target number of triangles is set. The default is 0.9,
+  /// which keeps 10% of the triangles.
+  VTKM_CONT void SetTargetReduction(vtkm::Float64 reduction)
+  {
+    this->TargetReduction = vtkm::Min(vtkm::Max(0.0, reduction), 1.0);
+  }
+  /// @copydoc SetTargetReduction
+  VTKM_CONT vtkm::Float64 GetTargetReduction() const { return this->TargetReduction; }
+
+private:
+  VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  vtkm::Id TargetNumberOfTriangles = 0;
+  vtkm::Float64 TargetReduction = 0.9;
+};
+} // namespace geometry_refinement
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_geometry_refinement_QuadricDecimation_h
@@ -28,9 +28,14 @@ VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
   else if (field.IsCellField())
   {
     // cell data must be scattered to the cells created per input cell
-    vtkm::cont::ArrayHandle<vtkm::Id> permutation =
-      worklet.GetOutCellScatter().GetOutputToInputMap();
-    return vtkm::filter::MapFieldPermutation(field, permutation, result);
+    if (worklet.HasImplicitCellMap())
+    {
+      result.AddField(vtkm::cont::Field(field.GetName(),
+                                        field.GetAssociation(),
+                                        worklet.ProcessImplicitCellField(field.GetData())));
+      return true;
+    }
+    return vtkm::filter::MapFieldPermutation(field, worklet.GetOutCellMap(), result);
   }
   else if (field.IsWholeDataSetField())
   {
@@ -68,7 +73,7 @@ VTKM_CONT vtkm::cont::DataSet Tetrahedralize::DoExecute(const vtkm::cont::DataSe
 
   // In case we already have a CellSetSingleType of tetras,
   // don't call the worklet and return the input DataSet directly
-  if (inCellSet.CanConvert<vtkm::cont::CellSetSingleType<>>() &&
+  if (!this->UseInt32Connectivity && inCellSet.CanConvert<vtkm::cont::CellSetSingleType<>>() &&
       inCellSet.AsCellSet<vtkm::cont::CellSetSingleType<>>().GetCellShapeAsId() ==
         vtkm::CellShapeTagTetra::Id)
   {
@@ -80,7 +85,7 @@ VTKM_CONT vtkm::cont::DataSet Tetrahedralize::DoExecute(const vtkm::cont::DataSe
 
   // Optimization in case we only have tetras in the CellSet
   bool allTetras = false;
-  if (inCellSet.CanConvert<vtkm::cont::CellSetExplicit<>>())
+  if (!this->UseInt32Connectivity && inCellSet.CanConvert<vtkm::cont::CellSetExplicit<>>())
   {
     vtkm::cont::CellSetExplicit<> inCellSetExplicit =
       inCellSet.AsCellSet<vtkm::cont::CellSetExplicit<>>();
@@ -111,12 +116,33 @@ VTKM_CONT vtkm::cont::DataSet Tetrahedralize::DoExecute(const vtkm::cont::DataSe
   if (!allTetras)
   {
     vtkm::worklet::Tetrahedralize worklet;
-    vtkm::cont::CastAndCall(inCellSet,
-                            [&](const auto& concrete) { outCellSet = worklet.Run(concrete); });
-
     auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
-    // create the output dataset (without a CoordinateSystem).
-    output = this->CreateResult(input, outCellSet, mapper);
+
+    if (this->ImplicitConnectivity && inCellSet.CanConvert<vtkm::cont::CellSetStructured<3>>())
+    {
+      // Structured tetrahedra are computed on the fly, so no connectivity is stored.
+      output = this->CreateResult(
+        input,
+        worklet.RunImplicit(inCellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>()),
+        mapper);
+    }
+    else
+    {
+      vtkm::cont::UnknownCellSet tetrahedralized;
+      vtkm::cont::CastAndCall(inCellSet, [&](const auto& concrete) {
+        if (this->UseInt32Connectivity)
+        {
+          tetrahedralized = worklet.RunInt32(concrete);
+        }
+        else
+        {
+          tetrahedralized = worklet.Run(concrete);
+        }
+      });
+
+      // create the output dataset (without a CoordinateSystem).
+      output = this->CreateResult(input, tetrahedralized, mapper);
+    }
   }
 
   // We did not change the geometry of the input dataset at all. Just attach coordinate system
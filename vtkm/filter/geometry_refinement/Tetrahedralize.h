@@ -31,7 +31,33 @@ namespace geometry_refinement
 /// will not have exactly the same interpolation.
 class VTKM_FILTER_GEOMETRY_REFINEMENT_EXPORT Tetrahedralize : public vtkm::filter::Filter
 {
+public:
+  /// @brief Specify whether 3D structured input produces implicit connectivity.
+  ///
+  /// When on, a `vtkm::cont::CellSetStructured<3>` input is turned into a
+  /// `vtkm::cont::CellSetStructuredTetrahedralized`, which computes the points of each
+  /// tetrahedron from the structured index instead of storing them. Worklets can use the
+  /// output like any other cell set, but filters that only support the default cell set
+  /// types will not accept it. Off by default.
+  VTKM_CONT void SetImplicitConnectivity(bool flag) { this->ImplicitConnectivity = flag; }
+  /// @copydoc SetImplicitConnectivity
+  VTKM_CONT bool GetImplicitConnectivity() const { return this->ImplicitConnectivity; }
+
+  /// @brief Specify whether the output connectivity is stored as 32-bit integers.
+  ///
+  /// When on, the output is a `vtkm::cont::CellSetSingleType` whose connectivity array is a
+  /// `vtkm::cont::ArrayHandleCast` of a `vtkm::Int32` array, which halves the size of the
+  /// connectivity. Input that already consists of tetrahedra is also converted. Filters that
+  /// only support the default cell set types will not accept this output. Off by default.
+  VTKM_CONT void SetUseInt32Connectivity(bool flag) { this->UseInt32Connectivity = flag; }
+  /// @copydoc SetUseInt32Connectivity
+  VTKM_CONT bool GetUseInt32Connectivity() const { return this->UseInt32Connectivity; }
+
+private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  bool ImplicitConnectivity = false;
+  bool UseInt32Connectivity = false;
 };
 
 } // namespace geometry_refinement
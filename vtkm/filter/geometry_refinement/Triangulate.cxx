@@ -29,9 +29,7 @@ VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
   else if (field.IsCellField())
   {
     // cell data must be scattered to the cells created per input cell
-    vtkm::cont::ArrayHandle<vtkm::Id> permutation =
-      worklet.GetOutCellScatter().GetOutputToInputMap();
-    return vtkm::filter::MapFieldPermutation(field, permutation, result);
+    return vtkm::filter::MapFieldPermutation(field, worklet.GetOutCellMap(), result);
   }
   else if (field.IsWholeDataSetField())
   {
@@ -69,7 +67,7 @@ VTKM_CONT vtkm::cont::DataSet Triangulate::DoExecute(const vtkm::cont::DataSet&
 
   // In case we already have a CellSetSingleType of tetras,
   // don't call the worklet and return the input DataSet directly
-  if (inCellSet.CanConvert<vtkm::cont::CellSetSingleType<>>() &&
+  if (!this->UseInt32Connectivity && inCellSet.CanConvert<vtkm::cont::CellSetSingleType<>>() &&
       inCellSet.AsCellSet<vtkm::cont::CellSetSingleType<>>().GetCellShapeAsId() ==
         vtkm::CellShapeTagTriangle::Id)
   {
@@ -81,7 +79,7 @@ VTKM_CONT vtkm::cont::DataSet Triangulate::DoExecute(const vtkm::cont::DataSet&
 
   // Optimization in case we only have triangles in the CellSet
   bool allTriangles = false;
-  if (inCellSet.CanConvert<vtkm::cont::CellSetExplicit<>>())
+  if (!this->UseInt32Connectivity && inCellSet.CanConvert<vtkm::cont::CellSetExplicit<>>())
   {
     vtkm::cont::CellSetExplicit<> inCellSetExplicit =
       inCellSet.AsCellSet<vtkm::cont::CellSetExplicit<>>();
@@ -111,12 +109,21 @@ VTKM_CONT vtkm::cont::DataSet Triangulate::DoExecute(const vtkm::cont::DataSet&
   if (!allTriangles)
   {
     vtkm::worklet::Triangulate worklet;
-    vtkm::cont::CastAndCall(inCellSet,
-                            [&](const auto& concrete) { outCellSet = worklet.Run(concrete); });
+    vtkm::cont::UnknownCellSet triangulated;
+    vtkm::cont::CastAndCall(inCellSet, [&](const auto& concrete) {
+      if (this->UseInt32Connectivity)
+      {
+        triangulated = worklet.RunInt32(concrete);
+      }
+      else
+      {
+        triangulated = worklet.Run(concrete);
+      }
+    });
 
     auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
     // create the output dataset (without a CoordinateSystem).
-    output = this->CreateResult(input, outCellSet, mapper);
+    output = this->CreateResult(input, triangulated, mapper);
   }
 
   // We did not change the geometry of the input dataset at all. Just attach coordinate system
@@ -31,7 +31,21 @@ namespace geometry_refinement
 /// will not have exactly the same interpolation.
 class VTKM_FILTER_GEOMETRY_REFINEMENT_EXPORT Triangulate : public vtkm::filter::Filter
 {
+public:
+  /// @brief Specify whether the output connectivity is stored as 32-bit integers.
+  ///
+  /// When on, the output is a `vtkm::cont::CellSetSingleType` whose connectivity array is a
+  /// `vtkm::cont::ArrayHandleCast` of a `vtkm::Int32` array, which halves the size of the
+  /// connectivity. Input that already consists of triangles is also converted. Filters that
+  /// only support the default cell set types will not accept this output. Off by default.
+  VTKM_CONT void SetUseInt32Connectivity(bool flag) { this->UseInt32Connectivity = flag; }
+  /// @copydoc SetUseInt32Connectivity
+  VTKM_CONT bool GetUseInt32Connectivity() const { return this->UseInt32Connectivity; }
+
+private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  bool UseInt32Connectivity = false;
 };
 
 } // namespace geometry_refinement
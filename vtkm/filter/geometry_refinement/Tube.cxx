@@ -16,9 +16,16 @@ namespace
 {
 VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
                           const vtkm::cont::Field& field,
-                          const vtkm::worklet::Tube& worklet)
+                          const vtkm::worklet::Tube& worklet,
+                          bool instanced)
 {
-  if (field.IsPointField())
+  if (field.IsPointField() && instanced)
+  {
+    // Instanced tubes use the input points.
+    result.AddField(field);
+    return true;
+  }
+  else if (field.IsPointField())
   {
     return vtkm::filter::MapFieldPermutation(field, worklet.GetOutputPointSourceIndex(), result);
   }
@@ -53,11 +60,20 @@ VTKM_CONT vtkm::cont::DataSet Tube::DoExecute(const vtkm::cont::DataSet& input)
   worklet.SetRadius(this->Radius);
 
   const auto& originalPoints = input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+  if (this->Instanced)
+  {
+    vtkm::cont::CellSetSingleType<> segments;
+    worklet.RunInstanced(originalPoints.GetDataAsMultiplexer(), input.GetCellSet(), segments);
+
+    auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet, true); };
+    return this->CreateResult(input, segments, mapper);
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Vec3f> newPoints;
   vtkm::cont::CellSetSingleType<> newCells;
   worklet.Run(originalPoints.GetDataAsMultiplexer(), input.GetCellSet(), newPoints, newCells);
 
-  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet, false); };
   // create the output dataset (without a CoordinateSystem).
   vtkm::cont::DataSet output = this->CreateResult(input, newCells, mapper);
 
@@ -43,12 +43,23 @@ public:
   /// specifies whether that cap is generated.
   VTKM_CONT void SetCapping(bool v) { this->Capping = v; }
 
+  /// @brief Specify whether the tubes are instanced instead of generated.
+  ///
+  /// When on, the output has one line cell for each segment of the polylines and keeps the
+  /// input points, so it is about as large as the input. The tubes are meant to be drawn by
+  /// a renderer that evaluates the radius on the fly, such as `vtkm::rendering::MapperCylinder`
+  /// with `SetRadius` set to the tube radius. The number of sides and capping do not apply.
+  /// This is off by default.
+  VTKM_CONT void SetInstanced(bool v) { this->Instanced = v; }
+  VTKM_CONT bool GetInstanced() const { return this->Instanced; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::FloatDefault Radius{};
   vtkm::Id NumberOfSides = 6;
   bool Capping = false;
+  bool Instanced = false;
 };
 } // namespace geometry_refinement
 } // namespace filter
@@ -54,12 +54,38 @@ VTKM_CONT vtkm::cont::DataSet VertexClustering::DoExecute(const vtkm::cont::Data
   vtkm::cont::UnknownCellSet outCellSet;
   vtkm::cont::UnknownArrayHandle outCoords;
   vtkm::worklet::VertexClustering worklet;
-  worklet.Run(inCellSet,
-              input.GetCoordinateSystem(),
-              bounds,
-              this->GetNumberOfDivisions(),
-              outCellSet,
-              outCoords);
+
+  auto runClustering = [&](const vtkm::Id3& divisions) {
+    worklet = vtkm::worklet::VertexClustering{};
+    worklet.SetUseQuadrics(this->GetUseQuadrics());
+    worklet.Run(inCellSet, input.GetCoordinateSystem(), bounds, divisions, outCellSet, outCoords);
+    return outCellSet.GetNumberOfCells();
+  };
+
+  vtkm::Id3 divisions = this->GetNumberOfDivisions();
+  vtkm::Id numTriangles = runClustering(divisions);
+
+  const vtkm::Id target = this->GetTargetNumberOfTriangles();
+  if ((target > 0) && (numTriangles > target))
+  {
+    // The number of triangles grows about with the square of the number of divisions.
+    // Scale the divisions down until the output is at most the target size. Every scaling
+    // shrinks the divisions above 1, and a single bin collapses every triangle, so the
+    // target is always reached.
+    while ((numTriangles > target) &&
+           ((divisions[0] > 1) || (divisions[1] > 1) || (divisions[2] > 1)))
+    {
+      const vtkm::Float64 ratio =
+        static_cast<vtkm::Float64>(target) / static_cast<vtkm::Float64>(numTriangles);
+      const vtkm::Float64 scale = vtkm::Min(0.95 * vtkm::Sqrt(ratio), 0.9);
+      for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+      {
+        divisions[dim] = vtkm::Max(
+          vtkm::Id{ 1 }, static_cast<vtkm::Id>(static_cast<vtkm::Float64>(divisions[dim]) * scale));
+      }
+      numTriangles = runClustering(divisions);
+    }
+  }
 
   auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
   return this->CreateResultCoordinateSystem(
@@ -45,6 +45,15 @@ namespace geometry_refinement
 /// doesn't increase the computation or memory of the algorithm and will produce
 /// significantly better results.
 ///
+/// When `UseQuadrics` is on, the representative vertex of each bin is placed where
+/// it minimizes the quadric error of the triangles around the vertices of the bin
+/// instead of being one of the vertices of the bin. This keeps sharp features and
+/// gives a much better surface for the same number of bins.
+///
+/// When a target number of triangles is given, the filter scales the number of
+/// divisions and runs the clustering again until the output has at most that
+/// many triangles.
+///
 class VTKM_FILTER_GEOMETRY_REFINEMENT_EXPORT VertexClustering : public vtkm::filter::Filter
 {
 public:
@@ -57,10 +66,31 @@ public:
   /// @copydoc SetNumberOfDivisions
   VTKM_CONT const vtkm::Id3& GetNumberOfDivisions() const { return this->NumberOfDivisions; }
 
+  /// @brief Specifies whether the clustered points are placed with quadric error metrics.
+  ///
+  /// When off (the default), a point of each bin is selected to represent the bin.
+  VTKM_CONT void SetUseQuadrics(bool flag) { this->UseQuadrics = flag; }
+  /// @copydoc SetUseQuadrics
+  VTKM_CONT bool GetUseQuadrics() const { return this->UseQuadrics; }
+
+  /// @brief Specifies the maximum number of triangles in the output.
+  ///
+  /// When positive, the number of divisions is used as a starting point and is scaled
+  /// until the output has at most this many triangles. Each adjustment runs the
+  /// clustering again. When 0 (the default), the number of divisions is used as is.
+  VTKM_CONT void SetTargetNumberOfTriangles(vtkm::Id count)
+  {
+    this->TargetNumberOfTriangles = count;
+  }
+  /// @copydoc SetTargetNumberOfTriangles
+  VTKM_CONT vtkm::Id GetTargetNumberOfTriangles() const { return this->TargetNumberOfTriangles; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Id3 NumberOfDivisions = { 256, 256, 256 };
+  bool UseQuadrics = false;
+  vtkm::Id TargetNumberOfTriangles = 0;
 };
 } // namespace geometry_refinement
 } // namespace filter
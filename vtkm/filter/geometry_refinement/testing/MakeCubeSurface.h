@@ -0,0 +1,90 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_geometry_refinement_testing_MakeCubeSurface_h
+#define vtk_m_filter_geometry_refinement_testing_MakeCubeSurface_h
+
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderExplicit.h>
+
+#include <map>
+#include <vector>
+
+// Makes the surface of the unit cube with n x n quads split in triangles on each side. The
+// triangles face outward.
+inline vtkm::cont::DataSet MakeCubeSurface(vtkm::Id n)
+{
+  std::vector<vtkm::Vec3f> points;
+  std::map<vtkm::Id3, vtkm::Id> pointIds;
+  auto pointId = [&](const vtkm::Id3& ijk) {
+    auto found = pointIds.find(ijk);
+    if (found != pointIds.end())
+    {
+      return found->second;
+    }
+    const vtkm::Id id = static_cast<vtkm::Id>(points.size());
+    points.push_back(vtkm::Vec3f(ijk) / static_cast<vtkm::FloatDefault>(n));
+    pointIds[ijk] = id;
+    return id;
+  };
+
+  std::vector<vtkm::Id> connectivity;
+  for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+  {
+    const vtkm::IdComponent b = (axis + 1) % 3;
+    const vtkm::IdComponent c = (axis + 2) % 3;
+    for (vtkm::Id side : { vtkm::Id{ 0 }, n })
+    {
+      for (vtkm::Id i = 0; i < n; ++i)
+      {
+        for (vtkm::Id j = 0; j < n; ++j)
+        {
+          vtkm::Id corners[4];
+          const vtkm::Id offsets[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+          for (int corner = 0; corner < 4; ++corner)
+          {
+            vtkm::Id3 ijk;
+            ijk[axis] = side;
+            ijk[b] = i + offsets[corner][0];
+            ijk[c] = j + offsets[corner][1];
+            corners[corner] = pointId(ijk);
+          }
+          if (side == 0)
+          {
+            std::swap(corners[1], corners[3]);
+          }
+          connectivity.insert(connectivity.end(), { corners[0], corners[1], corners[2] });
+          connectivity.insert(connectivity.end(), { corners[0], corners[2], corners[3] });
+        }
+      }
+    }
+  }
+
+  const vtkm::Id numCells = static_cast<vtkm::Id>(connectivity.size() / 3);
+  vtkm::cont::DataSetBuilderExplicit builder;
+  vtkm::cont::DataSet dataSet = builder.Create(
+    points, vtkm::CellShapeTagTriangle{}, 3, connectivity, "coordinates");
+
+  std::vector<vtkm::Float32> pointvar;
+  for (const vtkm::Vec3f& point : points)
+  {
+    pointvar.push_back(static_cast<vtkm::Float32>(point[0] + point[1] + point[2]));
+  }
+  dataSet.AddPointField("pointvar", pointvar);
+  std::vector<vtkm::Id> cellvar(static_cast<std::size_t>(numCells));
+  for (vtkm::Id cell = 0; cell < numCells; ++cell)
+  {
+    cellvar[static_cast<std::size_t>(cell)] = cell;
+  }
+  dataSet.AddCellField("cellvar", cellvar);
+  return dataSet;
+}
+
+#endif // vtk_m_filter_geometry_refinement_testing_MakeCubeSurface_h
@@ -0,0 +1,163 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/MakeTestDataSet.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vtkm/filter/geometry_refinement/QuadricDecimation.h>
+#include <vtkm/filter/geometry_refinement/testing/MakeCubeSurface.h>
+
+#include <map>
+#include <vector>
+
+namespace
+{
+
+vtkm::Float64 DistanceToCubeSurface(const vtkm::Vec3f_64& point)
+{
+  vtkm::Float64 distance = vtkm::Infinity64();
+  for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+  {
+    distance = vtkm::Min(distance, vtkm::Min(vtkm::Abs(point[axis]), vtkm::Abs(1 - point[axis])));
+  }
+  return distance;
+}
+
+void TestDecimateCube()
+{
+  std::cout << "Decimate the surface of a cube" << std::endl;
+  vtkm::cont::DataSet input = MakeCubeSurface(8);
+  VTKM_TEST_ASSERT(input.GetNumberOfCells() == 768);
+
+  vtkm::filter::geometry_refinement::QuadricDecimation decimation;
+  decimation.SetTargetNumberOfTriangles(100);
+  vtkm::cont::DataSet output = decimation.Execute(input);
+
+  const vtkm::Id numCells = output.GetNumberOfCells();
+  const vtkm::Id numPoints = output.GetNumberOfPoints();
+  std::cout << "  " << numCells << " triangles, " << numPoints << " points" << std::endl;
+  VTKM_TEST_ASSERT(numCells <= 100, "Too many triangles: ", numCells);
+  VTKM_TEST_ASSERT(numCells >= 12, "Too few triangles: ", numCells);
+  VTKM_TEST_ASSERT(output.GetField("pointvar").GetNumberOfValues() == numPoints);
+  VTKM_TEST_ASSERT(output.GetField("cellvar").GetNumberOfValues() == numCells);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> points;
+  vtkm::cont::ArrayCopy(output.GetCoordinateSystem().GetData(), points);
+  auto pointsPortal = points.ReadPortal();
+
+  // Flat sides collapse without error, so the points stay on the surface and the corners
+  // are kept.
+  vtkm::IdComponent numCorners = 0;
+  for (vtkm::Id pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+  {
+    const vtkm::Vec3f_64 point = pointsPortal.Get(pointIndex);
+    VTKM_TEST_ASSERT(DistanceToCubeSurface(point) < 1e-6, "Point off the surface: ", point);
+    auto onSide = [](vtkm::Float64 x) { return vtkm::Min(vtkm::Abs(x), vtkm::Abs(1 - x)) < 1e-6; };
+    if (onSide(point[0]) && onSide(point[1]) && onSide(point[2]))
+    {
+      ++numCorners;
+    }
+  }
+  VTKM_TEST_ASSERT(numCorners == 8, "Wrong number of corners: ", numCorners);
+
+  // The surface must stay closed, manifold, and oriented, so each edge is used once in each
+  // direction and the enclosed volume does not change.
+  vtkm::cont::CellSetSingleType<> cellSet;
+  output.GetCellSet().AsCellSet(cellSet);
+  auto connectivity =
+    cellSet.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{})
+      .ReadPortal();
+  std::map<vtkm::Id2, int> directedEdges;
+  vtkm::Float64 volume = 0;
+  for (vtkm::Id cell = 0; cell < numCells; ++cell)
+  {
+    const vtkm::Id3 triangle(connectivity.Get(3 * cell),
+                             connectivity.Get(3 * cell + 1),
+                             connectivity.Get(3 * cell + 2));
+    for (vtkm::IdComponent edge = 0; edge < 3; ++edge)
+    {
+      ++directedEdges[vtkm::Id2(triangle[edge], triangle[(edge + 1) % 3])];
+    }
+    volume += vtkm::Dot(pointsPortal.Get(triangle[0]),
+                        vtkm::Cross(pointsPortal.Get(triangle[1]), pointsPortal.Get(triangle[2]))) /
+      6.0;
+  }
+  for (const auto& edge : directedEdges)
+  {
+    VTKM_TEST_ASSERT(edge.second == 1, "Edge used more than once in a direction");
+    VTKM_TEST_ASSERT(directedEdges.count(vtkm::Id2(edge.first[1], edge.first[0])) == 1,
+                     "Open edge");
+  }
+  VTKM_TEST_ASSERT(test_equal(volume, 1.0), "Wrong volume: ", volume);
+}
+
+void TestTargetReduction()
+{
+  std::cout << "Decimate with a target reduction" << std::endl;
+  vtkm::cont::DataSet input = MakeCubeSurface(8);
+
+  vtkm::filter::geometry_refinement::QuadricDecimation decimation;
+  decimation.SetTargetReduction(0.5);
+  vtkm::cont::DataSet output = decimation.Execute(input);
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() <= 384);
+  // Each round stops close to the target.
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() >= 380);
+}
+
+void TestOpenSurface()
+{
+  std::cout << "Decimate a surface with a boundary" << std::endl;
+  vtkm::cont::testing::MakeTestDataSet maker;
+  vtkm::cont::DataSet input = maker.Make3DExplicitDataSetCowNose();
+
+  vtkm::filter::geometry_refinement::QuadricDecimation decimation;
+  decimation.SetTargetNumberOfTriangles(1);
+  vtkm::cont::DataSet output = decimation.Execute(input);
+
+  // The points of the boundary do not move, so the boundary is kept.
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() > 0);
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() < input.GetNumberOfCells());
+  VTKM_TEST_ASSERT(output.GetField("pointvar").GetNumberOfValues() == output.GetNumberOfPoints());
+}
+
+void TestNonTriangles()
+{
+  std::cout << "Reject cells that are not triangles" << std::endl;
+  vtkm::cont::testing::MakeTestDataSet maker;
+  vtkm::filter::geometry_refinement::QuadricDecimation decimation;
+  bool thrown = false;
+  try
+  {
+    decimation.Execute(maker.Make3DExplicitDataSet5());
+  }
+  catch (const vtkm::cont::ErrorBadValue&)
+  {
+    thrown = true;
+  }
+  VTKM_TEST_ASSERT(thrown, "Cells that are not triangles were not rejected");
+}
+
+void TestQuadricDecimation()
+{
+  TestDecimateCube();
+  TestTargetReduction();
+  TestOpenSurface();
+  TestNonTriangles();
+}
+
+} // anonymous namespace
+
+int UnitTestQuadricDecimationFilter(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestQuadricDecimation, argc, argv);
+}
@@ -155,6 +155,26 @@ void TestSplitSharpEdgesFilterSplitEveryEdge(
                                 expectedPointvar[static_cast<unsigned long>(i)]),
                      "point field array result does not match expected value");
   }
+
+  // Every face gets its own copy of each of its points, at the same location.
+  vtkm::cont::CellSetExplicit<> newCellset =
+    result.GetCellSet().AsCellSet<vtkm::cont::CellSetExplicit<>>();
+  const auto& connectivityArray = newCellset.GetConnectivityArray(vtkm::TopologyElementTagCell(),
+                                                                  vtkm::TopologyElementTagPoint());
+  auto connectivityArrayPortal = connectivityArray.ReadPortal();
+  std::vector<vtkm::IdComponent> pointUses(static_cast<std::size_t>(newCoords.GetNumberOfValues()));
+  for (vtkm::Id i = 0; i < connectivityArray.GetNumberOfValues(); i++)
+  {
+    const vtkm::Id pointId = connectivityArrayPortal.Get(i);
+    const vtkm::Id oldPointId = expectedConnectivityArray91[static_cast<std::size_t>(i)];
+    ++pointUses[static_cast<std::size_t>(pointId)];
+    VTKM_TEST_ASSERT(test_equal(newCoordsP.Get(pointId), expectedCoords[oldPointId]),
+                     "connectivity points to a copy of the wrong point");
+  }
+  for (vtkm::IdComponent uses : pointUses)
+  {
+    VTKM_TEST_ASSERT(uses == 1, "point is shared by faces across a sharp edge");
+  }
 }
 
 void TestSplitSharpEdgesFilterNoSplit(
@@ -221,6 +241,42 @@ void TestWithExplicitData()
   TestSplitSharpEdgesFilterNoSplit(simpleCubeWithSN, splitSharpEdgesFilter);
 }
 
+// Four triangles around point 0 on a ridge: faces 0 and 1 lie on one slope and faces 2 and 3
+// on the other, so the faces of the second slope are grouped below a root other than face 0.
+void TestWithRidge()
+{
+  std::vector<vtkm::Vec3f> coords = { vtkm::Vec3f(0, 0, 0),
+                                      vtkm::Vec3f(0, -1, 0),
+                                      vtkm::Vec3f(-1, 0, -1),
+                                      vtkm::Vec3f(0, 1, 0),
+                                      vtkm::Vec3f(1, 0, -1) };
+  std::vector<vtkm::UInt8> shapes(4, vtkm::CELL_SHAPE_TRIANGLE);
+  std::vector<vtkm::IdComponent> numIndices(4, 3);
+  std::vector<vtkm::Id> conn = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 1 };
+  vtkm::cont::DataSet ridge =
+    vtkm::cont::DataSetBuilderExplicit::Create(coords, shapes, numIndices, conn, "coordinates");
+
+  vtkm::filter::vector_analysis::SurfaceNormals surfaceNormalsFilter;
+  surfaceNormalsFilter.SetGenerateCellNormals(true);
+  ridge = surfaceNormalsFilter.Execute(ridge);
+
+  vtkm::filter::geometry_refinement::SplitSharpEdges split;
+  split.SetFeatureAngle(45);
+  split.SetActiveField("Normals", vtkm::cont::Field::Association::Cells);
+  vtkm::cont::DataSet result = split.Execute(ridge);
+
+  // The apex and both ends of the ridge get one copy for each slope.
+  VTKM_TEST_ASSERT(result.GetNumberOfPoints() == 8, "Wrong number of points");
+  vtkm::cont::CellSetExplicit<> cellSet =
+    result.GetCellSet().AsCellSet<vtkm::cont::CellSetExplicit<>>();
+  auto connectivity =
+    cellSet.GetConnectivityArray(vtkm::TopologyElementTagCell(), vtkm::TopologyElementTagPoint())
+      .ReadPortal();
+  VTKM_TEST_ASSERT(connectivity.Get(0) == connectivity.Get(3), "Apex split within a slope");
+  VTKM_TEST_ASSERT(connectivity.Get(6) == connectivity.Get(9), "Apex split within a slope");
+  VTKM_TEST_ASSERT(connectivity.Get(0) != connectivity.Get(6), "Apex shared across the ridge");
+}
+
 
 void TestWithStructuredData()
 {
@@ -255,6 +311,7 @@ void TestWithStructuredData()
 void TestSplitSharpEdgesFilter()
 {
   TestWithExplicitData();
+  TestWithRidge();
   TestWithStructuredData();
 }
 
@@ -8,6 +8,8 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/CellSetStructuredTetrahedralized.h>
+#include <vtkm/cont/ArrayHandleCast.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -45,6 +47,43 @@ public:
     VTKM_TEST_ASSERT(outData.ReadPortal().Get(9) == 100.2f, "Wrong cell field data");
   }
 
+  void TestStructuredImplicit() const
+  {
+    std::cout << "Testing tetrahedralize structured with implicit connectivity" << std::endl;
+    vtkm::cont::DataSet dataset = MakeTestDataSet().Make3DUniformDataSet0();
+
+    vtkm::filter::geometry_refinement::Tetrahedralize tetrahedralize;
+    tetrahedralize.SetFieldsToPass({ "pointvar", "cellvar" });
+    vtkm::cont::DataSet explicitOutput = tetrahedralize.Execute(dataset);
+
+    tetrahedralize.SetImplicitConnectivity(true);
+    vtkm::cont::DataSet output = tetrahedralize.Execute(dataset);
+    VTKM_TEST_ASSERT(output.GetCellSet().IsType<vtkm::cont::CellSetStructuredTetrahedralized>(),
+                     "Output CellSet is not implicit");
+    VTKM_TEST_ASSERT(test_equal(output.GetNumberOfCells(), 20), "Wrong result for Tetrahedralize");
+    VTKM_TEST_ASSERT(output.GetNumberOfCoordinateSystems() == 1);
+
+    // The implicit tetrahedra are the same as the explicit ones.
+    for (vtkm::Id cell = 0; cell < output.GetNumberOfCells(); ++cell)
+    {
+      vtkm::Id implicitIds[4];
+      vtkm::Id explicitIds[4];
+      output.GetCellSet().GetCellPointIds(cell, implicitIds);
+      explicitOutput.GetCellSet().GetCellPointIds(cell, explicitIds);
+      for (vtkm::IdComponent i = 0; i < 4; ++i)
+      {
+        VTKM_TEST_ASSERT(implicitIds[i] == explicitIds[i], "Wrong tetrahedron ", cell);
+      }
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Float32> outData;
+    output.GetField("cellvar").GetData().AsArrayHandle(outData);
+    VTKM_TEST_ASSERT(outData.ReadPortal().Get(5) == 100.2f, "Wrong cell field data");
+    VTKM_TEST_ASSERT(outData.ReadPortal().Get(9) == 100.2f, "Wrong cell field data");
+    VTKM_TEST_ASSERT(test_equal(output.GetField("pointvar").GetNumberOfValues(), 18),
+                     "Wrong number of points for Tetrahedralize");
+  }
+
   void TestExplicit() const
   {
     std::cout << "Testing tetrahedralize explicit" << std::endl;
@@ -112,11 +151,85 @@ public:
                      "Cell is not tetra");
   }
 
+  // Checks that two data sets have the same cells and the same cell field.
+  static void CheckSameCells(const vtkm::cont::DataSet& expected, const vtkm::cont::DataSet& actual)
+  {
+    VTKM_TEST_ASSERT(expected.GetNumberOfCells() == actual.GetNumberOfCells(),
+                     "Wrong number of cells");
+    for (vtkm::Id cell = 0; cell < expected.GetNumberOfCells(); ++cell)
+    {
+      vtkm::Id expectedIds[4];
+      vtkm::Id actualIds[4];
+      expected.GetCellSet().GetCellPointIds(cell, expectedIds);
+      actual.GetCellSet().GetCellPointIds(cell, actualIds);
+      for (vtkm::IdComponent i = 0; i < 4; ++i)
+      {
+        VTKM_TEST_ASSERT(expectedIds[i] == actualIds[i], "Wrong point in cell ", cell);
+      }
+    }
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(expected.GetField("cellvar").GetData(),
+                                             actual.GetField("cellvar").GetData()),
+                     "Wrong cell field data");
+  }
+
+  void TestInt32Connectivity() const
+  {
+    std::cout << "Testing tetrahedralize with Int32 connectivity" << std::endl;
+    using Int32CellSet = vtkm::cont::CellSetSingleType<
+      vtkm::cont::StorageTagCast<vtkm::Int32, vtkm::cont::StorageTagBasic>>;
+
+    for (const vtkm::cont::DataSet& dataset :
+         { MakeTestDataSet().Make3DUniformDataSet0(), MakeTestDataSet().Make3DExplicitDataSet5() })
+    {
+      vtkm::filter::geometry_refinement::Tetrahedralize filter;
+      filter.SetFieldsToPass({ "pointvar", "cellvar" });
+      vtkm::cont::DataSet expected = filter.Execute(dataset);
+
+      filter.SetUseInt32Connectivity(true);
+      vtkm::cont::DataSet output = filter.Execute(dataset);
+      VTKM_TEST_ASSERT(output.GetCellSet().IsType<Int32CellSet>(),
+                       "Output CellSet does not have Int32 connectivity");
+      CheckSameCells(expected, output);
+    }
+  }
+
+  void TestCellSetSingleTypeHexahedron() const
+  {
+    std::cout << "Testing tetrahedralize single type hexahedra" << std::endl;
+    // The same cells as an explicit cell set, which counts the output of each cell, and as a
+    // single type cell set, which finds the output size from the shape table.
+    std::vector<vtkm::Vec3f_32> coords(12);
+    std::vector<vtkm::UInt8> shapes(2, vtkm::CELL_SHAPE_HEXAHEDRON);
+    std::vector<vtkm::IdComponent> numIndices(2, 8);
+    std::vector<vtkm::Id> connectivity{ 0, 1, 4, 3, 6, 7, 10, 9, 1, 2, 5, 4, 7, 8, 11, 10 };
+
+    vtkm::cont::DataSetBuilderExplicit dsb;
+    vtkm::cont::DataSet explicitDataset = dsb.Create(coords, shapes, numIndices, connectivity);
+    explicitDataset.AddCellField("cellvar", std::vector<vtkm::Float32>{ 10.f, 20.f });
+
+    vtkm::cont::CellSetSingleType<> cellSet;
+    cellSet.Fill(12,
+                 vtkm::CELL_SHAPE_HEXAHEDRON,
+                 8,
+                 vtkm::cont::make_ArrayHandle(connectivity, vtkm::CopyFlag::On));
+    vtkm::cont::DataSet singleTypeDataset = explicitDataset;
+    singleTypeDataset.SetCellSet(cellSet);
+
+    vtkm::filter::geometry_refinement::Tetrahedralize filter;
+    vtkm::cont::DataSet expected = filter.Execute(explicitDataset);
+    vtkm::cont::DataSet output = filter.Execute(singleTypeDataset);
+    VTKM_TEST_ASSERT(output.GetNumberOfCells() == 10, "Wrong number of cells");
+    CheckSameCells(expected, output);
+  }
+
   void operator()() const
   {
     this->TestStructured();
+    this->TestStructuredImplicit();
     this->TestExplicit();
     this->TestCellSetSingleTypeTetra();
+    this->TestCellSetSingleTypeHexahedron();
+    this->TestInt32Connectivity();
     this->TestCellSetExplicitTetra();
   }
 };
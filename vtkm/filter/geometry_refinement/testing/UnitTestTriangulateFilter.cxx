@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayHandleCast.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -105,11 +106,84 @@ public:
                      "Cell is not triangular");
   }
 
+  // Checks that two data sets have the same cells and the same cell field.
+  static void CheckSameCells(const vtkm::cont::DataSet& expected, const vtkm::cont::DataSet& actual)
+  {
+    VTKM_TEST_ASSERT(expected.GetNumberOfCells() == actual.GetNumberOfCells(),
+                     "Wrong number of cells");
+    for (vtkm::Id cell = 0; cell < expected.GetNumberOfCells(); ++cell)
+    {
+      vtkm::Id expectedIds[3];
+      vtkm::Id actualIds[3];
+      expected.GetCellSet().GetCellPointIds(cell, expectedIds);
+      actual.GetCellSet().GetCellPointIds(cell, actualIds);
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        VTKM_TEST_ASSERT(expectedIds[i] == actualIds[i], "Wrong point in cell ", cell);
+      }
+    }
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(expected.GetField("cellvar").GetData(),
+                                             actual.GetField("cellvar").GetData()),
+                     "Wrong cell field data");
+  }
+
+  void TestInt32Connectivity() const
+  {
+    std::cout << "Testing triangulate with Int32 connectivity" << std::endl;
+    using Int32CellSet = vtkm::cont::CellSetSingleType<
+      vtkm::cont::StorageTagCast<vtkm::Int32, vtkm::cont::StorageTagBasic>>;
+
+    for (const vtkm::cont::DataSet& dataset :
+         { MakeTestDataSet().Make2DUniformDataSet1(), MakeTestDataSet().Make2DExplicitDataSet0() })
+    {
+      vtkm::filter::geometry_refinement::Triangulate filter;
+      filter.SetFieldsToPass({ "pointvar", "cellvar" });
+      vtkm::cont::DataSet expected = filter.Execute(dataset);
+
+      filter.SetUseInt32Connectivity(true);
+      vtkm::cont::DataSet output = filter.Execute(dataset);
+      VTKM_TEST_ASSERT(output.GetCellSet().IsType<Int32CellSet>(),
+                       "Output CellSet does not have Int32 connectivity");
+      CheckSameCells(expected, output);
+    }
+  }
+
+  void TestCellSetSingleTypeQuad() const
+  {
+    std::cout << "Testing triangulate single type quads" << std::endl;
+    // The same cells as an explicit cell set, which counts the output of each cell, and as a
+    // single type cell set, which finds the output size from the shape table.
+    std::vector<vtkm::Vec3f_32> coords(6);
+    std::vector<vtkm::UInt8> shapes(2, vtkm::CELL_SHAPE_QUAD);
+    std::vector<vtkm::IdComponent> numIndices(2, 4);
+    std::vector<vtkm::Id> connectivity{ 0, 1, 4, 3, 1, 2, 5, 4 };
+
+    vtkm::cont::DataSetBuilderExplicit dsb;
+    vtkm::cont::DataSet explicitDataset = dsb.Create(coords, shapes, numIndices, connectivity);
+    explicitDataset.AddCellField("cellvar", std::vector<vtkm::Float32>{ 10.f, 20.f });
+
+    vtkm::cont::CellSetSingleType<> cellSet;
+    cellSet.Fill(6,
+                 vtkm::CELL_SHAPE_QUAD,
+                 4,
+                 vtkm::cont::make_ArrayHandle(connectivity, vtkm::CopyFlag::On));
+    vtkm::cont::DataSet singleTypeDataset = explicitDataset;
+    singleTypeDataset.SetCellSet(cellSet);
+
+    vtkm::filter::geometry_refinement::Triangulate filter;
+    vtkm::cont::DataSet expected = filter.Execute(explicitDataset);
+    vtkm::cont::DataSet output = filter.Execute(singleTypeDataset);
+    VTKM_TEST_ASSERT(output.GetNumberOfCells() == 4, "Wrong number of cells");
+    CheckSameCells(expected, output);
+  }
+
   void operator()() const
   {
     this->TestStructured();
     this->TestExplicit();
     this->TestCellSetSingleTypeTriangle();
+    this->TestCellSetSingleTypeQuad();
+    this->TestInt32Connectivity();
     this->TestCellSetExplicitTriangle();
   }
 };
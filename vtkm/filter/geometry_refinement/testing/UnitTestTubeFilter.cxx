@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/geometry_refinement/Tube.h>
@@ -23,7 +24,7 @@ void appendPts(vtkm::cont::DataSetBuilderExplicitIterative& dsb,
   ids.push_back(pid);
 }
 
-void TestTubeFilters()
+vtkm::cont::DataSet MakePolylines()
 {
   using VecType = vtkm::Vec3f;
 
@@ -80,6 +81,12 @@ void TestTubeFilters()
 
   ds.AddPointField("pointVar", ptVar);
   ds.AddCellField("cellVar", cellVar);
+  return ds;
+}
+
+void TestTubeFilter()
+{
+  vtkm::cont::DataSet ds = MakePolylines();
 
   vtkm::filter::geometry_refinement::Tube tubeFilter;
   tubeFilter.SetCapping(true);
@@ -123,6 +130,53 @@ void TestTubeFilters()
     VTKM_TEST_ASSERT(portal.Get(i) == cellVals[static_cast<std::size_t>(i)],
                      "Wrong value for cell field");
 }
+
+void TestInstancedTubeFilter()
+{
+  vtkm::cont::DataSet ds = MakePolylines();
+
+  vtkm::filter::geometry_refinement::Tube tubeFilter;
+  tubeFilter.SetInstanced(true);
+  tubeFilter.SetRadius(static_cast<vtkm::FloatDefault>(0.2));
+  auto output = tubeFilter.Execute(ds);
+
+  //The points are not changed and each polyline segment is a line.
+  VTKM_TEST_ASSERT(output.GetNumberOfCoordinateSystems() == 1,
+                   "Wrong number of coordinate systems in the output dataset");
+  VTKM_TEST_ASSERT(output.GetNumberOfPoints() == ds.GetNumberOfPoints(),
+                   "Wrong number of coordinates");
+  VTKM_TEST_ASSERT(output.GetField("pointVar").GetNumberOfValues() == ds.GetNumberOfPoints(),
+                   "Wrong number of values in point field");
+
+  vtkm::cont::CellSetSingleType<> cells;
+  output.GetCellSet().AsCellSet(cells);
+  VTKM_TEST_ASSERT(cells.GetNumberOfCells() == 4, "Wrong number of cells");
+  VTKM_TEST_ASSERT(cells.GetCellShapeAsId() == vtkm::CELL_SHAPE_LINE, "Wrong cell shape");
+
+  std::vector<vtkm::Id> connVals = { 0, 1, 1, 2, 3, 4, 4, 5 };
+  auto connPortal =
+    cells.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{})
+      .ReadPortal();
+  VTKM_TEST_ASSERT(connPortal.GetNumberOfValues() == 8, "Wrong connectivity size");
+  for (vtkm::Id i = 0; i < 8; i++)
+    VTKM_TEST_ASSERT(connPortal.Get(i) == connVals[static_cast<std::size_t>(i)],
+                     "Wrong connectivity");
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> cellArr;
+  output.GetField("cellVar").GetData().AsArrayHandle(cellArr);
+  std::vector<vtkm::FloatDefault> cellVals = { 100, 100, 110, 110 };
+  auto portal = cellArr.ReadPortal();
+  VTKM_TEST_ASSERT(portal.GetNumberOfValues() == 4, "Wrong number of values in cell field");
+  for (vtkm::Id i = 0; i < 4; i++)
+    VTKM_TEST_ASSERT(portal.Get(i) == cellVals[static_cast<std::size_t>(i)],
+                     "Wrong value for cell field");
+}
+
+void TestTubeFilters()
+{
+  TestTubeFilter();
+  TestInstancedTubeFilter();
+}
 }
 
 int UnitTestTubeFilter(int argc, char* argv[])
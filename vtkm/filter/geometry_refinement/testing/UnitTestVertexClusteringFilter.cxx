@@ -12,13 +12,69 @@
 #include <vtkm/cont/testing/Testing.h>
 
 #include <vtkm/filter/geometry_refinement/VertexClustering.h>
+#include <vtkm/filter/geometry_refinement/testing/MakeCubeSurface.h>
 
 using vtkm::cont::testing::MakeTestDataSet;
 
 namespace
 {
+
+void TestQuadricClustering()
+{
+  vtkm::cont::DataSet dataSet = MakeCubeSurface(8);
+
+  vtkm::filter::geometry_refinement::VertexClustering clustering;
+  clustering.SetNumberOfDivisions(vtkm::Id3(3, 3, 3));
+  clustering.SetUseQuadrics(true);
+  vtkm::cont::DataSet output = clustering.Execute(dataSet);
+
+  // The bins at the corners have points of three sides, so the quadrics place their points
+  // exactly at the corners.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  output.GetCoordinateSystem().GetData().AsArrayHandle(points);
+  auto portal = points.ReadPortal();
+  vtkm::IdComponent numCorners = 0;
+  for (vtkm::Id pointIndex = 0; pointIndex < portal.GetNumberOfValues(); ++pointIndex)
+  {
+    const vtkm::Vec3f point = portal.Get(pointIndex);
+    auto onSide = [](vtkm::FloatDefault x) {
+      return vtkm::Min(vtkm::Abs(x), vtkm::Abs(1 - x)) < 1e-5;
+    };
+    if (onSide(point[0]) && onSide(point[1]) && onSide(point[2]))
+    {
+      ++numCorners;
+    }
+  }
+  VTKM_TEST_ASSERT(numCorners == 8, "Wrong number of corners: ", numCorners);
+
+  // Without quadrics, a point of the bin is used.
+  clustering.SetUseQuadrics(false);
+  output = clustering.Execute(dataSet);
+  output.GetCoordinateSystem().GetData().AsArrayHandle(points);
+  portal = points.ReadPortal();
+  VTKM_TEST_ASSERT(!test_equal(portal.Get(0), vtkm::Vec3f(0.0f)));
 }
 
+void TestTargetNumberOfTriangles()
+{
+  vtkm::cont::DataSet dataSet = MakeCubeSurface(8);
+
+  vtkm::filter::geometry_refinement::VertexClustering clustering;
+  clustering.SetNumberOfDivisions(vtkm::Id3(64, 64, 64));
+  clustering.SetUseQuadrics(true);
+  clustering.SetTargetNumberOfTriangles(200);
+  vtkm::cont::DataSet output = clustering.Execute(dataSet);
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() <= 200, "Too many triangles");
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() >= 12, "Too few triangles");
+
+  // The divisions keep shrinking until even a very small target is reached.
+  clustering.SetTargetNumberOfTriangles(1);
+  output = clustering.Execute(dataSet);
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() <= 1, "Too many triangles");
+}
+
+} // anonymous namespace
+
 void TestVertexClustering()
 {
   vtkm::cont::testing::MakeTestDataSet maker;
@@ -101,7 +157,14 @@ void TestVertexClustering()
   }
 }
 
+void TestVertexClusteringFilter()
+{
+  TestVertexClustering();
+  TestQuadricClustering();
+  TestTargetNumberOfTriangles();
+}
+
 int UnitTestVertexClusteringFilter(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestVertexClustering, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestVertexClusteringFilter, argc, argv);
 }
@@ -0,0 +1,134 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_Quadric_h
+#define vtk_m_worklet_Quadric_h
+
+#include <vtkm/Math.h>
+#include <vtkm/Matrix.h>
+#include <vtkm/Types.h>
+#include <vtkm/VectorAnalysis.h>
+
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace quadric
+{
+
+/// A quadric error metric as described by Garland and Heckbert, "Surface Simplification
+/// Using Quadric Error Metrics", SIGGRAPH 1997. The symmetric 4x4 matrix is stored as its
+/// upper triangle in row order: a^2, ab, ac, ad, b^2, bc, bd, c^2, cd, d^2 for a plane
+/// ax + by + cz + d = 0. Quadrics are summed with the usual Vec addition.
+using Quadric = vtkm::Vec<vtkm::Float64, 10>;
+
+/// Returns the quadric of the squared distance to the plane of a triangle, weighted by the
+/// area of the triangle. Degenerate triangles give a zero quadric.
+template <typename PointType>
+VTKM_EXEC_CONT Quadric TriangleQuadric(const PointType& p0,
+                                       const PointType& p1,
+                                       const PointType& p2)
+{
+  const vtkm::Vec3f_64 v0(p0);
+  const vtkm::Vec3f_64 cross = vtkm::Cross(vtkm::Vec3f_64(p1) - v0, vtkm::Vec3f_64(p2) - v0);
+  const vtkm::Float64 length = vtkm::Magnitude(cross);
+  if (length <= 0.0)
+  {
+    return Quadric(0.0);
+  }
+  const vtkm::Vec3f_64 normal = cross / length;
+  const vtkm::Float64 d = -vtkm::Dot(normal, v0);
+  const vtkm::Float64 area = 0.5 * length;
+
+  Quadric q;
+  q[0] = area * normal[0] * normal[0];
+  q[1] = area * normal[0] * normal[1];
+  q[2] = area * normal[0] * normal[2];
+  q[3] = area * normal[0] * d;
+  q[4] = area * normal[1] * normal[1];
+  q[5] = area * normal[1] * normal[2];
+  q[6] = area * normal[1] * d;
+  q[7] = area * normal[2] * normal[2];
+  q[8] = area * normal[2] * d;
+  q[9] = area * d * d;
+  return q;
+}
+
+/// Returns the error of a point for a quadric.
+VTKM_EXEC_CONT inline vtkm::Float64 Evaluate(const Quadric& q, const vtkm::Vec3f_64& p)
+{
+  const vtkm::Float64 x = p[0];
+  const vtkm::Float64 y = p[1];
+  const vtkm::Float64 z = p[2];
+  return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x +
+    q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y + q[7] * z * z + 2.0 * q[8] * z + q[9];
+}
+
+/// Finds the point that minimizes the error of a quadric. Returns false when the quadric
+/// does not have a unique minimum, such as for a flat or a cylindrical patch of surface.
+VTKM_EXEC_CONT inline bool Minimize(const Quadric& q, vtkm::Vec3f_64& point)
+{
+  vtkm::Matrix<vtkm::Float64, 3, 3> a;
+  a[0] = vtkm::Vec3f_64(q[0], q[1], q[2]);
+  a[1] = vtkm::Vec3f_64(q[1], q[4], q[5]);
+  a[2] = vtkm::Vec3f_64(q[2], q[5], q[7]);
+
+  // The determinant is compared to the cube of the average eigenvalue so that the test does
+  // not depend on the scale of the mesh.
+  const vtkm::Float64 scale = (q[0] + q[4] + q[7]) / 3.0;
+  const vtkm::Float64 determinant = vtkm::MatrixDeterminant(a);
+  if (!(scale > 0.0) || (vtkm::Abs(determinant) < 1e-6 * scale * scale * scale))
+  {
+    return false;
+  }
+
+  bool valid;
+  point = vtkm::SolveLinearSystem(a, vtkm::Vec3f_64(-q[3], -q[6], -q[8]), valid);
+  return valid;
+}
+
+/// Computes the area weighted plane quadric of each triangle.
+struct TriangleQuadrics : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn cellset, FieldInPoint points, FieldOutCell quadrics);
+  using ExecutionSignature = void(_2, _3);
+
+  template <typename PointsVecType>
+  VTKM_EXEC void operator()(const PointsVecType& points, Quadric& quadric) const
+  {
+    quadric = TriangleQuadric(points[0], points[1], points[2]);
+  }
+};
+
+/// Sums the quadrics of the triangles around each point.
+struct PointQuadrics : public vtkm::worklet::WorkletVisitPointsWithCells
+{
+  using ControlSignature = void(CellSetIn cellset, FieldInCell cellQuadrics, FieldOut quadrics);
+  using ExecutionSignature = void(CellCount, _2, _3);
+
+  template <typename QuadricsVecType>
+  VTKM_EXEC void operator()(vtkm::IdComponent numCells,
+                            const QuadricsVecType& cellQuadrics,
+                            Quadric& quadric) const
+  {
+    quadric = Quadric(0.0);
+    for (vtkm::IdComponent cellIndex = 0; cellIndex < numCells; ++cellIndex)
+    {
+      quadric += cellQuadrics[cellIndex];
+    }
+  }
+};
+
+}
+}
+} // namespace vtkm::worklet::quadric
+
+#endif // vtk_m_worklet_Quadric_h
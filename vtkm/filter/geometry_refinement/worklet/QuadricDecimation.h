@@ -0,0 +1,643 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_QuadricDecimation_h
+#define vtk_m_worklet_QuadricDecimation_h
+
+#include <vtkm/filter/geometry_refinement/worklet/Quadric.h>
+
+#include <vtkm/BinaryOperators.h>
+#include <vtkm/Math.h>
+#include <vtkm/Pair.h>
+#include <vtkm/Types.h>
+#include <vtkm/VectorAnalysis.h>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCast.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleGroupVec.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
+
+#include <vtkm/worklet/Keys.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace quadric_decimation
+{
+
+/// Gets the point ids of each triangle and flags the cells that are not triangles.
+struct ExtractTriangles : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn cellset, FieldOutCell triangles, FieldOutCell valid);
+  using ExecutionSignature = void(CellShape, PointCount, PointIndices, _2, _3);
+
+  template <typename CellShapeTag, typename PointIndicesVecType>
+  VTKM_EXEC void operator()(CellShapeTag shape,
+                            vtkm::IdComponent numPoints,
+                            const PointIndicesVecType& pointIndices,
+                            vtkm::Id3& triangle,
+                            bool& valid) const
+  {
+    valid = (shape.Id == vtkm::CELL_SHAPE_TRIANGLE) && (numPoints == 3);
+    triangle = valid ? vtkm::Id3(pointIndices[0], pointIndices[1], pointIndices[2]) : vtkm::Id3(0);
+  }
+};
+
+/// Lists the edges of each triangle with the smaller point id first.
+struct TriangleEdges : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn triangles, FieldOut edges);
+  using ExecutionSignature = void(_1, _2);
+
+  template <typename EdgesVecType>
+  VTKM_EXEC void operator()(const vtkm::Id3& triangle, EdgesVecType& edges) const
+  {
+    for (vtkm::IdComponent edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+    {
+      const vtkm::Id p0 = triangle[edgeIndex];
+      const vtkm::Id p1 = triangle[(edgeIndex + 1) % 3];
+      edges[edgeIndex] = vtkm::Id2(vtkm::Min(p0, p1), vtkm::Max(p0, p1));
+    }
+  }
+};
+
+/// Locks the points of the edges that are not shared by exactly two triangles. Locked
+/// points do not move, which keeps the boundaries and non-manifold features of the mesh.
+struct LockPoints : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn edges, FieldIn edgeCounts, WholeArrayOut locked);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename LockedPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            vtkm::IdComponent edgeCount,
+                            const LockedPortalType& locked) const
+  {
+    if (edgeCount != 2)
+    {
+      locked.Set(edge[0], 1);
+      locked.Set(edge[1], 1);
+    }
+  }
+};
+
+/// Finds where each edge would collapse and the quadric error of the collapse. Edges that
+/// cannot collapse get an infinite cost. An edge cannot collapse when both of its points are
+/// locked, when the points share more neighbors than the two opposite points of the edge
+/// (which would make the mesh non-manifold), or when the collapse flips a triangle.
+class EvaluateCollapses : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn edges,
+                                FieldIn edgeCounts,
+                                WholeArrayIn positions,
+                                WholeArrayIn quadrics,
+                                WholeArrayIn locked,
+                                WholeArrayIn triangles,
+                                WholeArrayIn pointCellIds,
+                                WholeArrayIn pointCellOffsets,
+                                FieldOut costs,
+                                FieldOut collapsePositions);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10);
+
+  template <typename PositionsPortal,
+            typename QuadricsPortal,
+            typename LockedPortal,
+            typename TrianglesPortal,
+            typename CellIdsPortal,
+            typename OffsetsPortal>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            vtkm::IdComponent edgeCount,
+                            const PositionsPortal& positions,
+                            const QuadricsPortal& quadrics,
+                            const LockedPortal& locked,
+                            const TrianglesPortal& triangles,
+                            const CellIdsPortal& pointCellIds,
+                            const OffsetsPortal& pointCellOffsets,
+                            vtkm::Float64& cost,
+                            vtkm::Vec3f_64& position) const
+  {
+    cost = vtkm::Infinity64();
+    const vtkm::Id u = edge[0];
+    const vtkm::Id v = edge[1];
+    const vtkm::Vec3f_64 pu = positions.Get(u);
+    const vtkm::Vec3f_64 pv = positions.Get(v);
+    position = pu;
+
+    const bool lockedU = locked.Get(u) != 0;
+    const bool lockedV = locked.Get(v) != 0;
+    if ((edgeCount != 2) || (lockedU && lockedV))
+    {
+      return;
+    }
+
+    const vtkm::worklet::quadric::Quadric quadric = quadrics.Get(u) + quadrics.Get(v);
+    if (lockedU)
+    {
+      position = pu;
+    }
+    else if (lockedV)
+    {
+      position = pv;
+    }
+    else
+    {
+      // Keep the optimal point near the edge. Far away points come from nearly singular
+      // quadrics and are not reliable.
+      const vtkm::Vec3f_64 midpoint = 0.5 * (pu + pv);
+      if (!vtkm::worklet::quadric::Minimize(quadric, position) ||
+          (vtkm::MagnitudeSquared(position - midpoint) > vtkm::MagnitudeSquared(pv - pu)))
+      {
+        position = midpoint;
+        vtkm::Float64 bestCost = vtkm::worklet::quadric::Evaluate(quadric, midpoint);
+        if (vtkm::worklet::quadric::Evaluate(quadric, pu) < bestCost)
+        {
+          position = pu;
+          bestCost = vtkm::worklet::quadric::Evaluate(quadric, pu);
+        }
+        if (vtkm::worklet::quadric::Evaluate(quadric, pv) < bestCost)
+        {
+          position = pv;
+        }
+      }
+    }
+
+    if (!this->LinkConditionHolds(u, v, triangles, pointCellIds, pointCellOffsets) ||
+        this->FlipsTriangle(u, v, position, positions, triangles, pointCellIds, pointCellOffsets) ||
+        this->FlipsTriangle(v, u, position, positions, triangles, pointCellIds, pointCellOffsets))
+    {
+      return;
+    }
+
+    cost = vtkm::Max(vtkm::worklet::quadric::Evaluate(quadric, position), 0.0);
+  }
+
+private:
+  template <typename TrianglesPortal, typename CellIdsPortal, typename OffsetsPortal>
+  VTKM_EXEC static bool IsNeighbor(vtkm::Id point,
+                                   vtkm::Id other,
+                                   const TrianglesPortal& triangles,
+                                   const CellIdsPortal& pointCellIds,
+                                   const OffsetsPortal& pointCellOffsets)
+  {
+    for (vtkm::Id index = pointCellOffsets.Get(point); index < pointCellOffsets.Get(point + 1);
+         ++index)
+    {
+      const vtkm::Id3 triangle = triangles.Get(pointCellIds.Get(index));
+      if ((triangle[0] == other) || (triangle[1] == other) || (triangle[2] == other))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Around a manifold edge, each of the two opposite points is in two of the triangles of u,
+  // so they are found 4 times. Any other shared neighbor pinches the mesh after the collapse.
+  template <typename TrianglesPortal, typename CellIdsPortal, typename OffsetsPortal>
+  VTKM_EXEC static bool LinkConditionHolds(vtkm::Id u,
+                                           vtkm::Id v,
+                                           const TrianglesPortal& triangles,
+                                           const CellIdsPortal& pointCellIds,
+                                           const OffsetsPortal& pointCellOffsets)
+  {
+    vtkm::IdComponent numShared = 0;
+    for (vtkm::Id index = pointCellOffsets.Get(u); index < pointCellOffsets.Get(u + 1); ++index)
+    {
+      const vtkm::Id3 triangle = triangles.Get(pointCellIds.Get(index));
+      for (vtkm::IdComponent corner = 0; corner < 3; ++corner)
+      {
+        const vtkm::Id w = triangle[corner];
+        if ((w != u) && (w != v) &&
+            IsNeighbor(v, w, triangles, pointCellIds, pointCellOffsets))
+        {
+          ++numShared;
+        }
+      }
+    }
+    return numShared <= 4;
+  }
+
+  // Checks whether moving point to the collapse position flips one of its triangles. The
+  // triangles that also use other are removed by the collapse and are skipped.
+  template <typename PositionsPortal,
+            typename TrianglesPortal,
+            typename CellIdsPortal,
+            typename OffsetsPortal>
+  VTKM_EXEC static bool FlipsTriangle(vtkm::Id point,
+                                      vtkm::Id other,
+                                      const vtkm::Vec3f_64& position,
+                                      const PositionsPortal& positions,
+                                      const TrianglesPortal& triangles,
+                                      const CellIdsPortal& pointCellIds,
+                                      const OffsetsPortal& pointCellOffsets)
+  {
+    for (vtkm::Id index = pointCellOffsets.Get(point); index < pointCellOffsets.Get(point + 1);
+         ++index)
+    {
+      const vtkm::Id3 triangle = triangles.Get(pointCellIds.Get(index));
+      if ((triangle[0] == other) || (triangle[1] == other) || (triangle[2] == other))
+      {
+        continue;
+      }
+      vtkm::Vec<vtkm::Vec3f_64, 3> before;
+      vtkm::Vec<vtkm::Vec3f_64, 3> after;
+      for (vtkm::IdComponent corner = 0; corner < 3; ++corner)
+      {
+        before[corner] = positions.Get(triangle[corner]);
+        after[corner] = (triangle[corner] == point) ? position : before[corner];
+      }
+      const vtkm::Vec3f_64 normalBefore =
+        vtkm::Cross(before[1] - before[0], before[2] - before[0]);
+      const vtkm::Vec3f_64 normalAfter = vtkm::Cross(after[1] - after[0], after[2] - after[0]);
+      if (vtkm::Dot(normalBefore, normalAfter) <= 0.0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+struct MakeCostKeys : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn costs, FieldOut keys);
+  using ExecutionSignature = void(_1, InputIndex, _2);
+
+  VTKM_EXEC void operator()(vtkm::Float64 cost,
+                            vtkm::Id edgeIndex,
+                            vtkm::Pair<vtkm::Float64, vtkm::Id>& key) const
+  {
+    key = vtkm::make_Pair(cost, edgeIndex);
+  }
+};
+
+/// Gives each edge its position in the edges sorted by cost. Edges that cannot collapse get
+/// the number of edges as rank.
+struct ScatterRanks : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn sortedKeys, WholeArrayOut ranks);
+  using ExecutionSignature = void(_1, InputIndex, _2);
+
+  template <typename RanksPortal>
+  VTKM_EXEC void operator()(const vtkm::Pair<vtkm::Float64, vtkm::Id>& key,
+                            vtkm::Id rank,
+                            const RanksPortal& ranks) const
+  {
+    ranks.Set(key.second, vtkm::IsFinite(key.first) ? rank : ranks.GetNumberOfValues());
+  }
+};
+
+/// Keeps the smallest value of the edges around each point.
+struct MinimumAroundPoints : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn edges, FieldIn values, AtomicArrayInOut pointMinimum);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename AtomicPortal>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            vtkm::Id value,
+                            const AtomicPortal& pointMinimum) const
+  {
+    for (vtkm::IdComponent end = 0; end < 2; ++end)
+    {
+      vtkm::Id current = pointMinimum.Get(edge[end]);
+      while ((value < current) && !pointMinimum.CompareExchange(edge[end], &current, value))
+      {
+      }
+    }
+  }
+};
+
+struct MinimumOfEnds : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn edges, WholeArrayIn pointValues, FieldOut edgeValues);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename PointValuesPortal>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            const PointValuesPortal& pointValues,
+                            vtkm::Id& value) const
+  {
+    value = vtkm::Min(pointValues.Get(edge[0]), pointValues.Get(edge[1]));
+  }
+};
+
+/// Selects the edges that have the smallest rank of all the edges that touch the triangles
+/// around them. No two selected edges touch the same triangle, so they can all collapse at
+/// once and the checks made by EvaluateCollapses stay valid.
+class SelectCollapses : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id MaximumRank;
+
+public:
+  VTKM_CONT SelectCollapses(vtkm::Id maximumRank)
+    : MaximumRank(maximumRank)
+  {
+  }
+
+  using ControlSignature = void(FieldIn edges,
+                                FieldIn ranks,
+                                WholeArrayIn pointMinimum,
+                                FieldOut selected);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename PointMinimumPortal>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            vtkm::Id rank,
+                            const PointMinimumPortal& pointMinimum,
+                            bool& selected) const
+  {
+    selected = (rank <= this->MaximumRank) && (pointMinimum.Get(edge[0]) == rank) &&
+      (pointMinimum.Get(edge[1]) == rank);
+  }
+};
+
+/// Collapses the selected edges. The point that stays takes the collapse position and the
+/// sum of the quadrics. A locked point always stays.
+struct ApplyCollapses : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn edges,
+                                FieldIn selected,
+                                FieldIn collapsePositions,
+                                WholeArrayIn locked,
+                                WholeArrayInOut positions,
+                                WholeArrayInOut quadrics,
+                                WholeArrayOut collapseMap);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7);
+
+  template <typename LockedPortal,
+            typename PositionsPortal,
+            typename QuadricsPortal,
+            typename CollapseMapPortal>
+  VTKM_EXEC void operator()(const vtkm::Id2& edge,
+                            bool selected,
+                            const vtkm::Vec3f_64& position,
+                            const LockedPortal& locked,
+                            const PositionsPortal& positions,
+                            const QuadricsPortal& quadrics,
+                            const CollapseMapPortal& collapseMap) const
+  {
+    if (!selected)
+    {
+      return;
+    }
+    const vtkm::Id keep = (locked.Get(edge[1]) != 0) ? edge[1] : edge[0];
+    const vtkm::Id remove = (keep == edge[0]) ? edge[1] : edge[0];
+    positions.Set(keep, position);
+    quadrics.Set(keep, quadrics.Get(edge[0]) + quadrics.Get(edge[1]));
+    collapseMap.Set(remove, keep);
+  }
+};
+
+/// Renumbers the points of the triangles after a collapse and flags the triangles that
+/// still have three different points.
+struct RemapTriangles : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn triangles,
+                                WholeArrayIn collapseMap,
+                                FieldOut newTriangles,
+                                FieldOut valid);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename CollapseMapPortal>
+  VTKM_EXEC void operator()(const vtkm::Id3& triangle,
+                            const CollapseMapPortal& collapseMap,
+                            vtkm::Id3& newTriangle,
+                            bool& valid) const
+  {
+    newTriangle = vtkm::Id3(
+      collapseMap.Get(triangle[0]), collapseMap.Get(triangle[1]), collapseMap.Get(triangle[2]));
+    valid = (newTriangle[0] != newTriangle[1]) && (newTriangle[0] != newTriangle[2]) &&
+      (newTriangle[1] != newTriangle[2]);
+  }
+};
+
+} // namespace quadric_decimation
+
+/// \brief Simplifies a triangle mesh with parallel quadric error metric edge collapses.
+///
+/// Each point holds the sum of the quadrics of the planes of its triangles as described by
+/// Garland and Heckbert. The edges are collapsed in rounds. In each round, the cost of
+/// collapsing every edge is computed and an independent set of the cheapest edges is
+/// collapsed at once. The rounds stop when the target number of triangles is reached or
+/// when no edge can collapse.
+class QuadricDecimation
+{
+public:
+  template <typename CellSetType>
+  VTKM_CONT vtkm::cont::CellSetSingleType<> Run(
+    const CellSetType& cellSet,
+    const vtkm::cont::UnknownArrayHandle& coordinates,
+    vtkm::Id targetNumberOfTriangles,
+    vtkm::cont::ArrayHandle<vtkm::Vec3f_64>& outPoints)
+  {
+    VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "QuadricDecimation Worklet");
+    using namespace quadric_decimation;
+    using Quadric = vtkm::worklet::quadric::Quadric;
+
+    vtkm::cont::Invoker invoke;
+
+    // The positions are modified as points collapse, so they are always copied.
+    vtkm::cont::ArrayHandle<vtkm::Vec3f_64> positions;
+    vtkm::cont::ArrayCopy(coordinates, positions);
+    const vtkm::Id numPoints = positions.GetNumberOfValues();
+
+    vtkm::cont::ArrayHandle<vtkm::Id3> triangles;
+    {
+      vtkm::cont::ArrayHandle<bool> valid;
+      invoke(ExtractTriangles{}, cellSet, triangles, valid);
+      if (!vtkm::cont::Algorithm::Reduce(valid, true, vtkm::LogicalAnd()))
+      {
+        throw vtkm::cont::ErrorBadValue("QuadricDecimation only supports triangle meshes.");
+      }
+    }
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(triangles.GetNumberOfValues()),
+                          this->CellIdMap);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> pointMap;
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numPoints), pointMap);
+
+    vtkm::cont::ArrayHandle<Quadric> quadrics;
+    bool firstRound = true;
+    while (triangles.GetNumberOfValues() > targetNumberOfTriangles)
+    {
+      const vtkm::Id numTriangles = triangles.GetNumberOfValues();
+      vtkm::cont::CellSetSingleType<> mesh = MakeMesh(triangles, numPoints);
+      if (firstRound)
+      {
+        vtkm::cont::ArrayHandle<Quadric> cellQuadrics;
+        invoke(vtkm::worklet::quadric::TriangleQuadrics{}, mesh, positions, cellQuadrics);
+        invoke(vtkm::worklet::quadric::PointQuadrics{}, mesh, cellQuadrics, quadrics);
+        firstRound = false;
+      }
+
+      // Find the unique edges and how many triangles use each of them.
+      vtkm::cont::ArrayHandle<vtkm::Id2> edges;
+      vtkm::cont::ArrayHandle<vtkm::IdComponent> edgeCounts;
+      {
+        vtkm::cont::ArrayHandle<vtkm::Id2> allEdges;
+        invoke(TriangleEdges{}, triangles, vtkm::cont::make_ArrayHandleGroupVec<3>(allEdges));
+        vtkm::cont::Algorithm::Sort(allEdges);
+        vtkm::cont::Algorithm::ReduceByKey(
+          allEdges,
+          vtkm::cont::make_ArrayHandleConstant<vtkm::IdComponent>(1, allEdges.GetNumberOfValues()),
+          edges,
+          edgeCounts,
+          vtkm::Add());
+      }
+      const vtkm::Id numEdges = edges.GetNumberOfValues();
+
+      vtkm::cont::ArrayHandle<vtkm::UInt8> locked;
+      locked.AllocateAndFill(numPoints, 0);
+      invoke(LockPoints{}, edges, edgeCounts, locked);
+
+      vtkm::cont::ArrayHandle<vtkm::Float64> costs;
+      vtkm::cont::ArrayHandle<vtkm::Vec3f_64> collapsePositions;
+      invoke(EvaluateCollapses{},
+             edges,
+             edgeCounts,
+             positions,
+             quadrics,
+             locked,
+             triangles,
+             mesh.GetConnectivityArray(vtkm::TopologyElementTagPoint{},
+                                       vtkm::TopologyElementTagCell{}),
+             mesh.GetOffsetsArray(vtkm::TopologyElementTagPoint{}, vtkm::TopologyElementTagCell{}),
+             costs,
+             collapsePositions);
+
+      // Rank the edges by cost. Ties are broken by edge index so the result is the same on
+      // every device.
+      vtkm::cont::ArrayHandle<vtkm::Id> ranks;
+      {
+        vtkm::cont::ArrayHandle<vtkm::Pair<vtkm::Float64, vtkm::Id>> costKeys;
+        invoke(MakeCostKeys{}, costs, costKeys);
+        vtkm::cont::Algorithm::Sort(costKeys);
+        ranks.Allocate(numEdges);
+        invoke(ScatterRanks{}, costKeys, ranks);
+      }
+
+      vtkm::cont::ArrayHandle<vtkm::Id> pointMinimum;
+      pointMinimum.AllocateAndFill(numPoints, numEdges);
+      invoke(MinimumAroundPoints{}, edges, ranks, pointMinimum);
+      vtkm::cont::ArrayHandle<vtkm::Id> edgeMinimum;
+      invoke(MinimumOfEnds{}, edges, pointMinimum, edgeMinimum);
+      pointMinimum.Fill(numEdges);
+      invoke(MinimumAroundPoints{}, edges, edgeMinimum, pointMinimum);
+
+      vtkm::cont::ArrayHandle<bool> selected;
+      invoke(SelectCollapses{ numEdges - 1 }, edges, ranks, pointMinimum, selected);
+      const vtkm::Id numSelected =
+        vtkm::cont::Algorithm::Reduce(vtkm::cont::make_ArrayHandleCast<vtkm::Id>(selected), 0);
+      if (numSelected == 0)
+      {
+        break;
+      }
+
+      // Each collapse removes about two triangles. Do not go much below the target.
+      const vtkm::Id maxCollapses =
+        vtkm::Max(vtkm::Id{ 1 }, (numTriangles - targetNumberOfTriangles) / 2);
+      if (numSelected > maxCollapses)
+      {
+        vtkm::cont::ArrayHandle<vtkm::Id> selectedRanks;
+        vtkm::cont::Algorithm::CopyIf(ranks, selected, selectedRanks);
+        vtkm::cont::Algorithm::Sort(selectedRanks);
+        const vtkm::Id maximumRank = selectedRanks.ReadPortal().Get(maxCollapses - 1);
+        invoke(SelectCollapses{ maximumRank }, edges, ranks, pointMinimum, selected);
+      }
+
+      vtkm::cont::ArrayHandle<vtkm::Id> collapseMap;
+      vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numPoints), collapseMap);
+      invoke(ApplyCollapses{},
+             edges,
+             selected,
+             collapsePositions,
+             locked,
+             positions,
+             quadrics,
+             collapseMap);
+
+      vtkm::cont::ArrayHandle<vtkm::Id3> remappedTriangles;
+      vtkm::cont::ArrayHandle<bool> validTriangles;
+      invoke(RemapTriangles{}, triangles, collapseMap, remappedTriangles, validTriangles);
+      vtkm::cont::Algorithm::CopyIf(remappedTriangles, validTriangles, triangles);
+      vtkm::cont::ArrayHandle<vtkm::Id> cellIdMap;
+      vtkm::cont::Algorithm::CopyIf(this->CellIdMap, validTriangles, cellIdMap);
+      this->CellIdMap = cellIdMap;
+
+      vtkm::cont::ArrayHandle<vtkm::Id> newPointMap;
+      vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(pointMap, collapseMap),
+                            newPointMap);
+      pointMap = newPointMap;
+    }
+
+    // Every input point maps to the point that it collapsed into. Number the remaining
+    // points consecutively.
+    this->PointKeys = vtkm::worklet::Keys<vtkm::Id>(pointMap);
+    const auto& remainingPoints = this->PointKeys.GetUniqueKeys();
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(remainingPoints, positions),
+                          outPoints);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> oldConnectivity = Flatten(triangles);
+      vtkm::cont::Algorithm::LowerBounds(remainingPoints, oldConnectivity, connectivity);
+    }
+    vtkm::cont::CellSetSingleType<> outCellSet;
+    outCellSet.Fill(
+      remainingPoints.GetNumberOfValues(), vtkm::CELL_SHAPE_TRIANGLE, 3, connectivity);
+    return outCellSet;
+  }
+
+  /// Groups the input points by the output point that they collapsed into.
+  VTKM_CONT const vtkm::worklet::Keys<vtkm::Id>& GetPointKeys() const { return this->PointKeys; }
+
+  /// The input cell of each output cell.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->CellIdMap; }
+
+private:
+  VTKM_CONT static vtkm::cont::ArrayHandle<vtkm::Id> Flatten(
+    const vtkm::cont::ArrayHandle<vtkm::Id3>& triangles)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+    auto groupedConnectivity = vtkm::cont::make_ArrayHandleGroupVec<3>(connectivity);
+    vtkm::cont::Algorithm::Copy(triangles, groupedConnectivity);
+    return connectivity;
+  }
+
+  VTKM_CONT static vtkm::cont::CellSetSingleType<> MakeMesh(
+    const vtkm::cont::ArrayHandle<vtkm::Id3>& triangles,
+    vtkm::Id numPoints)
+  {
+    vtkm::cont::CellSetSingleType<> mesh;
+    mesh.Fill(numPoints, vtkm::CELL_SHAPE_TRIANGLE, 3, Flatten(triangles));
+    return mesh;
+  }
+
+  vtkm::worklet::Keys<vtkm::Id> PointKeys;
+  vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_QuadricDecimation_h
@@ -11,17 +11,17 @@
 #define vtk_m_worklet_SplitSharpEdges_h
 
 #include <vtkm/worklet/CellDeepCopy.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletMapTopology.h>
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
-#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/Invoker.h>
-#include <vtkm/exec/CellEdge.h>
 
-#include <vtkm/Bitset.h>
-#include <vtkm/CellTraits.h>
-#include <vtkm/TypeTraits.h>
 #include <vtkm/VectorAnalysis.h>
 
 namespace vtkm
@@ -29,357 +29,283 @@ namespace vtkm
 namespace worklet
 {
 
-namespace internal
-{
-// Given a cell and a point on the cell, find the two edges that are
-// associated with this point in canonical index
-template <typename PointFromCellSetType>
-VTKM_EXEC vtkm::ErrorCode FindRelatedEdges(const vtkm::Id& pointIndex,
-                                           const vtkm::Id& cellIndexG,
-                                           const PointFromCellSetType& pFromCellSet,
-                                           vtkm::Id2& edge0G,
-                                           vtkm::Id2& edge1G)
+// Split sharp manifold edges where the feature angle between the
+// adjacent surfaces are larger than the threshold value
+//
+// The faces incident to each point are laid out contiguously in a compressed sparse row
+// (CSR) point-to-face adjacency that is built with a counting sort. Each point then groups
+// its incident faces in a single pass: two faces are in the same group when they share a
+// manifold edge through the point and the angle between their normals is below the feature
+// angle. The first group keeps the point and each other group gets a duplicate of it. The
+// duplicates of all points are numbered with a scan.
+class SplitSharpEdges
 {
-  typename PointFromCellSetType::CellShapeTag cellShape = pFromCellSet.GetCellShape(cellIndexG);
-  typename PointFromCellSetType::IndicesType cellConnections = pFromCellSet.GetIndices(cellIndexG);
-  vtkm::IdComponent numPointsInCell = pFromCellSet.GetNumberOfIndices(cellIndexG);
-  vtkm::IdComponent numEdges;
-  VTKM_RETURN_ON_ERROR(vtkm::exec::CellEdgeNumberOfEdges(numPointsInCell, cellShape, numEdges));
-  vtkm::IdComponent edgeIndex = -1;
-  // Find the two edges with the pointIndex
-  while (true)
+public:
+  // Counts the faces incident to each point.
+  struct CountIncidentFaces : public vtkm::worklet::WorkletVisitCellsWithPoints
   {
-    ++edgeIndex;
-    if (edgeIndex >= numEdges)
+    using ControlSignature = void(CellSetIn cellSet, AtomicArrayInOut faceCounts);
+    using ExecutionSignature = void(PointIndices, _2);
+
+    template <typename PointIndicesType, typename FaceCounts>
+    VTKM_EXEC void operator()(const PointIndicesType& pointIndices,
+                              const FaceCounts& faceCounts) const
     {
-      // Bad cell. Could not find two incident edges.
-      return vtkm::ErrorCode::MalformedCellDetected;
-    }
-    vtkm::IdComponent2 localEdgeIndices;
-    VTKM_RETURN_ON_ERROR(vtkm::exec::CellEdgeLocalIndex(
-      numPointsInCell, 0, edgeIndex, cellShape, localEdgeIndices[0]));
-    VTKM_RETURN_ON_ERROR(vtkm::exec::CellEdgeLocalIndex(
-      numPointsInCell, 1, edgeIndex, cellShape, localEdgeIndices[1]));
-    vtkm::Id2 canonicalEdgeId(cellConnections[localEdgeIndices[0]],
-                              cellConnections[localEdgeIndices[1]]);
-    if (canonicalEdgeId[0] == pointIndex || canonicalEdgeId[1] == pointIndex)
-    { // Assign value to edge0 first
-      if ((edge0G[0] == -1) && (edge0G[1] == -1))
+      for (vtkm::IdComponent i = 0; i < pointIndices.GetNumberOfComponents(); ++i)
       {
-        edge0G = canonicalEdgeId;
+        faceCounts.Add(pointIndices[i], 1);
       }
-      else
+    }
+  };
+
+  // Writes each face in the adjacency of its points.
+  struct FillIncidentFaces : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+    using ControlSignature = void(CellSetIn cellSet,
+                                  AtomicArrayInOut faceCursors,
+                                  WholeArrayOut incidentFaces);
+    using ExecutionSignature = void(InputIndex, PointIndices, _2, _3);
+
+    template <typename PointIndicesType, typename FaceCursors, typename IncidentFacesPortal>
+    VTKM_EXEC void operator()(vtkm::Id faceIndex,
+                              const PointIndicesType& pointIndices,
+                              const FaceCursors& faceCursors,
+                              const IncidentFacesPortal& incidentFaces) const
+    {
+      for (vtkm::IdComponent i = 0; i < pointIndices.GetNumberOfComponents(); ++i)
       {
-        edge1G = canonicalEdgeId;
-        break;
+        incidentFaces.Set(faceCursors.Add(pointIndices[i], 1), faceIndex);
       }
     }
-  }
-  return vtkm::ErrorCode::Success;
-}
+  };
 
-// TODO: We should replace this expensive lookup with a WholeCellSetIn<Edge, Cell> map.
-// Given an edge on a cell, it would find the neighboring
-// cell of this edge in local index. If it's a non manifold edge, -1 would be returned.
-template <typename PointFromCellSetType, typename IncidentCellVecType>
-VTKM_EXEC int FindNeighborCellInLocalIndex(const vtkm::Id2& eOI,
-                                           const PointFromCellSetType& pFromCellSet,
-                                           const IncidentCellVecType& incidentCells,
-                                           const vtkm::Id currentCellLocalIndex)
-{
-  int neighboringCellIndex = -1;
-  vtkm::IdComponent numberOfIncidentCells = incidentCells.GetNumberOfComponents();
-  for (vtkm::IdComponent incidentCellIndex = 0; incidentCellIndex < numberOfIncidentCells;
-       incidentCellIndex++)
+  // Groups the faces incident to each point. The incident faces are first sorted so that the
+  // output does not depend on the order in which they were added to the adjacency. The groups
+  // are kept in a union-find over the local indices of the faces that always links the root
+  // with the larger index to the one with the smaller index, so the root of each group is its
+  // first face. The `regions` array holds the union-find for the segment of each point and is
+  // then overwritten with the group of each face, numbered in the order of their first face.
+  // Group 0 keeps the point, so the point needs one new point for each other group.
+  class ClassifyPoint : public vtkm::worklet::WorkletMapField
   {
-    if (currentCellLocalIndex == incidentCellIndex)
+  public:
+    VTKM_CONT ClassifyPoint(vtkm::FloatDefault cosFeatureAngle)
+      : CosFeatureAngle(cosFeatureAngle)
     {
-      continue; // No need to check the current interested cell
     }
-    vtkm::Id cellIndexG = incidentCells[incidentCellIndex]; // Global cell index
-    typename PointFromCellSetType::CellShapeTag cellShape = pFromCellSet.GetCellShape(cellIndexG);
-    typename PointFromCellSetType::IndicesType cellConnections =
-      pFromCellSet.GetIndices(cellIndexG);
-    vtkm::IdComponent numPointsInCell = pFromCellSet.GetNumberOfIndices(cellIndexG);
-    vtkm::IdComponent numEdges;
-    vtkm::exec::CellEdgeNumberOfEdges(numPointsInCell, cellShape, numEdges);
-    vtkm::IdComponent edgeIndex = -1;
-    // Check if this cell has edge of interest
-    while (true)
+
+    using ControlSignature = void(FieldIn adjacencyBegin,
+                                  FieldIn adjacencyEnd,
+                                  WholeArrayInOut incidentFaces,
+                                  WholeArrayInOut regions,
+                                  WholeArrayIn connectivity,
+                                  WholeArrayIn cellOffsets,
+                                  WholeArrayIn faceNormals,
+                                  FieldOut newPointNum);
+    using ExecutionSignature = void(InputIndex, _1, _2, _3, _4, _5, _6, _7, _8);
+
+    template <typename IncidentFacesPortal,
+              typename RegionsPortal,
+              typename ConnectivityPortal,
+              typename OffsetsPortal,
+              typename NormalsPortal>
+    VTKM_EXEC void operator()(vtkm::Id pointIndex,
+                              vtkm::Id begin,
+                              vtkm::Id end,
+                              const IncidentFacesPortal& incidentFaces,
+                              const RegionsPortal& regions,
+                              const ConnectivityPortal& connectivity,
+                              const OffsetsPortal& cellOffsets,
+                              const NormalsPortal& faceNormals,
+                              vtkm::Id& newPointNum) const
     {
-      ++edgeIndex;
-      if (edgeIndex >= numEdges)
+      const vtkm::Id numFaces = end - begin;
+      for (vtkm::Id i = begin + 1; i < end; ++i)
       {
-        break;
+        const vtkm::Id face = incidentFaces.Get(i);
+        vtkm::Id j = i;
+        for (; (j > begin) && (incidentFaces.Get(j - 1) > face); --j)
+        {
+          incidentFaces.Set(j, incidentFaces.Get(j - 1));
+        }
+        incidentFaces.Set(j, face);
       }
-      vtkm::IdComponent2 localEdgeIndices;
-      vtkm::exec::CellEdgeLocalIndex(numPointsInCell, 0, edgeIndex, cellShape, localEdgeIndices[0]);
-      vtkm::exec::CellEdgeLocalIndex(numPointsInCell, 1, edgeIndex, cellShape, localEdgeIndices[1]);
-      vtkm::Id2 canonicalEdgeId(cellConnections[localEdgeIndices[0]],
-                                cellConnections[localEdgeIndices[1]]);
-      if ((canonicalEdgeId[0] == eOI[0] && canonicalEdgeId[1] == eOI[1]) ||
-          (canonicalEdgeId[0] == eOI[1] && canonicalEdgeId[1] == eOI[0]))
+      for (vtkm::Id i = 0; i < numFaces; ++i)
       {
-        neighboringCellIndex = incidentCellIndex;
-        break;
+        regions.Set(begin + i, i);
       }
-    }
-  }
-  return neighboringCellIndex;
-}
 
-// Generalized logic for finding what 'regions' own the connected cells.
-template <typename IncidentCellVecType, typename PointFromCellSetType, typename FaceNormalVecType>
-VTKM_EXEC bool FindConnectedCellOwnerships(vtkm::FloatDefault cosFeatureAngle,
-                                           const IncidentCellVecType& incidentCells,
-                                           vtkm::Id pointIndex,
-                                           const PointFromCellSetType& pFromCellSet,
-                                           const FaceNormalVecType& faceNormals,
-                                           vtkm::Id visitedCellsRegionIndex[64],
-                                           vtkm::Id& regionIndex)
-{
-  const vtkm::IdComponent numberOfIncidentCells = incidentCells.GetNumberOfComponents();
-  VTKM_ASSERT(numberOfIncidentCells < 64);
-  if (numberOfIncidentCells <= 1)
-  {
-    return false; // Not enough cells to compare
-  }
-  // Initialize a global cell mask to avoid confusion. globalCellIndex->status
-  // 0 means not visited yet 1 means visited.
-  vtkm::Bitset<vtkm::UInt64> visitedCells;
-  // Reallocate memory for visitedCellsGroup if needed
-
-  // Loop through each cell
-  for (vtkm::IdComponent incidentCellIndex = 0; incidentCellIndex < numberOfIncidentCells;
-       incidentCellIndex++)
-  {
-    vtkm::Id cellIndexG = incidentCells[incidentCellIndex]; // cell index in global order
-    // If not visited
-    if (!visitedCells.test(incidentCellIndex))
-    {
-      // Mark the cell and track the region
-      visitedCells.set(incidentCellIndex);
-      visitedCellsRegionIndex[incidentCellIndex] = regionIndex;
-
-      // Find two edges containing the current point in canonial index
-      vtkm::Id2 edge0G(-1, -1), edge1G(-1, -1);
-      internal::FindRelatedEdges(pointIndex, cellIndexG, pFromCellSet, edge0G, edge1G);
-      // Grow the area along each edge
-      for (size_t i = 0; i < 2; i++)
-      { // Reset these two values for each grow operation
-        vtkm::Id2 currentEdgeG = i == 0 ? edge0G : edge1G;
-        vtkm::IdComponent currentTestingCellIndex = incidentCellIndex;
-        while (currentTestingCellIndex >= 0)
+      for (vtkm::Id i = 0; i < numFaces; ++i)
+      {
+        const vtkm::Id2 edgePoints =
+          GetEdgePoints(pointIndex, incidentFaces.Get(begin + i), connectivity, cellOffsets);
+        for (vtkm::IdComponent edge = 0; edge < 2; ++edge)
         {
-          // Find the neighbor cell of the current cell edge in local index
-          int neighboringCellIndexQuery = internal::FindNeighborCellInLocalIndex(
-            currentEdgeG, pFromCellSet, incidentCells, currentTestingCellIndex);
-          // The edge should be manifold and the neighboring cell should
-          // have not been visited
-          if (neighboringCellIndexQuery != -1 && !visitedCells.test(neighboringCellIndexQuery))
+          // Only a manifold edge, shared by exactly two faces, connects the faces.
+          vtkm::Id neighbor = -1;
+          vtkm::IdComponent numNeighbors = 0;
+          for (vtkm::Id j = 0; j < numFaces; ++j)
           {
-            vtkm::IdComponent neighborCellIndex =
-              static_cast<vtkm::IdComponent>(neighboringCellIndexQuery);
-            // Try to grow the area if the feature angle between current neighbor
-            auto thisNormal = faceNormals[currentTestingCellIndex];
-            //neighborNormal
-            auto neighborNormal = faceNormals[neighborCellIndex];
-            // Try to grow the area
-            if (vtkm::dot(thisNormal, neighborNormal) > cosFeatureAngle)
-            { // No need to split.
-              visitedCells.set(neighborCellIndex);
-
-              // Mark the region visited
-              visitedCellsRegionIndex[neighborCellIndex] = regionIndex;
-
-              // Move to examine next cell
-              currentTestingCellIndex = neighborCellIndex;
-              vtkm::Id2 neighborCellEdge0G(-1, -1), neighborCellEdge1G(-1, -1);
-              internal::FindRelatedEdges(pointIndex,
-                                         incidentCells[currentTestingCellIndex],
-                                         pFromCellSet,
-                                         neighborCellEdge0G,
-                                         neighborCellEdge1G);
-              // Update currentEdgeG
-              if ((currentEdgeG == neighborCellEdge0G) ||
-                  currentEdgeG == vtkm::Id2(neighborCellEdge0G[1], neighborCellEdge0G[0]))
-              {
-                currentEdgeG = neighborCellEdge1G;
-              }
-              else
-              {
-                currentEdgeG = neighborCellEdge0G;
-              }
-            }
-            else
+            const vtkm::Id2 otherEdgePoints =
+              GetEdgePoints(pointIndex, incidentFaces.Get(begin + j), connectivity, cellOffsets);
+            if ((j != i) &&
+                ((otherEdgePoints[0] == edgePoints[edge]) ||
+                 (otherEdgePoints[1] == edgePoints[edge])))
             {
-              currentTestingCellIndex = -1;
+              neighbor = j;
+              ++numNeighbors;
             }
           }
-          else
+          if ((numNeighbors == 1) && (neighbor > i) &&
+              (vtkm::Dot(faceNormals.Get(incidentFaces.Get(begin + i)),
+                         faceNormals.Get(incidentFaces.Get(begin + neighbor))) >
+               this->CosFeatureAngle))
           {
-            currentTestingCellIndex =
-              -1; // Either seperated by previous visit, boundary or non-manifold
+            Unite(begin, i, neighbor, regions);
           }
-          // cells is smaller than the thresold and the nighboring cell has not been visited
         }
       }
-      regionIndex++;
+
+      // The parent of each face precedes it, so a pass in order points every face at its root.
+      for (vtkm::Id i = 0; i < numFaces; ++i)
+      {
+        const vtkm::Id parent = regions.Get(begin + i);
+        regions.Set(begin + i, (parent == i) ? i : regions.Get(begin + parent));
+      }
+      // Roots are numbered before the faces that point at them.
+      vtkm::Id numRegions = 0;
+      for (vtkm::Id i = 0; i < numFaces; ++i)
+      {
+        const vtkm::Id root = regions.Get(begin + i);
+        regions.Set(begin + i, (root == i) ? numRegions++ : regions.Get(begin + root));
+      }
+      newPointNum = (numRegions > 1) ? numRegions - 1 : 0;
     }
-  }
-  return true;
-}
 
-} // internal namespace
+  private:
+    // Returns the points that share an edge with `pointIndex` in `face`.
+    template <typename ConnectivityPortal, typename OffsetsPortal>
+    VTKM_EXEC static vtkm::Id2 GetEdgePoints(vtkm::Id pointIndex,
+                                             vtkm::Id face,
+                                             const ConnectivityPortal& connectivity,
+                                             const OffsetsPortal& cellOffsets)
+    {
+      const vtkm::Id faceBegin = cellOffsets.Get(face);
+      const vtkm::Id faceEnd = cellOffsets.Get(face + 1);
+      for (vtkm::Id i = faceBegin; i < faceEnd; ++i)
+      {
+        if (connectivity.Get(i) == pointIndex)
+        {
+          const vtkm::Id previous = (i == faceBegin) ? faceEnd - 1 : i - 1;
+          const vtkm::Id next = (i + 1 == faceEnd) ? faceBegin : i + 1;
+          return vtkm::Id2(connectivity.Get(previous), connectivity.Get(next));
+        }
+      }
+      return vtkm::Id2(-1, -1);
+    }
 
-// Split sharp manifold edges where the feature angle between the
-// adjacent surfaces are larger than the threshold value
-class SplitSharpEdges
-{
-public:
-  // This worklet would calculate the needed space for splitting sharp edges.
-  // For each point, it would have two values as numberOfNewPoint(how many
-  // times this point needs to be duplicated) and numberOfCellsNeedsUpdate
-  // (how many neighboring cells need to update connectivity).
-  // For example, Given a unit cube and feature angle
-  // as 89 degree, each point would be duplicated twice and there are two cells
-  // need connectivity update. There is no guarantee on which cell would get which
-  // new point.
-  class ClassifyPoint : public vtkm::worklet::WorkletVisitPointsWithCells
-  {
-  public:
-    ClassifyPoint(vtkm::FloatDefault cosfeatureAngle)
-      : CosFeatureAngle(cosfeatureAngle)
+    template <typename RegionsPortal>
+    VTKM_EXEC static vtkm::Id FindRoot(vtkm::Id begin, vtkm::Id index, const RegionsPortal& regions)
     {
+      vtkm::Id parent = regions.Get(begin + index);
+      while (parent != index)
+      {
+        index = parent;
+        parent = regions.Get(begin + index);
+      }
+      return index;
     }
-    using ControlSignature = void(CellSetIn intputCells,
-                                  WholeCellSetIn<Cell, Point>, // Query points from cell
-                                  FieldInCell faceNormals,
-                                  FieldOutPoint newPointNum,
-                                  FieldOutPoint cellNum);
-    using ExecutionSignature = void(CellIndices incidentCells,
-                                    InputIndex pointIndex,
-                                    _2 pFromCellSet,
-                                    _3 faceNormals,
-                                    _4 newPointNum,
-                                    _5 cellNum);
-    using InputDomain = _1;
-
-    template <typename IncidentCellVecType,
-              typename PointFromCellSetType,
-              typename FaceNormalVecType>
-    VTKM_EXEC void operator()(const IncidentCellVecType& incidentCells,
-                              vtkm::Id pointIndex,
-                              const PointFromCellSetType& pFromCellSet,
-                              const FaceNormalVecType& faceNormals,
-                              vtkm::Id& newPointNum,
-                              vtkm::Id& cellNum) const
+
+    template <typename RegionsPortal>
+    VTKM_EXEC static void Unite(vtkm::Id begin,
+                                vtkm::Id index1,
+                                vtkm::Id index2,
+                                const RegionsPortal& regions)
     {
-      vtkm::Id regionIndex = 0;
-      vtkm::Id visitedCellsRegionIndex[64] = { 0 };
-      const bool foundConnections = internal::FindConnectedCellOwnerships(this->CosFeatureAngle,
-                                                                          incidentCells,
-                                                                          pointIndex,
-                                                                          pFromCellSet,
-                                                                          faceNormals,
-                                                                          visitedCellsRegionIndex,
-                                                                          regionIndex);
-      if (!foundConnections)
+      const vtkm::Id root1 = FindRoot(begin, index1, regions);
+      const vtkm::Id root2 = FindRoot(begin, index2, regions);
+      if (root1 < root2)
       {
-        newPointNum = 0;
-        cellNum = 0;
+        regions.Set(begin + root2, root1);
       }
-      else
+      else if (root2 < root1)
       {
-        // For each new region you need a new point
-        vtkm::Id numberOfCellsNeedUpdate = 0;
-        const vtkm::IdComponent size = incidentCells.GetNumberOfComponents();
-        for (vtkm::IdComponent i = 0; i < size; i++)
-        {
-          if (visitedCellsRegionIndex[i] > 0)
-          {
-            numberOfCellsNeedUpdate++;
-          }
-        }
-        newPointNum = regionIndex - 1;
-        cellNum = numberOfCellsNeedUpdate;
+        regions.Set(begin + root1, root2);
       }
     }
 
-  private:
     vtkm::FloatDefault CosFeatureAngle; // Cos value of the feature angle
   };
 
-  // This worklet split the sharp edges and populate the
-  // cellTopologyUpdateTuples as (cellGlobalId, oldPointId, newPointId).
-  class SplitSharpEdge : public vtkm::worklet::WorkletVisitPointsWithCells
+  // Replaces the point in the faces of each group but the first one with the new point of
+  // the group, and records which point each new point duplicates.
+  class SplitSharpEdge : public vtkm::worklet::WorkletMapField
   {
   public:
-    SplitSharpEdge(vtkm::FloatDefault cosfeatureAngle, vtkm::Id numberOfOldPoints)
-      : CosFeatureAngle(cosfeatureAngle)
-      , NumberOfOldPoints(numberOfOldPoints)
+    VTKM_CONT SplitSharpEdge(vtkm::Id numberOfOldPoints)
+      : NumberOfOldPoints(numberOfOldPoints)
     {
     }
-    using ControlSignature = void(CellSetIn intputCells,
-                                  WholeCellSetIn<Cell, Point>, // Query points from cell
-                                  FieldInCell faceNormals,
-                                  FieldInPoint newPointStartingIndex,
-                                  FieldInPoint pointCellsStartingIndex,
-                                  WholeArrayOut cellTopologyUpdateTuples);
-    using ExecutionSignature = void(CellIndices incidentCells,
-                                    InputIndex pointIndex,
-                                    _2 pFromCellSet,
-                                    _3 faceNormals,
-                                    _4 newPointStartingIndex,
-                                    _5 pointCellsStartingIndex,
-                                    _6 cellTopologyUpdateTuples);
-    using InputDomain = _1;
-
-    template <typename IncidentCellVecType,
-              typename PointFromCellSetType,
-              typename FaceNormalVecType,
-              typename CellTopologyUpdateTuples>
-    VTKM_EXEC void operator()(const IncidentCellVecType& incidentCells,
-                              vtkm::Id pointIndex,
-                              const PointFromCellSetType& pFromCellSet,
-                              const FaceNormalVecType& faceNormals,
-                              const vtkm::Id& newPointStartingIndex,
-                              const vtkm::Id& pointCellsStartingIndex,
-                              CellTopologyUpdateTuples& cellTopologyUpdateTuples) const
+
+    using ControlSignature = void(FieldIn adjacencyBegin,
+                                  FieldIn adjacencyEnd,
+                                  FieldIn newPointStartingIndex,
+                                  FieldIn newPointNum,
+                                  WholeArrayIn incidentFaces,
+                                  WholeArrayIn regions,
+                                  WholeArrayIn connectivity,
+                                  WholeArrayIn cellOffsets,
+                                  WholeArrayOut newConnectivity,
+                                  WholeArrayOut newPointsIds);
+    using ExecutionSignature = void(InputIndex, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10);
+
+    template <typename IncidentFacesPortal,
+              typename RegionsPortal,
+              typename ConnectivityPortal,
+              typename OffsetsPortal,
+              typename NewConnectivityPortal,
+              typename NewPointsIdsPortal>
+    VTKM_EXEC void operator()(vtkm::Id pointIndex,
+                              vtkm::Id begin,
+                              vtkm::Id end,
+                              vtkm::Id newPointStartingIndex,
+                              vtkm::Id newPointNum,
+                              const IncidentFacesPortal& incidentFaces,
+                              const RegionsPortal& regions,
+                              const ConnectivityPortal& connectivity,
+                              const OffsetsPortal& cellOffsets,
+                              const NewConnectivityPortal& newConnectivity,
+                              const NewPointsIdsPortal& newPointsIds) const
     {
-      vtkm::Id regionIndex = 0;
-      vtkm::Id visitedCellsRegionIndex[64] = { 0 };
-      const bool foundConnections = internal::FindConnectedCellOwnerships(this->CosFeatureAngle,
-                                                                          incidentCells,
-                                                                          pointIndex,
-                                                                          pFromCellSet,
-                                                                          faceNormals,
-                                                                          visitedCellsRegionIndex,
-                                                                          regionIndex);
-      if (foundConnections)
+      if (newPointNum == 0)
+      {
+        return;
+      }
+      const vtkm::Id firstNewPoint = this->NumberOfOldPoints + newPointStartingIndex;
+      for (vtkm::Id i = 0; i < newPointNum; ++i)
+      {
+        newPointsIds.Set(firstNewPoint + i, pointIndex);
+      }
+
+      for (vtkm::Id i = begin; i < end; ++i)
       {
-        // For each new region you need a new point
-        // Initialize the offset in the global cellTopologyUpdateTuples;
-        vtkm::Id cellTopologyUpdateTuplesIndex = pointCellsStartingIndex;
-        const vtkm::IdComponent size = incidentCells.GetNumberOfComponents();
-        for (vtkm::Id i = 0; i < size; i++)
+        const vtkm::Id region = regions.Get(i);
+        if (region == 0)
         {
-          if (visitedCellsRegionIndex[i])
-          { // New region generated. Need to update the topology
-            vtkm::Id replacementPointId =
-              NumberOfOldPoints + newPointStartingIndex + visitedCellsRegionIndex[i] - 1;
-            vtkm::Id globalCellId = incidentCells[static_cast<vtkm::IdComponent>(i)];
-            // (cellGlobalIndex, oldPointId, replacementPointId)
-            vtkm::Id3 tuple = vtkm::make_Vec(globalCellId, pointIndex, replacementPointId);
-            cellTopologyUpdateTuples.Set(cellTopologyUpdateTuplesIndex, tuple);
-            cellTopologyUpdateTuplesIndex++;
+          continue;
+        }
+        const vtkm::Id face = incidentFaces.Get(i);
+        for (vtkm::Id j = cellOffsets.Get(face); j < cellOffsets.Get(face + 1); ++j)
+        {
+          if (connectivity.Get(j) == pointIndex)
+          {
+            newConnectivity.Set(j, firstNewPoint + region - 1);
           }
         }
       }
     }
 
   private:
-    vtkm::FloatDefault CosFeatureAngle; // Cos value of the feature angle
     vtkm::Id NumberOfOldPoints;
   };
 
@@ -401,103 +327,82 @@ public:
 
     const vtkm::FloatDefault featureAngleR =
       featureAngle / static_cast<vtkm::FloatDefault>(180.0) * vtkm::Pi<vtkm::FloatDefault>();
+    const vtkm::Id numberOfOldPoints = oldCoords.GetNumberOfValues();
+
+    vtkm::cont::CellSetExplicit<> faces;
+    CellDeepCopy::Run(oldCellset, faces, numberOfOldPoints);
+    const auto connectivity =
+      faces.GetConnectivityArray(vtkm::TopologyElementTagCell(), vtkm::TopologyElementTagPoint());
+    const auto cellOffsets =
+      faces.GetOffsetsArray(vtkm::TopologyElementTagCell(), vtkm::TopologyElementTagPoint());
+
+    // Build the point-to-face adjacency with a counting sort.
+    vtkm::cont::ArrayHandle<vtkm::Id> adjacencyOffsets;
+    adjacencyOffsets.AllocateAndFill(numberOfOldPoints + 1, 0);
+    invoke(CountIncidentFaces{}, faces, adjacencyOffsets);
+    vtkm::cont::Algorithm::ScanExclusive(adjacencyOffsets, adjacencyOffsets);
+    vtkm::cont::ArrayHandle<vtkm::Id> faceCursors;
+    vtkm::cont::ArrayCopy(adjacencyOffsets, faceCursors);
+    vtkm::cont::ArrayHandle<vtkm::Id> incidentFaces;
+    incidentFaces.Allocate(connectivity.GetNumberOfValues());
+    invoke(FillIncidentFaces{}, faces, faceCursors, incidentFaces);
+    faceCursors.ReleaseResources();
+
+    const auto adjacencyBegin =
+      vtkm::cont::make_ArrayHandleView(adjacencyOffsets, 0, numberOfOldPoints);
+    const auto adjacencyEnd =
+      vtkm::cont::make_ArrayHandleView(adjacencyOffsets, 1, numberOfOldPoints);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> regions;
+    regions.Allocate(incidentFaces.GetNumberOfValues());
+    vtkm::cont::ArrayHandle<vtkm::Id> newPointNums;
+    invoke(ClassifyPoint{ vtkm::Cos(featureAngleR) },
+           adjacencyBegin,
+           adjacencyEnd,
+           incidentFaces,
+           regions,
+           connectivity,
+           cellOffsets,
+           faceNormals,
+           newPointNums);
 
-    //Launch the first kernel that computes which points need to be split
-    vtkm::cont::ArrayHandle<vtkm::Id> newPointNums, cellNeedUpdateNums;
-    ClassifyPoint classifyPoint(vtkm::Cos(featureAngleR));
-    invoke(classifyPoint, oldCellset, oldCellset, faceNormals, newPointNums, cellNeedUpdateNums);
-    VTKM_ASSERT(newPointNums.GetNumberOfValues() == oldCoords.GetNumberOfValues());
-
-    //Compute relevant information from cellNeedUpdateNums so we can release
-    //that memory asap
-    vtkm::cont::ArrayHandle<vtkm::Id> pointCellsStartingIndexs;
-    vtkm::cont::Algorithm::ScanExclusive(cellNeedUpdateNums, pointCellsStartingIndexs);
-
-    const vtkm::Id cellsNeedUpdateNum =
-      vtkm::cont::Algorithm::Reduce(cellNeedUpdateNums, vtkm::Id(0));
-    cellNeedUpdateNums.ReleaseResources();
-
+    vtkm::cont::ArrayHandle<vtkm::Id> newPointStartingIndexs;
+    const vtkm::Id totalNewPointsNum =
+      vtkm::cont::Algorithm::ScanExclusive(newPointNums, newPointStartingIndexs);
 
     //Compute the mapping of new points to old points. This is required for
     //processing additional point fields
-    const vtkm::Id totalNewPointsNum = vtkm::cont::Algorithm::Reduce(newPointNums, vtkm::Id(0));
-    this->NewPointsIdArray.Allocate(oldCoords.GetNumberOfValues() + totalNewPointsNum);
-    vtkm::cont::Algorithm::CopySubRange(
-      vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), vtkm::Id(1), oldCoords.GetNumberOfValues()),
-      0,
-      oldCoords.GetNumberOfValues(),
-      this->NewPointsIdArray,
-      0);
-    auto newPointsIdArrayPortal = this->NewPointsIdArray.WritePortal();
-
-    // Fill the new point coordinate system with all the existing values
-    newCoords.Allocate(oldCoords.GetNumberOfValues() + totalNewPointsNum);
-    vtkm::cont::Algorithm::CopySubRange(oldCoords, 0, oldCoords.GetNumberOfValues(), newCoords);
-
+    this->NewPointsIdArray.Allocate(numberOfOldPoints + totalNewPointsNum);
+    vtkm::cont::Algorithm::CopySubRange(vtkm::cont::ArrayHandleIndex(numberOfOldPoints),
+                                        0,
+                                        numberOfOldPoints,
+                                        this->NewPointsIdArray);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> newConnectivity;
+    vtkm::cont::ArrayCopy(connectivity, newConnectivity);
     if (totalNewPointsNum > 0)
-    { //only if we have new points do we need add any of the new
-      //coordinate locations
-      vtkm::Id newCoordsIndex = oldCoords.GetNumberOfValues();
-      auto oldCoordsPortal = oldCoords.ReadPortal();
-      auto newCoordsPortal = newCoords.WritePortal();
-      auto newPointNumsPortal = newPointNums.WritePortal();
-      for (vtkm::Id i = 0; i < oldCoords.GetNumberOfValues(); i++)
-      { // Find out for each new point, how many times it should be added
-        for (vtkm::Id j = 0; j < newPointNumsPortal.Get(i); j++)
-        {
-          newPointsIdArrayPortal.Set(newCoordsIndex, i);
-          newCoordsPortal.Set(newCoordsIndex++, oldCoordsPortal.Get(i));
-        }
-      }
+    {
+      invoke(SplitSharpEdge{ numberOfOldPoints },
+             adjacencyBegin,
+             adjacencyEnd,
+             newPointStartingIndexs,
+             newPointNums,
+             incidentFaces,
+             regions,
+             connectivity,
+             cellOffsets,
+             newConnectivity,
+             this->NewPointsIdArray);
     }
 
-    // Allocate the size for the updateCellTopologyArray
-    vtkm::cont::ArrayHandle<vtkm::Id3> cellTopologyUpdateTuples;
-    cellTopologyUpdateTuples.Allocate(cellsNeedUpdateNum);
-
-    vtkm::cont::ArrayHandle<vtkm::Id> newpointStartingIndexs;
-    vtkm::cont::Algorithm::ScanExclusive(newPointNums, newpointStartingIndexs);
-    newPointNums.ReleaseResources();
+    vtkm::cont::ArrayCopy(
+      vtkm::cont::make_ArrayHandlePermutation(this->NewPointsIdArray, oldCoords), newCoords);
 
-
-    SplitSharpEdge splitSharpEdge(vtkm::Cos(featureAngleR), oldCoords.GetNumberOfValues());
-    invoke(splitSharpEdge,
-           oldCellset,
-           oldCellset,
-           faceNormals,
-           newpointStartingIndexs,
-           pointCellsStartingIndexs,
-           cellTopologyUpdateTuples);
-    auto ctutPortal = cellTopologyUpdateTuples.ReadPortal();
-    vtkm::cont::printSummary_ArrayHandle(cellTopologyUpdateTuples, std::cout);
-
-
-    // Create the new cellset
-    CellDeepCopy::Run(oldCellset, newCellset, this->NewPointsIdArray.GetNumberOfValues());
-    // FIXME: Since the non const get array function is not in CellSetExplict.h,
-    // here I just get a non-const copy of the array handle.
-    auto connectivityArrayHandle = newCellset.GetConnectivityArray(vtkm::TopologyElementTagCell(),
-                                                                   vtkm::TopologyElementTagPoint());
-    auto connectivityArrayHandleP = connectivityArrayHandle.WritePortal();
-    auto offsetArrayHandle =
-      newCellset.GetOffsetsArray(vtkm::TopologyElementTagCell(), vtkm::TopologyElementTagPoint());
-    auto offsetArrayHandleP = offsetArrayHandle.WritePortal();
-    for (vtkm::Id i = 0; i < cellTopologyUpdateTuples.GetNumberOfValues(); i++)
-    {
-      vtkm::Id cellId(ctutPortal.Get(i)[0]), oldPointId(ctutPortal.Get(i)[1]),
-        newPointId(ctutPortal.Get(i)[2]);
-      vtkm::Id bound = (cellId + 1 == offsetArrayHandle.GetNumberOfValues())
-        ? connectivityArrayHandle.GetNumberOfValues()
-        : offsetArrayHandleP.Get(cellId + 1);
-      vtkm::Id k = 0;
-      for (vtkm::Id j = offsetArrayHandleP.Get(cellId); j < bound; j++, k++)
-      {
-        if (connectivityArrayHandleP.Get(j) == oldPointId)
-        {
-          connectivityArrayHandleP.Set(j, newPointId);
-        }
-      }
-    }
+    newCellset.Fill(this->NewPointsIdArray.GetNumberOfValues(),
+                    faces.GetShapesArray(vtkm::TopologyElementTagCell(),
+                                         vtkm::TopologyElementTagPoint()),
+                    newConnectivity,
+                    cellOffsets);
   }
 
   vtkm::cont::ArrayHandle<vtkm::Id> GetNewPointsIdArray() const { return this->NewPointsIdArray; }
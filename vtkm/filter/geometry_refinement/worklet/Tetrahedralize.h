@@ -10,9 +10,22 @@
 #ifndef vtkm_m_worklet_Tetrahedralize_h
 #define vtkm_m_worklet_Tetrahedralize_h
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/CellSetStructuredTetrahedralized.h>
+#include <vtkm/cont/ErrorBadType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
+
 #include <vtkm/filter/geometry_refinement/worklet/tetrahedralize/TetrahedralizeExplicit.h>
 #include <vtkm/filter/geometry_refinement/worklet/tetrahedralize/TetrahedralizeStructured.h>
 
+#include <vtkm/worklet/ScatterUniform.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <limits>
+#include <type_traits>
+
 namespace vtkm
 {
 namespace worklet
@@ -21,69 +34,130 @@ namespace worklet
 class Tetrahedralize
 {
 public:
-  //
-  // Distribute multiple copies of cell data depending on cells create from original
-  //
-  struct DistributeCellData : public vtkm::worklet::WorkletMapField
+  /// Storage of the connectivity of `vtkm::cont::CellSetSingleType` when the point indices
+  /// are stored as 32-bit integers.
+  using Int32ConnectivityStorage =
+    vtkm::cont::StorageTagCast<vtkm::Int32, vtkm::cont::StorageTagBasic>;
+
+  // Tetrahedralize a data set with vtkm::Id connectivity, save the input cell of each
+  // tetrahedron
+  template <typename CellSetType>
+  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet)
   {
-    using ControlSignature = void(FieldIn inIndices, FieldOut outIndices);
-    using ExecutionSignature = void(_1, _2);
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+    this->BuildConnectivity(cellSet, connectivity);
 
-    using ScatterType = vtkm::worklet::ScatterCounting;
+    vtkm::cont::CellSetSingleType<> outCellSet;
+    outCellSet.Fill(cellSet.GetNumberOfPoints(), vtkm::CellShapeTagTetra::Id, 4, connectivity);
+    return outCellSet;
+  }
 
-    template <typename CountArrayType>
-    VTKM_CONT static ScatterType MakeScatter(const CountArrayType& countArray)
+  // Tetrahedralize a data set with vtkm::Int32 connectivity, save the input cell of each
+  // tetrahedron
+  template <typename CellSetType>
+  vtkm::cont::CellSetSingleType<Int32ConnectivityStorage> RunInt32(const CellSetType& cellSet)
+  {
+    if (cellSet.GetNumberOfPoints() > std::numeric_limits<vtkm::Int32>::max())
     {
-      return ScatterType(countArray);
+      throw vtkm::cont::ErrorBadValue("Too many points for 32-bit connectivity.");
     }
 
-    template <typename T>
-    VTKM_EXEC void operator()(T inputIndex, T& outputIndex) const
+    vtkm::cont::ArrayHandle<vtkm::Int32> connectivity;
+    this->BuildConnectivity(cellSet, connectivity);
+
+    vtkm::cont::CellSetSingleType<Int32ConnectivityStorage> outCellSet;
+    outCellSet.Fill(cellSet.GetNumberOfPoints(),
+                    vtkm::CellShapeTagTetra::Id,
+                    4,
+                    vtkm::cont::make_ArrayHandleCast<vtkm::Id>(connectivity));
+    return outCellSet;
+  }
+
+  // Copies the value of each hexahedron to its five tetrahedra
+  struct DistributeCellData : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn inField, FieldOut outField);
+    using ExecutionSignature = void(_1, _2);
+    using ScatterType = vtkm::worklet::ScatterUniform<5>;
+
+    template <typename InType, typename OutType>
+    VTKM_EXEC void operator()(const InType& inValue, OutType& outValue) const
     {
-      outputIndex = inputIndex;
+      for (vtkm::IdComponent c = 0; c < inValue.GetNumberOfComponents(); ++c)
+      {
+        outValue[c] = inValue[c];
+      }
     }
   };
 
-  Tetrahedralize()
-    : OutCellScatter(vtkm::cont::ArrayHandle<vtkm::IdComponent>{})
+  // Tetrahedralize structured data set without storing the connectivity. The input cell of
+  // each tetrahedron follows from its index, so no cell map is saved either.
+  vtkm::cont::CellSetStructuredTetrahedralized RunImplicit(
+    const vtkm::cont::CellSetStructured<3>& cellSet)
   {
+    this->OutCellMap.ReleaseResources();
+    this->ImplicitCellMap = true;
+    return vtkm::cont::CellSetStructuredTetrahedralized(cellSet);
   }
 
-  // Tetrahedralize explicit data set, save number of tetra cells per input
-  template <typename CellSetType>
-  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet)
+  /// Returns the index of the input cell of each output tetrahedron. Empty after
+  /// `RunImplicit`, in which case cell fields are mapped with `ProcessImplicitCellField`.
+  const vtkm::cont::ArrayHandle<vtkm::Id>& GetOutCellMap() const { return this->OutCellMap; }
+
+  /// Whether the last run was `RunImplicit`.
+  bool HasImplicitCellMap() const { return this->ImplicitCellMap; }
+
+  /// Maps a cell field of the input of `RunImplicit` to its tetrahedra.
+  vtkm::cont::UnknownArrayHandle ProcessImplicitCellField(
+    const vtkm::cont::UnknownArrayHandle& inArray) const
+  {
+    vtkm::cont::UnknownArrayHandle outArray = inArray.NewInstanceBasic();
+    outArray.Allocate(5 * inArray.GetNumberOfValues());
+    inArray.CastAndCallWithExtractedArray([&](const auto& concrete) {
+      using T = typename std::decay_t<decltype(concrete)>::ValueType::ComponentType;
+      vtkm::cont::Invoker invoke;
+      invoke(DistributeCellData{},
+             concrete,
+             outArray.ExtractArrayFromComponents<T>(vtkm::CopyFlag::Off));
+    });
+    return outArray;
+  }
+
+private:
+  // Tetrahedralize explicit data set
+  template <typename CellSetType, typename ConnectivityType>
+  void BuildConnectivity(const CellSetType& cellSet,
+                         vtkm::cont::ArrayHandle<ConnectivityType>& connectivity)
   {
     TetrahedralizeExplicit worklet;
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> outCellsPerCell;
-    vtkm::cont::CellSetSingleType<> result = worklet.Run(cellSet, outCellsPerCell);
-    this->OutCellScatter = DistributeCellData::MakeScatter(outCellsPerCell);
-    return result;
+    worklet.Run(cellSet, connectivity, this->OutCellMap);
   }
 
-  // Tetrahedralize structured data set, save number of tetra cells per input
-  vtkm::cont::CellSetSingleType<> Run(const vtkm::cont::CellSetStructured<3>& cellSet)
+  // Tetrahedralize structured data set
+  template <typename ConnectivityType>
+  void BuildConnectivity(const vtkm::cont::CellSetStructured<3>& cellSet,
+                         vtkm::cont::ArrayHandle<ConnectivityType>& connectivity)
   {
     TetrahedralizeStructured worklet;
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> outCellsPerCell;
-    vtkm::cont::CellSetSingleType<> result = worklet.Run(cellSet, outCellsPerCell);
-    this->OutCellScatter = DistributeCellData::MakeScatter(outCellsPerCell);
-    return result;
+    worklet.Run(cellSet, connectivity, this->OutCellMap);
   }
 
-  vtkm::cont::CellSetSingleType<> Run(const vtkm::cont::CellSetStructured<2>&)
+  template <typename ConnectivityType>
+  void BuildConnectivity(const vtkm::cont::CellSetStructured<2>&,
+                         vtkm::cont::ArrayHandle<ConnectivityType>&)
   {
     throw vtkm::cont::ErrorBadType("CellSetStructured<2> can't be tetrahedralized");
   }
 
-  vtkm::cont::CellSetSingleType<> Run(const vtkm::cont::CellSetStructured<1>&)
+  template <typename ConnectivityType>
+  void BuildConnectivity(const vtkm::cont::CellSetStructured<1>&,
+                         vtkm::cont::ArrayHandle<ConnectivityType>&)
   {
     throw vtkm::cont::ErrorBadType("CellSetStructured<1> can't be tetrahedralized");
   }
 
-  DistributeCellData::ScatterType GetOutCellScatter() const { return this->OutCellScatter; }
-
-private:
-  DistributeCellData::ScatterType OutCellScatter;
+  vtkm::cont::ArrayHandle<vtkm::Id> OutCellMap;
+  bool ImplicitCellMap = false;
 };
 }
 } // namespace vtkm::worklet
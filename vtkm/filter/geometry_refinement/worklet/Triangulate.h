@@ -10,9 +10,14 @@
 #ifndef vtkm_m_worklet_Triangulate_h
 #define vtkm_m_worklet_Triangulate_h
 
+#include <vtkm/cont/ErrorBadType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
 #include <vtkm/filter/geometry_refinement/worklet/triangulate/TriangulateExplicit.h>
 #include <vtkm/filter/geometry_refinement/worklet/triangulate/TriangulateStructured.h>
 
+#include <limits>
+
 namespace vtkm
 {
 namespace worklet
@@ -21,68 +26,80 @@ namespace worklet
 class Triangulate
 {
 public:
-  //
-  // Distribute multiple copies of cell data depending on cells create from original
-  //
-  struct DistributeCellData : public vtkm::worklet::WorkletMapField
+  /// Storage of the connectivity of `vtkm::cont::CellSetSingleType` when the point indices
+  /// are stored as 32-bit integers.
+  using Int32ConnectivityStorage =
+    vtkm::cont::StorageTagCast<vtkm::Int32, vtkm::cont::StorageTagBasic>;
+
+  // Triangulate a data set with vtkm::Id connectivity, save the input cell of each triangle
+  template <typename CellSetType>
+  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet)
   {
-    using ControlSignature = void(FieldIn inIndices, FieldOut outIndices);
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+    this->BuildConnectivity(cellSet, connectivity);
 
-    using ScatterType = vtkm::worklet::ScatterCounting;
+    vtkm::cont::CellSetSingleType<> outCellSet;
+    outCellSet.Fill(cellSet.GetNumberOfPoints(), vtkm::CellShapeTagTriangle::Id, 3, connectivity);
+    return outCellSet;
+  }
 
-    template <typename CountArrayType>
-    VTKM_CONT static ScatterType MakeScatter(const CountArrayType& countArray)
+  // Triangulate a data set with vtkm::Int32 connectivity, save the input cell of each triangle
+  template <typename CellSetType>
+  vtkm::cont::CellSetSingleType<Int32ConnectivityStorage> RunInt32(const CellSetType& cellSet)
+  {
+    if (cellSet.GetNumberOfPoints() > std::numeric_limits<vtkm::Int32>::max())
     {
-      return ScatterType(countArray);
+      throw vtkm::cont::ErrorBadValue("Too many points for 32-bit connectivity.");
     }
 
-    template <typename T>
-    VTKM_EXEC void operator()(T inputIndex, T& outputIndex) const
-    {
-      outputIndex = inputIndex;
-    }
-  };
+    vtkm::cont::ArrayHandle<vtkm::Int32> connectivity;
+    this->BuildConnectivity(cellSet, connectivity);
 
-  Triangulate()
-    : OutCellScatter(vtkm::cont::ArrayHandle<vtkm::IdComponent>{})
-  {
+    vtkm::cont::CellSetSingleType<Int32ConnectivityStorage> outCellSet;
+    outCellSet.Fill(cellSet.GetNumberOfPoints(),
+                    vtkm::CellShapeTagTriangle::Id,
+                    3,
+                    vtkm::cont::make_ArrayHandleCast<vtkm::Id>(connectivity));
+    return outCellSet;
   }
 
-  // Triangulate explicit data set, save number of triangulated cells per input
-  template <typename CellSetType>
-  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet)
+  /// Returns the index of the input cell of each output triangle.
+  const vtkm::cont::ArrayHandle<vtkm::Id>& GetOutCellMap() const { return this->OutCellMap; }
+
+private:
+  // Triangulate explicit data set
+  template <typename CellSetType, typename ConnectivityType>
+  void BuildConnectivity(const CellSetType& cellSet,
+                         vtkm::cont::ArrayHandle<ConnectivityType>& connectivity)
   {
     TriangulateExplicit worklet;
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> outCellsPerCell;
-    vtkm::cont::CellSetSingleType<> result = worklet.Run(cellSet, outCellsPerCell);
-    this->OutCellScatter = DistributeCellData::MakeScatter(outCellsPerCell);
-    return result;
+    worklet.Run(cellSet, connectivity, this->OutCellMap);
   }
 
-  // Triangulate structured data set, save number of triangulated cells per input
-  vtkm::cont::CellSetSingleType<> Run(const vtkm::cont::CellSetStructured<2>& cellSet)
+  // Triangulate structured data set
+  template <typename ConnectivityType>
+  void BuildConnectivity(const vtkm::cont::CellSetStructured<2>& cellSet,
+                         vtkm::cont::ArrayHandle<ConnectivityType>& connectivity)
   {
     TriangulateStructured worklet;
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> outCellsPerCell;
-    vtkm::cont::CellSetSingleType<> result = worklet.Run(cellSet, outCellsPerCell);
-    this->OutCellScatter = DistributeCellData::MakeScatter(outCellsPerCell);
-    return result;
+    worklet.Run(cellSet, connectivity, this->OutCellMap);
   }
 
-  vtkm::cont::CellSetSingleType<> Run(const vtkm::cont::CellSetStructured<3>&)
+  template <typename ConnectivityType>
+  void BuildConnectivity(const vtkm::cont::CellSetStructured<3>&,
+                         vtkm::cont::ArrayHandle<ConnectivityType>&)
   {
     throw vtkm::cont::ErrorBadType("CellSetStructured<3> can't be triangulated");
   }
 
-  vtkm::cont::CellSetSingleType<> Run(const vtkm::cont::CellSetStructured<1>&)
+  template <typename ConnectivityType>
+  void BuildConnectivity(const vtkm::cont::CellSetStructured<1>&,
+                         vtkm::cont::ArrayHandle<ConnectivityType>&)
   {
-    throw vtkm::cont::ErrorBadType("CellSetStructured<1> can't be tetrahedralized");
+    throw vtkm::cont::ErrorBadType("CellSetStructured<1> can't be triangulated");
   }
 
-  DistributeCellData::ScatterType GetOutCellScatter() const { return this->OutCellScatter; }
-
-private:
-  DistributeCellData::ScatterType OutCellScatter;
+  vtkm::cont::ArrayHandle<vtkm::Id> OutCellMap;
 };
 }
 } // namespace vtkm::worklet
@@ -17,6 +17,7 @@
 #include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/DispatcherMapTopology.h>
 #include <vtkm/worklet/ScatterCounting.h>
 #include <vtkm/worklet/WorkletMapField.h>
@@ -558,6 +559,76 @@ public:
     vtkm::Id NumSides;
   };
 
+  //Helper worklet to count the line segments of an instanced tube.
+  class CountInstancedSegments : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn nonIncidentPtsPerPolyline, FieldOut numSegments);
+    using ExecutionSignature = void(_1, _2);
+
+    VTKM_EXEC void operator()(const vtkm::IdComponent& nonIncidentPtsPerPolyline,
+                              vtkm::Id& numSegments) const
+    {
+      numSegments = (nonIncidentPtsPerPolyline > 1) ? (nonIncidentPtsPerPolyline - 1) : 0;
+    }
+  };
+
+  //Helper worklet to generate the line segments of an instanced tube. Coincident points
+  //are skipped the same way as they are when the tube points are generated.
+  class GenerateSegments : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  WholeArrayIn pointCoords,
+                                  FieldInCell numSegments,
+                                  FieldInCell segmentOffsets,
+                                  WholeArrayOut outConnectivity,
+                                  WholeArrayOut outCellSrcIdx);
+    using ExecutionSignature = void(PointCount numPoints,
+                                    PointIndices ptIndices,
+                                    InputIndex inCellIndex,
+                                    _2 inPts,
+                                    _3 numSegments,
+                                    _4 segmentOffset,
+                                    _5 outConn,
+                                    _6 outCellSrcIdx);
+    using InputDomain = _1;
+
+    template <typename PointIndexType,
+              typename InPointsType,
+              typename OutConnType,
+              typename OutCellSrcIdxType>
+    VTKM_EXEC void operator()(const vtkm::IdComponent& numPoints,
+                              const PointIndexType& ptIndices,
+                              vtkm::Id inCellIndex,
+                              const InPointsType& inPts,
+                              const vtkm::Id& numSegments,
+                              const vtkm::Id& segmentOffset,
+                              OutConnType& outConn,
+                              OutCellSrcIdxType& outCellSrcIdx) const
+    {
+      if (numSegments == 0)
+        return;
+
+      vtkm::Id outIdx = segmentOffset;
+      vtkm::Id pIdx = ptIndices[0];
+      vtkm::Vec3f p = inPts.Get(pIdx);
+      for (vtkm::IdComponent i = 1; i < numPoints; ++i)
+      {
+        const vtkm::Id pNextIdx = ptIndices[i];
+        const vtkm::Vec3f pNext = inPts.Get(pNextIdx);
+        if (vtkm::Magnitude(pNext - p) > vtkm::Epsilon<vtkm::FloatDefault>())
+        {
+          outConn.Set(2 * outIdx + 0, pIdx);
+          outConn.Set(2 * outIdx + 1, pNextIdx);
+          outCellSrcIdx.Set(outIdx, inCellIndex);
+          outIdx++;
+          pIdx = pNextIdx;
+          p = pNext;
+        }
+      }
+    }
+  };
 
   class MapField : public vtkm::worklet::WorkletMapField
   {
@@ -682,6 +753,55 @@ public:
     newCells.Fill(totalTubePts, vtkm::CELL_SHAPE_TRIANGLE, 3, newConnectivity);
   }
 
+  /// Generates the line segments of the tubes instead of their geometry. The segments use the
+  /// input points, so point fields do not change, and a renderer such as `MapperCylinder`
+  /// applies the radius when it draws them.
+  template <typename Storage>
+  VTKM_CONT void RunInstanced(const vtkm::cont::ArrayHandle<vtkm::Vec3f, Storage>& coords,
+                              const vtkm::cont::UnknownCellSet& cellset,
+                              vtkm::cont::CellSetSingleType<>& newCells)
+  {
+    if (!cellset.CanConvert<vtkm::cont::CellSetExplicit<>>() &&
+        !cellset.CanConvert<vtkm::cont::CellSetSingleType<>>())
+    {
+      throw vtkm::cont::ErrorBadValue("Tube filter only supported for polyline data.");
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Id> ptsPerPolyline, ptsPerTube, numTubeConnIds, validCell;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> nonIncidentPtsPerPolyline;
+    CountSegments countSegs(this->Capping, this->NumSides);
+    vtkm::worklet::DispatcherMapTopology<CountSegments> countInvoker(countSegs);
+    countInvoker.Invoke(cellset,
+                        coords,
+                        nonIncidentPtsPerPolyline,
+                        ptsPerPolyline,
+                        ptsPerTube,
+                        numTubeConnIds,
+                        validCell);
+
+    vtkm::Id totalPolylinePts = vtkm::cont::Algorithm::Reduce(ptsPerPolyline, vtkm::Id(0));
+    if (totalPolylinePts == 0)
+      throw vtkm::cont::ErrorBadValue("Tube filter only supported for polyline data.");
+
+    vtkm::cont::ArrayHandle<vtkm::Id> numSegments, segmentOffsets;
+    vtkm::worklet::DispatcherMapField<CountInstancedSegments> countSegmentsInvoker;
+    countSegmentsInvoker.Invoke(nonIncidentPtsPerPolyline, numSegments);
+    vtkm::Id totalSegments = vtkm::cont::Algorithm::ScanExclusive(numSegments, segmentOffsets);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> newConnectivity;
+    newConnectivity.Allocate(2 * totalSegments);
+    this->OutputCellSourceIndex.Allocate(totalSegments);
+    this->OutputPointSourceIndex.ReleaseResources();
+    vtkm::worklet::DispatcherMapTopology<GenerateSegments> genSegmentsDisp;
+    genSegmentsDisp.Invoke(cellset,
+                           coords,
+                           numSegments,
+                           segmentOffsets,
+                           newConnectivity,
+                           this->OutputCellSourceIndex);
+    newCells.Fill(coords.GetNumberOfValues(), vtkm::CELL_SHAPE_LINE, 2, newConnectivity);
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> GetOutputCellSourceIndex() const
   {
     return this->OutputCellSourceIndex;
@@ -22,9 +22,12 @@
 #include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/Logging.h>
 #include <vtkm/cont/UnknownArrayHandle.h>
 
+#include <vtkm/filter/geometry_refinement/worklet/Quadric.h>
+
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/DispatcherMapTopology.h>
 #include <vtkm/worklet/DispatcherReduceByKey.h>
@@ -97,6 +100,107 @@ struct SelectRepresentativePoint : public vtkm::worklet::WorkletReduceByKey
   }
 };
 
+/// Places the representative point of each cluster where it minimizes the sum of the
+/// quadrics of the points in the cluster. When the minimum is not unique or falls outside
+/// of the bin of the cluster, the average of the points is used instead.
+struct SelectQuadricPoint : public vtkm::worklet::WorkletReduceByKey
+{
+  using ControlSignature = void(KeysIn clusterIds,
+                                ValuesIn points,
+                                ValuesIn quadrics,
+                                ReducedValuesOut repPoints);
+  using ExecutionSignature = _4(_1, _2, _3);
+  using InputDomain = _1;
+
+  vtkm::Id3 Dimensions;
+  vtkm::Vec3f_64 Origin;
+  vtkm::Vec3f_64 BinSize;
+
+  VTKM_CONT SelectQuadricPoint(const vtkm::Id3& dimensions,
+                               const vtkm::Vec3f_64& origin,
+                               const vtkm::Vec3f_64& binSize)
+    : Dimensions(dimensions)
+    , Origin(origin)
+    , BinSize(binSize)
+  {
+  }
+
+  template <typename PointsInVecType, typename QuadricsVecType>
+  VTKM_EXEC typename PointsInVecType::ComponentType operator()(
+    vtkm::Id clusterId,
+    const PointsInVecType& pointsIn,
+    const QuadricsVecType& quadrics) const
+  {
+    using PointType = typename PointsInVecType::ComponentType;
+
+    const vtkm::IdComponent numPoints = pointsIn.GetNumberOfComponents();
+    vtkm::Vec3f_64 average(0.0);
+    vtkm::worklet::quadric::Quadric quadric(0.0);
+    for (vtkm::IdComponent pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+    {
+      const PointType point = pointsIn[pointIndex];
+      average += vtkm::Vec3f_64(point);
+      quadric += quadrics[pointIndex];
+    }
+    average = average / static_cast<vtkm::Float64>(numPoints);
+
+    vtkm::Vec3f_64 optimal;
+    if (!vtkm::worklet::quadric::Minimize(quadric, optimal))
+    {
+      return PointType(average);
+    }
+
+    const vtkm::Id3 bin(clusterId % this->Dimensions[0],
+                        (clusterId / this->Dimensions[0]) % this->Dimensions[1],
+                        clusterId / (this->Dimensions[0] * this->Dimensions[1]));
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      const vtkm::Float64 binMin =
+        this->Origin[dim] + static_cast<vtkm::Float64>(bin[dim]) * this->BinSize[dim];
+      if ((optimal[dim] < binMin) || (optimal[dim] > binMin + this->BinSize[dim]))
+      {
+        return PointType(average);
+      }
+    }
+    return PointType(optimal);
+  }
+
+  struct RunTrampoline
+  {
+    template <typename InputPointsArrayType, typename KeyType, typename CellSetType>
+    VTKM_CONT void operator()(const InputPointsArrayType& points,
+                              const vtkm::worklet::Keys<KeyType>& keys,
+                              const CellSetType& cellSet,
+                              const SelectQuadricPoint& worklet,
+                              vtkm::cont::UnknownArrayHandle& output) const
+    {
+      vtkm::cont::Invoker invoke;
+      vtkm::cont::ArrayHandle<vtkm::worklet::quadric::Quadric> cellQuadrics;
+      invoke(vtkm::worklet::quadric::TriangleQuadrics{}, cellSet, points, cellQuadrics);
+      vtkm::cont::ArrayHandle<vtkm::worklet::quadric::Quadric> pointQuadrics;
+      invoke(vtkm::worklet::quadric::PointQuadrics{}, cellSet, cellQuadrics, pointQuadrics);
+
+      vtkm::cont::ArrayHandle<typename InputPointsArrayType::ValueType> out;
+      invoke(worklet, keys, points, pointQuadrics, out);
+
+      output = out;
+    }
+  };
+
+  template <typename KeyType, typename CellSetType, typename InputDynamicPointsArrayType>
+  VTKM_CONT static vtkm::cont::UnknownArrayHandle Run(
+    const vtkm::worklet::Keys<KeyType>& keys,
+    const CellSetType& cellSet,
+    const InputDynamicPointsArrayType& inputPoints,
+    const SelectQuadricPoint& worklet)
+  {
+    vtkm::cont::UnknownArrayHandle output;
+    RunTrampoline trampoline;
+    vtkm::cont::CastAndCall(inputPoints, trampoline, keys, cellSet, worklet, output);
+    return output;
+  }
+};
+
 template <typename ValueType, typename StorageType, typename IndexArrayType>
 VTKM_CONT vtkm::cont::ArrayHandle<ValueType> ConcretePermutationArray(
   const IndexArrayType& indices,
@@ -384,7 +488,18 @@ public:
 
       // Compute representative points from each cluster (may not match the
       // PointIdMap indexing)
-      repPointArray = internal::SelectRepresentativePoint::Run(keys, coordinates);
+      if (this->UseQuadrics)
+      {
+        repPointArray = internal::SelectQuadricPoint::Run(
+          keys,
+          cellSet,
+          coordinates,
+          internal::SelectQuadricPoint(gridInfo.dim, gridInfo.origin, gridInfo.bin_size));
+      }
+      else
+      {
+        repPointArray = internal::SelectRepresentativePoint::Run(keys, coordinates);
+      }
     }
 
     auto repPointCidArray =
@@ -530,7 +645,13 @@ public:
   vtkm::cont::ArrayHandle<vtkm::Id> GetPointIdMap() const { return this->PointIdMap; }
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->CellIdMap; }
 
+  /// When on, the representative point of each cluster is placed where it minimizes the
+  /// quadric error of the triangles around the points of the cluster.
+  void SetUseQuadrics(bool flag) { this->UseQuadrics = flag; }
+  bool GetUseQuadrics() const { return this->UseQuadrics; }
+
 private:
+  bool UseQuadrics = false;
   vtkm::cont::ArrayHandle<vtkm::Id> PointIdMap;
   vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
 }; // struct VertexClustering
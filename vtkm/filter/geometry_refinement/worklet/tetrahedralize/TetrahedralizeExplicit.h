@@ -11,16 +11,14 @@
 #ifndef vtk_m_worklet_TetrahedralizeExplicit_h
 #define vtk_m_worklet_TetrahedralizeExplicit_h
 
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
-#include <vtkm/cont/ArrayHandleGroupVec.h>
+#include <vtkm/cont/ArrayHandleCast.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/CellSetExplicit.h>
-#include <vtkm/cont/DataSet.h>
-#include <vtkm/cont/Field.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/Invoker.h>
 
-#include <vtkm/worklet/DispatcherMapField.h>
-#include <vtkm/worklet/DispatcherMapTopology.h>
-#include <vtkm/worklet/ScatterCounting.h>
-#include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
 #include <vtkm/worklet/internal/TriangulateTables.h>
@@ -60,68 +58,102 @@ public:
 
   //
   // Worklet to turn cells into tetrahedra
-  // Vertices remain the same and each cell is processed with needing topology
+  // Vertices remain the same and each cell writes all of its tetrahedra at its output offset
   //
   class TetrahedralizeCell : public vtkm::worklet::WorkletVisitCellsWithPoints
   {
   public:
     using ControlSignature = void(CellSetIn cellset,
                                   ExecObject tables,
-                                  FieldOutCell connectivityOut);
-    using ExecutionSignature = void(CellShape, PointIndices, _2, _3, VisitIndex);
+                                  FieldInCell outOffset,
+                                  WholeArrayOut connectivityOut,
+                                  WholeArrayOut outCellMap);
+    using ExecutionSignature = void(CellShape, PointIndices, _2, _3, _4, _5, InputIndex);
     using InputDomain = _1;
 
-    using ScatterType = vtkm::worklet::ScatterCounting;
-
-    template <typename CellArrayType>
-    VTKM_CONT static ScatterType MakeScatter(const CellArrayType& cellArray)
-    {
-      return ScatterType(cellArray);
-    }
-
-    // Each cell produces tetrahedra and write result at the offset
-    template <typename CellShapeTag, typename ConnectivityInVec, typename ConnectivityOutVec>
+    template <typename CellShapeTag,
+              typename ConnectivityInVec,
+              typename ConnectivityPortal,
+              typename CellMapPortal>
     VTKM_EXEC void operator()(
       CellShapeTag shape,
       const ConnectivityInVec& connectivityIn,
       const vtkm::worklet::internal::TetrahedralizeTablesExecutionObject& tables,
-      ConnectivityOutVec& connectivityOut,
-      vtkm::IdComponent visitIndex) const
+      vtkm::Id outOffset,
+      ConnectivityPortal& connectivityOut,
+      CellMapPortal& outCellMap,
+      vtkm::Id inputIndex) const
     {
-      vtkm::IdComponent4 tetIndices = tables.GetIndices(shape, visitIndex);
-      connectivityOut[0] = connectivityIn[tetIndices[0]];
-      connectivityOut[1] = connectivityIn[tetIndices[1]];
-      connectivityOut[2] = connectivityIn[tetIndices[2]];
-      connectivityOut[3] = connectivityIn[tetIndices[3]];
+      using ConnectivityType = typename ConnectivityPortal::ValueType;
+      const vtkm::IdComponent count = tables.GetCount(shape);
+      for (vtkm::IdComponent tetrahedron = 0; tetrahedron < count; ++tetrahedron)
+      {
+        const vtkm::IdComponent4 tetIndices = tables.GetIndices(shape, tetrahedron);
+        const vtkm::Id outCell = outOffset + tetrahedron;
+        for (vtkm::IdComponent point = 0; point < 4; ++point)
+        {
+          connectivityOut.Set(4 * outCell + point,
+                              static_cast<ConnectivityType>(connectivityIn[tetIndices[point]]));
+        }
+        outCellMap.Set(outCell, inputIndex);
+      }
     }
   };
 
-  template <typename CellSetType>
-  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet,
-                                      vtkm::cont::ArrayHandle<vtkm::IdComponent>& outCellsPerCell)
+  // Tetrahedralizes cells of any shape. The number of tetrahedra of each cell is counted and
+  // scanned to find where each cell writes its tetrahedra.
+  template <typename CellSetType, typename ConnectivityType>
+  void Run(const CellSetType& cellSet,
+           vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
   {
-    vtkm::cont::CellSetSingleType<> outCellSet;
-
     vtkm::cont::Invoker invoke;
-
-    // Output topology
-    vtkm::cont::ArrayHandle<vtkm::Id> outConnectivity;
-
     vtkm::worklet::internal::TetrahedralizeTables tables;
 
     // Determine the number of output cells each input cell will generate
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> outCellsPerCell;
     invoke(TetrahedraPerCell{}, cellSet, tables, outCellsPerCell);
+    vtkm::cont::ArrayHandle<vtkm::Id> outOffsets;
+    const vtkm::Id numOutCells = vtkm::cont::Algorithm::ScanExclusive(
+      vtkm::cont::make_ArrayHandleCast<vtkm::Id>(outCellsPerCell), outOffsets);
 
-    // Build new cells
-    invoke(TetrahedralizeCell{},
-           TetrahedralizeCell::MakeScatter(outCellsPerCell),
-           cellSet,
-           tables,
-           vtkm::cont::make_ArrayHandleGroupVec<4>(outConnectivity));
+    this->Build(cellSet, outOffsets, numOutCells, tables, connectivity, outCellMap);
+  }
 
-    // Add cells to output cellset
-    outCellSet.Fill(cellSet.GetNumberOfPoints(), vtkm::CellShapeTagTetra::Id, 4, outConnectivity);
-    return outCellSet;
+  // Tetrahedralizes cells of a single shape. Every cell makes the same number of tetrahedra,
+  // which is found from the shape table, so no counting pass is needed.
+  template <typename ConnectivityStorageTag, typename ConnectivityType>
+  void Run(const vtkm::cont::CellSetSingleType<ConnectivityStorageTag>& cellSet,
+           vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
+  {
+    const vtkm::Id numCells = cellSet.GetNumberOfCells();
+    const vtkm::IdComponent count = (numCells > 0)
+      ? vtkm::worklet::internal::TetrahedralizeTables::GetCount(cellSet.GetCellShapeAsId())
+      : 0;
+
+    vtkm::worklet::internal::TetrahedralizeTables tables;
+    this->Build(cellSet,
+                vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, count, numCells),
+                count * numCells,
+                tables,
+                connectivity,
+                outCellMap);
+  }
+
+private:
+  template <typename CellSetType, typename OffsetsArrayType, typename ConnectivityType>
+  void Build(const CellSetType& cellSet,
+             const OffsetsArrayType& outOffsets,
+             vtkm::Id numOutCells,
+             const vtkm::worklet::internal::TetrahedralizeTables& tables,
+             vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+             vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
+  {
+    connectivity.Allocate(4 * numOutCells);
+    outCellMap.Allocate(numOutCells);
+    vtkm::cont::Invoker invoke;
+    invoke(TetrahedralizeCell{}, cellSet, tables, outOffsets, connectivity, outCellMap);
   }
 };
 }
@@ -11,17 +11,13 @@
 #ifndef vtk_m_worklet_TetrahedralizeStructured_h
 #define vtk_m_worklet_TetrahedralizeStructured_h
 
-#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleGroupVec.h>
-#include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
-#include <vtkm/cont/DataSet.h>
-#include <vtkm/cont/DeviceAdapter.h>
-#include <vtkm/cont/ErrorBadValue.h>
-#include <vtkm/cont/Field.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/exec/ConnectivityStructuredTetrahedralized.h>
 
-#include <vtkm/worklet/DispatcherMapTopology.h>
 #include <vtkm/worklet/ScatterUniform.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -39,8 +35,10 @@ namespace tetrahedralize
 class TetrahedralizeCell : public vtkm::worklet::WorkletVisitCellsWithPoints
 {
 public:
-  using ControlSignature = void(CellSetIn cellset, FieldOutCell connectivityOut);
-  using ExecutionSignature = void(PointIndices, _2, ThreadIndices);
+  using ControlSignature = void(CellSetIn cellset,
+                                FieldOutCell connectivityOut,
+                                FieldOutCell outCellMap);
+  using ExecutionSignature = void(PointIndices, _2, _3, ThreadIndices);
   using InputDomain = _1;
 
   using ScatterType = vtkm::worklet::ScatterUniform<5>;
@@ -49,24 +47,22 @@ public:
   template <typename ConnectivityInVec, typename ConnectivityOutVec, typename ThreadIndicesType>
   VTKM_EXEC void operator()(const ConnectivityInVec& connectivityIn,
                             ConnectivityOutVec& connectivityOut,
+                            vtkm::Id& outCellMap,
                             const ThreadIndicesType threadIndices) const
   {
-    VTKM_STATIC_CONSTEXPR_ARRAY vtkm::IdComponent StructuredTetrahedronIndices[2][5][4] = {
-      { { 0, 1, 3, 4 }, { 1, 4, 5, 6 }, { 1, 4, 6, 3 }, { 1, 3, 6, 2 }, { 3, 6, 7, 4 } },
-      { { 2, 1, 5, 0 }, { 0, 2, 3, 7 }, { 2, 5, 6, 7 }, { 0, 7, 4, 5 }, { 0, 2, 7, 5 } }
-    };
-
-    vtkm::Id3 inputIndex = threadIndices.GetInputIndex3D();
+    using Table = vtkm::exec::internal::StructuredTetrahedralizedTable;
+    using ConnectivityType = typename vtkm::VecTraits<ConnectivityOutVec>::ComponentType;
 
     // Calculate the type of tetrahedron generated because it alternates
-    vtkm::Id indexType = (inputIndex[0] + inputIndex[1] + inputIndex[2]) % 2;
-
-    vtkm::IdComponent visitIndex = threadIndices.GetVisitIndex();
-
-    connectivityOut[0] = connectivityIn[StructuredTetrahedronIndices[indexType][visitIndex][0]];
-    connectivityOut[1] = connectivityIn[StructuredTetrahedronIndices[indexType][visitIndex][1]];
-    connectivityOut[2] = connectivityIn[StructuredTetrahedronIndices[indexType][visitIndex][2]];
-    connectivityOut[3] = connectivityIn[StructuredTetrahedronIndices[indexType][visitIndex][3]];
+    const vtkm::IdComponent indexType = Table::GetParity(threadIndices.GetInputIndex3D());
+    const vtkm::IdComponent visitIndex = threadIndices.GetVisitIndex();
+
+    for (vtkm::IdComponent point = 0; point < 4; ++point)
+    {
+      connectivityOut[point] = static_cast<ConnectivityType>(
+        connectivityIn[Table::GetHexahedronPoint(indexType, visitIndex, point)]);
+    }
+    outCellMap = threadIndices.GetInputIndex();
   }
 };
 }
@@ -75,24 +71,16 @@ public:
 class TetrahedralizeStructured
 {
 public:
-  template <typename CellSetType>
-  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet,
-                                      vtkm::cont::ArrayHandle<vtkm::IdComponent>& outCellsPerCell)
+  template <typename CellSetType, typename ConnectivityType>
+  void Run(const CellSetType& cellSet,
+           vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
   {
-    vtkm::cont::CellSetSingleType<> outCellSet;
-    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
-
-    vtkm::worklet::DispatcherMapTopology<tetrahedralize::TetrahedralizeCell> dispatcher;
-    dispatcher.Invoke(cellSet, vtkm::cont::make_ArrayHandleGroupVec<4>(connectivity));
-
-    // Fill in array of output cells per input cell
-    vtkm::cont::ArrayCopy(
-      vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>(5, cellSet.GetNumberOfCells()),
-      outCellsPerCell);
-
-    // Add cells to output cellset
-    outCellSet.Fill(cellSet.GetNumberOfPoints(), vtkm::CellShapeTagTetra::Id, 4, connectivity);
-    return outCellSet;
+    vtkm::cont::Invoker invoke;
+    invoke(tetrahedralize::TetrahedralizeCell{},
+           cellSet,
+           vtkm::cont::make_ArrayHandleGroupVec<4>(connectivity),
+           outCellMap);
   }
 };
 }
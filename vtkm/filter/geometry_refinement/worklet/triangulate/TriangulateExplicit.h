@@ -11,16 +11,14 @@
 #ifndef vtk_m_worklet_TriangulateExplicit_h
 #define vtk_m_worklet_TriangulateExplicit_h
 
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
-#include <vtkm/cont/ArrayHandleGroupVec.h>
+#include <vtkm/cont/ArrayHandleCast.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/CellSetExplicit.h>
-#include <vtkm/cont/DataSet.h>
-#include <vtkm/cont/Field.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/Invoker.h>
 
-#include <vtkm/worklet/DispatcherMapField.h>
-#include <vtkm/worklet/DispatcherMapTopology.h>
-#include <vtkm/worklet/ScatterCounting.h>
-#include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
 #include <vtkm/worklet/internal/TriangulateTables.h>
@@ -61,67 +59,104 @@ public:
 
   //
   // Worklet to turn cells into triangles
-  // Vertices remain the same and each cell is processed with needing topology
+  // Vertices remain the same and each cell writes all of its triangles at its output offset
   //
   class TriangulateCell : public vtkm::worklet::WorkletVisitCellsWithPoints
   {
   public:
     using ControlSignature = void(CellSetIn cellset,
                                   ExecObject tables,
-                                  FieldOutCell connectivityOut);
-    using ExecutionSignature = void(CellShape, PointIndices, _2, _3, VisitIndex);
+                                  FieldInCell outOffset,
+                                  WholeArrayOut connectivityOut,
+                                  WholeArrayOut outCellMap);
+    using ExecutionSignature = void(CellShape, PointIndices, _2, _3, _4, _5, InputIndex);
     using InputDomain = _1;
 
-    using ScatterType = vtkm::worklet::ScatterCounting;
-
-    template <typename CountArrayType>
-    VTKM_CONT static ScatterType MakeScatter(const CountArrayType& countArray)
-    {
-      return ScatterType(countArray);
-    }
-
-    // Each cell produces triangles and write result at the offset
-    template <typename CellShapeTag, typename ConnectivityInVec, typename ConnectivityOutVec>
+    template <typename CellShapeTag,
+              typename ConnectivityInVec,
+              typename ConnectivityPortal,
+              typename CellMapPortal>
     VTKM_EXEC void operator()(
       CellShapeTag shape,
       const ConnectivityInVec& connectivityIn,
       const vtkm::worklet::internal::TriangulateTablesExecutionObject& tables,
-      ConnectivityOutVec& connectivityOut,
-      vtkm::IdComponent visitIndex) const
+      vtkm::Id outOffset,
+      ConnectivityPortal& connectivityOut,
+      CellMapPortal& outCellMap,
+      vtkm::Id inputIndex) const
     {
-      vtkm::IdComponent3 triIndices = tables.GetIndices(shape, visitIndex);
-      connectivityOut[0] = connectivityIn[triIndices[0]];
-      connectivityOut[1] = connectivityIn[triIndices[1]];
-      connectivityOut[2] = connectivityIn[triIndices[2]];
+      using ConnectivityType = typename ConnectivityPortal::ValueType;
+      const vtkm::IdComponent count =
+        tables.GetCount(shape, connectivityIn.GetNumberOfComponents());
+      for (vtkm::IdComponent triangle = 0; triangle < count; ++triangle)
+      {
+        const vtkm::IdComponent3 triIndices = tables.GetIndices(shape, triangle);
+        const vtkm::Id outCell = outOffset + triangle;
+        for (vtkm::IdComponent point = 0; point < 3; ++point)
+        {
+          connectivityOut.Set(3 * outCell + point,
+                              static_cast<ConnectivityType>(connectivityIn[triIndices[point]]));
+        }
+        outCellMap.Set(outCell, inputIndex);
+      }
     }
   };
-  template <typename CellSetType>
-  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet,
-                                      vtkm::cont::ArrayHandle<vtkm::IdComponent>& outCellsPerCell)
-  {
-    vtkm::cont::CellSetSingleType<> outCellSet;
 
+  // Triangulates cells of any shape. The number of triangles of each cell is counted and
+  // scanned to find where each cell writes its triangles.
+  template <typename CellSetType, typename ConnectivityType>
+  void Run(const CellSetType& cellSet,
+           vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
+  {
     vtkm::cont::Invoker invoke;
-
-    // Output topology
-    vtkm::cont::ArrayHandle<vtkm::Id> outConnectivity;
-
     vtkm::worklet::internal::TriangulateTables tables;
 
     // Determine the number of output cells each input cell will generate
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> outCellsPerCell;
     invoke(TrianglesPerCell{}, cellSet, tables, outCellsPerCell);
+    vtkm::cont::ArrayHandle<vtkm::Id> outOffsets;
+    const vtkm::Id numOutCells = vtkm::cont::Algorithm::ScanExclusive(
+      vtkm::cont::make_ArrayHandleCast<vtkm::Id>(outCellsPerCell), outOffsets);
 
-    // Build new cells
-    invoke(TriangulateCell{},
-           TriangulateCell::MakeScatter(outCellsPerCell),
-           cellSet,
-           tables,
-           vtkm::cont::make_ArrayHandleGroupVec<3>(outConnectivity));
-
-    // Add cells to output cellset
-    outCellSet.Fill(
-      cellSet.GetNumberOfPoints(), vtkm::CellShapeTagTriangle::Id, 3, outConnectivity);
-    return outCellSet;
+    this->Build(cellSet, outOffsets, numOutCells, tables, connectivity, outCellMap);
+  }
+
+  // Triangulates cells of a single shape. Every cell makes the same number of triangles, which
+  // is found from the shape table, so no counting pass is needed.
+  template <typename ConnectivityStorageTag, typename ConnectivityType>
+  void Run(const vtkm::cont::CellSetSingleType<ConnectivityStorageTag>& cellSet,
+           vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
+  {
+    const vtkm::Id numCells = cellSet.GetNumberOfCells();
+    const vtkm::IdComponent count = (numCells > 0)
+      ? vtkm::worklet::internal::TriangulateTables::GetCount(cellSet.GetCellShapeAsId(),
+                                                              cellSet.GetNumberOfPointsInCell(0))
+      : 0;
+
+    vtkm::worklet::internal::TriangulateTables tables;
+    this->Build(cellSet,
+                vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, count, numCells),
+                count * numCells,
+                tables,
+                connectivity,
+                outCellMap);
+  }
+
+private:
+  template <typename CellSetType, typename OffsetsArrayType, typename ConnectivityType>
+  void Build(const CellSetType& cellSet,
+             const OffsetsArrayType& outOffsets,
+             vtkm::Id numOutCells,
+             const vtkm::worklet::internal::TriangulateTables& tables,
+             vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+             vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
+  {
+    connectivity.Allocate(3 * numOutCells);
+    outCellMap.Allocate(numOutCells);
+    vtkm::cont::Invoker invoke;
+    invoke(TriangulateCell{}, cellSet, tables, outOffsets, connectivity, outCellMap);
   }
 };
 
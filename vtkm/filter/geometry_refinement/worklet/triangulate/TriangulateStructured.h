@@ -11,16 +11,11 @@
 #ifndef vtk_m_worklet_TriangulateStructured_h
 #define vtk_m_worklet_TriangulateStructured_h
 
-#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleGroupVec.h>
-#include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
-#include <vtkm/cont/DataSet.h>
-#include <vtkm/cont/ErrorBadValue.h>
-#include <vtkm/cont/Field.h>
+#include <vtkm/cont/Invoker.h>
 
-#include <vtkm/worklet/DispatcherMapTopology.h>
 #include <vtkm/worklet/ScatterUniform.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -37,8 +32,10 @@ namespace triangulate
 class TriangulateCell : public vtkm::worklet::WorkletVisitCellsWithPoints
 {
 public:
-  using ControlSignature = void(CellSetIn cellset, FieldOutCell connectivityOut);
-  using ExecutionSignature = void(PointIndices, _2, VisitIndex);
+  using ControlSignature = void(CellSetIn cellset,
+                                FieldOutCell connectivityOut,
+                                FieldOutCell outCellMap);
+  using ExecutionSignature = void(PointIndices, _2, _3, VisitIndex, InputIndex);
   using InputDomain = _1;
 
   using ScatterType = vtkm::worklet::ScatterUniform<2>;
@@ -47,13 +44,20 @@ public:
   template <typename ConnectivityInVec, typename ConnectivityOutVec>
   VTKM_EXEC void operator()(const ConnectivityInVec& connectivityIn,
                             ConnectivityOutVec& connectivityOut,
-                            vtkm::IdComponent visitIndex) const
+                            vtkm::Id& outCellMap,
+                            vtkm::IdComponent visitIndex,
+                            vtkm::Id inputIndex) const
   {
     VTKM_STATIC_CONSTEXPR_ARRAY vtkm::IdComponent StructuredTriangleIndices[2][3] = { { 0, 1, 2 },
                                                                                       { 0, 2, 3 } };
-    connectivityOut[0] = connectivityIn[StructuredTriangleIndices[visitIndex][0]];
-    connectivityOut[1] = connectivityIn[StructuredTriangleIndices[visitIndex][1]];
-    connectivityOut[2] = connectivityIn[StructuredTriangleIndices[visitIndex][2]];
+    using ConnectivityType = typename vtkm::VecTraits<ConnectivityOutVec>::ComponentType;
+    connectivityOut[0] =
+      static_cast<ConnectivityType>(connectivityIn[StructuredTriangleIndices[visitIndex][0]]);
+    connectivityOut[1] =
+      static_cast<ConnectivityType>(connectivityIn[StructuredTriangleIndices[visitIndex][1]]);
+    connectivityOut[2] =
+      static_cast<ConnectivityType>(connectivityIn[StructuredTriangleIndices[visitIndex][2]]);
+    outCellMap = inputIndex;
   }
 };
 }
@@ -62,25 +66,16 @@ public:
 class TriangulateStructured
 {
 public:
-  template <typename CellSetType>
-  vtkm::cont::CellSetSingleType<> Run(const CellSetType& cellSet,
-                                      vtkm::cont::ArrayHandle<vtkm::IdComponent>& outCellsPerCell)
-
+  template <typename CellSetType, typename ConnectivityType>
+  void Run(const CellSetType& cellSet,
+           vtkm::cont::ArrayHandle<ConnectivityType>& connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Id>& outCellMap)
   {
-    vtkm::cont::CellSetSingleType<> outCellSet;
-    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
-
-    vtkm::worklet::DispatcherMapTopology<triangulate::TriangulateCell> dispatcher;
-    dispatcher.Invoke(cellSet, vtkm::cont::make_ArrayHandleGroupVec<3>(connectivity));
-
-    // Fill in array of output cells per input cell
-    vtkm::cont::ArrayCopy(
-      vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>(2, cellSet.GetNumberOfCells()),
-      outCellsPerCell);
-
-    // Add cells to output cellset
-    outCellSet.Fill(cellSet.GetNumberOfPoints(), vtkm::CellShapeTagTriangle::Id, 3, connectivity);
-    return outCellSet;
+    vtkm::cont::Invoker invoke;
+    invoke(triangulate::TriangulateCell{},
+           cellSet,
+           vtkm::cont::make_ArrayHandleGroupVec<3>(connectivity),
+           outCellMap);
   }
 };
 }
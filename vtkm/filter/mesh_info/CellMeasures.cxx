@@ -11,6 +11,7 @@
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/filter/mesh_info/CellMeasures.h>
 #include <vtkm/filter/mesh_info/worklet/CellMeasure.h>
+#include <vtkm/filter/mesh_info/worklet/StructuredCellMeasure.h>
 
 namespace vtkm
 {
@@ -44,20 +45,29 @@ VTKM_CONT vtkm::cont::DataSet CellMeasures::DoExecute(const vtkm::cont::DataSet&
     throw vtkm::cont::ErrorFilterExecution("CellMeasures expects point field input.");
   }
 
+  std::string outputName = this->GetCellMeasureName();
+  if (outputName.empty())
+  {
+    // Default name is name of input.
+    outputName = "measure";
+  }
+
   const auto& cellset = input.GetCellSet();
-  vtkm::cont::ArrayHandle<vtkm::FloatDefault> outArray;
 
+  // Uniform and rectilinear grids have closed form measures that need no per cell storage.
+  vtkm::cont::UnknownArrayHandle structuredArray;
+  if (vtkm::worklet::StructuredCellMeasure::Run<vtkm::FloatDefault>(
+        cellset, field.GetData(), this->Measure, structuredArray))
+  {
+    return this->CreateResultFieldCell(input, outputName, structuredArray);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> outArray;
   auto resolveType = [&](const auto& concrete) {
     this->Invoke(vtkm::worklet::CellMeasure{ this->Measure }, cellset, concrete, outArray);
   };
   this->CastAndCallVecField<3>(field, resolveType);
 
-  std::string outputName = this->GetCellMeasureName();
-  if (outputName.empty())
-  {
-    // Default name is name of input.
-    outputName = "measure";
-  }
   return this->CreateResultFieldCell(input, outputName, outArray);
 }
 } // namespace mesh_info
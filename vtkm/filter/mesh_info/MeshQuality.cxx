@@ -43,6 +43,33 @@
 #include <vtkm/filter/mesh_info/MeshQualityTaper.h>
 #include <vtkm/filter/mesh_info/MeshQualityVolume.h>
 #include <vtkm/filter/mesh_info/MeshQualityWarpage.h>
+#include <vtkm/filter/mesh_info/worklet/MeshQualityWorklet.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellAspectGammaMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellAspectRatioMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellConditionMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellDiagonalRatioMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellDimensionMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellJacobianMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellMaxAngleMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellMaxDiagonalMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellMinAngleMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellMinDiagonalMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellOddyMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellRelativeSizeSquaredMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellScaledJacobianMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellShapeAndSizeMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellShapeMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellShearMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellSkewMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellStretchMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellTaperMetric.h>
+#include <vtkm/filter/mesh_info/worklet/cellmetrics/CellWarpageMetric.h>
+
+#include <vtkm/CellTraits.h>
+#include <vtkm/exec/CellMeasure.h>
+
+#include <algorithm>
+#include <map>
 
 namespace vtkm
 {
@@ -79,6 +106,124 @@ const std::map<CellMetric, std::string> MetricNames = {
   { CellMetric::Volume, "volume" },
   { CellMetric::Warpage, "warpage" }
 };
+
+// Computes the metric at an index of a list of metrics. The average area and volume
+// are only used by the metrics relative to the size of the cells.
+struct MultipleMetrics
+{
+  static constexpr vtkm::IdComponent MaxNumberOfMetrics =
+    static_cast<vtkm::IdComponent>(CellMetric::None);
+
+  CellMetric Metrics[MaxNumberOfMetrics];
+  vtkm::Float64 AverageArea = 1;
+  vtkm::Float64 AverageVolume = 1;
+
+  VTKM_EXEC vtkm::Float64 GetAverageSize(vtkm::CellTopologicalDimensionsTag<2>) const
+  {
+    return this->AverageArea;
+  }
+  VTKM_EXEC vtkm::Float64 GetAverageSize(vtkm::CellTopologicalDimensionsTag<3>) const
+  {
+    return this->AverageVolume;
+  }
+  template <vtkm::IdComponent Dimension>
+  VTKM_EXEC vtkm::Float64 GetAverageSize(vtkm::CellTopologicalDimensionsTag<Dimension>) const
+  {
+    return 1;
+  }
+
+  template <typename OutType, typename PointCoordVecType, typename CellShapeType>
+  VTKM_EXEC OutType ComputeMetric(vtkm::IdComponent index,
+                                  const vtkm::IdComponent& numPts,
+                                  const PointCoordVecType& pts,
+                                  CellShapeType shape,
+                                  vtkm::ErrorCode& ec) const
+  {
+    namespace cellmetrics = vtkm::worklet::cellmetrics;
+    using DimensionTag = typename vtkm::CellTraits<CellShapeType>::TopologicalDimensionsTag;
+    constexpr vtkm::IdComponent dims = vtkm::CellTraits<CellShapeType>::TOPOLOGICAL_DIMENSIONS;
+    switch (this->Metrics[index])
+    {
+      case CellMetric::Area:
+        return (dims == 2) ? vtkm::exec::CellMeasure<OutType>(numPts, pts, shape, ec) : OutType(0);
+      case CellMetric::AspectGamma:
+        return cellmetrics::CellAspectGammaMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::AspectRatio:
+        return cellmetrics::CellAspectRatioMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Condition:
+        return cellmetrics::CellConditionMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::DiagonalRatio:
+        return cellmetrics::CellDiagonalRatioMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Dimension:
+        return cellmetrics::CellDimensionMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Jacobian:
+        return cellmetrics::CellJacobianMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::MaxAngle:
+        return cellmetrics::CellMaxAngleMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::MaxDiagonal:
+        return cellmetrics::CellMaxDiagonalMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::MinAngle:
+        return cellmetrics::CellMinAngleMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::MinDiagonal:
+        return cellmetrics::CellMinDiagonalMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Oddy:
+        return cellmetrics::CellOddyMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::RelativeSizeSquared:
+        return cellmetrics::CellRelativeSizeSquaredMetric<OutType>(
+          numPts, pts, static_cast<OutType>(this->GetAverageSize(DimensionTag{})), shape, ec);
+      case CellMetric::ScaledJacobian:
+        return cellmetrics::CellScaledJacobianMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Shape:
+        return cellmetrics::CellShapeMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::ShapeAndSize:
+        return cellmetrics::CellShapeAndSizeMetric<OutType>(
+          numPts, pts, static_cast<OutType>(this->GetAverageSize(DimensionTag{})), shape, ec);
+      case CellMetric::Shear:
+        return cellmetrics::CellShearMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Skew:
+        return cellmetrics::CellSkewMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Stretch:
+        return cellmetrics::CellStretchMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Taper:
+        return cellmetrics::CellTaperMetric<OutType>(numPts, pts, shape, ec);
+      case CellMetric::Volume:
+        return (dims == 3) ? vtkm::exec::CellMeasure<OutType>(numPts, pts, shape, ec) : OutType(0);
+      case CellMetric::Warpage:
+        return cellmetrics::CellWarpageMetric<OutType>(numPts, pts, shape, ec);
+      default:
+        return OutType(0);
+    }
+  }
+};
+
+vtkm::Float64 ComputeTotal(const vtkm::cont::UnknownArrayHandle& array)
+{
+  vtkm::Float64 total = 0;
+  array
+    .CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldScalar, VTKM_DEFAULT_STORAGE_LIST>(
+      [&](const auto& concrete) { total = vtkm::cont::Algorithm::Reduce(concrete, total); });
+  return total;
+}
+
+// Same as `MeshQualityArea::ComputeAverageArea` and `MeshQualityVolume::ComputeAverageVolume`.
+vtkm::Float64 ComputeAverage(const vtkm::cont::UnknownArrayHandle& array)
+{
+  vtkm::Id numValues = array.GetNumberOfValues();
+  return (numValues > 0) ? ComputeTotal(array) / static_cast<vtkm::Float64>(numValues) : 1;
+}
+
+void AddSummary(vtkm::cont::DataSet& result, const std::string& fieldName)
+{
+  const vtkm::cont::Field& field = result.GetCellField(fieldName);
+  const vtkm::Range range = field.GetRange().ReadPortal().Get(0);
+  const vtkm::Id numValues = field.GetNumberOfValues();
+  const vtkm::Float64 average =
+    (numValues > 0) ? ComputeTotal(field.GetData()) / static_cast<vtkm::Float64>(numValues) : 0;
+  result.AddField(vtkm::cont::Field(
+    fieldName + "Summary",
+    vtkm::cont::Field::Association::WholeDataSet,
+    vtkm::cont::make_ArrayHandle<vtkm::Float64>({ range.Min, range.Max, average })));
+}
 } // anonymous namespace
 
 VTKM_CONT MeshQuality::MeshQuality()
@@ -105,8 +250,18 @@ VTKM_CONT std::string MeshQuality::GetMetricName() const
   return MetricNames.at(this->MyMetric);
 }
 
+VTKM_CONT std::string MeshQuality::GetMetricName(CellMetric metric)
+{
+  return MetricNames.at(metric);
+}
+
 VTKM_CONT vtkm::cont::DataSet MeshQuality::DoExecute(const vtkm::cont::DataSet& input)
 {
+  if (!this->MyMetrics.empty())
+  {
+    return this->ExecuteMultipleMetrics(input);
+  }
+
   std::unique_ptr<vtkm::filter::Filter> implementation;
   switch (this->MyMetric)
   {
@@ -185,7 +340,84 @@ VTKM_CONT vtkm::cont::DataSet MeshQuality::DoExecute(const vtkm::cont::DataSet&
 
   implementation->SetOutputFieldName(this->GetOutputFieldName());
   implementation->SetActiveCoordinateSystem(this->GetActiveCoordinateSystemIndex());
-  return implementation->Execute(input);
+  vtkm::cont::DataSet result = implementation->Execute(input);
+  if (this->ComputeSummaries)
+  {
+    AddSummary(result, this->GetOutputFieldName());
+  }
+  return result;
+}
+
+VTKM_CONT vtkm::cont::DataSet MeshQuality::ExecuteMultipleMetrics(const vtkm::cont::DataSet& input)
+{
+  const vtkm::cont::Field& field = this->GetFieldFromDataSet(input);
+
+  // Metrics relative to the size of the cells need the average area and volume of the
+  // cells, so they are computed in a second traversal after the area and volume.
+  std::vector<CellMetric> firstPass;
+  std::vector<CellMetric> secondPass;
+  auto addMetric = [](std::vector<CellMetric>& metrics, CellMetric metric) {
+    if ((metric != CellMetric::None) &&
+        (std::find(metrics.begin(), metrics.end(), metric) == metrics.end()))
+    {
+      metrics.push_back(metric);
+    }
+  };
+  for (CellMetric metric : this->MyMetrics)
+  {
+    if ((metric == CellMetric::RelativeSizeSquared) || (metric == CellMetric::ShapeAndSize))
+    {
+      addMetric(secondPass, metric);
+    }
+    else
+    {
+      addMetric(firstPass, metric);
+    }
+  }
+  if (!secondPass.empty())
+  {
+    addMetric(firstPass, CellMetric::Area);
+    addMetric(firstPass, CellMetric::Volume);
+  }
+
+  std::map<CellMetric, vtkm::cont::UnknownArrayHandle> metricArrays;
+  auto computeMetrics = [&](const std::vector<CellMetric>& metrics, MultipleMetrics functor) {
+    if (metrics.empty())
+    {
+      return;
+    }
+    std::copy(metrics.begin(), metrics.end(), functor.Metrics);
+    MeshQualityMultiMetricWorklet<MultipleMetrics> worklet(
+      functor, static_cast<vtkm::IdComponent>(metrics.size()));
+    std::vector<vtkm::cont::UnknownArrayHandle> arrays = worklet.Run(input, field);
+    for (std::size_t index = 0; index < metrics.size(); ++index)
+    {
+      metricArrays[metrics[index]] = arrays[index];
+    }
+  };
+
+  computeMetrics(firstPass, MultipleMetrics{});
+  if (!secondPass.empty())
+  {
+    MultipleMetrics functor;
+    functor.AverageArea = ComputeAverage(metricArrays.at(CellMetric::Area));
+    functor.AverageVolume = ComputeAverage(metricArrays.at(CellMetric::Volume));
+    computeMetrics(secondPass, functor);
+  }
+
+  vtkm::cont::DataSet result = this->CreateResult(input);
+  for (CellMetric metric : this->MyMetrics)
+  {
+    if (metric != CellMetric::None)
+    {
+      result.AddCellField(GetMetricName(metric), metricArrays.at(metric));
+      if (this->ComputeSummaries)
+      {
+        AddSummary(result, GetMetricName(metric));
+      }
+    }
+  }
+  return result;
 }
 } // namespace mesh_info
 } // namespace filter
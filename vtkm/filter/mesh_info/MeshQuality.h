@@ -26,6 +26,9 @@
 
 #include <vtkm/Deprecated.h>
 
+#include <string>
+#include <vector>
+
 namespace vtkm
 {
 namespace filter
@@ -107,11 +110,39 @@ public:
 
   /// @brief Return a string describing the metric selected.
   VTKM_CONT std::string GetMetricName() const;
+  /// @brief Return a string describing the given metric.
+  ///
+  /// This is also the name of the cell field holding the metric when several metrics
+  /// are computed.
+  VTKM_CONT static std::string GetMetricName(CellMetric metric);
+
+  /// @brief Specify several metrics to compute on the mesh.
+  ///
+  /// When this list is not empty, the metric given to `SetMetric()` is ignored and all the
+  /// metrics in the list are computed in a single traversal of the cells, which share
+  /// the gathered point coordinates of each cell. Each metric is written to its own cell
+  /// field, named with `GetMetricName()`. The list is empty by default.
+  VTKM_CONT void SetMetrics(const std::vector<CellMetric>& metrics) { this->MyMetrics = metrics; }
+  /// @copydoc SetMetrics
+  VTKM_CONT const std::vector<CellMetric>& GetMetrics() const { return this->MyMetrics; }
+
+  /// @brief Specify whether to add a summary of each metric to the output.
+  ///
+  /// When this flag is on, a whole data set field is added for each computed metric.
+  /// It is named after the metric field with a `Summary` suffix and holds the minimum,
+  /// maximum and average of the metric over all the cells. This flag is off by default.
+  VTKM_CONT void SetComputeSummaries(bool flag) { this->ComputeSummaries = flag; }
+  /// @copydoc SetComputeSummaries
+  VTKM_CONT bool GetComputeSummaries() const { return this->ComputeSummaries; }
 
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
+  VTKM_CONT vtkm::cont::DataSet ExecuteMultipleMetrics(const vtkm::cont::DataSet& input);
+
   CellMetric MyMetric = CellMetric::None;
+  std::vector<CellMetric> MyMetrics;
+  bool ComputeSummaries = false;
 };
 } // namespace mesh_info
 } // namespace filter
@@ -19,6 +19,7 @@
 //=========================================================================
 
 #include <vtkm/filter/mesh_info/MeshQualityArea.h>
+#include <vtkm/filter/mesh_info/worklet/StructuredCellMeasure.h>
 
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -153,6 +154,15 @@ vtkm::cont::DataSet MeshQualityArea::DoExecute(const vtkm::cont::DataSet& input)
 
   auto resolveType = [&](const auto& concrete) {
     using T = typename std::decay_t<decltype(concrete)>::ValueType::ComponentType;
+    // Uniform and rectilinear grids have closed form areas that need no per cell storage.
+    if (vtkm::worklet::StructuredCellMeasure::Run<T>(
+          input.GetCellSet(),
+          concrete,
+          vtkm::filter::mesh_info::IntegrationType::Area,
+          outArray))
+    {
+      return;
+    }
     vtkm::cont::ArrayHandle<T> result;
     this->Invoke(AreaWorklet{}, input.GetCellSet(), concrete, result);
     outArray = result;
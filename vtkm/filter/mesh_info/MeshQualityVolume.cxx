@@ -19,6 +19,7 @@
 //=========================================================================
 
 #include <vtkm/filter/mesh_info/MeshQualityVolume.h>
+#include <vtkm/filter/mesh_info/worklet/StructuredCellMeasure.h>
 
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -142,6 +143,15 @@ vtkm::cont::DataSet MeshQualityVolume::DoExecute(const vtkm::cont::DataSet& inpu
 
   auto resolveType = [&](const auto& concrete) {
     using T = typename std::decay_t<decltype(concrete)>::ValueType::ComponentType;
+    // Uniform and rectilinear grids have closed form volumes that need no per cell storage.
+    if (vtkm::worklet::StructuredCellMeasure::Run<T>(
+          input.GetCellSet(),
+          concrete,
+          vtkm::filter::mesh_info::IntegrationType::Volume,
+          outArray))
+    {
+      return;
+    }
     vtkm::cont::ArrayHandle<T> result;
     this->Invoke(VolumeWorklet{}, input.GetCellSet(), concrete, result);
     outArray = result;
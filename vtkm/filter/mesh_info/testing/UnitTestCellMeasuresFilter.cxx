@@ -8,11 +8,16 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
 #include <vector>
 #include <vtkm/filter/mesh_info/CellMeasures.h>
+#include <vtkm/filter/mesh_info/worklet/StructuredCellMeasure.h>
 
 namespace
 {
@@ -36,7 +41,7 @@ struct CheckCellMeasuresFunctor
   }
 };
 
-void TestCellMeasuresFilter(vtkm::cont::DataSet& dataset,
+void TestCellMeasuresFilter(const vtkm::cont::DataSet& dataset,
                             const char* msg,
                             const std::vector<vtkm::Float32>& expected,
                             const vtkm::filter::mesh_info::IntegrationType& type)
@@ -58,10 +63,85 @@ void TestCellMeasuresFilter(vtkm::cont::DataSet& dataset,
   VTKM_TEST_ASSERT(result.GetNumberOfValues() == static_cast<vtkm::Id>(expected.size()),
                    "Output field could not be found or was improper.");
 
-  vtkm::cont::CastAndCall(
-    result.ResetTypes(vtkm::TypeListFieldScalar{}, VTKM_DEFAULT_STORAGE_LIST{}),
-    CheckCellMeasuresFunctor{},
-    expected);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> resultArray;
+  vtkm::cont::ArrayCopyShallowIfPossible(result, resultArray);
+  CheckCellMeasuresFunctor{}(resultArray, expected);
+}
+
+// Compares the closed form measures of a structured data set with the measures computed
+// from each cell after the coordinates are converted to an explicit array.
+template <typename ExpectedArrayType>
+void TestStructuredCellMeasuresFilter(const vtkm::cont::DataSet& dataset,
+                                      const char* msg,
+                                      const vtkm::filter::mesh_info::IntegrationType& type)
+{
+  std::cout << "Testing CellMeasures Filter on " << msg << "\n";
+
+  vtkm::filter::mesh_info::CellMeasures vols;
+  vols.SetMeasure(type);
+  vtkm::cont::DataSet outputData = vols.Execute(dataset);
+  auto result = outputData.GetField(vols.GetCellMeasureName()).GetData();
+  VTKM_TEST_ASSERT(result.IsType<ExpectedArrayType>(), "Structured measures are not implicit");
+  VTKM_TEST_ASSERT(result.GetNumberOfValues() == dataset.GetNumberOfCells());
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopy(dataset.GetCoordinateSystem().GetData(), points);
+  vtkm::cont::DataSet explicitPoints = dataset;
+  explicitPoints.AddCoordinateSystem(
+    vtkm::cont::CoordinateSystem(dataset.GetCoordinateSystem().GetName(), points));
+  vtkm::cont::DataSet expectedData = vols.Execute(explicitPoints);
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> computed;
+  vtkm::cont::ArrayCopy(result, computed);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> expected;
+  vtkm::cont::ArrayCopy(expectedData.GetField(vols.GetCellMeasureName()).GetData(), expected);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(computed, expected),
+                   "Wrong result for CellMeasure filter");
+}
+
+void TestStructuredCellMeasures()
+{
+  using vtkm::filter::mesh_info::IntegrationType;
+  using UniformArrayType = vtkm::cont::ArrayHandleConstant<vtkm::FloatDefault>;
+  using RectilinearArrayType =
+    vtkm::worklet::StructuredCellMeasure::RectilinearMeasureArrayType<vtkm::FloatDefault>;
+
+  const vtkm::Vec3f origin(1.0f, -2.0f, 0.5f);
+  const vtkm::Vec3f spacing(0.5f, 2.0f, 0.25f);
+  TestStructuredCellMeasuresFilter<UniformArrayType>(
+    vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(4, 3, 5), origin, spacing),
+    "uniform 3D",
+    IntegrationType::AllMeasures);
+  TestStructuredCellMeasuresFilter<UniformArrayType>(
+    vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(4, 1, 5), origin, spacing),
+    "uniform 2D in the xz plane",
+    IntegrationType::AllMeasures);
+  TestStructuredCellMeasuresFilter<UniformArrayType>(
+    vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(4, 3, 5), origin, spacing),
+    "uniform 3D (only area)",
+    IntegrationType::Area);
+
+  const std::vector<vtkm::Float32> x = { 0.0f, 0.5f, 2.0f, 2.25f };
+  const std::vector<vtkm::Float32> y = { 1.0f, 3.0f, 3.5f };
+  const std::vector<vtkm::Float64> z = { -1.0, 0.0, 4.0, 4.5, 7.0 };
+  const std::vector<vtkm::Float64> decreasing = { 3.0, 2.0, 0.5 };
+  TestStructuredCellMeasuresFilter<RectilinearArrayType>(
+    vtkm::cont::DataSetBuilderRectilinear::Create(x, y, std::vector<vtkm::Float32>{ 2.0f, 5.0f }),
+    "rectilinear 3D",
+    IntegrationType::AllMeasures);
+  TestStructuredCellMeasuresFilter<RectilinearArrayType>(
+    vtkm::cont::DataSetBuilderRectilinear::Create(z, z, decreasing),
+    "rectilinear 3D with a decreasing axis",
+    IntegrationType::AllMeasures);
+  TestStructuredCellMeasuresFilter<RectilinearArrayType>(
+    vtkm::cont::DataSetBuilderRectilinear::Create(x, y), "rectilinear 2D", IntegrationType::Area);
+
+  // The cells of 1D structured cell sets are only measured in closed form.
+  vtkm::cont::DataSet data =
+    vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(1, 4, 1), origin, spacing);
+  TestCellMeasuresFilter(data, "uniform 1D", { 2.f, 2.f, 2.f }, IntegrationType::AllMeasures);
+  data = vtkm::cont::DataSetBuilderRectilinear::Create(decreasing);
+  TestCellMeasuresFilter(data, "rectilinear 1D", { 1.f, 1.5f }, IntegrationType::AllMeasures);
 }
 
 void TestCellMeasures()
@@ -96,6 +176,8 @@ void TestCellMeasures()
     "explicit dataset 6 (all)",
     { 0.999924f, 0.999924f, 0.f, 0.f, 3.85516f, 1.00119f, 0.083426f, 0.25028f },
     IntegrationType::AllMeasures);
+
+  TestStructuredCellMeasures();
 }
 
 } // anonymous namespace
@@ -20,9 +20,13 @@
 #include <cstdio>
 #include <string>
 #include <vector>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
 #include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/ErrorExecution.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/mesh_info/MeshQuality.h>
@@ -180,6 +184,126 @@ bool TestMeshQualityFilter(const vtkm::cont::DataSet& input,
   return anyFailures;
 }
 
+void TestMultipleMetrics(const vtkm::cont::DataSet& input)
+{
+  using CellMetric = vtkm::filter::mesh_info::CellMetric;
+  const std::vector<CellMetric> metrics = { CellMetric::Area,
+                                            CellMetric::AspectRatio,
+                                            CellMetric::Condition,
+                                            CellMetric::MinAngle,
+                                            CellMetric::ScaledJacobian,
+                                            CellMetric::ShapeAndSize,
+                                            CellMetric::Volume,
+                                            CellMetric::RelativeSizeSquared,
+                                            CellMetric::AspectRatio };
+
+  vtkm::filter::mesh_info::MeshQuality multiFilter;
+  multiFilter.SetMetrics(metrics);
+  multiFilter.SetComputeSummaries(true);
+  vtkm::cont::DataSet multiOutput = multiFilter.Execute(input);
+
+  for (CellMetric metric : metrics)
+  {
+    const std::string name = vtkm::filter::mesh_info::MeshQuality::GetMetricName(metric);
+    std::cout << "Testing metric " << name << " among several metrics" << std::endl;
+
+    vtkm::filter::mesh_info::MeshQuality singleFilter;
+    singleFilter.SetMetric(metric);
+    vtkm::cont::DataSet singleOutput = singleFilter.Execute(input);
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> expected;
+    singleOutput.GetCellField(name).GetData().AsArrayHandle(expected);
+    vtkm::cont::ArrayHandle<vtkm::Float64> computed;
+    multiOutput.GetCellField(name).GetData().AsArrayHandle(computed);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(computed, expected), "Wrong values for ", name);
+
+    vtkm::Float64 min = vtkm::Infinity64();
+    vtkm::Float64 max = vtkm::NegativeInfinity64();
+    vtkm::Float64 sum = 0;
+    auto portal = expected.ReadPortal();
+    for (vtkm::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+    {
+      min = vtkm::Min(min, portal.Get(index));
+      max = vtkm::Max(max, portal.Get(index));
+      sum += portal.Get(index);
+    }
+    vtkm::cont::ArrayHandle<vtkm::Float64> summary;
+    multiOutput.GetField(name + "Summary").GetData().AsArrayHandle(summary);
+    VTKM_TEST_ASSERT(multiOutput.GetField(name + "Summary").IsWholeDataSetField());
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      summary,
+      vtkm::cont::make_ArrayHandle<vtkm::Float64>(
+        { min, max, sum / static_cast<vtkm::Float64>(portal.GetNumberOfValues()) })));
+  }
+}
+
+void TestStructuredMetrics(const vtkm::cont::DataSet& input, const char* msg)
+{
+  using CellMetric = vtkm::filter::mesh_info::CellMetric;
+
+  // The area and volume of structured cells are computed in closed form. Compare them with
+  // the values computed from each cell when the coordinates are an explicit array.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopy(input.GetCoordinateSystem().GetData(), points);
+  vtkm::cont::DataSet explicitPoints = input;
+  explicitPoints.AddCoordinateSystem(
+    vtkm::cont::CoordinateSystem(input.GetCoordinateSystem().GetName(), points));
+
+  const CellMetric metrics[] = { CellMetric::Area,
+                                 CellMetric::Volume,
+                                 CellMetric::RelativeSizeSquared };
+  for (CellMetric metric : metrics)
+  {
+    const std::string name = vtkm::filter::mesh_info::MeshQuality::GetMetricName(metric);
+    std::cout << "Testing metric " << name << " on " << msg << std::endl;
+
+    vtkm::filter::mesh_info::MeshQuality filter;
+    filter.SetMetric(metric);
+    filter.SetComputeSummaries(true);
+    vtkm::cont::DataSet output = filter.Execute(input);
+    vtkm::cont::DataSet expectedOutput = filter.Execute(explicitPoints);
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> computed;
+    vtkm::cont::ArrayCopy(output.GetCellField(name).GetData(), computed);
+    vtkm::cont::ArrayHandle<vtkm::Float64> expected;
+    vtkm::cont::ArrayCopy(expectedOutput.GetCellField(name).GetData(), expected);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(computed, expected), "Wrong values for ", name);
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> summary;
+    output.GetField(name + "Summary").GetData().AsArrayHandle(summary);
+    vtkm::cont::ArrayHandle<vtkm::Float64> expectedSummary;
+    expectedOutput.GetField(name + "Summary").GetData().AsArrayHandle(expectedSummary);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(summary, expectedSummary),
+                     "Wrong summary for ",
+                     name);
+  }
+}
+
+void TestStructuredMetrics()
+{
+  vtkm::cont::DataSet uniform = vtkm::cont::DataSetBuilderUniform::Create(
+    vtkm::Id3(4, 3, 5), vtkm::Vec3f(0.0f), vtkm::Vec3f(0.5f, 2.0f, 0.25f));
+  TestStructuredMetrics(uniform, "uniform 3D");
+  vtkm::filter::mesh_info::MeshQuality volumeFilter;
+  volumeFilter.SetMetric(vtkm::filter::mesh_info::CellMetric::Volume);
+  vtkm::cont::DataSet volumeOutput = volumeFilter.Execute(uniform);
+  VTKM_TEST_ASSERT(volumeOutput.GetCellField("volume")
+                     .GetData()
+                     .IsType<vtkm::cont::ArrayHandleConstant<vtkm::FloatDefault>>(),
+                   "Volume of uniform cells is not constant");
+
+  TestStructuredMetrics(vtkm::cont::DataSetBuilderUniform::Create(
+                          vtkm::Id2(5, 3), vtkm::Vec2f(0.0f), vtkm::Vec2f(2.0f)),
+                        "uniform 2D");
+
+  const std::vector<vtkm::Float64> x = { 0.0, 0.5, 2.0, 2.25 };
+  const std::vector<vtkm::Float64> y = { 1.0, 3.0, 3.5 };
+  const std::vector<vtkm::Float64> z = { 5.0, 4.0, 0.5 };
+  TestStructuredMetrics(vtkm::cont::DataSetBuilderRectilinear::Create(x, y), "rectilinear 2D");
+  TestStructuredMetrics(vtkm::cont::DataSetBuilderRectilinear::Create(x, y, z),
+                        "rectilinear 3D");
+}
+
 int TestMeshQuality()
 {
   using FloatVec = std::vector<vtkm::FloatDefault>;
@@ -373,6 +497,10 @@ int TestMeshQuality()
     bool see_previous_messages = false; // this variable name plays well with macro
     VTKM_TEST_ASSERT(see_previous_messages, "Failure occurred during test");
   }
+
+  TestMultipleMetrics(explicitInput);
+  TestMultipleMetrics(singleTypeInput);
+  TestStructuredMetrics();
   return 0;
 }
 
@@ -22,12 +22,18 @@
 
 #include <vtkm/worklet/WorkletMapTopology.h>
 
+#include <vtkm/cont/ArrayExtractComponent.h>
+#include <vtkm/cont/ArrayHandleRecombineVec.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/Field.h>
 #include <vtkm/cont/UnknownArrayHandle.h>
 
 #include <vtkm/ErrorCode.h>
 #include <vtkm/TypeList.h>
+#include <vtkm/VecTraits.h>
+#include <vtkm/VecVariable.h>
+
+#include <vector>
 
 namespace
 {
@@ -105,6 +111,147 @@ struct MeshQualityWorklet : vtkm::worklet::WorkletVisitCellsWithPoints
   }
 };
 
+/**
+  * Worklet that computes several mesh quality metrics for each cell in one
+  * traversal of the input mesh. The points of each cell are gathered once and
+  * shared by all the metrics. `MetricsType` provides a `ComputeMetric` method
+  * that computes the metric at a given index of its list of metrics. One array
+  * of metric values (one per cell) is returned for each metric.
+  */
+template <typename MetricsType>
+struct MeshQualityMultiMetricWorklet : vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn cellset,
+                                FieldInPoint pointCoords,
+                                FieldOutCell metricsOut);
+  using ExecutionSignature = void(CellShape, PointCount, _2, _3);
+
+  // Cells with more points than this, which can only be polygons or poly lines, are
+  // not gathered.
+  static constexpr vtkm::IdComponent MaxGatheredPoints = 8;
+
+  MetricsType Metrics;
+  vtkm::IdComponent NumberOfMetrics;
+
+  VTKM_CONT MeshQualityMultiMetricWorklet(const MetricsType& metrics,
+                                          vtkm::IdComponent numberOfMetrics)
+    : Metrics(metrics)
+    , NumberOfMetrics(numberOfMetrics)
+  {
+  }
+
+  template <typename CellShapeType, typename PointCoordVecType, typename OutVecType>
+  VTKM_EXEC void operator()(CellShapeType shape,
+                            const vtkm::IdComponent& numPoints,
+                            const PointCoordVecType& pts,
+                            OutVecType& metricsOut) const
+  {
+    vtkm::UInt8 thisId = shape.Id;
+    if (shape.Id == vtkm::CELL_SHAPE_POLYGON)
+    {
+      if (numPoints == 3)
+        thisId = vtkm::CELL_SHAPE_TRIANGLE;
+      else if (numPoints == 4)
+        thisId = vtkm::CELL_SHAPE_QUAD;
+    }
+
+    vtkm::ErrorCode errorCode = vtkm::ErrorCode::Success;
+    if (numPoints <= MaxGatheredPoints)
+    {
+      vtkm::VecVariable<typename PointCoordVecType::ComponentType, MaxGatheredPoints> gathered;
+      for (vtkm::IdComponent i = 0; i < numPoints; ++i)
+      {
+        gathered.Append(pts[i]);
+      }
+      switch (thisId)
+      {
+        vtkmGenericCellShapeMacro(
+          this->ComputeMetrics(numPoints, gathered, CellShapeTag{}, metricsOut, errorCode));
+        default:
+          errorCode = vtkm::ErrorCode::InvalidShapeId;
+          this->ZeroMetrics(metricsOut);
+      }
+    }
+    else if (thisId == vtkm::CELL_SHAPE_POLYGON)
+    {
+      this->ComputeMetrics(numPoints, pts, vtkm::CellShapeTagPolygon{}, metricsOut, errorCode);
+    }
+    else if (thisId == vtkm::CELL_SHAPE_POLY_LINE)
+    {
+      this->ComputeMetrics(numPoints, pts, vtkm::CellShapeTagPolyLine{}, metricsOut, errorCode);
+    }
+    else
+    {
+      errorCode = vtkm::ErrorCode::InvalidShapeId;
+      this->ZeroMetrics(metricsOut);
+    }
+
+    if (errorCode != vtkm::ErrorCode::Success)
+    {
+      this->RaiseError(vtkm::ErrorString(errorCode));
+    }
+  }
+
+  template <typename PointCoordVecType, typename CellShapeType, typename OutVecType>
+  VTKM_EXEC void ComputeMetrics(const vtkm::IdComponent& numPoints,
+                                const PointCoordVecType& pts,
+                                CellShapeType shape,
+                                OutVecType& metricsOut,
+                                vtkm::ErrorCode& errorCode) const
+  {
+    using OutType = typename vtkm::VecTraits<OutVecType>::ComponentType;
+    for (vtkm::IdComponent index = 0; index < this->NumberOfMetrics; ++index)
+    {
+      metricsOut[index] =
+        this->Metrics.template ComputeMetric<OutType>(index, numPoints, pts, shape, errorCode);
+    }
+  }
+
+  template <typename OutVecType>
+  VTKM_EXEC void ZeroMetrics(OutVecType& metricsOut) const
+  {
+    using OutType = typename vtkm::VecTraits<OutVecType>::ComponentType;
+    for (vtkm::IdComponent index = 0; index < this->NumberOfMetrics; ++index)
+    {
+      metricsOut[index] = OutType(0.0);
+    }
+  }
+
+  VTKM_CONT std::vector<vtkm::cont::UnknownArrayHandle> Run(const vtkm::cont::DataSet& input,
+                                                            const vtkm::cont::Field& field)
+  {
+    if (!field.IsPointField())
+    {
+      throw vtkm::cont::ErrorBadValue("Active field for MeshQuality must be point coordinates. "
+                                      "But the active field is not a point field.");
+    }
+
+    std::vector<vtkm::cont::UnknownArrayHandle> outArrays;
+    vtkm::cont::Invoker invoke;
+
+    auto resolveType = [&](const auto& concrete) {
+      using T = typename std::decay_t<decltype(concrete)>::ValueType::ComponentType;
+      // Each metric is written directly to its own array, seen by the worklet as one
+      // component of a recombined array.
+      vtkm::cont::ArrayHandleRecombineVec<T> values;
+      for (vtkm::IdComponent index = 0; index < this->NumberOfMetrics; ++index)
+      {
+        vtkm::cont::ArrayHandle<T> result;
+        result.Allocate(input.GetNumberOfCells());
+        values.AppendComponentArray(
+          vtkm::cont::ArrayExtractComponent(result, 0, vtkm::CopyFlag::Off));
+        outArrays.push_back(result);
+      }
+      invoke(*this, input.GetCellSet(), concrete, values);
+    };
+    field.GetData()
+      .CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldVec3, VTKM_DEFAULT_STORAGE_LIST>(
+        resolveType);
+
+    return outArrays;
+  }
+};
+
 } // anonymous namespace
 
 #endif //vtk_m_filter_mesh_info_worklet_MeshQualityWorklet_h
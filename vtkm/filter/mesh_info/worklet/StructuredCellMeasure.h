@@ -0,0 +1,246 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_StructuredCellMeasure_h
+#define vtk_m_worklet_StructuredCellMeasure_h
+
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/filter/mesh_info/CellMeasures.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+/**\brief Closed form measures of the cells of axis aligned structured grids.
+  *
+  * All cells of a structured grid with uniform point coordinates have the same measure, so
+  * the measures are returned as an `ArrayHandleConstant`. The measure of a cell of a
+  * rectilinear grid is the product of the spacings of its axes, so the measures are returned
+  * as an implicit array over the cartesian product of the spacing of each axis. In both cases
+  * nothing is computed or stored per cell.
+  *
+  * As with `CellMeasure`, lengths and areas are positive and volumes are signed.
+  */
+class StructuredCellMeasure
+{
+public:
+  struct SpacingProduct
+  {
+    template <typename T>
+    VTKM_EXEC_CONT T operator()(const vtkm::Vec<T, 3>& spacing) const
+    {
+      return spacing[0] * spacing[1] * spacing[2];
+    }
+  };
+
+  template <typename T>
+  using RectilinearMeasureArrayType = vtkm::cont::ArrayHandleTransform<
+    vtkm::cont::ArrayHandleCartesianProduct<vtkm::cont::ArrayHandle<T>,
+                                            vtkm::cont::ArrayHandle<T>,
+                                            vtkm::cont::ArrayHandle<T>>,
+    SpacingProduct>;
+
+  class AxisSpacing : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn index, WholeArrayIn axisCoords, FieldOut spacing);
+    using ExecutionSignature = void(_1, _2, _3);
+
+    explicit AxisSpacing(bool unsignedSpacing)
+      : Unsigned(unsignedSpacing)
+    {
+    }
+
+    template <typename CoordsPortalType, typename T>
+    VTKM_EXEC void operator()(vtkm::Id index, const CoordsPortalType& axisCoords, T& spacing) const
+    {
+      spacing = static_cast<T>(axisCoords.Get(index + 1) - axisCoords.Get(index));
+      if (this->Unsigned)
+      {
+        spacing = vtkm::Abs(spacing);
+      }
+    }
+
+  private:
+    bool Unsigned;
+  };
+
+  /// Computes the measures of the cells of `cellSet` with the point coordinates `coords`.
+  /// Returns false, without changing `measures`, if the cell set is not structured or the
+  /// coordinates are neither uniform nor rectilinear. Cells whose dimension is not selected
+  /// by `measure` get 0.
+  template <typename T>
+  VTKM_CONT static bool Run(const vtkm::cont::UnknownCellSet& cellSet,
+                            const vtkm::cont::UnknownArrayHandle& coords,
+                            vtkm::filter::mesh_info::IntegrationType measure,
+                            vtkm::cont::UnknownArrayHandle& measures)
+  {
+    std::vector<vtkm::Id> cellSetDimensions;
+    if (cellSet.IsType<vtkm::cont::CellSetStructured<1>>())
+    {
+      cellSetDimensions = {
+        cellSet.AsCellSet<vtkm::cont::CellSetStructured<1>>().GetPointDimensions()
+      };
+    }
+    else if (cellSet.IsType<vtkm::cont::CellSetStructured<2>>())
+    {
+      const vtkm::Id2 dims =
+        cellSet.AsCellSet<vtkm::cont::CellSetStructured<2>>().GetPointDimensions();
+      cellSetDimensions = { dims[0], dims[1] };
+    }
+    else if (cellSet.IsType<vtkm::cont::CellSetStructured<3>>())
+    {
+      const vtkm::Id3 dims =
+        cellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+      cellSetDimensions = { dims[0], dims[1], dims[2] };
+    }
+    else
+    {
+      return false;
+    }
+
+    using Float32Rectilinear =
+      vtkm::cont::ArrayHandleCartesianProduct<vtkm::cont::ArrayHandle<vtkm::Float32>,
+                                              vtkm::cont::ArrayHandle<vtkm::Float32>,
+                                              vtkm::cont::ArrayHandle<vtkm::Float32>>;
+    using Float64Rectilinear =
+      vtkm::cont::ArrayHandleCartesianProduct<vtkm::cont::ArrayHandle<vtkm::Float64>,
+                                              vtkm::cont::ArrayHandle<vtkm::Float64>,
+                                              vtkm::cont::ArrayHandle<vtkm::Float64>>;
+
+    vtkm::Id3 coordsDimensions;
+    if (coords.IsType<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+    {
+      coordsDimensions =
+        coords.AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>().GetDimensions();
+    }
+    else if (coords.IsType<Float32Rectilinear>())
+    {
+      coordsDimensions = GetDimensions(coords.AsArrayHandle<Float32Rectilinear>());
+    }
+    else if (coords.IsType<Float64Rectilinear>())
+    {
+      coordsDimensions = GetDimensions(coords.AsArrayHandle<Float64Rectilinear>());
+    }
+    else
+    {
+      return false;
+    }
+
+    // The cells span the axes of the coordinates that have more than one point. These must
+    // match the dimensions of the cell set.
+    std::vector<vtkm::Id> axesDimensions;
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      if (coordsDimensions[axis] > 1)
+      {
+        axesDimensions.push_back(coordsDimensions[axis]);
+      }
+    }
+    if (axesDimensions != cellSetDimensions)
+    {
+      return false;
+    }
+
+    using vtkm::filter::mesh_info::IntegrationType;
+    const vtkm::IdComponent cellDimension =
+      static_cast<vtkm::IdComponent>(cellSetDimensions.size());
+    const IntegrationType cellMeasure = (cellDimension == 1)
+      ? IntegrationType::ArcLength
+      : ((cellDimension == 2) ? IntegrationType::Area : IntegrationType::Volume);
+    if ((measure & cellMeasure) != cellMeasure)
+    {
+      measures = vtkm::cont::make_ArrayHandleConstant(T(0), cellSet.GetNumberOfCells());
+      return true;
+    }
+
+    // Volumes keep the orientation of the cells.
+    const bool unsignedMeasure = (cellDimension < 3);
+    if (coords.IsType<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+    {
+      const auto spacing =
+        coords.AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>().GetSpacing();
+      T value = 1;
+      for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+      {
+        if (coordsDimensions[axis] > 1)
+        {
+          value *= static_cast<T>(unsignedMeasure ? vtkm::Abs(spacing[axis]) : spacing[axis]);
+        }
+      }
+      measures = vtkm::cont::make_ArrayHandleConstant(value, cellSet.GetNumberOfCells());
+    }
+    else if (coords.IsType<Float32Rectilinear>())
+    {
+      measures =
+        MakeRectilinearMeasures<T>(coords.AsArrayHandle<Float32Rectilinear>(), unsignedMeasure);
+    }
+    else
+    {
+      measures =
+        MakeRectilinearMeasures<T>(coords.AsArrayHandle<Float64Rectilinear>(), unsignedMeasure);
+    }
+    return true;
+  }
+
+private:
+  template <typename RectilinearType>
+  VTKM_CONT static vtkm::Id3 GetDimensions(const RectilinearType& coords)
+  {
+    return vtkm::Id3(coords.GetFirstArray().GetNumberOfValues(),
+                     coords.GetSecondArray().GetNumberOfValues(),
+                     coords.GetThirdArray().GetNumberOfValues());
+  }
+
+  template <typename T, typename AxisArrayType>
+  VTKM_CONT static vtkm::cont::ArrayHandle<T> MakeSpacing(const AxisArrayType& axisCoords,
+                                                          bool unsignedMeasure)
+  {
+    // An axis with a single point does not contribute to the measure.
+    if (axisCoords.GetNumberOfValues() < 2)
+    {
+      return vtkm::cont::make_ArrayHandle<T>({ T(1) });
+    }
+    vtkm::cont::ArrayHandle<T> spacing;
+    vtkm::cont::Invoker invoke;
+    invoke(AxisSpacing{ unsignedMeasure },
+           vtkm::cont::ArrayHandleIndex(axisCoords.GetNumberOfValues() - 1),
+           axisCoords,
+           spacing);
+    return spacing;
+  }
+
+  template <typename T, typename RectilinearType>
+  VTKM_CONT static RectilinearMeasureArrayType<T> MakeRectilinearMeasures(
+    const RectilinearType& coords,
+    bool unsignedMeasure)
+  {
+    return vtkm::cont::make_ArrayHandleTransform(
+      vtkm::cont::make_ArrayHandleCartesianProduct(
+        MakeSpacing<T>(coords.GetFirstArray(), unsignedMeasure),
+        MakeSpacing<T>(coords.GetSecondArray(), unsignedMeasure),
+        MakeSpacing<T>(coords.GetThirdArray(), unsignedMeasure)),
+      SpacingProduct{});
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_StructuredCellMeasure_h
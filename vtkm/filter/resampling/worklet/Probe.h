@@ -23,6 +23,8 @@
 
 #include <vtkm/VecFromPortalPermute.h>
 
+#include <type_traits>
+
 namespace vtkm
 {
 namespace worklet
@@ -31,34 +33,18 @@ namespace worklet
 class Probe
 {
   //============================================================================
-public:
-  class FindCellWorklet : public vtkm::worklet::WorkletMapField
-  {
-  public:
-    using ControlSignature = void(FieldIn points,
-                                  ExecObject locator,
-                                  FieldOut cellIds,
-                                  FieldOut pcoords);
-    using ExecutionSignature = void(_1, _2, _3, _4);
-
-    template <typename LocatorType>
-    VTKM_EXEC void operator()(const vtkm::Vec3f& point,
-                              const LocatorType& locator,
-                              vtkm::Id& cellId,
-                              vtkm::Vec3f& pcoords) const
-    {
-      locator.FindCell(point, cellId, pcoords);
-    }
-  };
-
 private:
   struct RunSelectLocator
   {
     template <typename LocatorType, typename PointsType>
     void operator()(const LocatorType& locator, Probe& worklet, const PointsType& points) const
     {
-      worklet.Invoke(
-        FindCellWorklet{}, points, locator, worklet.CellIds, worklet.ParametricCoordinates);
+      // Locating the points in spatially coherent order only pays off for locators that
+      // search a data structure. The structured grid locators compute the cell directly.
+      constexpr bool sortPoints =
+        !std::is_same<LocatorType, vtkm::cont::CellLocatorUniformGrid>::value &&
+        !std::is_same<LocatorType, vtkm::cont::CellLocatorRectilinearGrid>::value;
+      locator.FindCells(points, worklet.CellIds, worklet.ParametricCoordinates, sortPoints);
     }
   };
 
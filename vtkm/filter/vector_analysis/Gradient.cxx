@@ -79,8 +79,16 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
     if (this->ComputePointGradient)
     {
       vtkm::worklet::PointGradient gradient;
+      gradient.SetUseHigherOrderStencil(this->UseHigherOrderStencil);
       result = gradient.Run(inputCellSet, coords, concrete, gradientfields);
     }
+    else if (vtkm::worklet::StructuredCellGradient::CanRun(inputCellSet, coords))
+    {
+      // Cells of uniform and rectilinear grids are boxes, so their gradients are
+      // differences across the cell edges.
+      result =
+        vtkm::worklet::StructuredCellGradient::Run(inputCellSet, coords, concrete, gradientfields);
+    }
     else
     {
       vtkm::worklet::CellGradient gradient;
@@ -88,6 +88,16 @@ public:
   /// @copydoc SetComputeGradient
   bool GetComputeGradient() const { return StoreGradient; }
 
+  /// @brief Specify whether to use fourth-order differences on uniform and rectilinear grids.
+  ///
+  /// When this flag is on (default is off), point gradients of structured data with uniform
+  /// or rectilinear coordinates use fourth-order central differences at the points that
+  /// are at least two points away from the boundary. The other points, and all other
+  /// inputs, use the usual second-order differences.
+  void SetUseHigherOrderStencil(bool enable) { UseHigherOrderStencil = enable; }
+  /// @copydoc SetUseHigherOrderStencil
+  bool GetUseHigherOrderStencil() const { return UseHigherOrderStencil; }
+
   /// Make the vector gradient output format be in FORTRAN Column-major order.
   /// This is only used when the input field is a vector field.
   /// Enabling column-major is important if integrating with other projects
@@ -109,6 +119,7 @@ private:
   bool ComputeQCriterion = false;
   bool StoreGradient = true;
   bool RowOrdering = true;
+  bool UseHigherOrderStencil = false;
 
   std::string DivergenceName = "Divergence";
   std::string GradientsName = "Gradients";
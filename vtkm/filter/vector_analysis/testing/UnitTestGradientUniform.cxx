@@ -10,6 +10,8 @@
 
 #include <vtkm/filter/vector_analysis/Gradient.h>
 
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -160,11 +162,138 @@ void TestPointGradientUniform3DWithVectorField()
 
 
 
+vtkm::cont::DataSet MakeRectilinearDataSet()
+{
+  // Uneven spacing along every axis.
+  std::vector<vtkm::Float64> x = { 0.0, 0.5, 1.5, 2.0, 3.25, 4.0, 5.5 };
+  std::vector<vtkm::Float64> y = { -1.0, 0.0, 0.25, 1.0, 2.5, 3.0 };
+  std::vector<vtkm::Float64> z = { 0.0, 1.0, 1.5, 3.0, 3.5 };
+  return vtkm::cont::DataSetBuilderRectilinear::Create(x, y, z);
+}
+
+template <typename FieldFunction>
+void AddPointField(vtkm::cont::DataSet& dataSet, const std::string& name, FieldFunction function)
+{
+  auto coords = dataSet.GetCoordinateSystem().GetDataAsMultiplexer();
+  auto coordsPortal = coords.ReadPortal();
+  using ValueType = decltype(function(coordsPortal.Get(0)));
+  vtkm::cont::ArrayHandle<ValueType> field;
+  field.Allocate(coords.GetNumberOfValues());
+  for (vtkm::Id index = 0; index < coords.GetNumberOfValues(); ++index)
+  {
+    field.WritePortal().Set(index, function(coordsPortal.Get(index)));
+  }
+  dataSet.AddPointField(name, field);
+}
+
+void TestGradientRectilinear3D()
+{
+  std::cout << "Testing Gradient Filter on 3D rectilinear data" << std::endl;
+  vtkm::cont::DataSet dataSet = MakeRectilinearDataSet();
+  AddPointField(dataSet, "linear", [](const vtkm::Vec3f& p) {
+    return static_cast<vtkm::Float64>(2 * p[0] + 3 * p[1] - p[2]);
+  });
+  // Each component is linear along every axis, so the differences are exact.
+  AddPointField(dataSet, "vectors", [](const vtkm::Vec3f& p) {
+    return vtkm::Vec3f_64(p[0] * p[1], p[1] * p[2], p[2] * p[0]);
+  });
+
+  for (bool pointGradient : { false, true })
+  {
+    vtkm::filter::vector_analysis::Gradient gradient;
+    gradient.SetComputePointGradient(pointGradient);
+    gradient.SetActiveField("linear");
+    vtkm::cont::DataSet result = gradient.Execute(dataSet);
+
+    vtkm::cont::ArrayHandle<vtkm::Vec3f_64> gradients;
+    result.GetField("Gradients").GetData().AsArrayHandle(gradients);
+    auto portal = gradients.ReadPortal();
+    for (vtkm::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+    {
+      VTKM_TEST_ASSERT(test_equal(portal.Get(index), vtkm::Vec3f_64(2, 3, -1)),
+                       "Wrong gradient on rectilinear data");
+    }
+  }
+
+  vtkm::filter::vector_analysis::Gradient gradient;
+  gradient.SetComputePointGradient(true);
+  gradient.SetComputeDivergence(true);
+  gradient.SetComputeVorticity(true);
+  gradient.SetActiveField("vectors");
+  vtkm::cont::DataSet result = gradient.Execute(dataSet);
+
+  auto coordsPortal = dataSet.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  vtkm::cont::ArrayHandle<vtkm::Float64> divergence;
+  result.GetPointField("Divergence").GetData().AsArrayHandle(divergence);
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> vorticity;
+  result.GetPointField("Vorticity").GetData().AsArrayHandle(vorticity);
+  for (vtkm::Id index = 0; index < coordsPortal.GetNumberOfValues(); ++index)
+  {
+    vtkm::Vec3f_64 p = coordsPortal.Get(index);
+    VTKM_TEST_ASSERT(test_equal(divergence.ReadPortal().Get(index), p[0] + p[1] + p[2]),
+                     "Wrong divergence on rectilinear data");
+    VTKM_TEST_ASSERT(
+      test_equal(vorticity.ReadPortal().Get(index), vtkm::Vec3f_64(-p[1], -p[2], -p[0])),
+      "Wrong vorticity on rectilinear data");
+  }
+}
+
+void TestHigherOrderPointGradient(const vtkm::cont::DataSet& input)
+{
+  vtkm::cont::DataSet dataSet = input;
+  // The fourth-order differences are exact for polynomials up to degree 4 along each axis.
+  AddPointField(dataSet, "cubic", [](const vtkm::Vec3f& p) {
+    return static_cast<vtkm::Float64>(p[0] * p[0] * p[0] + p[1] * p[1] * p[2]);
+  });
+
+  vtkm::filter::vector_analysis::Gradient gradient;
+  gradient.SetComputePointGradient(true);
+  gradient.SetUseHigherOrderStencil(true);
+  gradient.SetActiveField("cubic");
+  vtkm::cont::DataSet result = gradient.Execute(dataSet);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> gradients;
+  result.GetPointField("Gradients").GetData().AsArrayHandle(gradients);
+  auto portal = gradients.ReadPortal();
+  auto coordsPortal = dataSet.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  vtkm::Id3 dims =
+    dataSet.GetCellSet().AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+  for (vtkm::Id k = 2; k < dims[2] - 2; ++k)
+  {
+    for (vtkm::Id j = 2; j < dims[1] - 2; ++j)
+    {
+      for (vtkm::Id i = 2; i < dims[0] - 2; ++i)
+      {
+        vtkm::Id index = i + dims[0] * (j + dims[1] * k);
+        vtkm::Vec3f_64 p = coordsPortal.Get(index);
+        vtkm::Vec3f_64 expected(3 * p[0] * p[0], 2 * p[1] * p[2], p[1] * p[1]);
+        VTKM_TEST_ASSERT(test_equal(portal.Get(index), expected, 1e-4),
+                         "Wrong higher order gradient at ",
+                         p,
+                         ": ",
+                         portal.Get(index),
+                         " expected ",
+                         expected);
+      }
+    }
+  }
+}
+
+void TestHigherOrderPointGradient()
+{
+  std::cout << "Testing Gradient Filter with higher order stencil" << std::endl;
+  TestHigherOrderPointGradient(vtkm::cont::DataSetBuilderUniform::Create(
+    vtkm::Id3(7, 6, 5), vtkm::Vec3f(-1.0f, 0.5f, 0.0f), vtkm::Vec3f(0.5f, 0.25f, 1.0f)));
+  TestHigherOrderPointGradient(MakeRectilinearDataSet());
+}
+
 void TestGradient()
 {
   TestCellGradientUniform3D();
   TestCellGradientUniform3DWithVectorField();
   TestPointGradientUniform3DWithVectorField();
+  TestGradientRectilinear3D();
+  TestHigherOrderPointGradient();
 }
 }
 
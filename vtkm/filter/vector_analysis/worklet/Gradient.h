@@ -19,6 +19,7 @@
 #include <vtkm/filter/vector_analysis/worklet/gradient/GradientOutput.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/PointGradient.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/QCriterion.h>
+#include <vtkm/filter/vector_analysis/worklet/gradient/StructuredCellGradient.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/StructuredPointGradient.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/Transpose.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/Vorticity.h>
@@ -29,6 +30,8 @@
 #include <vtkm/cont/ArrayHandleSOA.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UncertainCellSet.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/internal/Instantiations.h>
 
@@ -55,10 +58,12 @@ struct DeducedPointGrad
 {
   DeducedPointGrad(const CoordinateSystem& coords,
                    const vtkm::cont::ArrayHandle<T, S>& field,
-                   GradientOutputFields<T>* result)
+                   GradientOutputFields<T>* result,
+                   bool higherOrder = false)
     : Points(&coords)
     , Field(&field)
     , Result(result)
+    , HigherOrder(higherOrder)
   {
   }
 
@@ -78,7 +83,8 @@ struct DeducedPointGrad
 
   void Go(const vtkm::cont::CellSetStructured<3>& cellset) const
   {
-    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher;
+    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher(
+      StructuredPointGradient(this->HigherOrder));
     dispatcher.Invoke(cellset, //topology to iterate on a per point basis
                       *this->Points,
                       *this->Field,
@@ -89,7 +95,8 @@ struct DeducedPointGrad
   void Go(const vtkm::cont::CellSetPermutation<vtkm::cont::CellSetStructured<3>, PermIterType>&
             cellset) const
   {
-    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher;
+    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher(
+      StructuredPointGradient(this->HigherOrder));
     dispatcher.Invoke(cellset, //topology to iterate on a per point basis
                       *this->Points,
                       *this->Field,
@@ -98,7 +105,8 @@ struct DeducedPointGrad
 
   void Go(const vtkm::cont::CellSetStructured<2>& cellset) const
   {
-    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher;
+    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher(
+      StructuredPointGradient(this->HigherOrder));
     dispatcher.Invoke(cellset, //topology to iterate on a per point basis
                       *this->Points,
                       *this->Field,
@@ -109,7 +117,8 @@ struct DeducedPointGrad
   void Go(const vtkm::cont::CellSetPermutation<vtkm::cont::CellSetStructured<2>, PermIterType>&
             cellset) const
   {
-    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher;
+    vtkm::worklet::DispatcherPointNeighborhood<StructuredPointGradient> dispatcher(
+      StructuredPointGradient(this->HigherOrder));
     dispatcher.Invoke(cellset, //topology to iterate on a per point basis
                       *this->Points,
                       *this->Field,
@@ -120,6 +129,7 @@ struct DeducedPointGrad
   const CoordinateSystem* const Points;
   const vtkm::cont::ArrayHandle<T, S>* const Field;
   GradientOutputFields<T>* Result;
+  bool HigherOrder;
 
 private:
   void operator=(const DeducedPointGrad<CoordinateSystem, T, S>&) = delete;
@@ -228,6 +238,11 @@ private:
 class PointGradient
 {
 public:
+  /// Use fourth-order central differences away from the boundary of uniform and
+  /// rectilinear grids. The default is off.
+  void SetUseHigherOrderStencil(bool enable) { this->UseHigherOrderStencil = enable; }
+  bool GetUseHigherOrderStencil() const { return this->UseHigherOrderStencil; }
+
   template <typename CellSetType, typename CoordinateSystem, typename T, typename S>
   vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> Run(const CellSetType& cells,
                                                const CoordinateSystem& coords,
@@ -237,10 +252,14 @@ public:
     //we are using cast and call here as we pass the cells twice to the invoke
     //and want the type resolved once before hand instead of twice
     //by the dispatcher ( that will cost more in time and binary size )
-    gradient::DeducedPointGrad<CoordinateSystem, T, S> func(coords, field, &extraOutput);
+    gradient::DeducedPointGrad<CoordinateSystem, T, S> func(
+      coords, field, &extraOutput, this->UseHigherOrderStencil);
     vtkm::cont::CastAndCall(cells, func);
     return extraOutput.Gradient;
   }
+
+private:
+  bool UseHigherOrderStencil = false;
 };
 
 class CellGradient
@@ -269,6 +288,61 @@ vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> CellGradient::Run(
 }
 #endif
 
+/// Computes cell gradients of structured cell sets whose points come from uniform or
+/// rectilinear coordinates, where every cell is an axis aligned box.
+class StructuredCellGradient
+{
+public:
+  using CellSetList =
+    vtkm::List<vtkm::cont::CellSetStructured<2>, vtkm::cont::CellSetStructured<3>>;
+  using CoordinatesStorageList =
+    vtkm::List<vtkm::cont::StorageTagUniformPoints,
+               vtkm::cont::StorageTagCartesianProduct<vtkm::cont::StorageTagBasic,
+                                                      vtkm::cont::StorageTagBasic,
+                                                      vtkm::cont::StorageTagBasic>>;
+
+  static bool CanRun(const vtkm::cont::UnknownCellSet& cells,
+                     const vtkm::cont::CoordinateSystem& coords)
+  {
+    using CartesianStorage = vtkm::cont::StorageTagCartesianProduct<vtkm::cont::StorageTagBasic,
+                                                                    vtkm::cont::StorageTagBasic,
+                                                                    vtkm::cont::StorageTagBasic>;
+    const bool structured = cells.IsType<vtkm::cont::CellSetStructured<2>>() ||
+      cells.IsType<vtkm::cont::CellSetStructured<3>>();
+    const bool axisAligned =
+      coords.GetData().IsStorageType<vtkm::cont::StorageTagUniformPoints>() ||
+      coords.GetData().IsStorageType<CartesianStorage>();
+    return structured && axisAligned;
+  }
+
+  template <typename T, typename S>
+  static vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> Run(const vtkm::cont::UnknownCellSet& cells,
+                                                      const vtkm::cont::CoordinateSystem& coords,
+                                                      const vtkm::cont::ArrayHandle<T, S>& field,
+                                                      GradientOutputFields<T>& extraOutput);
+};
+
+#ifndef VTKM_GRADIENT_CHECK_WORKLET_INSTANCES
+template <typename T, typename S>
+vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> StructuredCellGradient::Run(
+  const vtkm::cont::UnknownCellSet& cells,
+  const vtkm::cont::CoordinateSystem& coords,
+  const vtkm::cont::ArrayHandle<T, S>& field,
+  GradientOutputFields<T>& extraOutput)
+{
+  vtkm::cont::Invoker invoke;
+  coords.GetData().CastAndCallForTypes<vtkm::TypeListFieldVec3, CoordinatesStorageList>(
+    [&](const auto& points) {
+      invoke(vtkm::worklet::gradient::StructuredCellGradient{},
+             cells.ResetCellSetList<CellSetList>(),
+             points,
+             field,
+             extraOutput);
+    });
+  return extraOutput.Gradient;
+}
+#endif
+
 }
 } // namespace vtkm::worklet
 
@@ -623,4 +697,38 @@ extern template vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec3f, 3>> vtkm::worklet
   GradientOutputFields<vtkm::Vec3f>&);
 VTKM_INSTANTIATION_END
 
+//---------------------------------------------------------------------------
+VTKM_INSTANTIATION_BEGIN
+extern template vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Float32, 3>>
+vtkm::worklet::StructuredCellGradient::Run(
+  const vtkm::cont::UnknownCellSet&,
+  const vtkm::cont::CoordinateSystem&,
+  const vtkm::cont::ArrayHandle<vtkm::Float32, vtkm::cont::StorageTagBasic>&,
+  GradientOutputFields<vtkm::Float32>&);
+VTKM_INSTANTIATION_END
+VTKM_INSTANTIATION_BEGIN
+extern template vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Float64, 3>>
+vtkm::worklet::StructuredCellGradient::Run(
+  const vtkm::cont::UnknownCellSet&,
+  const vtkm::cont::CoordinateSystem&,
+  const vtkm::cont::ArrayHandle<vtkm::Float64, vtkm::cont::StorageTagBasic>&,
+  GradientOutputFields<vtkm::Float64>&);
+VTKM_INSTANTIATION_END
+VTKM_INSTANTIATION_BEGIN
+extern template vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec3f_32, 3>>
+vtkm::worklet::StructuredCellGradient::Run(
+  const vtkm::cont::UnknownCellSet&,
+  const vtkm::cont::CoordinateSystem&,
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f_32, vtkm::cont::StorageTagBasic>&,
+  GradientOutputFields<vtkm::Vec3f_32>&);
+VTKM_INSTANTIATION_END
+VTKM_INSTANTIATION_BEGIN
+extern template vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec3f_64, 3>>
+vtkm::worklet::StructuredCellGradient::Run(
+  const vtkm::cont::UnknownCellSet&,
+  const vtkm::cont::CoordinateSystem&,
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f_64, vtkm::cont::StorageTagBasic>&,
+  GradientOutputFields<vtkm::Vec3f_64>&);
+VTKM_INSTANTIATION_END
+
 #endif
@@ -0,0 +1,104 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_gradient_StructuredCellGradient_h
+#define vtk_m_worklet_gradient_StructuredCellGradient_h
+
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+#include <vtkm/filter/vector_analysis/worklet/gradient/GradientOutput.h>
+
+#include <vtkm/TypeTraits.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace gradient
+{
+
+//Computes the gradient at the center of cells that are axis aligned boxes, such
+//as the cells of uniform and rectilinear grids. The derivative along each cell
+//axis is the average difference across the parallel edges of the cell, which is
+//what the cell derivative of the (bi/tri)linear interpolant gives at the center.
+struct StructuredCellGradient : vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn,
+                                FieldInPoint pointCoordinates,
+                                FieldInPoint inputField,
+                                GradientOutputs outputFields);
+
+  using ExecutionSignature = void(PointCount, _2, _3, _4);
+  using InputDomain = _1;
+
+  template <typename PointCoordVecType, typename FieldInVecType, typename GradientOutType>
+  VTKM_EXEC void operator()(vtkm::IdComponent pointCount,
+                            const PointCoordVecType& wCoords,
+                            const FieldInVecType& field,
+                            GradientOutType& outputGradient) const
+  {
+    using OT = typename GradientOutType::ComponentType;
+    using BT = typename vtkm::VecTraits<OT>::BaseComponentType;
+    outputGradient = GradientOutType(vtkm::TypeTraits<OT>::ZeroInitialization());
+
+    if (pointCount == 8)
+    {
+      const BT quarter = static_cast<BT>(0.25);
+      this->AxisDerivative(wCoords[1] - wCoords[0],
+                           ((field[1] - field[0]) + (field[2] - field[3]) +
+                            (field[5] - field[4]) + (field[6] - field[7])) *
+                             quarter,
+                           outputGradient);
+      this->AxisDerivative(wCoords[3] - wCoords[0],
+                           ((field[3] - field[0]) + (field[2] - field[1]) +
+                            (field[7] - field[4]) + (field[6] - field[5])) *
+                             quarter,
+                           outputGradient);
+      this->AxisDerivative(wCoords[4] - wCoords[0],
+                           ((field[4] - field[0]) + (field[5] - field[1]) +
+                            (field[6] - field[2]) + (field[7] - field[3])) *
+                             quarter,
+                           outputGradient);
+    }
+    else if (pointCount == 4)
+    {
+      const BT half = static_cast<BT>(0.5);
+      this->AxisDerivative(wCoords[1] - wCoords[0],
+                           ((field[1] - field[0]) + (field[2] - field[3])) * half,
+                           outputGradient);
+      this->AxisDerivative(wCoords[3] - wCoords[0],
+                           ((field[3] - field[0]) + (field[2] - field[1])) * half,
+                           outputGradient);
+    }
+  }
+
+  //the edge of an axis aligned cell only moves along one axis
+  template <typename CoordType, typename ValueType, typename GradientOutType>
+  VTKM_EXEC void AxisDerivative(const CoordType& edge,
+                                const ValueType& difference,
+                                GradientOutType& outputGradient) const
+  {
+    using OT = typename GradientOutType::ComponentType;
+    using BT = typename vtkm::VecTraits<OT>::BaseComponentType;
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      if (edge[axis] != 0)
+      {
+        outputGradient[axis] = static_cast<OT>(difference / static_cast<BT>(edge[axis]));
+        return;
+      }
+    }
+  }
+};
+}
+}
+}
+
+#endif
@@ -11,9 +11,12 @@
 #ifndef vtk_m_worklet_gradient_StructuredPointGradient_h
 #define vtk_m_worklet_gradient_StructuredPointGradient_h
 
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/GradientOutput.h>
 #include <vtkm/worklet/WorkletPointNeighborhood.h>
 
+#include <vtkm/TypeTraits.h>
+
 
 namespace vtkm
 {
@@ -34,6 +37,15 @@ struct StructuredPointGradient : public vtkm::worklet::WorkletPointNeighborhood
 
   using InputDomain = _1;
 
+  StructuredPointGradient() = default;
+
+  /// When `higherOrder` is on, uniform and rectilinear grids use fourth-order central
+  /// differences for the points at least two points away from the boundary.
+  VTKM_CONT explicit StructuredPointGradient(bool higherOrder)
+    : HigherOrder(higherOrder)
+  {
+  }
+
   template <typename PointsIn, typename FieldIn, typename GradientOutType>
   VTKM_EXEC void operator()(const vtkm::exec::BoundaryState& boundary,
                             const PointsIn& inputPoints,
@@ -86,7 +98,13 @@ struct StructuredPointGradient : public vtkm::worklet::WorkletPointNeighborhood
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #endif
-    if (boundary.IsRadiusInXBoundary(1))
+    if (this->HigherOrder && boundary.IsRadiusInXBoundary(2))
+    {
+      auto d1 = inputField.GetUnchecked(1, 0, 0) - inputField.GetUnchecked(-1, 0, 0);
+      auto d2 = inputField.GetUnchecked(2, 0, 0) - inputField.GetUnchecked(-2, 0, 0);
+      outputGradient[0] = static_cast<OT>((d1 * 8.0f - d2) / (r[0] * 12));
+    }
+    else if (boundary.IsRadiusInXBoundary(1))
     {
       auto dx = inputField.GetUnchecked(1, 0, 0) - inputField.GetUnchecked(-1, 0, 0);
       outputGradient[0] = static_cast<OT>((dx * 0.5f) / r[0]);
@@ -97,7 +115,13 @@ struct StructuredPointGradient : public vtkm::worklet::WorkletPointNeighborhood
       outputGradient[0] = static_cast<OT>(dx / r[0]);
     }
 
-    if (boundary.IsRadiusInYBoundary(1))
+    if (this->HigherOrder && boundary.IsRadiusInYBoundary(2))
+    {
+      auto d1 = inputField.GetUnchecked(0, 1, 0) - inputField.GetUnchecked(0, -1, 0);
+      auto d2 = inputField.GetUnchecked(0, 2, 0) - inputField.GetUnchecked(0, -2, 0);
+      outputGradient[1] = static_cast<OT>((d1 * 8.0f - d2) / (r[1] * 12));
+    }
+    else if (boundary.IsRadiusInYBoundary(1))
     {
       auto dy = inputField.GetUnchecked(0, 1, 0) - inputField.GetUnchecked(0, -1, 0);
       outputGradient[1] = static_cast<OT>((dy * 0.5f) / r[1]);
@@ -108,7 +132,13 @@ struct StructuredPointGradient : public vtkm::worklet::WorkletPointNeighborhood
       outputGradient[1] = static_cast<OT>(dy / (r[1]));
     }
 
-    if (boundary.IsRadiusInZBoundary(1))
+    if (this->HigherOrder && boundary.IsRadiusInZBoundary(2))
+    {
+      auto d1 = inputField.GetUnchecked(0, 0, 1) - inputField.GetUnchecked(0, 0, -1);
+      auto d2 = inputField.GetUnchecked(0, 0, 2) - inputField.GetUnchecked(0, 0, -2);
+      outputGradient[2] = static_cast<OT>((d1 * 8.0f - d2) / (r[2] * 12));
+    }
+    else if (boundary.IsRadiusInZBoundary(1))
     {
       auto dz = inputField.GetUnchecked(0, 0, 1) - inputField.GetUnchecked(0, 0, -1);
       outputGradient[2] = static_cast<OT>((dz * 0.5f) / r[2]);
@@ -123,6 +153,106 @@ struct StructuredPointGradient : public vtkm::worklet::WorkletPointNeighborhood
 #endif
   }
 
+  template <typename FieldIn,
+            typename GradientOutType,
+            typename CoordType,
+            typename PortalX,
+            typename PortalY,
+            typename PortalZ>
+  VTKM_EXEC void operator()(
+    const vtkm::exec::BoundaryState& boundary,
+    const vtkm::exec::FieldNeighborhood<
+      vtkm::internal::ArrayPortalCartesianProduct<CoordType, PortalX, PortalY, PortalZ>>&
+      inputPoints,
+    const FieldIn& inputField,
+    GradientOutType& outputGradient) const
+  {
+    //Rectilinear points only move along one axis in each index direction, so the
+    //gradient is a derivative along each axis and the Jacobian is not needed
+    using OT = typename GradientOutType::ComponentType;
+    outputGradient = GradientOutType(vtkm::TypeTraits<OT>::ZeroInitialization());
+
+    this->AxisDerivative(
+      boundary.IsRadiusInXBoundary(2), { 1, 0, 0 }, inputPoints, inputField, outputGradient);
+    this->AxisDerivative(
+      boundary.IsRadiusInYBoundary(2), { 0, 1, 0 }, inputPoints, inputField, outputGradient);
+    this->AxisDerivative(
+      boundary.IsRadiusInZBoundary(2), { 0, 0, 1 }, inputPoints, inputField, outputGradient);
+  }
+
+  //computes the derivative along the axis that the points follow in the index
+  //direction of step. Near the boundary, Get clamps the neighbors so that the
+  //difference is one-sided.
+  template <typename PointsIn, typename FieldIn, typename GradientOutType>
+  VTKM_EXEC void AxisDerivative(bool inRadius2,
+                                const vtkm::IdComponent3& step,
+                                const PointsIn& inputPoints,
+                                const FieldIn& inputField,
+                                GradientOutType& outputGradient) const
+  {
+    using CoordType = typename PointsIn::ValueType;
+    using CT = typename vtkm::VecTraits<CoordType>::BaseComponentType;
+    using OT = typename GradientOutType::ComponentType;
+    using BT = typename vtkm::VecTraits<OT>::BaseComponentType;
+
+    const CoordType edge = inputPoints.Get(step[0], step[1], step[2]) -
+      inputPoints.Get(-step[0], -step[1], -step[2]);
+    vtkm::IdComponent axis = 0;
+    while ((axis < 3) && (edge[axis] == 0))
+    {
+      ++axis;
+    }
+    if (axis == 3)
+    {
+      return; //the grid is flat in this index direction
+    }
+
+    if (!this->HigherOrder || !inRadius2)
+    {
+      auto d = inputField.Get(step[0], step[1], step[2]) -
+        inputField.Get(-step[0], -step[1], -step[2]);
+      outputGradient[axis] = static_cast<OT>(d / static_cast<BT>(edge[axis]));
+      return;
+    }
+
+    //differentiate the polynomial through the 5 points along the axis, which
+    //keeps fourth-order accuracy when the spacing is not even
+    CT s[5];
+    const CT center = inputPoints.GetUnchecked(0, 0, 0)[axis];
+    for (vtkm::IdComponent k = 0; k < 5; ++k)
+    {
+      s[k] =
+        inputPoints.GetUnchecked((k - 2) * step[0], (k - 2) * step[1], (k - 2) * step[2])[axis] -
+        center;
+    }
+    OT derivative = vtkm::TypeTraits<OT>::ZeroInitialization();
+    for (vtkm::IdComponent j = 0; j < 5; ++j)
+    {
+      CT weight = (j == 2) ? CT(0) : CT(1);
+      CT denominator = 1;
+      for (vtkm::IdComponent k = 0; k < 5; ++k)
+      {
+        if (k == j)
+        {
+          continue;
+        }
+        if (j == 2)
+        {
+          weight -= 1 / s[k];
+        }
+        else
+        {
+          weight *= (k == 2) ? CT(1) : -s[k];
+          denominator *= s[j] - s[k];
+        }
+      }
+      derivative += static_cast<OT>(
+        inputField.GetUnchecked((j - 2) * step[0], (j - 2) * step[1], (j - 2) * step[2]) *
+        static_cast<BT>(weight / denominator));
+    }
+    outputGradient[axis] = derivative;
+  }
+
   //we need to pass the coordinates into this function, and instead
   //of the input being Vec<coordtype,3> it needs to be Vec<float,3> as the metrics
   //will be float,3 even when T is a 3 component field
@@ -184,6 +314,8 @@ struct StructuredPointGradient : public vtkm::worklet::WorkletPointNeighborhood
     m_zeta[1] = -aj * (xi[0] * eta[2] - xi[2] * eta[0]);
     m_zeta[2] = aj * (xi[0] * eta[1] - xi[1] * eta[0]);
   }
+
+  bool HigherOrder = false;
 };
 }
 }
@@ -39,13 +39,17 @@ public:
     VTKM_CONT
     CountSegments() {}
     typedef void ControlSignature(CellSetIn cellset, FieldOut);
-    typedef void ExecutionSignature(CellShape, _2);
+    typedef void ExecutionSignature(CellShape, PointCount, _2);
 
     VTKM_EXEC
-    void operator()(vtkm::CellShapeTagGeneric shapeType, vtkm::Id& segments) const
+    void operator()(vtkm::CellShapeTagGeneric shapeType,
+                    vtkm::IdComponent numPoints,
+                    vtkm::Id& segments) const
     {
       if (shapeType.Id == vtkm::CELL_SHAPE_LINE)
         segments = 1;
+      else if (shapeType.Id == vtkm::CELL_SHAPE_POLY_LINE)
+        segments = vtkm::Max(numPoints - 1, 0);
       else if (shapeType.Id == vtkm::CELL_SHAPE_TRIANGLE)
         segments = 3;
       else if (shapeType.Id == vtkm::CELL_SHAPE_QUAD)
@@ -63,18 +67,24 @@ public:
     }
 
     VTKM_EXEC
-    void operator()(vtkm::CellShapeTagHexahedron vtkmNotUsed(shapeType), vtkm::Id& segments) const
+    void operator()(vtkm::CellShapeTagHexahedron vtkmNotUsed(shapeType),
+                    vtkm::IdComponent vtkmNotUsed(numPoints),
+                    vtkm::Id& segments) const
     {
       segments = 36;
     }
 
     VTKM_EXEC
-    void operator()(vtkm::CellShapeTagQuad vtkmNotUsed(shapeType), vtkm::Id& segments) const
+    void operator()(vtkm::CellShapeTagQuad vtkmNotUsed(shapeType),
+                    vtkm::IdComponent vtkmNotUsed(numPoints),
+                    vtkm::Id& segments) const
     {
       segments = 4;
     }
     VTKM_EXEC
-    void operator()(vtkm::CellShapeTagWedge vtkmNotUsed(shapeType), vtkm::Id& segments) const
+    void operator()(vtkm::CellShapeTagWedge vtkmNotUsed(shapeType),
+                    vtkm::IdComponent vtkmNotUsed(numPoints),
+                    vtkm::Id& segments) const
     {
       segments = 24;
     }
@@ -317,6 +327,18 @@ public:
         segment[2] = cellIndices[1];
         outputIndices.Set(pointOffset, segment);
       }
+      if (shapeType.Id == vtkm::CELL_SHAPE_POLY_LINE)
+      {
+        vtkm::Id3 segment;
+        segment[0] = cellId;
+        const vtkm::IdComponent numPoints = cellIndices.GetNumberOfComponents();
+        for (vtkm::IdComponent i = 0; i < numPoints - 1; ++i)
+        {
+          segment[1] = cellIndices[i];
+          segment[2] = cellIndices[i + 1];
+          outputIndices.Set(pointOffset + i, segment);
+        }
+      }
       if (shapeType.Id == vtkm::CELL_SHAPE_TRIANGLE)
       {
         vtkm::Id3 segment;
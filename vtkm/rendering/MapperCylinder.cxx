@@ -150,9 +150,6 @@ void MapperCylinder::RenderCellsImpl(const vtkm::cont::UnknownCellSet& cellset,
       0.038697244f * vtkm::Pow(vtkm::Float32(min_dist), 4.f) +
       0.002366979f * vtkm::Pow(vtkm::Float32(min_dist), 5.f);
     baseRadius /= min_dist;
-    vtkm::worklet::DispatcherMapField<vtkm::rendering::raytracing::MemSet<vtkm::Float32>>(
-      vtkm::rendering::raytracing::MemSet<vtkm::Float32>(baseRadius))
-      .Invoke(cylExtractor.GetRadii());
   }
 
   if (this->Internals->UseVariableRadius)
@@ -174,7 +171,16 @@ void MapperCylinder::RenderCellsImpl(const vtkm::cont::UnknownCellSet& cellset,
   if (cylExtractor.GetNumberOfCylinders() > 0)
   {
     auto cylIntersector = std::make_shared<raytracing::CylinderIntersector>();
-    cylIntersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetRadii());
+    if (cylExtractor.GetUniformRadius() > 0.f)
+    {
+      // A constant radius is applied when rays hit the cylinders, so lines and polylines are
+      // rendered as tubes without storing any tube geometry.
+      cylIntersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetUniformRadius());
+    }
+    else
+    {
+      cylIntersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetRadii());
+    }
     this->Internals->Tracer.AddShapeIntersector(cylIntersector);
     shapeBounds.Include(cylIntersector->GetShapeBounds());
   }
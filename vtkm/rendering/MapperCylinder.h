@@ -25,6 +25,9 @@ namespace rendering
  * \brief `MapperCylinder` renderers edges from a cell set
  *        and renders them as cylinders via ray tracing.
  *
+ * Lines and polylines are rendered as tubes. With a constant
+ * radius, the radius is applied when rays hit each segment, so
+ * no tube geometry or per segment radius is stored.
  */
 class VTKM_RENDERING_EXPORT MapperCylinder : public Mapper
 {
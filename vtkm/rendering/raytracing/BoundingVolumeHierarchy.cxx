@@ -20,6 +20,7 @@
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/TryExecute.h>
 
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/AtomicArray.h>
 
 #include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
@@ -40,6 +41,19 @@ namespace raytracing
 namespace detail
 {
 
+VTKM_CONT void ComputeExtent(AABBs& aabbs, vtkm::Vec3f_32& minExtent, vtkm::Vec3f_32& maxExtent)
+{
+  minExtent = vtkm::Vec3f_32(vtkm::Infinity32(), vtkm::Infinity32(), vtkm::Infinity32());
+  maxExtent = vtkm::Vec3f_32(
+    vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32());
+  maxExtent[0] = vtkm::cont::Algorithm::Reduce(aabbs.xmaxs, maxExtent[0], MaxValue());
+  maxExtent[1] = vtkm::cont::Algorithm::Reduce(aabbs.ymaxs, maxExtent[1], MaxValue());
+  maxExtent[2] = vtkm::cont::Algorithm::Reduce(aabbs.zmaxs, maxExtent[2], MaxValue());
+  minExtent[0] = vtkm::cont::Algorithm::Reduce(aabbs.xmins, minExtent[0], MinValue());
+  minExtent[1] = vtkm::cont::Algorithm::Reduce(aabbs.ymins, minExtent[1], MinValue());
+  minExtent[2] = vtkm::cont::Algorithm::Reduce(aabbs.zmins, minExtent[2], MinValue());
+}
+
 class LinearBVHBuilder
 {
 public:
@@ -55,6 +69,8 @@ public:
 
   class TreeBuilder;
 
+  class NodeCost;
+
   VTKM_CONT
   LinearBVHBuilder() {}
 
@@ -63,6 +79,12 @@ public:
   VTKM_CONT void BuildHierarchy(BVHData& bvh);
 
   VTKM_CONT void Build(LinearBVH& linearBVH);
+
+  VTKM_CONT void Refit(LinearBVH& linearBVH, AABBs& aabbs);
+
+  VTKM_CONT vtkm::Float32 ComputeCost(LinearBVH& linearBVH);
+
+  VTKM_CONT void PropagateBounds(LinearBVH& linearBVH);
 }; // class LinearBVHBuilder
 
 class LinearBVHBuilder::CountingIterator : public vtkm::worklet::WorkletMapField
@@ -123,6 +145,7 @@ public:
   vtkm::cont::ArrayHandle<vtkm::Id> leftChild;
   vtkm::cont::ArrayHandle<vtkm::Id> rightChild;
   vtkm::cont::ArrayHandle<vtkm::Id> leafs;
+  vtkm::cont::ArrayHandle<vtkm::Id> primitiveOrder;
   vtkm::cont::ArrayHandle<vtkm::Bounds> innerBounds;
   vtkm::cont::ArrayHandleCounting<vtkm::Id> leafOffsets;
   AABBs& AABB;
@@ -474,6 +497,38 @@ public:
   }
 }; // class TreeBuilder
 
+class LinearBVHBuilder::NodeCost : public vtkm::worklet::WorkletMapField
+{
+public:
+  VTKM_CONT
+  NodeCost() {}
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_EXEC
+  static vtkm::Float32 HalfArea(vtkm::Float32 dx, vtkm::Float32 dy, vtkm::Float32 dz)
+  {
+    return dx * dy + dy * dz + dz * dx;
+  }
+
+  template <typename BVHType>
+  VTKM_EXEC void operator()(const vtkm::Id& index,
+                            const BVHType& flatBVH,
+                            vtkm::Float32& cost) const
+  {
+    // each inner node stores the AABBs of both of its children
+    vtkm::Vec4f_32 first4Vec = flatBVH.Get(index * 4);
+    vtkm::Vec4f_32 second4Vec = flatBVH.Get(index * 4 + 1);
+    vtkm::Vec4f_32 third4Vec = flatBVH.Get(index * 4 + 2);
+    cost = HalfArea(first4Vec[3] - first4Vec[0],
+                    second4Vec[0] - first4Vec[1],
+                    second4Vec[1] - first4Vec[2]) +
+      HalfArea(third4Vec[1] - second4Vec[2],
+               third4Vec[2] - second4Vec[3],
+               third4Vec[3] - third4Vec[0]);
+  }
+}; // class NodeCost
+
 VTKM_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
 {
   //create array of indexes to be sorted with morton codes
@@ -548,6 +603,8 @@ VTKM_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
   vtkm::worklet::DispatcherMapField<CreateLeafs> leafDispatcher;
   leafDispatcher.Invoke(iterator, bvh.leafs);
 
+  bvh.primitiveOrder = iterator;
+
 } // method SortAABB
 
 VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
@@ -593,15 +650,9 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
 
 
   // Find the extent of all bounding boxes to generate normalization for morton codes
-  vtkm::Vec3f_32 minExtent(vtkm::Infinity32(), vtkm::Infinity32(), vtkm::Infinity32());
-  vtkm::Vec3f_32 maxExtent(
-    vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32());
-  maxExtent[0] = vtkm::cont::Algorithm::Reduce(bvh.AABB.xmaxs, maxExtent[0], MaxValue());
-  maxExtent[1] = vtkm::cont::Algorithm::Reduce(bvh.AABB.ymaxs, maxExtent[1], MaxValue());
-  maxExtent[2] = vtkm::cont::Algorithm::Reduce(bvh.AABB.zmaxs, maxExtent[2], MaxValue());
-  minExtent[0] = vtkm::cont::Algorithm::Reduce(bvh.AABB.xmins, minExtent[0], MinValue());
-  minExtent[1] = vtkm::cont::Algorithm::Reduce(bvh.AABB.ymins, minExtent[1], MinValue());
-  minExtent[2] = vtkm::cont::Algorithm::Reduce(bvh.AABB.zmins, minExtent[2], MinValue());
+  vtkm::Vec3f_32 minExtent;
+  vtkm::Vec3f_32 maxExtent;
+  ComputeExtent(bvh.AABB, minExtent, maxExtent);
 
   linearBVH.TotalBounds.X.Min = minExtent[0];
   linearBVH.TotalBounds.X.Max = maxExtent[0];
@@ -635,42 +686,107 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
     TreeBuilder(bvh.GetNumberOfPrimitives()));
   treeDispatch.Invoke(bvh.leftChild, bvh.rightChild, bvh.mortonCodes, bvh.parent);
 
-  const vtkm::Int32 primitiveCount = vtkm::Int32(bvh.GetNumberOfPrimitives());
+  linearBVH.PrimitiveOrder = bvh.primitiveOrder;
+  linearBVH.Parents = bvh.parent;
+  linearBVH.LeftChildren = bvh.leftChild;
+  linearBVH.RightChildren = bvh.rightChild;
+
+  PropagateBounds(linearBVH);
+
+  linearBVH.Leafs = bvh.leafs;
+  // Only trees that get refit need their cost, so Refit computes it on first use.
+  linearBVH.BuildCost = -1.f;
+}
+
+VTKM_CONT void LinearBVHBuilder::PropagateBounds(LinearBVH& linearBVH)
+{
+  const vtkm::Id primitiveCount = linearBVH.PrimitiveOrder.GetNumberOfValues();
 
   vtkm::cont::ArrayHandle<vtkm::Int32> counters;
-  counters.Allocate(bvh.GetNumberOfPrimitives() - 1);
+  counters.Allocate(primitiveCount - 1);
 
-  vtkm::cont::ArrayHandleConstant<vtkm::Int32> zero(0, bvh.GetNumberOfPrimitives() - 1);
+  vtkm::cont::ArrayHandleConstant<vtkm::Int32> zero(0, primitiveCount - 1);
   vtkm::cont::Algorithm::Copy(zero, counters);
 
-  vtkm::worklet::DispatcherMapField<PropagateAABBs> propDispatch(PropagateAABBs{ primitiveCount });
-
-  propDispatch.Invoke(bvh.AABB.xmins,
-                      bvh.AABB.ymins,
-                      bvh.AABB.zmins,
-                      bvh.AABB.xmaxs,
-                      bvh.AABB.ymaxs,
-                      bvh.AABB.zmaxs,
-                      bvh.leafOffsets,
-                      bvh.parent,
-                      bvh.leftChild,
-                      bvh.rightChild,
+  vtkm::worklet::DispatcherMapField<PropagateAABBs> propDispatch(
+    PropagateAABBs{ vtkm::Int32(primitiveCount) });
+
+  AABBs& aabbs = linearBVH.GetAABBs();
+  propDispatch.Invoke(aabbs.xmins,
+                      aabbs.ymins,
+                      aabbs.zmins,
+                      aabbs.xmaxs,
+                      aabbs.ymaxs,
+                      aabbs.zmaxs,
+                      vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 2, primitiveCount),
+                      linearBVH.Parents,
+                      linearBVH.LeftChildren,
+                      linearBVH.RightChildren,
                       counters,
                       linearBVH.FlatBVH);
+}
 
-  linearBVH.Leafs = bvh.leafs;
+// Estimates the cost of tracing a ray through the BVH with the surface area heuristic,
+// relative to testing a single box around the whole scene.
+VTKM_CONT vtkm::Float32 LinearBVHBuilder::ComputeCost(LinearBVH& linearBVH)
+{
+  const vtkm::Bounds& total = linearBVH.TotalBounds;
+  vtkm::Float32 totalArea = NodeCost::HalfArea(vtkm::Float32(total.X.Length()),
+                                               vtkm::Float32(total.Y.Length()),
+                                               vtkm::Float32(total.Z.Length()));
+  if (totalArea <= 0.f)
+  {
+    return 0.f;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> nodeCosts;
+  vtkm::worklet::DispatcherMapField<NodeCost> costDispatch;
+  costDispatch.Invoke(vtkm::cont::ArrayHandleCounting<vtkm::Id>(
+                        0, 1, linearBVH.PrimitiveOrder.GetNumberOfValues() - 1),
+                      linearBVH.FlatBVH,
+                      nodeCosts);
+  return vtkm::cont::Algorithm::Reduce(nodeCosts, 0.f) / totalArea;
+}
+
+VTKM_CONT void LinearBVHBuilder::Refit(LinearBVH& linearBVH, AABBs& aabbs)
+{
+  // Gather the moved AABBs into the order of the leaves
+  AABBs sorted;
+  auto gather = [&](const vtkm::cont::ArrayHandle<vtkm::Float32>& in,
+                    vtkm::cont::ArrayHandle<vtkm::Float32>& out) {
+    vtkm::cont::Algorithm::Copy(
+      vtkm::cont::make_ArrayHandlePermutation(linearBVH.PrimitiveOrder, in), out);
+  };
+  gather(aabbs.xmins, sorted.xmins);
+  gather(aabbs.ymins, sorted.ymins);
+  gather(aabbs.zmins, sorted.zmins);
+  gather(aabbs.xmaxs, sorted.xmaxs);
+  gather(aabbs.ymaxs, sorted.ymaxs);
+  gather(aabbs.zmaxs, sorted.zmaxs);
+  linearBVH.AABB = sorted;
+
+  vtkm::Vec3f_32 minExtent;
+  vtkm::Vec3f_32 maxExtent;
+  ComputeExtent(linearBVH.AABB, minExtent, maxExtent);
+  linearBVH.TotalBounds = vtkm::Bounds(minExtent, maxExtent);
+
+  PropagateBounds(linearBVH);
 }
 } //namespace detail
 
 LinearBVH::LinearBVH()
   : IsConstructed(false)
-  , CanConstruct(false){};
+  , CanConstruct(false)
+  , BuildCost(-1.f)
+  , RefitQualityThreshold(2.f){};
 
 VTKM_CONT
 LinearBVH::LinearBVH(AABBs& aabbs)
   : AABB(aabbs)
   , IsConstructed(false)
   , CanConstruct(true)
+  , BuildCost(-1.f)
+  , RefitQualityThreshold(2.f)
 {
 }
 
@@ -679,9 +795,16 @@ LinearBVH::LinearBVH(const LinearBVH& other)
   : AABB(other.AABB)
   , FlatBVH(other.FlatBVH)
   , Leafs(other.Leafs)
+  , TotalBounds(other.TotalBounds)
   , LeafCount(other.LeafCount)
   , IsConstructed(other.IsConstructed)
   , CanConstruct(other.CanConstruct)
+  , PrimitiveOrder(other.PrimitiveOrder)
+  , Parents(other.Parents)
+  , LeftChildren(other.LeftChildren)
+  , RightChildren(other.RightChildren)
+  , BuildCost(other.BuildCost)
+  , RefitQualityThreshold(other.RefitQualityThreshold)
 {
 }
 
@@ -701,6 +824,7 @@ void LinearBVH::Construct()
 
   detail::LinearBVHBuilder builder;
   builder.Build(*this);
+  IsConstructed = true;
 }
 
 VTKM_CONT
@@ -711,6 +835,45 @@ void LinearBVH::SetData(AABBs& aabbs)
   CanConstruct = true;
 }
 
+VTKM_CONT
+bool LinearBVH::Refit(AABBs& aabbs)
+{
+  // Trees built for a single AABB duplicate it, so they are cheaper to just rebuild.
+  vtkm::Id numberOfAABBs = aabbs.xmins.GetNumberOfValues();
+  if (IsConstructed && numberOfAABBs > 1 && numberOfAABBs == PrimitiveOrder.GetNumberOfValues())
+  {
+    detail::LinearBVHBuilder builder;
+    if (BuildCost < 0.f)
+    {
+      // The inner nodes still hold the bounds they were constructed with.
+      BuildCost = builder.ComputeCost(*this);
+    }
+    builder.Refit(*this, aabbs);
+    vtkm::Float32 cost = builder.ComputeCost(*this);
+    if (cost <= RefitQualityThreshold * BuildCost)
+    {
+      return true;
+    }
+    Logger::GetInstance()->AddLogData("bvh_refit_cost", cost);
+  }
+
+  SetData(aabbs);
+  Construct();
+  return false;
+}
+
+VTKM_CONT
+void LinearBVH::SetRefitQualityThreshold(vtkm::Float32 threshold)
+{
+  RefitQualityThreshold = threshold;
+}
+
+VTKM_CONT
+vtkm::Float32 LinearBVH::GetRefitQualityThreshold() const
+{
+  return RefitQualityThreshold;
+}
+
 // explicitly export
 //template VTKM_RENDERING_EXPORT void LinearBVH::ConstructOnDevice<
 //  vtkm::cont::DeviceAdapterTagSerial>(vtkm::cont::DeviceAdapterTagSerial);
@@ -21,6 +21,11 @@ namespace rendering
 namespace raytracing
 {
 
+namespace detail
+{
+class LinearBVHBuilder;
+}
+
 struct AABBs
 {
   vtkm::cont::ArrayHandle<vtkm::Float32> xmins;
@@ -48,6 +53,15 @@ public:
 protected:
   bool IsConstructed;
   bool CanConstruct;
+  // The shape of the tree is kept so that it can be refit when the AABBs move.
+  vtkm::cont::ArrayHandle<vtkm::Id> PrimitiveOrder;
+  vtkm::cont::ArrayHandle<vtkm::Id> Parents;
+  vtkm::cont::ArrayHandle<vtkm::Id> LeftChildren;
+  vtkm::cont::ArrayHandle<vtkm::Id> RightChildren;
+  vtkm::Float32 BuildCost;
+  vtkm::Float32 RefitQualityThreshold;
+
+  friend class detail::LinearBVHBuilder;
 
 public:
   LinearBVH();
@@ -66,6 +80,22 @@ public:
   VTKM_CONT
   void SetData(AABBs& aabbs);
 
+  //
+  // Updates a constructed BVH for AABBs that moved without being added, removed or
+  // reordered. The node bounds are recomputed bottom-up while the shape of the tree is kept.
+  // If the surface area heuristic cost of the refit tree exceeds the refit quality threshold
+  // times the cost of the last construction, the tree is constructed again instead.
+  // Returns true if the tree was refit and false if it was reconstructed.
+  //
+  VTKM_CONT
+  bool Refit(AABBs& aabbs);
+
+  VTKM_CONT
+  void SetRefitQualityThreshold(vtkm::Float32 threshold);
+
+  VTKM_CONT
+  vtkm::Float32 GetRefitQualityThreshold() const;
+
   VTKM_CONT
   AABBs& GetAABBs();
 
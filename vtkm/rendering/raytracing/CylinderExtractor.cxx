@@ -11,6 +11,8 @@
 #include <vtkm/rendering/raytracing/CylinderExtractor.h>
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/rendering/Cylinderizer.h>
 #include <vtkm/rendering/raytracing/Worklets.h>
 #include <vtkm/worklet/DispatcherMapField.h>
@@ -236,11 +238,12 @@ void CylinderExtractor::ExtractCells(const vtkm::cont::UnknownCellSet& cells,
 
 void CylinderExtractor::SetUniformRadius(const vtkm::Float32 radius)
 {
-  const vtkm::Id size = this->CylIds.GetNumberOfValues();
-  Radii.Allocate(size);
-
-  vtkm::cont::ArrayHandleConstant<vtkm::Float32> radiusHandle(radius, size);
-  vtkm::cont::Algorithm::Copy(radiusHandle, Radii);
+  if (!(radius > 0.f))
+  {
+    throw vtkm::cont::ErrorBadValue("Cylinder Extractor: radius must be positive");
+  }
+  this->UniformRadius = radius;
+  this->Radii.ReleaseResources();
 }
 
 void CylinderExtractor::SetCylinderIdsFromCells(const vtkm::cont::UnknownCellSet& cells)
@@ -285,6 +288,7 @@ void CylinderExtractor::SetVaryingRadius(const vtkm::Float32 minRadius,
 
   vtkm::Range range = rangeArray.ReadPortal().Get(0);
 
+  this->UniformRadius = -1.f;
   Radii.Allocate(this->CylIds.GetNumberOfValues());
   vtkm::worklet::DispatcherMapField<detail::FieldRadius>(
     detail::FieldRadius(minRadius, maxRadius, range))
@@ -299,9 +303,20 @@ vtkm::cont::ArrayHandle<vtkm::Id3> CylinderExtractor::GetCylIds()
 
 vtkm::cont::ArrayHandle<vtkm::Float32> CylinderExtractor::GetRadii()
 {
+  if (this->UniformRadius > 0.f && this->Radii.GetNumberOfValues() != this->GetNumberOfCylinders())
+  {
+    vtkm::cont::ArrayHandleConstant<vtkm::Float32> radiusHandle(this->UniformRadius,
+                                                                this->GetNumberOfCylinders());
+    vtkm::cont::Algorithm::Copy(radiusHandle, this->Radii);
+  }
   return this->Radii;
 }
 
+vtkm::Float32 CylinderExtractor::GetUniformRadius() const
+{
+  return this->UniformRadius;
+}
+
 vtkm::Id CylinderExtractor::GetNumberOfCylinders() const
 {
   return this->CylIds.GetNumberOfValues();
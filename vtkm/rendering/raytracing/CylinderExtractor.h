@@ -11,6 +11,7 @@
 #define vtk_m_rendering_raytracing_Cylinder_Extractor_h
 
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/rendering/vtkm_rendering_export.h>
 
 namespace vtkm
 {
@@ -24,15 +25,16 @@ namespace raytracing
  *        the edges of a cell set.
  *
  */
-class CylinderExtractor
+class VTKM_RENDERING_EXPORT CylinderExtractor
 {
 protected:
   vtkm::cont::ArrayHandle<vtkm::Id3> CylIds;
   vtkm::cont::ArrayHandle<vtkm::Float32> Radii;
+  vtkm::Float32 UniformRadius = -1.f;
 
 public:
   //
-  // Extract all vertex shapes with constant radius
+  // Extract all vertex shapes with constant radius, which must be positive
   //
   void ExtractCells(const vtkm::cont::UnknownCellSet& cells, vtkm::Float32 radius);
 
@@ -47,7 +49,13 @@ public:
 
   vtkm::cont::ArrayHandle<vtkm::Id3> GetCylIds();
 
+  // Returns one radius per cylinder. For a constant radius the array is only created when it
+  // is asked for.
   vtkm::cont::ArrayHandle<vtkm::Float32> GetRadii();
+
+  // Returns the radius of all cylinders when they were extracted with a constant radius and
+  // a negative value otherwise.
+  vtkm::Float32 GetUniformRadius() const;
   vtkm::Id GetNumberOfCylinders() const;
 
 protected:
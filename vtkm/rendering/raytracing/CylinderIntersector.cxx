@@ -10,6 +10,7 @@
 
 #include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
 #include <vtkm/rendering/raytracing/BVHTraverser.h>
 #include <vtkm/rendering/raytracing/CylinderIntersector.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
@@ -152,14 +153,18 @@ public:
   using FloatPortal = typename FloatHandle::ReadPortalType;
   IdArrayPortal CylIds;
   FloatPortal Radii;
+  // When positive, all cylinders have this radius and Radii is not used.
+  vtkm::Float32 UniformRadius;
 
   CylinderLeafIntersector() {}
 
   CylinderLeafIntersector(const IdHandle& cylIds,
                           const FloatHandle& radii,
+                          vtkm::Float32 uniformRadius,
                           vtkm::cont::Token& token)
     : CylIds(cylIds.PrepareForInput(Device(), token))
     , Radii(radii.PrepareForInput(Device(), token))
+    , UniformRadius(uniformRadius)
   {
   }
 
@@ -274,7 +279,7 @@ public:
       if (cylIndex < CylIds.GetNumberOfValues())
       {
         vtkm::Id3 pointIndex = CylIds.Get(cylIndex);
-        vtkm::Float32 radius = Radii.Get(cylIndex);
+        vtkm::Float32 radius = (UniformRadius > 0.f) ? UniformRadius : Radii.Get(cylIndex);
         vtkm::Vec<Precision, 3> bottom, top;
         bottom = vtkm::Vec<Precision, 3>(points.Get(pointIndex[1]));
         top = vtkm::Vec<Precision, 3>(points.Get(pointIndex[2]));
@@ -302,11 +307,13 @@ protected:
   using FloatHandle = vtkm::cont::ArrayHandle<vtkm::Float32>;
   IdHandle CylIds;
   FloatHandle Radii;
+  vtkm::Float32 UniformRadius;
 
 public:
-  CylinderLeafWrapper(IdHandle& cylIds, FloatHandle radii)
+  CylinderLeafWrapper(IdHandle& cylIds, FloatHandle radii, vtkm::Float32 uniformRadius)
     : CylIds(cylIds)
     , Radii(radii)
+    , UniformRadius(uniformRadius)
   {
   }
 
@@ -314,7 +321,8 @@ public:
   VTKM_CONT CylinderLeafIntersector<Device> PrepareForExecution(Device,
                                                                 vtkm::cont::Token& token) const
   {
-    return CylinderLeafIntersector<Device>(this->CylIds, this->Radii, token);
+    return CylinderLeafIntersector<Device>(
+      this->CylIds, this->Radii, this->UniformRadius, token);
   }
 };
 
@@ -418,6 +426,7 @@ public:
 
 CylinderIntersector::CylinderIntersector()
   : ShapeIntersector()
+  , UniformRadius(-1.f)
 {
 }
 
@@ -428,13 +437,36 @@ void CylinderIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
                                   vtkm::cont::ArrayHandle<vtkm::Float32> radii)
 {
   this->Radii = radii;
+  this->UniformRadius = -1.f;
   this->CylIds = cylIds;
   this->CoordsHandle = coords;
+  this->BuildAABBs(this->Radii);
+}
+
+void CylinderIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
+                                  vtkm::cont::ArrayHandle<vtkm::Id3> cylIds,
+                                  vtkm::Float32 radius)
+{
+  if (!(radius > 0.f))
+  {
+    throw vtkm::cont::ErrorBadValue("CylinderIntersector: radius must be positive");
+  }
+  this->Radii.ReleaseResources();
+  this->UniformRadius = radius;
+  this->CylIds = cylIds;
+  this->CoordsHandle = coords;
+  this->BuildAABBs(
+    vtkm::cont::make_ArrayHandleConstant(radius, this->CylIds.GetNumberOfValues()));
+}
+
+template <typename RadiiArrayType>
+void CylinderIntersector::BuildAABBs(const RadiiArrayType& radii)
+{
   AABBs AABB;
 
   vtkm::worklet::DispatcherMapField<detail::FindCylinderAABBs>(detail::FindCylinderAABBs())
     .Invoke(this->CylIds,
-            this->Radii,
+            radii,
             AABB.xmins,
             AABB.ymins,
             AABB.zmins,
@@ -460,7 +492,7 @@ template <typename Precision>
 void CylinderIntersector::IntersectRaysImp(Ray<Precision>& rays, bool vtkmNotUsed(returnCellIndex))
 {
 
-  detail::CylinderLeafWrapper leafIntersector(this->CylIds, Radii);
+  detail::CylinderLeafWrapper leafIntersector(this->CylIds, this->Radii, this->UniformRadius);
 
   BVHTraverser traverser;
   traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
@@ -27,6 +27,10 @@ class CylinderIntersector : public ShapeIntersector
 protected:
   vtkm::cont::ArrayHandle<vtkm::Id3> CylIds;
   vtkm::cont::ArrayHandle<vtkm::Float32> Radii;
+  vtkm::Float32 UniformRadius;
+
+  template <typename RadiiArrayType>
+  void BuildAABBs(const RadiiArrayType& radii);
 
 public:
   CylinderIntersector();
@@ -37,6 +41,12 @@ public:
                vtkm::cont::ArrayHandle<vtkm::Id3> cylIds,
                vtkm::cont::ArrayHandle<vtkm::Float32> radii);
 
+  // All cylinders have the same radius. The radius is used directly when intersecting rays,
+  // so no array of radii is stored.
+  void SetData(const vtkm::cont::CoordinateSystem& coords,
+               vtkm::cont::ArrayHandle<vtkm::Id3> cylIds,
+               vtkm::Float32 radius);
+
   void IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex = false) override;
 
 
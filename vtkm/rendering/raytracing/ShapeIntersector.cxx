@@ -93,6 +93,12 @@ void ShapeIntersector::SetAABBs(AABBs& aabbs)
   this->BVH.Construct();
   this->ShapeBounds = this->BVH.TotalBounds;
 }
+
+void ShapeIntersector::RefitAABBs(AABBs& aabbs)
+{
+  this->BVH.Refit(aabbs);
+  this->ShapeBounds = this->BVH.TotalBounds;
+}
 }
 }
 } //namespace vtkm::rendering::raytracing
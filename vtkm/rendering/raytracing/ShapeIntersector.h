@@ -28,6 +28,7 @@ protected:
   vtkm::cont::CoordinateSystem CoordsHandle;
   vtkm::Bounds ShapeBounds;
   void SetAABBs(AABBs& aabbs);
+  void RefitAABBs(AABBs& aabbs);
 
 public:
   ShapeIntersector();
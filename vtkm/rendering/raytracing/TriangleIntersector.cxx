@@ -492,6 +492,24 @@ void TriangleIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
   this->SetAABBs(AABB);
 }
 
+void TriangleIntersector::UpdateCoordinates(const vtkm::cont::CoordinateSystem& coords)
+{
+  CoordsHandle = coords;
+
+  vtkm::rendering::raytracing::AABBs AABB;
+  vtkm::worklet::DispatcherMapField<detail::FindTriangleAABBs>(detail::FindTriangleAABBs())
+    .Invoke(Triangles,
+            AABB.xmins,
+            AABB.ymins,
+            AABB.zmins,
+            AABB.xmaxs,
+            AABB.ymaxs,
+            AABB.zmaxs,
+            CoordsHandle);
+
+  this->RefitAABBs(AABB);
+}
+
 vtkm::cont::ArrayHandle<vtkm::Id4> TriangleIntersector::GetTriangles()
 {
   return Triangles;
@@ -36,6 +36,11 @@ public:
   void SetData(const vtkm::cont::CoordinateSystem& coords,
                vtkm::cont::ArrayHandle<vtkm::Id4> triangles);
 
+  // Moves the vertices of the triangles without changing the triangles themselves. The BVH
+  // is refit to the new positions rather than being rebuilt, unless its quality degrades
+  // too much.
+  void UpdateCoordinates(const vtkm::cont::CoordinateSystem& coords);
+
   vtkm::cont::ArrayHandle<vtkm::Id4> GetTriangles();
   vtkm::Id GetNumberOfShapes() const override;
 
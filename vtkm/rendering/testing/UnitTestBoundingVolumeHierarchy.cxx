@@ -0,0 +1,162 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using vtkm::rendering::raytracing::AABBs;
+using vtkm::rendering::raytracing::LinearBVH;
+
+constexpr vtkm::Id NumberOfBoxes = 256;
+
+// Unit boxes spread along the x axis, with box i at the position of slot[i].
+AABBs MakeBoxes(const std::vector<vtkm::Id>& slot, const vtkm::Vec3f_32& offset)
+{
+  std::vector<vtkm::Float32> xmins, ymins, zmins, xmaxs, ymaxs, zmaxs;
+  for (vtkm::Id i = 0; i < NumberOfBoxes; ++i)
+  {
+    vtkm::Float32 x = 2.f * static_cast<vtkm::Float32>(slot[static_cast<std::size_t>(i)]);
+    xmins.push_back(x + offset[0]);
+    ymins.push_back(offset[1]);
+    zmins.push_back(offset[2]);
+    xmaxs.push_back(x + 1.f + offset[0]);
+    ymaxs.push_back(1.f + offset[1]);
+    zmaxs.push_back(1.f + offset[2]);
+  }
+  AABBs aabbs;
+  aabbs.xmins = vtkm::cont::make_ArrayHandle(xmins, vtkm::CopyFlag::On);
+  aabbs.ymins = vtkm::cont::make_ArrayHandle(ymins, vtkm::CopyFlag::On);
+  aabbs.zmins = vtkm::cont::make_ArrayHandle(zmins, vtkm::CopyFlag::On);
+  aabbs.xmaxs = vtkm::cont::make_ArrayHandle(xmaxs, vtkm::CopyFlag::On);
+  aabbs.ymaxs = vtkm::cont::make_ArrayHandle(ymaxs, vtkm::CopyFlag::On);
+  aabbs.zmaxs = vtkm::cont::make_ArrayHandle(zmaxs, vtkm::CopyFlag::On);
+  return aabbs;
+}
+
+struct TreeChecker
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32>::ReadPortalType Nodes;
+  vtkm::cont::ArrayHandle<vtkm::Id>::ReadPortalType Leafs;
+  vtkm::cont::ArrayHandle<vtkm::Float32>::ReadPortalType XMin, YMin, ZMin, XMax, YMax, ZMax;
+  std::vector<bool> Seen;
+
+  // Returns the bounds of the boxes under a child link and checks that every inner node
+  // stores exactly the bounds of its two subtrees.
+  vtkm::Bounds Visit(vtkm::Int32 link)
+  {
+    if (link < 0)
+    {
+      vtkm::Id leaf = -(link + 1);
+      VTKM_TEST_ASSERT(this->Leafs.Get(leaf) == 1, "Leaves should hold a single box");
+      vtkm::Id box = this->Leafs.Get(leaf + 1);
+      VTKM_TEST_ASSERT(!this->Seen[static_cast<std::size_t>(box)], "Box reached twice");
+      this->Seen[static_cast<std::size_t>(box)] = true;
+      return vtkm::Bounds(this->XMin.Get(box),
+                          this->XMax.Get(box),
+                          this->YMin.Get(box),
+                          this->YMax.Get(box),
+                          this->ZMin.Get(box),
+                          this->ZMax.Get(box));
+    }
+
+    vtkm::Vec4f_32 first = this->Nodes.Get(link);
+    vtkm::Vec4f_32 second = this->Nodes.Get(link + 1);
+    vtkm::Vec4f_32 third = this->Nodes.Get(link + 2);
+    vtkm::Vec4f_32 fourth = this->Nodes.Get(link + 3);
+    vtkm::Int32 children[2];
+    std::memcpy(&children[0], &fourth[0], 4);
+    std::memcpy(&children[1], &fourth[1], 4);
+
+    vtkm::Bounds left = this->Visit(children[0]);
+    vtkm::Bounds right = this->Visit(children[1]);
+    VTKM_TEST_ASSERT(
+      test_equal(left,
+                 vtkm::Bounds(first[0], first[3], first[1], second[0], first[2], second[1])),
+      "Wrong left child bounds");
+    VTKM_TEST_ASSERT(
+      test_equal(right,
+                 vtkm::Bounds(second[2], third[1], second[3], third[2], third[0], third[3])),
+      "Wrong right child bounds");
+    return left + right;
+  }
+};
+
+void CheckTree(LinearBVH& bvh, const AABBs& aabbs)
+{
+  VTKM_TEST_ASSERT(bvh.GetIsConstructed(), "BVH should be constructed");
+  TreeChecker checker{ bvh.FlatBVH.ReadPortal(),   bvh.Leafs.ReadPortal(),
+                       aabbs.xmins.ReadPortal(),   aabbs.ymins.ReadPortal(),
+                       aabbs.zmins.ReadPortal(),   aabbs.xmaxs.ReadPortal(),
+                       aabbs.ymaxs.ReadPortal(),   aabbs.zmaxs.ReadPortal(),
+                       std::vector<bool>(static_cast<std::size_t>(NumberOfBoxes), false) };
+  vtkm::Bounds bounds = checker.Visit(0);
+  VTKM_TEST_ASSERT(std::all_of(checker.Seen.begin(), checker.Seen.end(), [](bool b) { return b; }),
+                   "Not every box is in the tree");
+  VTKM_TEST_ASSERT(test_equal(bounds, bvh.TotalBounds), "Wrong total bounds");
+}
+
+void TestRefit()
+{
+  std::cout << "Testing LinearBVH::Refit" << std::endl;
+
+  std::vector<vtkm::Id> slots(static_cast<std::size_t>(NumberOfBoxes));
+  std::iota(slots.begin(), slots.end(), vtkm::Id(0));
+
+  AABBs initial = MakeBoxes(slots, vtkm::Vec3f_32(0.f));
+  LinearBVH bvh(initial);
+  bvh.Construct();
+  CheckTree(bvh, MakeBoxes(slots, vtkm::Vec3f_32(0.f)));
+
+  // Moving every box by the same amount keeps the quality of the tree.
+  AABBs moved = MakeBoxes(slots, vtkm::Vec3f_32(10.f, -5.f, 3.f));
+  VTKM_TEST_ASSERT(bvh.Refit(moved), "Translated boxes should be refit");
+  CheckTree(bvh, MakeBoxes(slots, vtkm::Vec3f_32(10.f, -5.f, 3.f)));
+  VTKM_TEST_ASSERT(test_equal(bvh.TotalBounds, vtkm::Bounds(10, 521, -5, -4, 3, 4)),
+                   "Wrong bounds after refit");
+
+  // Shuffling the boxes leaves every inner node spanning the whole scene, so the tree
+  // gets rebuilt.
+  std::shuffle(slots.begin(), slots.end(), std::mt19937(42));
+  AABBs shuffled = MakeBoxes(slots, vtkm::Vec3f_32(0.f));
+  VTKM_TEST_ASSERT(!bvh.Refit(shuffled), "Shuffled boxes should trigger a rebuild");
+  CheckTree(bvh, MakeBoxes(slots, vtkm::Vec3f_32(0.f)));
+
+  // The rebuilt tree serves as the reference for the following refits.
+  AABBs shifted = MakeBoxes(slots, vtkm::Vec3f_32(0.f, 1.f, 0.f));
+  VTKM_TEST_ASSERT(bvh.Refit(shifted), "The rebuilt tree should be refit");
+  CheckTree(bvh, MakeBoxes(slots, vtkm::Vec3f_32(0.f, 1.f, 0.f)));
+
+  // A threshold below one rebuilds even when nothing degraded.
+  bvh.SetRefitQualityThreshold(0.5f);
+  AABBs same = MakeBoxes(slots, vtkm::Vec3f_32(0.f, 1.f, 0.f));
+  VTKM_TEST_ASSERT(!bvh.Refit(same), "A low threshold should trigger a rebuild");
+  CheckTree(bvh, MakeBoxes(slots, vtkm::Vec3f_32(0.f, 1.f, 0.f)));
+}
+
+void TestBoundingVolumeHierarchy()
+{
+  TestRefit();
+}
+
+} // anonymous namespace
+
+int UnitTestBoundingVolumeHierarchy(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestBoundingVolumeHierarchy, argc, argv);
+}
@@ -0,0 +1,104 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/Math.h>
+#include <vtkm/cont/DataSetBuilderExplicit.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/raytracing/CylinderExtractor.h>
+
+#include <vector>
+
+namespace
+{
+
+// A polyline through points 0 to 3 followed by a line from point 3 to point 4.
+vtkm::cont::DataSet MakePolyLineDataSet()
+{
+  std::vector<vtkm::Vec3f> coordinates;
+  for (vtkm::Id index = 0; index < 5; ++index)
+  {
+    coordinates.push_back(vtkm::Vec3f(static_cast<vtkm::FloatDefault>(index), 0, 0));
+  }
+  std::vector<vtkm::UInt8> shapes = { vtkm::CELL_SHAPE_POLY_LINE, vtkm::CELL_SHAPE_LINE };
+  std::vector<vtkm::IdComponent> numIndices = { 4, 2 };
+  std::vector<vtkm::Id> connectivity = { 0, 1, 2, 3, 3, 4 };
+  vtkm::cont::DataSet dataSet =
+    vtkm::cont::DataSetBuilderExplicit::Create(coordinates, shapes, numIndices, connectivity);
+  dataSet.AddCellField("cellvar", std::vector<vtkm::Float32>{ 1.f, 2.f });
+  return dataSet;
+}
+
+void TestPolyLine()
+{
+  std::cout << "Testing CylinderExtractor with polylines" << std::endl;
+  vtkm::cont::DataSet dataSet = MakePolyLineDataSet();
+
+  vtkm::rendering::raytracing::CylinderExtractor extractor;
+  extractor.ExtractCells(dataSet.GetCellSet(), 0.5f);
+  VTKM_TEST_ASSERT(extractor.GetNumberOfCylinders() == 4, "Wrong number of cylinders");
+  // Each cylinder holds its cell and the two points of its segment.
+  auto expectedIds =
+    vtkm::cont::make_ArrayHandle<vtkm::Id3>({ { 0, 0, 1 }, { 0, 1, 2 }, { 0, 2, 3 }, { 1, 3, 4 } });
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(extractor.GetCylIds(), expectedIds),
+                   "Wrong cylinder ids");
+
+  // A constant radius is kept as is, and only expanded to one radius per cylinder on demand.
+  VTKM_TEST_ASSERT(test_equal(extractor.GetUniformRadius(), 0.5f), "Wrong uniform radius");
+  VTKM_TEST_ASSERT(
+    test_equal_ArrayHandles(extractor.GetRadii(),
+                            vtkm::cont::make_ArrayHandle<vtkm::Float32>({ .5f, .5f, .5f, .5f })),
+    "Wrong radii");
+
+  // Radii varying with a field are stored for each cylinder.
+  extractor.ExtractCells(dataSet.GetCellSet(), dataSet.GetField("cellvar"), 1.f, 3.f);
+  VTKM_TEST_ASSERT(extractor.GetNumberOfCylinders() == 4, "Wrong number of cylinders");
+  VTKM_TEST_ASSERT(extractor.GetUniformRadius() < 0.f, "Radius should not be uniform");
+  VTKM_TEST_ASSERT(
+    test_equal_ArrayHandles(extractor.GetRadii(),
+                            vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 1.f, 1.f, 1.f, 3.f })),
+    "Wrong varying radii");
+}
+
+void TestNonPositiveRadius()
+{
+  std::cout << "Testing CylinderExtractor with a non-positive or NaN radius" << std::endl;
+  vtkm::cont::DataSet dataSet = MakePolyLineDataSet();
+
+  // Turn off floating point exceptions. This is only for conditions that allow NaNs.
+  vtkm::testing::FloatingPointExceptionTrapDisable();
+  for (vtkm::Float32 radius : { 0.f, -1.f, vtkm::Nan32() })
+  {
+    vtkm::rendering::raytracing::CylinderExtractor extractor;
+    bool rejected = false;
+    try
+    {
+      extractor.ExtractCells(dataSet.GetCellSet(), radius);
+    }
+    catch (const vtkm::cont::ErrorBadValue&)
+    {
+      rejected = true;
+    }
+    VTKM_TEST_ASSERT(rejected, "A non-positive or NaN radius should be rejected");
+  }
+}
+
+void TestCylinderExtractor()
+{
+  TestPolyLine();
+  TestNonPositiveRadius();
+}
+
+} // anonymous namespace
+
+int UnitTestCylinderExtractor(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestCylinderExtractor, argc, argv);
+}
@@ -0,0 +1,409 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_ImplicitFunctionBricks_h
+#define vtk_m_worklet_ImplicitFunctionBricks_h
+
+#include <vtkm/ImplicitFunction.h>
+#include <vtkm/Math.h>
+#include <vtkm/Range.h>
+#include <vtkm/VectorAnalysis.h>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownCellSet.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+namespace detail
+{
+
+// Bounds on the values of an implicit function over an axis-aligned box. The bounds
+// are conservative: every point of the box has a value within them.
+VTKM_EXEC_CONT inline vtkm::Range ImplicitFunctionValueRange(const vtkm::Plane& plane,
+                                                             const vtkm::Vec<vtkm::Range, 3>& box,
+                                                             vtkm::Float64& scale)
+{
+  vtkm::Range range(0.0, 0.0);
+  scale = 0.0;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    const vtkm::Float64 normal = plane.GetNormal()[d];
+    const vtkm::Float64 origin = plane.GetOrigin()[d];
+    const vtkm::Float64 a = normal * (box[d].Min - origin);
+    const vtkm::Float64 b = normal * (box[d].Max - origin);
+    range.Min += vtkm::Min(a, b);
+    range.Max += vtkm::Max(a, b);
+    scale += vtkm::Abs(normal) *
+      (vtkm::Max(vtkm::Abs(box[d].Min), vtkm::Abs(box[d].Max)) + vtkm::Abs(origin));
+  }
+  return range;
+}
+
+VTKM_EXEC_CONT inline vtkm::Range ImplicitFunctionValueRange(const vtkm::Sphere& sphere,
+                                                             const vtkm::Vec<vtkm::Range, 3>& box,
+                                                             vtkm::Float64& scale)
+{
+  vtkm::Float64 nearest = 0.0;
+  vtkm::Float64 farthest = 0.0;
+  vtkm::Float64 magnitude = 0.0;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    const vtkm::Float64 center = sphere.GetCenter()[d];
+    const vtkm::Float64 toMin = box[d].Min - center;
+    const vtkm::Float64 toMax = box[d].Max - center;
+    const vtkm::Float64 gap = vtkm::Max(vtkm::Max(toMin, -toMax), 0.0);
+    const vtkm::Float64 far = vtkm::Max(vtkm::Abs(toMin), vtkm::Abs(toMax));
+    nearest += gap * gap;
+    farthest += far * far;
+    magnitude += vtkm::Abs(center) + vtkm::Max(vtkm::Abs(box[d].Min), vtkm::Abs(box[d].Max));
+  }
+  const vtkm::Float64 radius = sphere.GetRadius();
+  scale = (magnitude * magnitude) + (radius * radius);
+  return vtkm::Range(nearest - (radius * radius), farthest - (radius * radius));
+}
+
+VTKM_EXEC_CONT inline vtkm::Range ImplicitFunctionValueRange(const vtkm::Box& boxFunction,
+                                                             const vtkm::Vec<vtkm::Range, 3>& box,
+                                                             vtkm::Float64& scale)
+{
+  // The value of a box is the negated distance to its closest face inside it and the
+  // distance to it outside of it.
+  bool strictlyInside = true;
+  vtkm::Float64 insideDistance = vtkm::Infinity64();
+  vtkm::Float64 outsideDistance = 0.0;
+  scale = 0.0;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    const vtkm::Float64 minPoint = boxFunction.GetMinPoint()[d];
+    const vtkm::Float64 maxPoint = boxFunction.GetMaxPoint()[d];
+    const vtkm::Float64 toMin = box[d].Min - minPoint;
+    const vtkm::Float64 toMax = maxPoint - box[d].Max;
+    strictlyInside = strictlyInside && (toMin > 0) && (toMax > 0);
+    insideDistance = vtkm::Min(insideDistance, vtkm::Min(toMin, toMax));
+    const vtkm::Float64 gap =
+      vtkm::Max(vtkm::Max(minPoint - box[d].Max, box[d].Min - maxPoint), 0.0);
+    outsideDistance += gap * gap;
+    scale = vtkm::Max(scale,
+                      vtkm::Max(vtkm::Max(vtkm::Abs(box[d].Min), vtkm::Abs(box[d].Max)),
+                                vtkm::Max(vtkm::Abs(minPoint), vtkm::Abs(maxPoint))));
+  }
+  if (strictlyInside)
+  {
+    return vtkm::Range(vtkm::NegativeInfinity64(), -insideDistance);
+  }
+  else if (outsideDistance > 0)
+  {
+    return vtkm::Range(vtkm::Sqrt(outsideDistance), vtkm::Infinity64());
+  }
+  else
+  {
+    return vtkm::Range(vtkm::NegativeInfinity64(), vtkm::Infinity64());
+  }
+}
+
+} // namespace detail
+
+/// \brief Classifies the cells of a structured mesh against an implicit function by bricks.
+///
+/// The cells of a structured mesh with uniform or rectilinear coordinates are split into
+/// bricks of `BrickSize` cells along each axis. For each brick, the range of the implicit
+/// function over the bounds of the points of its cells is computed from the shape of the
+/// function, without evaluating it at any point. A brick whose range lies below the iso value
+/// is `Inside`, one whose range lies above it is `Outside`, and the cells of these bricks can
+/// be accepted or rejected as a whole. Only the cells of the `Crossing` bricks need the
+/// function to be evaluated at their points. `GetCellStates` gives the state of the brick of
+/// each cell in cell order.
+///
+/// The range of the function is only known for `vtkm::Box`, `vtkm::Plane` and
+/// `vtkm::Sphere`.
+///
+class ImplicitFunctionBricks
+{
+public:
+  static constexpr vtkm::Id BrickSize = 16;
+
+  enum BrickState : vtkm::UInt8
+  {
+    Inside = 0,
+    Outside = 1,
+    Crossing = 2
+  };
+
+  template <typename FunctionType>
+  class ClassifyBricks : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn brickIds,
+                                  WholeArrayIn xBounds,
+                                  WholeArrayIn yBounds,
+                                  WholeArrayIn zBounds,
+                                  FieldOut states);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+    VTKM_CONT ClassifyBricks(const FunctionType& function,
+                             const vtkm::Id3& numberOfBricks,
+                             vtkm::Float64 isoValue)
+      : Function(function)
+      , NumberOfBricks(numberOfBricks)
+      , IsoValue(isoValue)
+    {
+    }
+
+    template <typename BoundsPortal>
+    VTKM_EXEC void operator()(vtkm::Id brickId,
+                              const BoundsPortal& xBounds,
+                              const BoundsPortal& yBounds,
+                              const BoundsPortal& zBounds,
+                              vtkm::UInt8& state) const
+    {
+      const vtkm::Id i = brickId % this->NumberOfBricks[0];
+      const vtkm::Id j = (brickId / this->NumberOfBricks[0]) % this->NumberOfBricks[1];
+      const vtkm::Id k = brickId / (this->NumberOfBricks[0] * this->NumberOfBricks[1]);
+      const vtkm::Vec<vtkm::Range, 3> box(xBounds.Get(i), yBounds.Get(j), zBounds.Get(k));
+
+      vtkm::Float64 scale;
+      const vtkm::Range range = detail::ImplicitFunctionValueRange(this->Function, box, scale);
+
+      // Widen the range to cover the rounding of the coordinates and of the function.
+      const vtkm::Float64 tolerance = 16.0 * vtkm::Epsilon<vtkm::Float32>() * (1.0 + scale);
+      if (range.Max + tolerance < this->IsoValue)
+      {
+        state = Inside;
+      }
+      else if (range.Min - tolerance > this->IsoValue)
+      {
+        state = Outside;
+      }
+      else
+      {
+        state = Crossing;
+      }
+    }
+
+  private:
+    FunctionType Function;
+    vtkm::Id3 NumberOfBricks;
+    vtkm::Float64 IsoValue;
+  };
+
+  /// Maps the id of a cell to the id of its brick.
+  struct CellBrickId
+  {
+    vtkm::Id3 CellDimensions;
+    vtkm::Id3 NumberOfBricks;
+
+    VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id cellId) const
+    {
+      const vtkm::Id i = cellId % this->CellDimensions[0];
+      const vtkm::Id j = (cellId / this->CellDimensions[0]) % this->CellDimensions[1];
+      const vtkm::Id k = cellId / (this->CellDimensions[0] * this->CellDimensions[1]);
+      return (i / BrickSize) +
+        this->NumberOfBricks[0] * ((j / BrickSize) + this->NumberOfBricks[1] * (k / BrickSize));
+    }
+  };
+
+  using CellStatesArrayHandle = vtkm::cont::ArrayHandlePermutation<
+    vtkm::cont::ArrayHandleTransform<vtkm::cont::ArrayHandleIndex, CellBrickId>,
+    vtkm::cont::ArrayHandle<vtkm::UInt8>>;
+
+  /// Classify the cell bricks of `cellSet` against `isoValue`. Returns false without
+  /// classifying anything when the cell set is not a 2D or 3D structured cell set, the
+  /// coordinates are not uniform or rectilinear, or the range of the function is not known.
+  VTKM_CONT bool Run(const vtkm::cont::UnknownCellSet& cellSet,
+                     const vtkm::ImplicitFunctionGeneral& function,
+                     vtkm::Float64 isoValue,
+                     const vtkm::cont::CoordinateSystem& coords)
+  {
+    vtkm::Id3 pointDims(1, 1, 1);
+    if (cellSet.CanConvert<vtkm::cont::CellSetStructured<3>>())
+    {
+      pointDims = cellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+    }
+    else if (cellSet.CanConvert<vtkm::cont::CellSetStructured<2>>())
+    {
+      vtkm::Id2 dims = cellSet.AsCellSet<vtkm::cont::CellSetStructured<2>>().GetPointDimensions();
+      pointDims = vtkm::Id3(dims[0], dims[1], 1);
+    }
+    else
+    {
+      return false;
+    }
+
+    if (!function.IsType<vtkm::Box>() && !function.IsType<vtkm::Plane>() &&
+        !function.IsType<vtkm::Sphere>())
+    {
+      return false;
+    }
+
+    // The bounds of the points of each brick of cells along each axis.
+    vtkm::Vec<std::vector<vtkm::Range>, 3> axisBounds;
+    using UniformCoordinatesArrayHandle = vtkm::cont::ArrayHandleUniformPointCoordinates;
+    using RectilinearCoordinatesArrayHandle =
+      vtkm::cont::ArrayHandleCartesianProduct<vtkm::cont::ArrayHandle<vtkm::FloatDefault>,
+                                              vtkm::cont::ArrayHandle<vtkm::FloatDefault>,
+                                              vtkm::cont::ArrayHandle<vtkm::FloatDefault>>;
+    if (coords.GetData().CanConvert<UniformCoordinatesArrayHandle>())
+    {
+      auto uniform = coords.GetData().AsArrayHandle<UniformCoordinatesArrayHandle>();
+      const vtkm::Vec3f origin = uniform.GetOrigin();
+      const vtkm::Vec3f spacing = uniform.GetSpacing();
+      for (vtkm::IdComponent d = 0; d < 3; ++d)
+      {
+        this->ComputeAxisBounds(
+          pointDims[d],
+          [&](vtkm::Id index) {
+            return static_cast<vtkm::Float64>(origin[d]) +
+              static_cast<vtkm::Float64>(spacing[d]) * static_cast<vtkm::Float64>(index);
+          },
+          axisBounds[d]);
+      }
+    }
+    else if (coords.GetData().CanConvert<RectilinearCoordinatesArrayHandle>())
+    {
+      auto rectilinear = coords.GetData().AsArrayHandle<RectilinearCoordinatesArrayHandle>();
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> axes[3] = { rectilinear.GetFirstArray(),
+                                                              rectilinear.GetSecondArray(),
+                                                              rectilinear.GetThirdArray() };
+      for (vtkm::IdComponent d = 0; d < 3; ++d)
+      {
+        auto portal = axes[d].ReadPortal();
+        this->ComputeAxisBounds(
+          pointDims[d],
+          [&](vtkm::Id index) { return static_cast<vtkm::Float64>(portal.Get(index)); },
+          axisBounds[d]);
+      }
+    }
+    else
+    {
+      return false;
+    }
+
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      this->CellDimensions[d] = vtkm::Max(pointDims[d] - 1, vtkm::Id(1));
+      this->NumberOfBricks[d] = static_cast<vtkm::Id>(axisBounds[d].size());
+    }
+
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandleIndex brickIds(this->GetNumberOfBricks());
+    auto xBounds = vtkm::cont::make_ArrayHandle(axisBounds[0], vtkm::CopyFlag::Off);
+    auto yBounds = vtkm::cont::make_ArrayHandle(axisBounds[1], vtkm::CopyFlag::Off);
+    auto zBounds = vtkm::cont::make_ArrayHandle(axisBounds[2], vtkm::CopyFlag::Off);
+    if (function.IsType<vtkm::Box>())
+    {
+      invoke(ClassifyBricks<vtkm::Box>(function.Get<vtkm::Box>(), this->NumberOfBricks, isoValue),
+             brickIds,
+             xBounds,
+             yBounds,
+             zBounds,
+             this->BrickStates);
+    }
+    else if (function.IsType<vtkm::Plane>())
+    {
+      invoke(
+        ClassifyBricks<vtkm::Plane>(function.Get<vtkm::Plane>(), this->NumberOfBricks, isoValue),
+        brickIds,
+        xBounds,
+        yBounds,
+        zBounds,
+        this->BrickStates);
+    }
+    else
+    {
+      invoke(
+        ClassifyBricks<vtkm::Sphere>(function.Get<vtkm::Sphere>(), this->NumberOfBricks, isoValue),
+        brickIds,
+        xBounds,
+        yBounds,
+        zBounds,
+        this->BrickStates);
+    }
+    return true;
+  }
+
+  /// The `BrickState` of the brick of each cell after the last run, in cell order.
+  VTKM_CONT CellStatesArrayHandle GetCellStates() const
+  {
+    const vtkm::Id numCells =
+      this->CellDimensions[0] * this->CellDimensions[1] * this->CellDimensions[2];
+    const CellBrickId cellBrickId{ this->CellDimensions, this->NumberOfBricks };
+    return vtkm::cont::make_ArrayHandlePermutation(
+      vtkm::cont::make_ArrayHandleTransform(vtkm::cont::ArrayHandleIndex(numCells), cellBrickId),
+      this->BrickStates);
+  }
+
+  /// Number of bricks of the last run.
+  VTKM_CONT vtkm::Id GetNumberOfBricks() const
+  {
+    return this->NumberOfBricks[0] * this->NumberOfBricks[1] * this->NumberOfBricks[2];
+  }
+
+  /// Number of bricks of the last run in `state`.
+  VTKM_CONT vtkm::Id GetNumberOfBricks(BrickState state) const
+  {
+    return vtkm::cont::Algorithm::Reduce(
+      vtkm::cont::make_ArrayHandleTransform(this->BrickStates, IsState{ state }), vtkm::Id(0));
+  }
+
+private:
+  struct IsState
+  {
+    vtkm::UInt8 State;
+
+    VTKM_EXEC_CONT vtkm::Id operator()(vtkm::UInt8 state) const
+    {
+      return (state == this->State) ? 1 : 0;
+    }
+  };
+
+  // The bounds along one axis of the points used by each brick of cells. A mesh that is
+  // flat along the axis has a single brick holding its only point.
+  template <typename CoordinateFunctor>
+  VTKM_CONT static void ComputeAxisBounds(vtkm::Id numPoints,
+                                          const CoordinateFunctor& coordinate,
+                                          std::vector<vtkm::Range>& bounds)
+  {
+    const vtkm::Id numCells = vtkm::Max(numPoints - 1, vtkm::Id(1));
+    const vtkm::Id numBricks = (numCells + BrickSize - 1) / BrickSize;
+    bounds.resize(static_cast<std::size_t>(numBricks));
+    for (vtkm::Id brick = 0; brick < numBricks; ++brick)
+    {
+      const vtkm::Id first = brick * BrickSize;
+      const vtkm::Id last = vtkm::Min((brick + 1) * BrickSize, numPoints - 1);
+      const vtkm::Float64 a = coordinate(first);
+      const vtkm::Float64 b = coordinate(last);
+      bounds[static_cast<std::size_t>(brick)] = vtkm::Range(vtkm::Min(a, b), vtkm::Max(a, b));
+    }
+  }
+
+  vtkm::Id3 CellDimensions{ 0, 0, 0 };
+  vtkm::Id3 NumberOfBricks{ 0, 0, 0 };
+  vtkm::cont::ArrayHandle<vtkm::UInt8> BrickStates;
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_ImplicitFunctionBricks_h
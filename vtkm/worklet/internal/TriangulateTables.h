@@ -143,6 +143,17 @@ public:
       this->Counts, this->Offsets, this->Indices, device, token);
   }
 
+  /// Returns the number of triangles a cell of the given shape and number of points is split
+  /// into. This can be used in the control environment to size the output in advance.
+  VTKM_CONT static vtkm::IdComponent GetCount(vtkm::UInt8 shape, vtkm::IdComponent numPoints)
+  {
+    if (shape == vtkm::CELL_SHAPE_POLYGON)
+    {
+      return numPoints - 2;
+    }
+    return (shape < vtkm::NUMBER_OF_CELL_SHAPES) ? TriangleCountData[shape] : 0;
+  }
+
   VTKM_CONT
   TriangulateTables()
     : Counts(vtkm::cont::make_ArrayHandle(vtkm::worklet::internal::TriangleCountData,
@@ -299,6 +310,13 @@ private:
 class TetrahedralizeTables : public vtkm::cont::ExecutionObjectBase
 {
 public:
+  /// Returns the number of tetrahedra a cell of the given shape is split into. This can be
+  /// used in the control environment to size the output in advance.
+  VTKM_CONT static vtkm::IdComponent GetCount(vtkm::UInt8 shape)
+  {
+    return (shape < vtkm::NUMBER_OF_CELL_SHAPES) ? TetrahedronCountData[shape] : 0;
+  }
+
   VTKM_CONT
   TetrahedralizeTables()
     : Counts(vtkm::cont::make_ArrayHandle(vtkm::worklet::internal::TetrahedronCountData,
@@ -585,6 +585,337 @@ struct Invert
   vtkm::Id operator()(const vtkm::Id& value) const { return 1 - value; }
 }; // struct Invert
 
+VTKM_EXEC_CONT
+inline vtkm::FloatDefault HalfSurfaceArea(const vtkm::Bounds& bounds)
+{
+  if (!bounds.IsNonEmpty())
+  {
+    return 0;
+  }
+  vtkm::Float64 dx = bounds.X.Length();
+  vtkm::Float64 dy = bounds.Y.Length();
+  vtkm::Float64 dz = bounds.Z.Length();
+  return static_cast<vtkm::FloatDefault>(dx * dy + dy * dz + dz * dx);
+}
+
+// Index of the bin that a cell center falls into when the range of centers in its segment is
+// divided into numBins equal bins.
+VTKM_EXEC_CONT
+inline vtkm::Id CenterBin(vtkm::FloatDefault center, const vtkm::Range& range, vtkm::Id numBins)
+{
+  vtkm::Float64 length = range.Length();
+  if (!(length > 0))
+  {
+    return 0;
+  }
+  vtkm::Float64 bin = static_cast<vtkm::Float64>(numBins) * (center - range.Min) / length;
+  return vtkm::Max(vtkm::Id(0), vtkm::Min(static_cast<vtkm::Id>(bin), numBins - 1));
+}
+
+struct BinnedSplit
+{
+  vtkm::FloatDefault Cost;
+  vtkm::FloatDefault LMax;
+  vtkm::FloatDefault RMin;
+  vtkm::Id Bin;
+
+  VTKM_EXEC_CONT
+  BinnedSplit()
+    : Cost(vtkm::Infinity<vtkm::FloatDefault>())
+    , LMax()
+    , RMin()
+    , Bin(-1)
+  {
+  }
+}; // struct BinnedSplit
+
+struct CenterRangeCalculator : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2);
+  using InputDomain = _1;
+
+  VTKM_EXEC
+  void operator()(const vtkm::FloatDefault& center, vtkm::Range& range) const
+  {
+    range = vtkm::Range(center, center);
+  }
+}; // struct CenterRangeCalculator
+
+struct CellBoundsCombiner : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+  using InputDomain = _1;
+
+  VTKM_EXEC
+  void operator()(const vtkm::Range& rangeX,
+                  const vtkm::Range& rangeY,
+                  const vtkm::Range& rangeZ,
+                  vtkm::Bounds& bounds) const
+  {
+    bounds = vtkm::Bounds(rangeX, rangeY, rangeZ);
+  }
+}; // struct CellBoundsCombiner
+
+// Computes a key that groups the cells by segment and, within a segment, by bin, and counts
+// the cells of every key.
+struct BinKeyCalculator : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldIn, FieldOut, AtomicArrayInOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  BinKeyCalculator(vtkm::IdComponent numBins)
+    : NumBins(numBins)
+  {
+  }
+
+  template <typename CountsPortal>
+  VTKM_EXEC void operator()(const vtkm::FloatDefault& center,
+                            const vtkm::Id& segmentId,
+                            const vtkm::Range& segmentCenterRange,
+                            vtkm::Id& key,
+                            const CountsPortal& binCounts) const
+  {
+    key = segmentId * this->NumBins + CenterBin(center, segmentCenterRange, this->NumBins);
+    binCounts.Add(key, 1);
+  }
+
+  vtkm::Id NumBins;
+}; // struct BinKeyCalculator
+
+// Places every cell at the next free position of its key, which groups the cells by key
+// without sorting them.
+struct BinScatter : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, AtomicArrayInOut, WholeArrayOut, WholeArrayOut);
+  typedef void ExecutionSignature(WorkIndex, _1, _2, _3, _4);
+  using InputDomain = _1;
+
+  template <typename CursorsPortal, typename OrderPortal, typename KeysPortal>
+  VTKM_EXEC void operator()(const vtkm::Id& cellIndex,
+                            const vtkm::Id& key,
+                            const CursorsPortal& cursors,
+                            OrderPortal& cellOrder,
+                            KeysPortal& groupedKeys) const
+  {
+    vtkm::Id position = cursors.Add(key, 1);
+    cellOrder.Set(position, cellIndex);
+    groupedKeys.Set(position, key);
+  }
+}; // struct BinScatter
+
+// Sweeps over the non-empty bins of a segment along one dimension and finds the boundary
+// between bins with the lowest surface area heuristic cost.
+struct BinnedSplitSweep : public vtkm::worklet::WorkletMapField
+{
+  static constexpr vtkm::IdComponent MaxNumberOfBins = 64;
+
+  typedef void ControlSignature(FieldIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  BinnedSplitSweep(vtkm::IdComponent numBins, vtkm::IdComponent dimension)
+    : NumBins(numBins)
+    , Dimension(dimension)
+  {
+  }
+
+  template <typename OffsetsPortal,
+            typename KeysPortal,
+            typename BoundsPortal,
+            typename CountsPortal>
+  VTKM_EXEC void operator()(const vtkm::Id& segmentIndex,
+                            const OffsetsPortal& binOffsets,
+                            const KeysPortal& binKeys,
+                            const BoundsPortal& binBounds,
+                            const CountsPortal& binCounts,
+                            BinnedSplit& split) const
+  {
+    split = BinnedSplit();
+    const vtkm::Id start = binOffsets.Get(segmentIndex);
+    const vtkm::Id numBins = binOffsets.Get(segmentIndex + 1) - start;
+    if (numBins < 2)
+    {
+      return;
+    }
+
+    // Accumulate the right side of each candidate split from the last bin backward.
+    vtkm::Vec<vtkm::FloatDefault, MaxNumberOfBins> rightAreas;
+    vtkm::Vec<vtkm::FloatDefault, MaxNumberOfBins> rightMins;
+    vtkm::Vec<vtkm::Id, MaxNumberOfBins> rightCounts;
+    vtkm::Bounds right;
+    vtkm::Id rightCount = 0;
+    for (vtkm::Id i = numBins - 1; i > 0; --i)
+    {
+      right.Include(binBounds.Get(start + i));
+      rightCount += binCounts.Get(start + i);
+      const vtkm::Range* rightRanges = &right.X;
+      rightAreas[static_cast<vtkm::IdComponent>(i)] = HalfSurfaceArea(right);
+      rightMins[static_cast<vtkm::IdComponent>(i)] =
+        static_cast<vtkm::FloatDefault>(rightRanges[this->Dimension].Min);
+      rightCounts[static_cast<vtkm::IdComponent>(i)] = rightCount;
+    }
+
+    vtkm::Bounds left;
+    vtkm::Id leftCount = 0;
+    for (vtkm::Id i = 0; i < numBins - 1; ++i)
+    {
+      left.Include(binBounds.Get(start + i));
+      leftCount += binCounts.Get(start + i);
+      const vtkm::IdComponent next = static_cast<vtkm::IdComponent>(i + 1);
+      vtkm::FloatDefault cost = HalfSurfaceArea(left) * static_cast<vtkm::FloatDefault>(leftCount) +
+        rightAreas[next] * static_cast<vtkm::FloatDefault>(rightCounts[next]);
+      if (cost < split.Cost)
+      {
+        const vtkm::Range* leftRanges = &left.X;
+        split.Cost = cost;
+        split.Bin = binKeys.Get(start + i) % this->NumBins;
+        split.LMax = static_cast<vtkm::FloatDefault>(leftRanges[this->Dimension].Max);
+        split.RMin = rightMins[next];
+      }
+    }
+  }
+
+  vtkm::Id NumBins;
+  vtkm::IdComponent Dimension;
+}; // struct BinnedSplitSweep
+
+struct BinnedSplitSelector : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldOut,
+                                FieldOut,
+                                FieldOut,
+                                FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  BinnedSplitSelector(vtkm::IdComponent maxLeafSize)
+    : MaxLeafSize(maxLeafSize)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(const vtkm::Id& segmentSize,
+                  const BinnedSplit& xSplit,
+                  const BinnedSplit& ySplit,
+                  const BinnedSplit& zSplit,
+                  const vtkm::Range& xCenterRange,
+                  const vtkm::Range& yCenterRange,
+                  const vtkm::Range& zCenterRange,
+                  TreeNode& node,
+                  vtkm::Id& splitBin,
+                  vtkm::Range& splitCenterRange,
+                  vtkm::Id& choice) const
+  {
+    splitBin = -1;
+    if (segmentSize <= this->MaxLeafSize)
+    {
+      node.Dimension = -1;
+      choice = 0;
+      return;
+    }
+    choice = 1;
+    // When all cell centers coincide, no plane separates them. Such segments are split in
+    // half by position, which the split bin of -1 signifies.
+    node.Dimension = 0;
+    vtkm::FloatDefault minCost = vtkm::Infinity<vtkm::FloatDefault>();
+    this->Consider(xSplit, xCenterRange, 0, minCost, node, splitBin, splitCenterRange);
+    this->Consider(ySplit, yCenterRange, 1, minCost, node, splitBin, splitCenterRange);
+    this->Consider(zSplit, zCenterRange, 2, minCost, node, splitBin, splitCenterRange);
+  }
+
+  VTKM_EXEC
+  void Consider(const BinnedSplit& split,
+                const vtkm::Range& centerRange,
+                vtkm::IdComponent dimension,
+                vtkm::FloatDefault& minCost,
+                TreeNode& node,
+                vtkm::Id& splitBin,
+                vtkm::Range& splitCenterRange) const
+  {
+    if (split.Bin >= 0 && split.Cost < minCost)
+    {
+      minCost = split.Cost;
+      node.Dimension = dimension;
+      node.LMax = split.LMax;
+      node.RMin = split.RMin;
+      splitBin = split.Bin;
+      splitCenterRange = centerRange;
+    }
+  }
+
+  vtkm::IdComponent MaxLeafSize;
+}; // struct BinnedSplitSelector
+
+struct BinnedSplitDirectionFlag : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldIn,
+                                FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6, _7, _8, _9, WorkIndex);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  BinnedSplitDirectionFlag(vtkm::IdComponent numBins)
+    : NumBins(numBins)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(const vtkm::FloatDefault& x,
+                  const vtkm::FloatDefault& y,
+                  const vtkm::FloatDefault& z,
+                  const TreeNode& split,
+                  const vtkm::Id& splitBin,
+                  const vtkm::Range& splitCenterRange,
+                  const vtkm::Id& segmentStart,
+                  const vtkm::Id& segmentSize,
+                  vtkm::Id& flag,
+                  vtkm::Id index) const
+  {
+    // We use 0 to signify left child, 1 for right child
+    if (split.Dimension < 0)
+    {
+      flag = 0;
+    }
+    else if (splitBin < 0)
+    {
+      flag = static_cast<vtkm::Id>(index - segmentStart >= segmentSize / 2);
+    }
+    else
+    {
+      const vtkm::Vec3f point(x, y, z);
+      flag = static_cast<vtkm::Id>(
+        CenterBin(point[split.Dimension], splitCenterRange, this->NumBins) > splitBin);
+    }
+  }
+
+  vtkm::Id NumBins;
+}; // struct BinnedSplitDirectionFlag
+
 VTKM_CONT
 struct RangeAdd
 {
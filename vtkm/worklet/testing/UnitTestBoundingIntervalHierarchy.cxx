@@ -9,8 +9,10 @@
 //============================================================================
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandleConcatenate.h>
 #include <vtkm/cont/CellLocatorBoundingIntervalHierarchy.h>
+#include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/RuntimeDeviceInformation.h>
@@ -64,18 +66,11 @@ vtkm::cont::DataSet ConstructDataSet(vtkm::Id size)
   return vtkm::cont::DataSetBuilderUniform().Create(vtkm::Id3(size, size, size));
 }
 
-void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponent numPlanes)
+void CheckCellCentroids(const vtkm::cont::CellLocatorBoundingIntervalHierarchy& bih,
+                        const vtkm::cont::UnknownCellSet& cellSet,
+                        const vtkm::cont::CoordinateSystem& coords)
 {
-
-  vtkm::cont::UnknownCellSet cellSet = dataSet.GetCellSet();
-  auto vertices = dataSet.GetCoordinateSystem().GetDataAsMultiplexer();
-
-  vtkm::cont::CellLocatorBoundingIntervalHierarchy bih =
-    vtkm::cont::CellLocatorBoundingIntervalHierarchy(numPlanes, 5);
-  bih.SetCellSet(cellSet);
-  bih.SetCoordinates(dataSet.GetCoordinateSystem());
-  bih.Update();
-
+  auto vertices = coords.GetDataAsMultiplexer();
   vtkm::cont::ArrayHandle<vtkm::Vec3f> centroids;
   vtkm::worklet::DispatcherMapTopology<CellCentroidCalculator>().Invoke(
     cellSet, vertices, centroids);
@@ -91,6 +86,103 @@ void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponen
   VTKM_TEST_ASSERT(numDiffs == 0, "Calculated cell Ids not the same as expected cell Ids");
 }
 
+void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponent numPlanes)
+{
+  vtkm::cont::CellLocatorBoundingIntervalHierarchy bih =
+    vtkm::cont::CellLocatorBoundingIntervalHierarchy(numPlanes, 5);
+  bih.SetCellSet(dataSet.GetCellSet());
+  bih.SetCoordinates(dataSet.GetCoordinateSystem());
+  bih.Update();
+
+  CheckCellCentroids(bih, dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+}
+
+void TestBinnedSAH(vtkm::cont::DataSet dataSet,
+                   vtkm::IdComponent numBins,
+                   vtkm::IdComponent maxLeafSize)
+{
+  std::cout << "Testing binned SAH build with " << numBins << " bins and leaf size "
+            << maxLeafSize << std::endl;
+  vtkm::cont::CellLocatorBoundingIntervalHierarchy bih;
+  bih.SetBuildMethod(vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::BinnedSAH);
+  bih.SetNumberOfBins(numBins);
+  bih.SetMaxLeafSize(maxLeafSize);
+  bih.SetCellSet(dataSet.GetCellSet());
+  bih.SetCoordinates(dataSet.GetCoordinateSystem());
+  bih.Update();
+
+  CheckCellCentroids(bih, dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+}
+
+void TestBinnedSAHCoincidentCells()
+{
+  std::cout << "Testing binned SAH build with coincident cells" << std::endl;
+  // No plane separates cells that are all in the same place, so the build has to fall back
+  // on splitting them by position.
+  const vtkm::Id numCells = 20;
+  std::vector<vtkm::Vec3f> points = {
+    { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }
+  };
+  std::vector<vtkm::UInt8> shapes(numCells, vtkm::CELL_SHAPE_TETRA);
+  std::vector<vtkm::IdComponent> numIndices(numCells, 4);
+  std::vector<vtkm::Id> connectivity;
+  for (vtkm::Id i = 0; i < numCells; ++i)
+  {
+    connectivity.insert(connectivity.end(), { 0, 1, 2, 3 });
+  }
+  vtkm::cont::DataSet dataSet =
+    vtkm::cont::DataSetBuilderExplicit::Create(points, shapes, numIndices, connectivity);
+
+  vtkm::cont::CellLocatorBoundingIntervalHierarchy bih;
+  bih.SetBuildMethod(vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::BinnedSAH);
+  bih.SetMaxLeafSize(2);
+  bih.SetCellSet(dataSet.GetCellSet());
+  bih.SetCoordinates(dataSet.GetCoordinateSystem());
+  bih.Update();
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> parametric;
+  bih.FindCells(vtkm::cont::make_ArrayHandle<vtkm::Vec3f>({ { 0.1f, 0.1f, 0.1f } }),
+                cellIds,
+                parametric);
+  VTKM_TEST_ASSERT(cellIds.ReadPortal().Get(0) >= 0, "Point in coincident cells not found");
+}
+
+void TestRefit(vtkm::cont::DataSet dataSet)
+{
+  std::cout << "Testing refit of a deformed mesh" << std::endl;
+  vtkm::cont::CoordinateSystem coords = dataSet.GetCoordinateSystem();
+
+  vtkm::cont::CellLocatorBoundingIntervalHierarchy bih(4, 5);
+  bih.SetCellSet(dataSet.GetCellSet());
+  bih.SetCoordinates(coords);
+  bih.Update();
+
+  // Smoothly deform the mesh without changing its connectivity.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> deformedPoints;
+  vtkm::cont::ArrayCopy(coords.GetData(), deformedPoints);
+  auto portal = deformedPoints.WritePortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+  {
+    vtkm::Vec3f p = portal.Get(i);
+    portal.Set(i,
+               vtkm::Vec3f(p[0] + 0.25f * vtkm::Sin(p[1]), 1.5f * p[1], p[2] + 0.1f * p[0]));
+  }
+  vtkm::cont::CoordinateSystem deformedCoords("coords", deformedPoints);
+
+  VTKM_TEST_ASSERT(bih.Refit(deformedCoords), "Small deformation should not rebuild");
+  CheckCellCentroids(bih, dataSet.GetCellSet(), deformedCoords);
+
+  // Refitting back to the original points must give the original tree.
+  VTKM_TEST_ASSERT(bih.Refit(coords), "Refit back to original points should not rebuild");
+  CheckCellCentroids(bih, dataSet.GetCellSet(), coords);
+
+  // A threshold of 0 tolerates no degradation at all, so the tree is always rebuilt.
+  bih.SetRefitQualityThreshold(0);
+  VTKM_TEST_ASSERT(!bih.Refit(deformedCoords), "Zero threshold should force a rebuild");
+  CheckCellCentroids(bih, dataSet.GetCellSet(), deformedCoords);
+}
+
 void RunTest()
 {
 //If this test is run on a machine that already has heavy
@@ -108,6 +200,11 @@ void RunTest()
   TestBoundingIntervalHierarchy(ConstructDataSet(8), 4);
   TestBoundingIntervalHierarchy(ConstructDataSet(8), 6);
   TestBoundingIntervalHierarchy(ConstructDataSet(8), 9);
+  TestBinnedSAH(ConstructDataSet(8), 2, 1);
+  TestBinnedSAH(ConstructDataSet(8), 16, 5);
+  TestBinnedSAH(ConstructDataSet(8), 64, 8);
+  TestBinnedSAHCoincidentCells();
+  TestRefit(ConstructDataSet(8));
 }
 
 } // anonymous namespace